@@ -1471,6 +1471,34 @@ static Expr* lowerReduceOp(Expr* ref, SymExpr* opSE, SymExpr* dataSE,
   return new CallExpr(opSE, iitR);
 }
 
+// Resolve chpl__treeReducible(op(inputType), data), a param.
+static bool isTreeReducible(Expr* ref, Expr* opExpr, SymExpr* dataSE) {
+  Expr* op = opExpr->copy();
+  ref->insertBefore(op);
+  Expr* opR = resolveExpr(op)->remove();
+  if (!isSymExpr(opR)) opR = normalizeIITR(ref, opR);
+
+  CallExpr* test = new CallExpr("chpl__treeReducible", opR, dataSE->copy());
+  ref->insertBefore(test);
+  Expr* testR = resolveExpr(test)->remove();
+
+  SymExpr* se = toSymExpr(testR);
+  INT_ASSERT(se && (se->symbol() == gTrue || se->symbol() == gFalse));
+
+  return se->symbol() == gTrue;
+}
+
+static ForallStmt* buildReduceForall(Symbol* result, Expr* opExpr,
+                                     SymExpr* dataSE, bool zippered) {
+  bool  reqSerial = false; // We may need it for #11819, otherwise remove it.
+
+  VarSymbol*       idx  = newTemp("chpl_redIdx");
+  ShadowVarSymbol* svar = new ShadowVarSymbol(TFI_REDUCE, "chpl_redSVar",
+                                              new SymExpr(result), opExpr);
+
+  return ForallStmt::fromReduceExpr(idx, dataSE, svar, zippered, reqSerial);
+}
+
 //
 // lowerPrimReduce(call), where 'call' is PRIM_REDUCE, converts:
 //   move call_tmp, call
@@ -1490,6 +1518,12 @@ static Expr* lowerReduceOp(Expr* ref, SymExpr* opSE, SymExpr* dataSE,
 // We ensure resolution of the ForallStmt within the resolveBlockStmt /
 // for_exprs_postorder framework by placing it after the no-op.
 //
+// When not zippered, and chpl__treeReducible(op(inputType), data) is true,
+// the ForallStmt is replaced by:
+//   move call_tmp, chpl__treeReduce(op(inputType), data)
+// so that the modules can reduce distributed arrays with built-in ops
+// by combining the locales' partial results up a tree.
+//
 Expr* lowerPrimReduce(CallExpr* call) {
   if (call->id == breakOnResolveID) gdbShouldBreakHere();
 
@@ -1500,7 +1534,6 @@ Expr* lowerPrimReduce(CallExpr* call) {
   SymExpr*   opSE = toSymExpr(call->get(1)->remove());           // 1st arg
   SymExpr* dataSE = toSymExpr(call->get(1)->remove());           // 2nd arg
   bool   zippered = toSymExpr(call->get(1))->symbol() == gTrue;  // 3rd arg
-  bool  reqSerial = false; // We may need it for #11819, otherwise remove it.
 
   Expr* opExpr = lowerReduceOp(callStmt, opSE, dataSE, zippered);
 
@@ -1515,16 +1548,19 @@ Expr* lowerPrimReduce(CallExpr* call) {
     result = toSymExpr(move->get(1))->symbol();
   }
 
-  VarSymbol*       idx  = newTemp("chpl_redIdx");
-  ShadowVarSymbol* svar = new ShadowVarSymbol(TFI_REDUCE, "chpl_redSVar",
-                                              new SymExpr(result), opExpr);
-  ForallStmt*      fs   = ForallStmt::fromReduceExpr(idx, dataSE, svar,
-                                                     zippered, reqSerial);
+  Expr* stmt = NULL;
+  if (!zippered && isTreeReducible(callStmt, opExpr, dataSE)) {
+    CallExpr* tree = new CallExpr("chpl__treeReduce", opExpr, dataSE);
+    stmt = new CallExpr(PRIM_MOVE, result, tree);
+  } else {
+    stmt = buildReduceForall(result, opExpr, dataSE, zippered);
+  }
+
   if (callStmt == call) {
-    callStmt->insertBefore(fs);
+    callStmt->insertBefore(stmt);
     call->replace(new SymExpr(result));
   } else {
-    callStmt->replace(fs);
+    callStmt->replace(stmt);
   }
 
   return noop;
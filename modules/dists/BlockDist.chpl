@@ -1331,6 +1331,13 @@ proc BlockArr.dsiTargetLocales() {
   return dom.dist.targetLocales;
 }
 
+// Reductions with built-in ops combine the locales' results up a tree.
+proc BlockArr.doiTreeReduce(op) {
+  const res = treeReduceArr(op, _to_unmanaged(this));
+  delete op;
+  return res;
+}
+
 proc BlockDom.dsiTargetLocales() {
   return dist.targetLocales;
 }
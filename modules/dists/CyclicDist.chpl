@@ -1189,6 +1189,14 @@ where useBulkTransferDist {
 proc CyclicArr.dsiTargetLocales() {
   return dom.dist.targetLocs;
 }
+
+// Reductions with built-in ops combine the locales' results up a tree.
+proc CyclicArr.doiTreeReduce(op) {
+  const res = treeReduceArr(op, _to_unmanaged(this));
+  delete op;
+  return res;
+}
+
 proc CyclicDom.dsiTargetLocales() {
   return dist.targetLocs;
 }
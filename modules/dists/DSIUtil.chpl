@@ -590,3 +590,59 @@ proc bulkCommConvertCoordinate(ind, bView:domain, aView:domain)
   }
   return result;
 }
+
+//
+// Reduce a privatized distributed array with 'op', one of the built-in
+// reductions that chpl__isTreeReduceOp() accepts.  'arr' holds the
+// per-locale array descriptors in 'locArr', each with its local elements
+// in 'myElems'.  Each locale reduces its own elements, and then the
+// partial results are combined up a tree of the target locales with the
+// same fanout as the runtime's broadcasts and collectives.  So the
+// reduction takes O(log P) steps, and no locale combines more than a
+// fanout's worth of partial results.  Each locale finds its children in
+// its own privatized copy of 'arr', to avoid reading them remotely.
+//
+proc treeReduceArr(op, arr) {
+  extern proc chpl_comm_bcast_fanout(): int(32);
+
+  type resType = op.generate().type;
+  const fanout = max(1, chpl_comm_bcast_fanout(): int);
+  const n = arr.locArr.size;
+  const pid = arr.pid;
+
+  // The 'ord'th of a's per-locale array descriptors, in row-major order.
+  proc locArrAt(a, in ord: int) {
+    const locDom = a.locArr.domain;
+    var idx: locDom.rank*locDom.idxType;
+    for param d in 1..locDom.rank by -1 {
+      const dim = locDom.dim(d);
+      idx(d) = dim.orderToIndex(ord % dim.size);
+      ord /= dim.size;
+    }
+    return a.locArr[idx];
+  }
+
+  // Reduce the subtree rooted at the 'r'th target locale, 'loc'.
+  proc subtree(r: int, loc: locale): resType {
+    var res: resType;
+    on loc {
+      const myArr = if _privatization then chpl_getPrivatizedCopy(arr.type, pid)
+                                      else arr;
+      const myop = new op.type();
+      var mine = chpl__localReduce(myop, locArrAt(myArr, r).myElems);
+      const children = r*fanout+1..min(r*fanout+fanout, n-1);
+      if children.size > 0 {
+        var childRes: [children] resType;
+        coforall c in children with (ref childRes) do
+          childRes[c] = subtree(c, locArrAt(myArr, c).locale);
+        for x in childRes do
+          myop.accumulateOntoState(mine, x);
+      }
+      res = mine;
+      delete myop;
+    }
+    return res;
+  }
+
+  return subtree(0, locArrAt(arr, 0).locale);
+}
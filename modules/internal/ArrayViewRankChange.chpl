@@ -493,7 +493,7 @@ module ArrayViewRankChange {
     forwarding arr except these,
                       doiBulkTransferFromKnown, doiBulkTransferToKnown,
                       doiBulkTransferFromAny,  doiBulkTransferToAny, doiScan,
-                      chpl__serialize, chpl__deserialize;
+                      doiTreeReduce, chpl__serialize, chpl__deserialize;
 
 
 
@@ -79,7 +79,7 @@ module ArrayViewSlice {
     forwarding arr except these,
                       doiBulkTransferFromKnown, doiBulkTransferToKnown,
                       doiBulkTransferFromAny,  doiBulkTransferToAny,
-                      chpl__serialize, chpl__deserialize;
+                      doiTreeReduce, chpl__serialize, chpl__deserialize;
 
 
     //
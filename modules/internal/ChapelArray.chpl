@@ -170,10 +170,6 @@ module ChapelArray {
   private use ChapelDebugPrint;
   private use SysCTypes;
 
-  // Explicitly use a processor atomic, as most calls to this function are
-  // likely be on locale 0
-  pragma "no doc"
-  var numPrivateObjects: chpl__processorAtomicType(int);
   pragma "no doc"
   param nullPid = -1;
 
@@ -223,13 +219,15 @@ module ChapelArray {
   // with a privatized value that can be retrieved by the pid
   // without communication.
   proc _newPrivatizedClass(value) : int {
-
-    const n = numPrivateObjects.fetchAdd(1);
+    extern proc chpl_newPrivatizedPid(): int;
 
     const hereID = here.id;
     const privatizeData = value.dsiGetPrivatizeData();
-    on Locales[0] do
+    var n: int;
+    on Locales[0] {
+      n = chpl_newPrivatizedPid();
       _newPrivatizedClassHelp(value, value, n, hereID, privatizeData);
+    }
 
     proc _newPrivatizedClassHelp(parentValue, originalValue, n, hereID, privatizeData) {
       var newValue = originalValue;
@@ -261,8 +259,12 @@ module ChapelArray {
     // Do nothing for null pids.
     if pid == nullPid then return;
 
+    // Once the helper returns, the pid is clear on every locale, so it
+    // can be reused.
     on Locales[0] {
+      extern proc chpl_freePrivatizedPid(pid:int);
       _freePrivatizedClassHelp(pid, original);
+      chpl_freePrivatizedPid(pid);
     }
 
     proc _freePrivatizedClassHelp(pid, original) {
@@ -3072,6 +3074,11 @@ module ChapelArray {
       return _value.doiScan(op, this.domain);
     }
 
+    pragma "no doc"
+    proc _treeReduce(op) where Reflection.canResolveMethod(_value, "doiTreeReduce", op) {
+      return _value.doiTreeReduce(op);
+    }
+
   }  // record _array
 
   // _instance is a subclass of BaseArr.  LYDIA NOTE: moved this from
@@ -767,6 +767,10 @@ module ChapelDistribution {
       halt("_preserveArrayElement() not supported for non-associative arrays");
     }
 
+    proc _migrateArrayElement(oldslot, newslot) {
+      halt("_migrateArrayElement() not supported for non-associative arrays");
+    }
+
     proc dsiSupportsAlignedFollower() param return false;
 
     proc dsiSupportsPrivatization() param return false;
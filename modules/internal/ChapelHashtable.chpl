@@ -0,0 +1,398 @@
+/*
+ * Copyright 2004-2020 Hewlett Packard Enterprise Development LP
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// ChapelHashtable.chpl
+//
+// An open addressing hash table that stores each key and its value
+// inline in one slot.  This is the storage behind the standard map and
+// set types.
+//
+// Parallel safe maps and sets split their keys over several of these
+// tables ("shards"), each protected by its own lock, so that operations
+// on keys in different shards do not contend.
+//
+module ChapelHashtable {
+
+  use DSIUtil;
+  private use ChapelBase, ChapelLocks, DefaultAssociative;
+
+  // The number of shards used by parallel safe maps and sets.  Must be
+  // a power of two.
+  config param parSafeHashtableShards = 64;
+
+  // Tables never shrink below this many slots.  Must be a power of two.
+  private param chpl__hashtableMinSize = 16;
+
+  proc chpl__hashtableNumShards(param parSafe: bool) param {
+    if parSafe then
+      return parSafeHashtableShards;
+    else
+      return 1;
+  }
+
+  // The (1-based) shard holding a key with this hash.  This uses the high
+  // bits of the hash since the low bits select the slot within a shard.
+  inline proc chpl__hashtableShard(hash: uint, param numShards: int): int {
+    if numShards == 1 then
+      return 1;
+    else
+      return ((hash >> 48) & (numShards - 1):uint):int + 1;
+  }
+
+  inline proc chpl__hashtableHash(const ref key): uint {
+    return chpl__defaultHashWrapper(key):uint;
+  }
+
+  // The key and value of an entry are only initialized while its status
+  // is full.
+  record chpl__hashtableEntry {
+    type keyType;
+    type valType;
+    var status: chpl__hash_status = chpl__hash_status.empty;
+    var key: keyType;
+    var val: valType;
+  }
+
+  // A shard lock, padded to keep each lock on its own cache line
+  record chpl__hashtableLock {
+    var lock: chpl_LocalSpinlock;
+    var pad: 7*int;
+  }
+
+  //
+  // The locks for each shard of a table.  This is a class so that
+  // methods with a const receiver can still acquire them.
+  //
+  class chpl__hashtableLocks {
+    param numLocks: int;
+    var locks: numLocks*chpl__hashtableLock;
+
+    inline proc lock(shard: int) {
+      locks[shard].lock.lock();
+    }
+
+    inline proc unlock(shard: int) {
+      locks[shard].lock.unlock();
+    }
+
+    proc lockAll() {
+      for shard in 1..numLocks do
+        lock(shard);
+    }
+
+    proc unlockAll() {
+      for shard in 1..numLocks do
+        unlock(shard);
+    }
+  }
+
+  //
+  // Tables are power-of-two sized, probed triangularly, and allocated on
+  // the first add.  They grow when more than half the slots are full or
+  // deleted and shrink when fewer than an eighth are full.
+  //
+  // None of the methods here lock; callers are responsible for that.
+  //
+  record chpl__hashtable {
+    type keyType;
+    type valType;
+
+    var tableNumFullSlots: int;
+    var tableNumDeletedSlots: int;
+    var tableSize: int;
+    var table: _ddata(chpl__hashtableEntry(keyType, valType));
+
+    proc init(type keyType, type valType) {
+      this.keyType = keyType;
+      this.valType = valType;
+    }
+
+    proc init=(const ref other: chpl__hashtable(?kt, ?vt)) {
+      this.keyType = kt;
+      this.valType = vt;
+      this.complete();
+
+      if other.tableSize > 0 {
+        _allocateTable(other.tableSize);
+        // keep the same slots, so no probe sequence changes
+        for slot in 0..#tableSize {
+          ref entry = other.table[slot];
+          if entry.status == chpl__hash_status.full then
+            fillSlot(slot, entry.key, entry.val);
+          else if entry.status == chpl__hash_status.deleted {
+            table[slot].status = chpl__hash_status.deleted;
+            tableNumDeletedSlots += 1;
+          }
+        }
+      }
+    }
+
+    proc deinit() {
+      clear();
+    }
+
+    proc _allocateTable(size: int) {
+      table = _ddata_allocate(chpl__hashtableEntry(keyType, valType), size,
+                              initElts=false);
+      tableSize = size;
+      for slot in 0..#size do
+        table[slot].status = chpl__hash_status.empty;
+    }
+
+    // Destroys every key and value and frees the table
+    proc clear() {
+      if tableSize == 0 then return;
+      for slot in allSlots() do
+        _destroySlot(slot);
+      _ddata_free(table, tableSize);
+      tableSize = 0;
+      tableNumFullSlots = 0;
+      tableNumDeletedSlots = 0;
+    }
+
+    inline proc isSlotFull(slot: int): bool {
+      return table[slot].status == chpl__hash_status.full;
+    }
+
+    // Returns (true, slot) if 'key' is in the table.  Otherwise, returns
+    // (false, slot) where 'slot' is the first available slot in the probe
+    // sequence for 'key', or -1 if there is none.
+    proc _findSlot(const ref key: keyType, hash: uint): (bool, int) {
+      if tableSize == 0 then
+        return (false, -1);
+
+      const mask = (tableSize - 1):uint;
+      var slot = hash & mask;
+      var firstOpen = -1;
+      for probe in 0..#tableSize {
+        ref entry = table[slot:int];
+        select entry.status {
+          when chpl__hash_status.empty {
+            if firstOpen == -1 then firstOpen = slot:int;
+            return (false, firstOpen);
+          }
+          when chpl__hash_status.deleted {
+            if firstOpen == -1 then firstOpen = slot:int;
+          }
+          when chpl__hash_status.full {
+            if entry.key == key then
+              return (true, slot:int);
+          }
+        }
+        slot = (slot + probe:uint + 1) & mask;
+      }
+      return (false, firstOpen);
+    }
+
+    // Returns (true, slot) if 'key' is in the table, or (false, -1)
+    proc findFullSlot(const ref key: keyType,
+                      hash = chpl__hashtableHash(key)): (bool, int) {
+      const (found, slot) = _findSlot(key, hash);
+      if found then
+        return (true, slot);
+      else
+        return (false, -1);
+    }
+
+    // Returns (true, slot) if 'key' is in the table.  Otherwise, makes
+    // room for it if needed and returns (false, slot) for the slot it
+    // should be stored in.
+    proc findAvailableSlot(const ref key: keyType,
+                           hash = chpl__hashtableHash(key)): (bool, int) {
+      if (tableNumFullSlots + tableNumDeletedSlots + 1) * 2 > tableSize {
+        // Rebuild at the same size if most of the used slots are deleted
+        var newSize = tableSize;
+        if tableSize == 0 then
+          newSize = chpl__hashtableMinSize;
+        else if (tableNumFullSlots + 1) * 4 > tableSize then
+          newSize = tableSize * 2;
+        _rehash(newSize);
+      }
+      return _findSlot(key, hash);
+    }
+
+    // Stores 'key' and 'val' in an available slot
+    pragma "unsafe"
+    proc fillSlot(slot: int,
+                  pragma "no auto destroy" in key: keyType,
+                  pragma "no auto destroy" in val: valType) {
+      ref entry = table[slot];
+      if entry.status == chpl__hash_status.deleted then
+        tableNumDeletedSlots -= 1;
+      entry.status = chpl__hash_status.full;
+      __primitive("=", entry.key, key);
+      if valType != nothing then
+        __primitive("=", entry.val, val);
+      tableNumFullSlots += 1;
+    }
+
+    // Destroys the key and value in a full slot and marks it deleted
+    proc clearSlot(slot: int) {
+      _destroySlot(slot);
+      table[slot].status = chpl__hash_status.deleted;
+      tableNumFullSlots -= 1;
+      tableNumDeletedSlots += 1;
+    }
+
+    proc _destroySlot(slot: int) {
+      ref entry = table[slot];
+      chpl__autoDestroy(entry.key);
+      if valType != nothing then
+        chpl__autoDestroy(entry.val);
+    }
+
+    proc maybeShrinkAfterRemove() {
+      if tableSize > chpl__hashtableMinSize &&
+         tableNumFullSlots * 8 < tableSize then
+        _rehash(tableSize / 2);
+    }
+
+    // Makes room for at least 'numKeys' keys without growing
+    proc requestCapacity(numKeys: int) {
+      var newSize = chpl__hashtableMinSize;
+      while newSize < (numKeys + 1) * 2 do
+        newSize *= 2;
+      if newSize > tableSize then
+        _rehash(newSize);
+    }
+
+    // Moves every entry into a new table with 'newSize' slots, dropping
+    // any deleted slots along the way.
+    pragma "unsafe"
+    proc _rehash(newSize: int) {
+      const oldTable = table;
+      const oldSize = tableSize;
+
+      _allocateTable(newSize);
+      tableNumFullSlots = 0;
+      tableNumDeletedSlots = 0;
+
+      for slot in 0..#oldSize {
+        ref oldEntry = oldTable[slot];
+        if oldEntry.status == chpl__hash_status.full {
+          const (_, newSlot) = _findSlot(oldEntry.key,
+                                         chpl__hashtableHash(oldEntry.key));
+          ref entry = table[newSlot];
+          entry.status = chpl__hash_status.full;
+          __primitive("=", entry.key, oldEntry.key);
+          if valType != nothing then
+            __primitive("=", entry.val, oldEntry.val);
+          tableNumFullSlots += 1;
+        }
+      }
+
+      if oldSize > 0 then
+        _ddata_free(oldTable, oldSize);
+    }
+
+    iter allSlots() {
+      for slot in 0..#tableSize {
+        if isSlotFull(slot) then
+          yield slot;
+      }
+    }
+
+    iter allSlots(param tag: iterKind) where tag == iterKind.standalone {
+      const numTasks = if dataParTasksPerLocale==0 then here.maxTaskPar
+                       else dataParTasksPerLocale;
+      const numChunks = _computeNumChunks(numTasks,
+                                          dataParIgnoreRunningTasks,
+                                          dataParMinGranularity,
+                                          tableSize);
+      if numChunks <= 1 {
+        for slot in allSlots() do
+          yield slot;
+      } else {
+        coforall chunk in 0..#numChunks {
+          const (lo, hi) = _computeBlock(tableSize, numChunks,
+                                         chunk, tableSize-1);
+          for slot in lo..hi {
+            if isSlotFull(slot) then
+              yield slot;
+          }
+        }
+      }
+    }
+  }
+
+  //
+  // Iterators over the full slots of a tuple of shards, yielding
+  // (shard, slot) pairs.
+  //
+  iter chpl__shardedSlots(const ref shards) {
+    for shard in 1..shards.size {
+      for slot in shards[shard].allSlots() do
+        yield (shard, slot);
+    }
+  }
+
+  iter chpl__shardedSlots(const ref shards, param tag: iterKind)
+  where tag == iterKind.standalone {
+    if shards.size == 1 {
+      forall slot in shards[1].allSlots() do
+        yield (1, slot);
+    } else {
+      forall shard in 1..shards.size {
+        for slot in shards[shard].allSlots() do
+          yield (shard, slot);
+      }
+    }
+  }
+
+  // The leader divides up the slots of all the shards, numbered as if
+  // the shards were laid end to end.
+  iter chpl__shardedSlots(const ref shards, param tag: iterKind)
+  where tag == iterKind.leader {
+    var numSlots = 0;
+    for shard in 1..shards.size do
+      numSlots += shards[shard].tableSize;
+
+    const numTasks = if dataParTasksPerLocale==0 then here.maxTaskPar
+                     else dataParTasksPerLocale;
+    const numChunks = _computeNumChunks(numTasks,
+                                        dataParIgnoreRunningTasks,
+                                        dataParMinGranularity,
+                                        numSlots);
+    if numChunks <= 1 {
+      yield 0..numSlots-1;
+    } else {
+      coforall chunk in 0..#numChunks {
+        const (lo, hi) = _computeBlock(numSlots, numChunks,
+                                       chunk, numSlots-1);
+        yield lo..hi;
+      }
+    }
+  }
+
+  iter chpl__shardedSlots(const ref shards, param tag: iterKind, followThis)
+  where tag == iterKind.follower {
+    const chunk = followThis;
+    var offset = 0;
+    for shard in 1..shards.size {
+      const size = shards[shard].tableSize;
+      const lo = max(chunk.low, offset);
+      const hi = min(chunk.high, offset + size - 1);
+      for slot in lo-offset..hi-offset {
+        if shards[shard].isSlotFull(slot) then
+          yield (shard, slot);
+      }
+      offset += size;
+    }
+  }
+}
@@ -655,11 +655,9 @@ module ChapelLocale {
       return dummyLocale;
   }
 
-  // the type of elements in chpl_privateObjects.
-  extern record chpl_privateObject_t {
-    var obj:c_void_ptr;
-  }
-  extern var chpl_privateObjects:c_ptr(chpl_privateObject_t);
+  pragma "no doc"
+  pragma "fast-on safe extern function"
+  extern proc chpl_getPrivatizedClass(pid:int):c_void_ptr;
 
   pragma "no doc"
   pragma "fn returns infinite lifetime"
@@ -667,7 +665,7 @@ module ChapelLocale {
   // Why is the compiler making the objectType argument wide?
   inline
   proc chpl_getPrivatizedCopy(type objectType, objectPid:int): objectType {
-    return __primitive("cast", objectType, chpl_privateObjects[objectPid].obj);
+    return __primitive("cast", objectType, chpl_getPrivatizedClass(objectPid));
   }
 
 //########################################################################{
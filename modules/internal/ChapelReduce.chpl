@@ -71,6 +71,55 @@ module ChapelReduce {
     delete localOp;
   }
 
+  // The built-in reductions whose partial results can be combined with
+  // accumulateOntoState(), in any order and on any locale.
+  proc chpl__isTreeReduceOp(type opType) param {
+    return isSubtype(opType, SumReduceScanOp) ||
+           isSubtype(opType, ProductReduceScanOp) ||
+           isSubtype(opType, MinReduceScanOp) ||
+           isSubtype(opType, MaxReduceScanOp) ||
+           isSubtype(opType, LogicalAndReduceScanOp) ||
+           isSubtype(opType, LogicalOrReduceScanOp) ||
+           isSubtype(opType, BitwiseAndReduceScanOp) ||
+           isSubtype(opType, BitwiseOrReduceScanOp) ||
+           isSubtype(opType, BitwiseXorReduceScanOp);
+  }
+
+  // Reduce expressions that aren't zippered ask this first.  If it is
+  // true, 'op reduce data' is computed by chpl__treeReduce() instead of
+  // by a forall loop with a reduce intent, in which every locale's
+  // partial result is combined into the one on the reducing locale.
+  proc chpl__treeReducible(type opType, data) param {
+    use Reflection;
+    if !isArray(data) || !chpl__isTreeReduceOp(opType) then
+      return false;
+    else if !isNumericType(data.eltType) && !isBoolType(data.eltType) then
+      return false;
+    else {
+      var op: unmanaged opType?;
+      return canResolveMethod(data, "_treeReduce", op!);
+    }
+  }
+
+  proc chpl__treeReduce(type opType, data) {
+    return data._treeReduce(new unmanaged opType());
+  }
+
+  // Reduce a local array with 'op', for chpl__isTreeReduceOp() ops.
+  proc chpl__localReduce(op, A) {
+    type t = _to_borrowed(op.type);
+    if isSubtype(t, SumReduceScanOp) then return + reduce A;
+    else if isSubtype(t, ProductReduceScanOp) then return * reduce A;
+    else if isSubtype(t, MinReduceScanOp) then return min reduce A;
+    else if isSubtype(t, MaxReduceScanOp) then return max reduce A;
+    else if isSubtype(t, LogicalAndReduceScanOp) then return && reduce A;
+    else if isSubtype(t, LogicalOrReduceScanOp) then return || reduce A;
+    else if isSubtype(t, BitwiseAndReduceScanOp) then return & reduce A;
+    else if isSubtype(t, BitwiseOrReduceScanOp) then return | reduce A;
+    else if isSubtype(t, BitwiseXorReduceScanOp) then return ^ reduce A;
+    else compilerError("chpl__localReduce() called with ", t:string);
+  }
+
   // Return true for simple cases where x.type == (x+x).type.
   // This should be true for the great majority of cases in practice.
   // This proc helps us avoid run-time computations upon chpl__sumType().
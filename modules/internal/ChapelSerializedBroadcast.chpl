@@ -28,6 +28,21 @@ module ChapelSerializedBroadcast {
 
   extern proc chpl_get_global_serialize_table(idx : int) : c_void_ptr;
 
+  //
+  // Broadcasts are done over the same k-ary spanning tree the runtime
+  // uses, so that the root doesn't have to start an 'on' on every
+  // locale itself.  Locales are numbered by rank relative to the root.
+  //
+  extern proc chpl_comm_bcast_fanout() : int(32);
+
+  private proc chpl__bcastTreeChildren(rank : int, fanout : int) {
+    return rank*fanout+1..min(rank*fanout+fanout, numLocales-1);
+  }
+
+  private proc chpl__bcastTreeLocale(root : int, rank : int) {
+    return Locales[(rank + root) % numLocales];
+  }
+
   proc chpl__broadcastGlobal(ref localeZeroGlobal : ?T, id : int)
   where chpl__enableSerializedGlobals {
     //
@@ -48,27 +63,45 @@ module ChapelSerializedBroadcast {
     } else {
       const data = localeZeroGlobal.chpl__serialize();
       const root = here.id;
-      coforall loc in Locales do on loc {
-        if here.id != root {
-          pragma "no copy"
-          pragma "no auto destroy"
-          var temp = localeZeroGlobal.type.chpl__deserialize(data);
+      chpl__broadcastGlobalSubtree(localeZeroGlobal.type, data, id, root,
+                                   0, chpl_comm_bcast_fanout());
+    }
+  }
+
+  private proc chpl__broadcastGlobalSubtree(type globalType, data,
+                                            id : int, root : int,
+                                            rank : int, fanout : int) {
+    coforall child in chpl__bcastTreeChildren(rank, fanout) do
+      on chpl__bcastTreeLocale(root, child) {
+        pragma "no copy"
+        pragma "no auto destroy"
+        var temp = globalType.chpl__deserialize(data);
 
-          const destVoidPtr = chpl_get_global_serialize_table(id);
-          const dest = destVoidPtr:c_ptr(localeZeroGlobal.type);
+        const destVoidPtr = chpl_get_global_serialize_table(id);
+        const dest = destVoidPtr:c_ptr(globalType);
 
-          __primitive("=", dest.deref(), temp);
-        }
+        __primitive("=", dest.deref(), temp);
+
+        chpl__broadcastGlobalSubtree(globalType, data, id, root, child,
+                                     fanout);
       }
-    }
   }
 
   proc chpl__destroyBroadcastedGlobal(ref localeZeroGlobal, id : int)
   where chpl__enableSerializedGlobals {
     type globalType = localeZeroGlobal.type;
     const root = here.id;
-    coforall loc in Locales do on loc {
-      if here.id != root {
+    chpl__destroyBroadcastedSubtree(globalType, id, root, 0,
+                                    chpl_comm_bcast_fanout());
+  }
+
+  private proc chpl__destroyBroadcastedSubtree(type globalType, id : int,
+                                               root : int, rank : int,
+                                               fanout : int) {
+    coforall child in chpl__bcastTreeChildren(rank, fanout) do
+      on chpl__bcastTreeLocale(root, child) {
+        chpl__destroyBroadcastedSubtree(globalType, id, root, child, fanout);
+
         const voidPtr = chpl_get_global_serialize_table(id);
         var ptr = voidPtr:c_ptr(globalType);
 
@@ -78,6 +111,5 @@ module ChapelSerializedBroadcast {
 
         chpl__autoDestroy(temp);
       }
-    }
   }
 }
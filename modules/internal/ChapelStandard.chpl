@@ -52,6 +52,7 @@ module ChapelStandard {
   use ChapelIO;
   use LocaleTree;
   use DefaultAssociative;
+  use ChapelHashtable;
   use DefaultSparse;
   use ChapelTaskID;
   use ChapelTaskTable;
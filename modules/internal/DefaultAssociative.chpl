@@ -28,6 +28,17 @@ module DefaultAssociative {
   config param debugDefaultAssoc = false;
   config param debugAssocDataPar = false;
 
+  // Selects the table engine used by default associative domains.
+  // By default, tables are prime-sized and probed quadratically.  When
+  // this is set, tables are power-of-two sized and probed one group of
+  // slots at a time, using packed metadata bytes that hold a hash
+  // fingerprint for each slot (in the style of Swiss tables).
+  config param defaultAssocSwissTable = false;
+
+  // Number of lock stripes used by parSafe domains with the Swiss table
+  // engine.  Must be a power of two.
+  config param defaultAssocLockStripes = 256;
+
   // TODO: make the domain parameterized by this?
   type chpl_table_index_type = int;
 
@@ -42,6 +53,20 @@ module DefaultAssociative {
     var idx: idxType;
   }
 
+  // Table entry used by the Swiss table engine.  The status of each
+  // slot is kept in the separate metadata words instead.
+  record chpl_SwissTableEntry {
+    type idxType;
+    var idx: idxType;
+  }
+
+  proc chpl__assocTableEntryType(type idxType) type {
+    if defaultAssocSwissTable then
+      return chpl_SwissTableEntry(idxType);
+    else
+      return chpl_TableEntry(idxType);
+  }
+
   proc chpl__primes return
   (23, 53, 89, 191, 383, 761, 1531, 3067, 6143, 12281, 24571, 49139, 98299,
    196597, 393209, 786431, 1572853, 3145721, 6291449, 12582893, 25165813,
@@ -54,6 +79,119 @@ module DefaultAssociative {
    27021597764222939, 54043195528445869, 108086391056891903, 216172782113783773,
    432345564227567561, 864691128455135207);
 
+  // Number of slots in a table of size class 'sizeNum'
+  proc chpl__assocTableSize(sizeNum: int): int {
+    if defaultAssocSwissTable then
+      return 1 << (sizeNum + 3);
+    else
+      return chpl__primes(sizeNum);
+  }
+
+  // Largest supported size class
+  proc chpl__assocMaxTableSizeNum param {
+    if defaultAssocSwissTable then
+      return 59;
+    else
+      return chpl__primes.size;
+  }
+
+  //
+  // Swiss table metadata.  Slots are grouped by 8, and each group is
+  // described by one uint(64) holding one byte per slot.  An empty slot
+  // is 0x00, a deleted slot is 0x01 and a full slot is 0x80 | (the low
+  // 7 bits of its hash).  The helpers below check all 8 slots of a
+  // group at once and return a mask with the high bit of each selected
+  // byte set.
+  //
+  param chpl__swissGroupSize = 8;
+  param chpl__swissDeleted: uint = 0x01;
+  param chpl__swissLsbs: uint = 0x0101010101010101;
+  param chpl__swissMsbs: uint = 0x8080808080808080;
+
+  // Marks a slot claimed by an add that has not finished storing its
+  // index yet.  Only used by concurrent (parSafe) tables.
+  param chpl__swissBusy: uint = 0x02;
+
+  // parSafe domains using the Swiss table engine run concurrently:
+  // each operation locks only the stripe for its index, and slots are
+  // claimed with a compare-and-swap on their group's metadata.
+  proc chpl__assocConcurrent(param parSafe: bool) param {
+    return parSafe && defaultAssocSwissTable;
+  }
+
+  proc chpl__assocMetaType(param parSafe: bool) type {
+    if chpl__assocConcurrent(parSafe) then
+      return chpl__processorAtomicType(uint);
+    else
+      return uint;
+  }
+
+  proc chpl__assocNumLockStripes(param parSafe: bool) param {
+    if chpl__assocConcurrent(parSafe) then
+      return defaultAssocLockStripes;
+    else
+      return 0;
+  }
+
+  // A lock stripe, padded to keep each lock on its own cache line
+  record chpl_assocLockStripe {
+    var lock: chpl_LocalSpinlock;
+    var pad: 7*int;
+  }
+
+  inline proc chpl__swissLoad(word: uint): uint {
+    return word;
+  }
+
+  inline proc chpl__swissLoad(const ref word): uint
+  where isAtomicType(word.type) {
+    return word.read();
+  }
+
+  proc chpl__assocNumMetaGroups(tableSize: int): int {
+    if defaultAssocSwissTable then
+      return tableSize / chpl__swissGroupSize;
+    else
+      return 0;
+  }
+
+  inline proc chpl__swissFingerprint(hash: uint): uint {
+    return 0x80 | (hash & 0x7f);
+  }
+
+  // Full slots that may hold 'fingerprint'.  This can report false
+  // positives, so the keys still need to be compared.
+  inline proc chpl__swissMatch(group: uint, fingerprint: uint): uint {
+    const x = group ^ (chpl__swissLsbs * fingerprint);
+    return (x - chpl__swissLsbs) & ~x & chpl__swissMsbs;
+  }
+
+  inline proc chpl__swissMatchFull(group: uint): uint {
+    return group & chpl__swissMsbs;
+  }
+
+  // Slots that are empty or deleted
+  inline proc chpl__swissMatchAvailable(group: uint): uint {
+    return ~group & chpl__swissMsbs;
+  }
+
+  // Slots that are empty.  Only the lowest selected slot is exact;
+  // higher ones can be false positives.
+  inline proc chpl__swissMatchEmpty(group: uint): uint {
+    return (group - chpl__swissLsbs) & ~group & chpl__swissMsbs;
+  }
+
+  // Does the group contain an empty slot?
+  inline proc chpl__swissHasEmpty(group: uint): bool {
+    return chpl__swissMatchEmpty(group) != 0;
+  }
+
+  // Position within the group of the lowest slot selected by 'mask'
+  inline proc chpl__swissFirstInMask(mask: uint): int {
+    extern proc chpl_bitops_ctz_64(x: uint(64)) : uint(64);
+    return (chpl_bitops_ctz_64(mask) / 8): int;
+  }
+
   class DefaultAssociativeDom: BaseAssociativeDom {
     type idxType;
     param parSafe: bool;
@@ -66,17 +204,107 @@ module DefaultAssociative {
     // by design a distributed data structure
     var numEntries: chpl__processorAtomicType(int);
     var tableLock: if parSafe then chpl_LocalSpinlock else nothing;
+
+    // For concurrent tables: the per-stripe locks, and the number of
+    // slots that are not empty (full, deleted or being added to).
+    // Deleted slots are only reclaimed when the table is rebuilt.
+    var stripeDom = {0..#chpl__assocNumLockStripes(parSafe)};
+    var stripeLocks: [stripeDom] chpl_assocLockStripe;
+    var numUsedSlots: chpl__processorAtomicType(int);
     var tableSizeNum = 1;
     var tableSize : int;
-    var tableDom = {0..tableSize-1};
-    var table: [tableDom] chpl_TableEntry(idxType);
+
+    // The table, and the packed slot metadata for the Swiss table
+    // engine (one word per group of slots, empty when using the default
+    // engine), are kept in one of two generations of fields.  Only
+    // concurrent tables use the second: a resize builds the new table
+    // in the generation that isn't current and then switches 'curGen'
+    // over to it.  Use the tableDom/table/metaDom/meta accessors below
+    // to get at the current generation.
+    var curGen = 0;
+    var tableDom0 = {0..tableSize-1};
+    var table0: [tableDom0] chpl__assocTableEntryType(idxType);
+    var metaDom0 = {0..#chpl__assocNumMetaGroups(tableSize)};
+    var meta0: [metaDom0] chpl__assocMetaType(parSafe);
+    var tableDom1 = {0..(-1:chpl_table_index_type)};
+    var table1: [tableDom1] chpl__assocTableEntryType(idxType);
+    var metaDom1 = {0..(-1:chpl_table_index_type)};
+    var meta1: [metaDom1] chpl__assocMetaType(parSafe);
+
+    // For concurrent tables: held while resizing, and set while entries
+    // are still being moved out of the previous generation.
+    var resizeLock: if chpl__assocConcurrent(parSafe) then chpl_LocalSpinlock
+                                                     else nothing;
+    var migrating: chpl__processorAtomicType(bool);
+
+    proc concurrentTable param return chpl__assocConcurrent(parSafe);
+
+    inline proc _tableDomFor(gen: int) ref {
+      if !concurrentTable then return tableDom0;
+      else if gen == 0 then return tableDom0;
+      else return tableDom1;
+    }
+
+    inline proc _tableFor(gen: int) ref {
+      if !concurrentTable then return table0;
+      else if gen == 0 then return table0;
+      else return table1;
+    }
+
+    inline proc _metaDomFor(gen: int) ref {
+      if !concurrentTable then return metaDom0;
+      else if gen == 0 then return metaDom0;
+      else return metaDom1;
+    }
+
+    inline proc _metaFor(gen: int) ref {
+      if !concurrentTable then return meta0;
+      else if gen == 0 then return meta0;
+      else return meta1;
+    }
+
+    inline proc tableDom ref return _tableDomFor(curGen);
+    inline proc table ref return _tableFor(curGen);
+    inline proc metaDom ref return _metaDomFor(curGen);
+    inline proc meta ref return _metaFor(curGen);
   
+    // Locks the whole table.  For concurrent tables this acquires every
+    // stripe lock, in order, and so blocks all other operations.
     inline proc lockTable() {
-      if parSafe then tableLock.lock();
+      if concurrentTable {
+        for stripe in stripeDom do
+          stripeLocks[stripe].lock.lock();
+      } else if parSafe {
+        tableLock.lock();
+      }
     }
   
     inline proc unlockTable() {
-      if parSafe then tableLock.unlock();
+      if concurrentTable {
+        for stripe in stripeDom do
+          stripeLocks[stripe].lock.unlock();
+      } else if parSafe {
+        tableLock.unlock();
+      }
+    }
+
+    inline proc _stripeFor(hash: uint): int {
+      return ((hash >> 7) & (defaultAssocLockStripes - 1):uint):int;
+    }
+
+    // Lock only what is needed to operate on an index with this hash
+    inline proc _lockFor(hash: uint) {
+      if concurrentTable then
+        stripeLocks[_stripeFor(hash)].lock.lock();
+      else
+        lockTable();
+    }
+
+    inline proc _unlockFor(hash: uint) {
+      if concurrentTable then
+        stripeLocks[_stripeFor(hash)].lock.unlock();
+      else
+        unlockTable();
     }
   
     // TODO: An ugly [0..-1] domain appears several times in the code --
@@ -96,7 +324,7 @@ module DefaultAssociative {
       this.idxType = idxType;
       this.parSafe = parSafe;
       this.dist = dist;
-      this.tableSize = chpl__primes(tableSizeNum);
+      this.tableSize = chpl__assocTableSize(tableSizeNum);
     }
   
     //
@@ -205,7 +433,10 @@ module DefaultAssociative {
         yield i;
       on this {
         postponeResize = false;
-        if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
+        if concurrentTable {
+          if (numEntries.read()*8 < tableSize && tableSizeNum > 1) then
+            _concurrentShrink();
+        } else if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
           lockTable();
           if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
             _resize(grow=false);
@@ -236,7 +467,7 @@ module DefaultAssociative {
 
       if numChunks == 1 {
         for slot in 0..numIndices-1 {
-          if table[slot].status == chpl__hash_status.full {
+          if _isFullSlot(slot) {
             yield table[slot].idx;
           }
         }
@@ -247,7 +478,7 @@ module DefaultAssociative {
           if debugAssocDataPar then
             writeln("*** chunk: ", chunk, " owns ", lo..hi);
           for slot in lo..hi {
-            if table[slot].status == chpl__hash_status.full {
+            if _isFullSlot(slot) {
               yield table[slot].idx;
             }
           }
@@ -311,13 +542,12 @@ module DefaultAssociative {
         if followThisDom.dsiNumIndices != this.dsiNumIndices then
           halt("zippered associative domains do not match");
 
-      var otherTable = followThisDom.table;
       for slot in chunk.low..chunk.high {
-        var entry = otherTable[slot];
-        if entry.status == chpl__hash_status.full {
+        if followThisDom._isFullSlot(slot) {
           var idx = slot;
           if !sameDom {
-            const (match, loc) = _findFilledSlot(entry.idx, needLock=false);
+            const (match, loc) = _findFilledSlot(followThisDom.table[slot].idx,
+                                                 needLock=false);
             if !match then halt("zippered associative domains do not match");
             idx = loc;
           }
@@ -335,12 +565,25 @@ module DefaultAssociative {
 
     override proc dsiClear() {
       on this {
+        if concurrentTable then resizeLock.lock();
         lockTable();
-        for slot in tableDom {
-          table[slot].status = chpl__hash_status.empty;
+        if concurrentTable {
+          for group in metaDom {
+            meta[group].write(0);
+          }
+          numUsedSlots.write(0);
+        } else if defaultAssocSwissTable {
+          for group in metaDom {
+            meta[group] = 0;
+          }
+        } else {
+          for slot in tableDom {
+            table[slot].status = chpl__hash_status.empty;
+          }
         }
         numEntries.write(0);
         unlockTable();
+        if concurrentTable then resizeLock.unlock();
       }
     }
   
@@ -372,21 +615,192 @@ module DefaultAssociative {
       const inSlot = slotNum;
       var retVal = 0;
       on this {
-        if parSafe && needLock then lockTable();
-        var findAgain = parSafe && needLock;
-        if ((numEntries.read()+1)*2 > tableSize) {
-          _resize(grow=true);
-          findAgain = true;
+        if concurrentTable {
+          (slotNum, retVal) = _concurrentAdd(idx, needLock);
+        } else {
+          if parSafe && needLock then lockTable();
+          var findAgain = parSafe && needLock;
+          if ((numEntries.read()+1)*2 > tableSize) {
+            _resize(grow=true);
+            findAgain = true;
+          }
+          if findAgain then
+            (slotNum, retVal) = _add(idx, -1);
+          else
+            (_, retVal) = _add(idx, inSlot);
+          if parSafe && needLock then unlockTable();
         }
-        if findAgain then
-          (slotNum, retVal) = _add(idx, -1);
-        else
-          (_, retVal) = _add(idx, inSlot);
-        if parSafe && needLock then unlockTable();
       }
       return (slotNum, retVal);
     }
 
+    // Adds 'idx' to a concurrent table, locking only its stripe.  The
+    // new slot is claimed as busy so that tasks probing other stripes
+    // do not compare against it until its index has been stored.
+    //
+    // Returns a tuple like _add()
+    pragma "unsafe" // see issue #11666
+    proc _concurrentAdd(idx: idxType, needLock: bool) {
+      const hash = chpl__defaultHashWrapper(idx):uint;
+      while true {
+        if needLock then _lockFor(hash);
+
+        _migrateIndex(idx, hash);
+        const (found, foundSlot) = _swissFindFilledSlot(idx, needLock=false);
+        if found {
+          if needLock then _unlockFor(hash);
+          return (foundSlot, 0);
+        }
+
+        if (numUsedSlots.read()+1)*2 > tableSize && !postponeResize {
+          // Grow with the stripe released, since growing moves entries
+          // of every stripe
+          if needLock then _unlockFor(hash);
+          _concurrentGrow();
+          continue;
+        }
+
+        const slotNum = _swissClaimSlot(hash);
+        if slotNum < 0 {
+          // other tasks filled the table before it could grow
+          if postponeResize then
+            halt("couldn't add ", idx, " -- ", numEntries.read(), " / ", tableSize, " taken");
+          if needLock then _unlockFor(hash);
+          _concurrentGrow();
+          continue;
+        }
+        table[slotNum].idx = idx;
+        _setMetaByte(slotNum, chpl__swissFingerprint(hash));
+        numEntries.add(1);
+
+        // default initialize newly added array elements
+        for a in _arrs do
+          a.clearEntry(idx);
+
+        if needLock then _unlockFor(hash);
+        return (slotNum, 1);
+      }
+      return (-1, 0); // never reached
+    }
+
+    // Grows a concurrent table, or rebuilds it at the same size if most
+    // of its used slots are deleted ones.
+    proc _concurrentGrow() {
+      resizeLock.lock();
+      if (numUsedSlots.read()+1)*2 > tableSize && !postponeResize {
+        if numEntries.read()*4 < tableSize {
+          _concurrentRehash(tableSizeNum);
+        } else {
+          if tableSizeNum+1 > chpl__assocMaxTableSizeNum then
+            halt("associative array exceeds maximum size");
+          _concurrentRehash(tableSizeNum+1);
+        }
+      }
+      resizeLock.unlock();
+    }
+
+    proc _concurrentShrink() {
+      resizeLock.lock();
+      if numEntries.read()*8 < tableSize && tableSizeNum > 1 &&
+         !postponeResize then
+        _concurrentRehash(tableSizeNum-1);
+      resizeLock.unlock();
+    }
+
+    // Moves a concurrent table to size class 'newSizeNum' without
+    // stopping other operations for the length of the rebuild.
+    //
+    // The new table is allocated in the other generation while the
+    // current one stays in use.  Every stripe lock is then held just
+    // long enough to make the new table current.  From there on adds go
+    // to the new table, and the entries left in the old one are moved
+    // over one at a time, each under the lock of its own stripe.  Any
+    // operation on an index that hasn't been moved yet moves it first
+    // (see _migrateIndex()), so the two tables never both hold an index.
+    //
+    // Only one resize runs at a time.  Adds that need another one while
+    // this runs wait for it to finish.
+    //
+    // NOTE: Calls to this routine assume that resizeLock has been acquired.
+    //
+    proc _concurrentRehash(newSizeNum: int) {
+      const oldGen = curGen, newGen = 1 - curGen;
+      const newSize = chpl__assocTableSize(newSizeNum);
+      _tableDomFor(newGen) = {0..newSize-1};
+      _metaDomFor(newGen) = {0..#chpl__assocNumMetaGroups(newSize)};
+
+      lockTable();
+      curGen = newGen;
+      tableSizeNum = newSizeNum;
+      tableSize = newSize;
+      numUsedSlots.write(0);
+      migrating.write(true);
+      unlockTable();
+
+      // No index is added to the old table any more, so each full slot
+      // still holds what it did when the scan reads it.
+      forall group in _metaDomFor(oldGen) {
+        var full = chpl__swissMatchFull(_metaWord(group, oldGen));
+        while full != 0 {
+          const slot = group*chpl__swissGroupSize + chpl__swissFirstInMask(full);
+          const hash = chpl__defaultHashWrapper(_tableFor(oldGen)[slot].idx):uint;
+          _lockFor(hash);
+          _migrateSlot(slot, hash);
+          _unlockFor(hash);
+          full &= full - 1;
+        }
+      }
+
+      // Wait for operations that may still be looking at the old table
+      // before freeing it.
+      lockTable();
+      migrating.write(false);
+      unlockTable();
+      _tableDomFor(oldGen) = {0..(-1:chpl_table_index_type)};
+      _metaDomFor(oldGen) = {0..(-1:chpl_table_index_type)};
+    }
+
+    // If a resize is moving entries to a new table and 'idx' is still
+    // in the old one, moves it over now.
+    //
+    // NOTE: Calls to this routine assume that the stripe lock for 'hash'
+    // has been acquired.
+    //
+    proc _migrateIndex(idx: idxType, hash: uint) {
+      if concurrentTable {
+        if migrating.read() {
+          const (found, slot) = _swissFindFilledSlot(idx, needLock=false,
+                                                     gen=1-curGen);
+          if found then
+            _migrateSlot(slot, hash);
+        }
+      }
+    }
+
+    // Moves the index in 'slot' of the old table, whose hash is 'hash',
+    // along with its array elements, to the current table.  Does nothing
+    // if it has already been moved or removed.
+    //
+    // NOTE: Calls to this routine assume that the stripe lock for 'hash'
+    // has been acquired.
+    //
+    pragma "unsafe" // see issue #11666
+    proc _migrateSlot(slot: int, hash: uint) {
+      const oldGen = 1 - curGen;
+      if (_metaByte(slot, oldGen) & 0x80) == 0 then return;
+      const newSlot = _swissClaimSlot(hash);
+      if newSlot < 0 then
+        halt("couldn't move an index while resizing -- ",
+             numEntries.read(), " / ", tableSize, " taken");
+      // Lookups that don't lock match the new slot as soon as its
+      // fingerprint is set, so the elements have to be there first.
+      table[newSlot].idx = _tableFor(oldGen)[slot].idx;
+      for a in _arrs do
+        a._migrateArrayElement(slot, newSlot);
+      _setMetaByte(newSlot, chpl__swissFingerprint(hash));
+      _setMetaByte(slot, chpl__swissDeleted, oldGen);
+    }
+
     // This routine adds new indices without checking the table size and
     //  is thus appropriate for use by routines like _resize().
     //
@@ -399,7 +813,7 @@ module DefaultAssociative {
       if !foundSlot then
         (foundSlot, slotNum) = _findEmptySlot(idx);
       if foundSlot {
-        table[slotNum].status = chpl__hash_status.full;
+        _markFull(slotNum, idx);
         table[slotNum].idx = idx;
         numEntries.add(1);
 
@@ -420,42 +834,66 @@ module DefaultAssociative {
     proc dsiRemove(idx: idxType) {
       var retval = 1;
       on this {
-        lockTable();
-        const (foundSlot, slotNum) = _findFilledSlot(idx, needLock=!parSafe);
-        if (foundSlot) {
-          for a in _arrs do
-            a.clearEntry(idx);
-          table[slotNum].status = chpl__hash_status.deleted;
-          numEntries.sub(1);
+        if concurrentTable {
+          retval = _concurrentRemove(idx);
         } else {
-          retval = 0;
-        }
-        if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
-          _resize(grow=false);
+          lockTable();
+          const (foundSlot, slotNum) = _findFilledSlot(idx, needLock=!parSafe);
+          if (foundSlot) {
+            for a in _arrs do
+              a.clearEntry(idx);
+            _markRemoved(slotNum);
+            numEntries.sub(1);
+          } else {
+            retval = 0;
+          }
+          if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
+            _resize(grow=false);
+          }
+          unlockTable();
         }
-        unlockTable();
       }
       return retval;
     }
+
+    // Removes 'idx' from a concurrent table, locking only its stripe.
+    proc _concurrentRemove(idx: idxType) {
+      var retval = 1;
+      const hash = chpl__defaultHashWrapper(idx):uint;
+      _lockFor(hash);
+      _migrateIndex(idx, hash);
+      const (foundSlot, slotNum) = _swissFindFilledSlot(idx, needLock=false);
+      if (foundSlot) {
+        for a in _arrs do
+          a.clearEntry(idx);
+        _markRemoved(slotNum);
+        numEntries.sub(1);
+      } else {
+        retval = 0;
+      }
+      _unlockFor(hash);
+
+      if (numEntries.read()*8 < tableSize && tableSizeNum > 1) then
+        _concurrentShrink();
+      return retval;
+    }
   
-    proc findPrimeSizeIndex(numKeys:int) {
-      //Find the first suitable prime
+    proc findTableSizeIndex(numKeys:int) {
+      //Find the first suitable table size
       var threshold = (numKeys + 1) * 2;
-      var prime = 0;
-      var primeLoc = 0;
-      for i in 1..chpl__primes.size {
-          if chpl__primes(i) > threshold {
-            prime = chpl__primes(i);
-            primeLoc = i;
+      var sizeLoc = 0;
+      for i in 1..chpl__assocMaxTableSizeNum {
+          if chpl__assocTableSize(i) > threshold {
+            sizeLoc = i;
             break;
           }
       }
 
-      //No suitable prime found
-      if prime == 0 {
+      //No suitable size found
+      if sizeLoc == 0 {
         halt("Requested capacity (", numKeys, ") exceeds maximum size");
       }
-      return primeLoc;
+      return sizeLoc;
     }
 
     proc dsiRequestCapacity(numKeys:int) {
@@ -463,10 +901,10 @@ module DefaultAssociative {
 
       if entries < numKeys {
 
-        var primeLoc = findPrimeSizeIndex(numKeys);
-        var prime = chpl__primes(primeLoc);
+        var sizeLoc = findTableSizeIndex(numKeys);
 
         //Changing underlying structure, time for locking
+        if concurrentTable then resizeLock.lock();
         lockTable();
         if entries > 0 {
           // Slow path: back up required
@@ -474,20 +912,21 @@ module DefaultAssociative {
 
           // copy the table (TODO: could use swap between two versions)
           var copyDom = tableDom;
-          var copyTable: [copyDom] chpl_TableEntry(idxType) = table;
+          var copyTable: [copyDom] table.eltType = table;
+          var copyMetaDom = metaDom;
+          var copyMeta: [copyMetaDom] uint = [group in copyMetaDom] _metaWord(group);
 
           // Do not preserve entries
           tableDom = {0..-1};
+          metaDom = {0..-1};
 
-          tableSizeNum = primeLoc;
-          tableSize = prime;
-          tableDom = {0..tableSize-1};
+          _setTableSize(sizeLoc);
 
           //numEntries will be reconstructed as keys are readded
           numEntries.write(0);
 
           // insert old data into newly resized table
-          for slot in _fullSlots(copyTable) {
+          for slot in _fullSlots(copyTable, copyMeta) {
             const (newslot, _) = _add(copyTable[slot].idx);
             _preserveArrayElements(oldslot=slot, newslot=newslot);
           }
@@ -495,12 +934,13 @@ module DefaultAssociative {
           _removeArrayBackups();
         } else {
           //Fast path, nothing to backup
-          tableSizeNum=primeLoc;
-          tableSize=prime;
-          tableDom = {0..tableSize-1};
+          metaDom = {0..-1};
+          _setTableSize(sizeLoc);
         }
+        numUsedSlots.write(numEntries.read());
 
         unlockTable();
+        if concurrentTable then resizeLock.unlock();
       } else if entries > numKeys {
         warning("Requested capacity (", numKeys, ") ",
                 "is less than current size (", entries, ")");
@@ -527,72 +967,259 @@ module DefaultAssociative {
     //
     proc _resize(grow:bool) {
       if postponeResize then return;
+      const newSizeNum = tableSizeNum + (if grow then 1 else -1);
+      if newSizeNum > chpl__assocMaxTableSizeNum then halt("associative array exceeds maximum size");
+      _rehash(newSizeNum);
+    }
+
+    // Rebuilds the table at size class 'newSizeNum'.
+    //
+    // NOTE: Calls to this routine assume that the tableLock has been acquired.
+    //
+    proc _rehash(newSizeNum: int) {
       // back up the arrays
       _backupArrays();
   
       // copy the table (TODO: could use swap between two versions)
       var copyDom = tableDom;
-      var copyTable: [copyDom] chpl_TableEntry(idxType) = table;
+      var copyTable: [copyDom] table.eltType = table;
+      var copyMetaDom = metaDom;
+      var copyMeta: [copyMetaDom] uint = [group in copyMetaDom] _metaWord(group);
   
       // grow original table
       tableDom = {0..(-1:chpl_table_index_type)}; // non-preserving resize
+      metaDom = {0..(-1:chpl_table_index_type)};
       numEntries.write(0); // reset, because the adds below will re-set this
-      tableSizeNum += if grow then 1 else -1;
-      if tableSizeNum > chpl__primes.size then halt("associative array exceeds maximum size");
-      tableSize = chpl__primes(tableSizeNum);
-      tableDom = {0..tableSize-1};
+      _setTableSize(newSizeNum);
   
       // insert old data into newly resized table
-      for slot in _fullSlots(copyTable) {
+      for slot in _fullSlots(copyTable, copyMeta) {
         const (newslot, _) = _add(copyTable[slot].idx);
         _preserveArrayElements(oldslot=slot, newslot=newslot);
       }
+      numUsedSlots.write(numEntries.read());
       
       _removeArrayBackups();
     }
 
+    // Sets the size class of the table.  Callers should first empty
+    // tableDom and metaDom so that no entries are preserved.
+    proc _setTableSize(sizeNum: int) {
+      tableSizeNum = sizeNum;
+      tableSize = chpl__assocTableSize(sizeNum);
+      tableDom = {0..tableSize-1};
+      metaDom = {0..#chpl__assocNumMetaGroups(tableSize)};
+    }
+
+    inline proc _metaWord(group: int, gen = curGen): uint {
+      return chpl__swissLoad(_metaFor(gen)[group]);
+    }
+
+    inline proc _metaByte(slot: int, gen = curGen): uint {
+      const shift = ((slot % chpl__swissGroupSize) * 8):uint;
+      return (_metaWord(slot / chpl__swissGroupSize, gen) >> shift) & 0xff;
+    }
+
+    inline proc _setMetaByte(slot: int, val: uint, gen = curGen) {
+      const shift = ((slot % chpl__swissGroupSize) * 8):uint;
+      const mask = ~(0xff:uint << shift);
+      ref group = _metaFor(gen)[slot / chpl__swissGroupSize];
+      if concurrentTable {
+        // other slots in the group may be changing at the same time
+        var old = group.read();
+        while !group.compareAndSwap(old, (old & mask) | (val << shift)) do
+          old = group.read();
+      } else {
+        group = (group & mask) | (val << shift);
+      }
+    }
+
+    // Claims the first empty slot in the probe sequence for 'hash' by
+    // marking it busy.  Returns -1 if there is none.
+    proc _swissClaimSlot(hash: uint): int {
+      for group in _swissProbeGroups(hash) {
+        var groupMeta = _metaWord(group);
+        var empty = chpl__swissMatchEmpty(groupMeta);
+        while empty != 0 {
+          const pos = chpl__swissFirstInMask(empty);
+          const busy = groupMeta | (chpl__swissBusy << (pos * 8):uint);
+          if meta[group].compareAndSwap(groupMeta, busy) {
+            numUsedSlots.add(1);
+            return group * chpl__swissGroupSize + pos;
+          }
+          // another task changed the group; look again
+          groupMeta = _metaWord(group);
+          empty = chpl__swissMatchEmpty(groupMeta);
+        }
+      }
+      return -1;
+    }
+
+    inline proc _isFullSlot(slot: int): bool {
+      if defaultAssocSwissTable then
+        return (_metaByte(slot) & 0x80) != 0;
+      else
+        return table[slot].status == chpl__hash_status.full;
+    }
+
+    inline proc _markFull(slot: int, idx: idxType) {
+      if defaultAssocSwissTable then
+        _setMetaByte(slot,
+                     chpl__swissFingerprint(chpl__defaultHashWrapper(idx):uint));
+      else
+        table[slot].status = chpl__hash_status.full;
+    }
+
+    inline proc _markRemoved(slot: int) {
+      if concurrentTable {
+        // A concurrent lookup may still be comparing against this slot,
+        // so it must not be reused until the table is rebuilt.
+        _setMetaByte(slot, chpl__swissDeleted);
+      } else if defaultAssocSwissTable {
+        // Probing only continues past groups without an empty slot.  If
+        // this group still has one, no probe sequence has ever passed
+        // through it, so the slot can be emptied instead of deleted.
+        if chpl__swissHasEmpty(meta[slot / chpl__swissGroupSize]) then
+          _setMetaByte(slot, 0);
+        else
+          _setMetaByte(slot, chpl__swissDeleted);
+      } else {
+        table[slot].status = chpl__hash_status.deleted;
+      }
+    }
+
     // Searches for 'idx' in a filled slot.
     //
     // Returns true if found, along with the first open slot that may be
     // re-used for faster addition to the domain
     proc _findFilledSlot(idx: idxType, needLock = true) : (bool, index(tableDom)) {
-      if parSafe && needLock then lockTable();
-      var firstOpen = -1;
-      for slotNum in _lookForSlots(idx, table.domain.high+1) {
-        const slotStatus = table[slotNum].status;
-        // if we encounter a slot that's empty, our element could not
-        // be found past this point.
-        if (slotStatus == chpl__hash_status.empty) {
-          if firstOpen == -1 then firstOpen = slotNum;
-          if parSafe && needLock then unlockTable();
-          return (false, firstOpen);
-        } else if (slotStatus == chpl__hash_status.full) {
-          if (table[slotNum].idx == idx) {
+      if defaultAssocSwissTable {
+        return _swissFindFilledSlot(idx, needLock);
+      } else {
+        if parSafe && needLock then lockTable();
+        var firstOpen = -1;
+        for slotNum in _lookForSlots(idx, table.domain.high+1) {
+          const slotStatus = table[slotNum].status;
+          // if we encounter a slot that's empty, our element could not
+          // be found past this point.
+          if (slotStatus == chpl__hash_status.empty) {
+            if firstOpen == -1 then firstOpen = slotNum;
             if parSafe && needLock then unlockTable();
-            return (true, slotNum);
+            return (false, firstOpen);
+          } else if (slotStatus == chpl__hash_status.full) {
+            if (table[slotNum].idx == idx) {
+              if parSafe && needLock then unlockTable();
+              return (true, slotNum);
+            }
+          } else { // this entry was removed, but is the first slot we could use
+            if firstOpen == -1 then firstOpen = slotNum;
           }
-        } else { // this entry was removed, but is the first slot we could use
-          if firstOpen == -1 then firstOpen = slotNum;
         }
+        if parSafe && needLock then unlockTable();
+        return (false, -1);
+      }
+    }
+
+    // Finds the slot holding the array elements for 'idx', without
+    // locking when possible.  Also returns the generation of the table
+    // the slot is in, since a concurrent resize can switch generations
+    // at any time.  The old generation stays allocated until the resize
+    // has moved everything out of it, but elements written there after
+    // being moved are lost: as before, writing array elements while
+    // their domain is being resized is a race.
+    proc _findElementSlot(idx: idxType): (bool, index(tableDom), int) {
+      if concurrentTable {
+        const gen = curGen;
+        const (found, slotNum) = _swissFindFilledSlot(idx, needLock=false,
+                                                      gen);
+        if found || (!migrating.read() && gen == curGen) then
+          return (found, slotNum, gen);
+
+        // it may not have been moved to the new table yet
+        const hash = chpl__defaultHashWrapper(idx):uint;
+        _lockFor(hash);
+        _migrateIndex(idx, hash);
+        const lockedGen = curGen;
+        const (lockedFound, lockedSlot) = _swissFindFilledSlot(idx,
+                                                               needLock=false);
+        _unlockFor(hash);
+        return (lockedFound, lockedSlot, lockedGen);
+      } else {
+        const (found, slotNum) = _findFilledSlot(idx, needLock=false);
+        return (found, slotNum, 0);
+      }
+    }
+
+    // The Swiss table version of _findFilledSlot.  Keys are only
+    // compared in slots whose fingerprint matches the hash of 'idx'.
+    //
+    // 'gen' selects the generation of a concurrent table to search.
+    proc _swissFindFilledSlot(idx: idxType, needLock: bool,
+                              gen = curGen) : (bool, index(tableDom)) {
+      const hash = chpl__defaultHashWrapper(idx):uint;
+      if parSafe && needLock {
+        // A resize may switch generations until the lock is held, so
+        // search whichever is current then rather than 'gen'.
+        _lockFor(hash);
+        _migrateIndex(idx, hash);
+        const ret = _swissFindSlot(idx, hash, curGen);
+        _unlockFor(hash);
+        return ret;
+      }
+      return _swissFindSlot(idx, hash, gen);
+    }
+
+    proc _swissFindSlot(idx: idxType, hash: uint,
+                        gen: int) : (bool, index(tableDom)) {
+      ref tab = _tableFor(gen);
+      ref metaTab = _metaFor(gen);
+      const fingerprint = chpl__swissFingerprint(hash);
+      var firstOpen = -1;
+      for group in _swissProbeGroups(hash, gen) {
+        const groupMeta = chpl__swissLoad(metaTab[group]);
+        const groupStart = group * chpl__swissGroupSize;
+        var matches = chpl__swissMatch(groupMeta, fingerprint);
+        while matches != 0 {
+          const slotNum = groupStart + chpl__swissFirstInMask(matches);
+          if tab[slotNum].idx == idx then
+            return (true, slotNum);
+          matches &= matches - 1;
+        }
+        if firstOpen == -1 {
+          const available = chpl__swissMatchAvailable(groupMeta);
+          if available != 0 then
+            firstOpen = groupStart + chpl__swissFirstInMask(available);
+        }
+        // if this group has an empty slot, our element could not be
+        // found past this point.
+        if chpl__swissHasEmpty(groupMeta) then
+          break;
       }
-      if parSafe && needLock then unlockTable();
-      return (false, -1);
+      return (false, firstOpen);
     }
 
     //
     // NOTE: Calls to this routine assume that the tableLock has been acquired.
     //
     proc _findEmptySlot(idx: idxType): (bool, index(tableDom)) {
-      for slotNum in _lookForSlots(idx) {
-        const slotStatus = table[slotNum].status;
-        if (slotStatus == chpl__hash_status.empty ||
-            slotStatus == chpl__hash_status.deleted) {
-          return (true, slotNum);
-        } else if (table[slotNum].idx == idx) {
+      if defaultAssocSwissTable {
+        const (found, slotNum) = _swissFindFilledSlot(idx, needLock=false);
+        if found then
           return (false, slotNum);
+        else
+          return (slotNum != -1, slotNum);
+      } else {
+        for slotNum in _lookForSlots(idx) {
+          const slotStatus = table[slotNum].status;
+          if (slotStatus == chpl__hash_status.empty ||
+              slotStatus == chpl__hash_status.deleted) {
+            return (true, slotNum);
+          } else if (table[slotNum].idx == idx) {
+            return (false, slotNum);
+          }
         }
+        return (false, -1);
       }
-      return (false, -1);
     }
       
     //
@@ -611,10 +1238,33 @@ module DefaultAssociative {
       }
     }
   
-    iter _fullSlots(tab = table) {
-      for slot in tab.domain {
-        if tab[slot].status == chpl__hash_status.full then
-          yield slot;
+    // Yields the groups to probe for 'hash'.  Triangular probing
+    // visits every group once since the number of groups is a power
+    // of two.
+    iter _swissProbeGroups(hash: uint, gen = curGen) {
+      const numGroups = _metaDomFor(gen).size;
+      const mask = (numGroups - 1):uint;
+      var group = (hash >> 7) & mask;
+      for probe in 0..#numGroups {
+        yield group:int;
+        group = (group + probe:uint + 1) & mask;
+      }
+    }
+
+    iter _fullSlots(tab = table, metaTab: [] = meta) {
+      if defaultAssocSwissTable {
+        for group in metaTab.domain {
+          var full = chpl__swissMatchFull(chpl__swissLoad(metaTab[group]));
+          while full != 0 {
+            yield group*chpl__swissGroupSize + chpl__swissFirstInMask(full);
+            full &= full - 1;
+          }
+        }
+      } else {
+        for slot in tab.domain {
+          if tab[slot].status == chpl__hash_status.full then
+            yield slot;
+        }
       }
     }
 
@@ -636,7 +1286,18 @@ module DefaultAssociative {
     param parSafeDom: bool;
     var dom : unmanaged DefaultAssociativeDom(idxType, parSafe=parSafeDom);
   
-    var data : [dom.tableDom] eltType;
+    // One generation of elements for each generation of the domain's
+    // table.  Use the 'data' accessor for the current one.
+    var data0 : [dom.tableDom0] eltType;
+    var data1 : [dom.tableDom1] eltType;
+
+    inline proc _dataFor(gen: int) ref {
+      if !dom.concurrentTable then return data0;
+      else if gen == 0 then return data0;
+      else return data1;
+    }
+
+    inline proc data ref return _dataFor(dom.curGen);
   
     var tmpDom = {0..(-1:chpl_table_index_type)};
     var tmpTable: [tmpDom] eltType;
@@ -655,11 +1316,11 @@ module DefaultAssociative {
     // ref version
     proc dsiAccess(idx : idxType) ref {
       // Attempt to look up the value
-      var (found, slotNum) = dom._findFilledSlot(idx, needLock=false);
+      var (found, slotNum, gen) = dom._findElementSlot(idx);
 
       // if an element exists for that index, return (a ref to) it
       if found {
-        return data[slotNum];
+        return _dataFor(gen)[slotNum];
 
       // if the element didn't exist, then it is an error
       } else {
@@ -670,9 +1331,9 @@ module DefaultAssociative {
     // value version for POD types
     proc dsiAccess(idx : idxType)
     where shouldReturnRvalueByValue(eltType) {
-      var (found, slotNum) = dom._findFilledSlot(idx, needLock=false);
+      var (found, slotNum, gen) = dom._findElementSlot(idx);
       if found {
-        return data(slotNum);
+        return _dataFor(gen)(slotNum);
       } else {
         halt("array index out of bounds: ", idx);
         return data(0);
@@ -681,9 +1342,9 @@ module DefaultAssociative {
     // const ref version for strings, records with copy ctor
     proc dsiAccess(idx : idxType) const ref
     where shouldReturnRvalueByConstRef(eltType) {
-      var (found, slotNum) = dom._findFilledSlot(idx, needLock=false);
+      var (found, slotNum, gen) = dom._findElementSlot(idx);
       if found {
-        return data(slotNum);
+        return _dataFor(gen)(slotNum);
       } else {
         halt("array index out of bounds: ", idx);
         return data(0);
@@ -716,7 +1377,7 @@ module DefaultAssociative {
       const numChunks = _computeNumChunks(numIndices);
       if numChunks == 1 {
         for slot in 0..#numIndices {
-          if dom.table[slot].status == chpl__hash_status.full {
+          if dom._isFullSlot(slot) {
             yield data[slot];
           }
         }
@@ -727,9 +1388,8 @@ module DefaultAssociative {
           if debugAssocDataPar {
             writeln("In associative array standalone iterator: chunk = ", chunk);
           }
-          var table = dom.table;
           for slot in lo..hi {
-            if dom.table[slot].status == chpl__hash_status.full {
+            if dom._isFullSlot(slot) {
               yield data[slot];
             }
           }
@@ -754,13 +1414,12 @@ module DefaultAssociative {
         if followThisDom.dsiNumIndices != this.dom.dsiNumIndices then
           halt("zippered associative array does not match the iterated domain");
 
-      var otherTable = followThisDom.table;
       for slot in chunk.low..chunk.high {
-        var entry = otherTable[slot];
-        if entry.status == chpl__hash_status.full {
+        if followThisDom._isFullSlot(slot) {
           var idx = slot;
           if !sameDom {
-            const (match, loc) = dom._findFilledSlot(entry.idx, needLock=false);
+            const (match, loc) = dom._findFilledSlot(followThisDom.table[slot].idx,
+                                                     needLock=false);
             if !match then halt("zippered associative array does not match the iterated domain");
             idx = loc;
           }
@@ -882,6 +1541,10 @@ module DefaultAssociative {
       data(newslot) = tmpTable[oldslot];
     }
 
+    override proc _migrateArrayElement(oldslot, newslot) {
+      data(newslot) = _dataFor(1 - dom.curGen)[oldslot];
+    }
+
     proc dsiTargetLocales() {
       return [this.locale, ];
     }
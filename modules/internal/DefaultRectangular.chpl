@@ -1049,7 +1049,7 @@ module DefaultRectangular {
     override proc dsiDestroyArr() {
       if (externArr) {
         if (!_borrowed) {
-          chpl_call_free_func(externFreeFunc, c_ptrTo(data));
+          chpl_call_free_func(externFreeFunc, data: c_void_ptr);
         }
       } else {
         var numElts:intIdxType = 0;
@@ -1573,6 +1573,46 @@ module DefaultRectangular {
       }
     }
 
+    // Can elements of this type be copied to and from binary channels
+    // as they are in memory?  Bools of any width are read and written as
+    // one byte, so only bool and bool(8) can.
+    proc ioBulkType(type t) param {
+      if t == bool then return true;
+      else if isBoolType(t) then return numBytes(t) == 1;
+      else return _isSimpleIoType(t);
+    }
+
+    // The size of the byte-swapping unit for an element type in the bulk
+    // binary path, 1 for single-byte types, or 0 if the type has to go
+    // element by element in a non-native byte order.
+    proc ioSwapSize(type t) param {
+      if isComplexType(t) then return numBytes(t) / 2;
+      else if isIntegralType(t) || isRealType(t) || isImagType(t) then
+        return numBytes(t);
+      else if isBoolType(t) then return 1;
+      else return 0;
+    }
+
+    // Do all dimensions of dom step through arr's storage in order?
+    proc ioAllStridesMatch() {
+      for param d in 1..rank do
+        if dom.dsiDim(d).stride != arr.dom.dsiDim(d).stride ||
+           dom.dsiDim(d).stride < 0 then
+          return false;
+      return true;
+    }
+
+    // Is each row of the last dimension of dom a contiguous run of memory,
+    // visited in index order?
+    proc ioRowsContiguous() {
+      if rank == 1 then
+        return ioAllStridesMatch() && arr.isDataContiguous(dom);
+      for param d in 1..rank do
+        if dom.dsiDim(d).stride < 0 then return false;
+      return arr.blk(rank) == 1 &&
+             dom.dsiDim(rank).stride == arr.dom.dsiDim(rank).stride;
+    }
+
     proc recursiveArrayWriter(in idx: rank*idxType, dim=1, in last=false) throws {
       var binary = f.binary();
       var arrayStyle = f.styleElement(QIO_STYLE_ELEMENT_ARRAY);
@@ -1726,28 +1766,48 @@ module DefaultRectangular {
       }
 
     } else if arr.isDefaultRectangular() && !chpl__isArrayView(arr) &&
-              _isSimpleIoType(arr.eltType) && f.binary() &&
-              isNative && arr.isDataContiguous(dom) {
-      // If we can, we would like to read/write the array as a single write op
-      // since _ddata is just a pointer to the memory location we just pass
-      // that along with the size of the array. This is only possible when the
-      // byte order is set to native or its equivalent.
+              f.binary() && ioBulkType(arr.eltType) &&
+              (isNative || ioSwapSize(arr.eltType) != 0) &&
+              ioRowsContiguous() {
+      // If we can, we would like to read/write the array in a few large
+      // operations rather than element by element.  Since _ddata is just a
+      // pointer to the memory location we pass along runs of it: the whole
+      // array when the data is contiguous, otherwise one run per row of the
+      // last dimension.  A non-native byte order is handled by swapping
+      // each element in bounded chunks as it is copied.
       const elemSize = c_sizeof(arr.eltType);
       if boundsChecking {
         var rw = if f.writing then "write" else "read";
-        assert((dom.dsiNumIndices:uint*elemSize:uint) <= max(ssize_t):uint,
-               "length of array to ", rw, " is greater than ssize_t can hold");
+        assert((dom.dsiNumIndices:uint*elemSize:uint) <= max(int(64)):uint,
+               "length of array to ", rw, " is greater than int(64) can hold");
       }
 
-      const len = dom.dsiNumIndices;
+      const swapSize = if isNative then 0 else ioSwapSize(arr.eltType);
       const src = arr.theData;
-      const idx = arr.getDataIndex(dom.dsiLow);
-      const size = len:ssize_t*elemSize:ssize_t;
+
+      proc readWriteRun(idx, len) throws {
+        const size = len:int(64)*elemSize:int(64);
+        f._readWriteElts(_ddata_shift(arr.eltType, src, idx):c_void_ptr,
+                         size, swapSize);
+      }
+
       try {
-        if f.writing {
-          f.writeBytes(_ddata_shift(arr.eltType, src, idx), size);
+        if ioAllStridesMatch() && arr.isDataContiguous(dom) {
+          readWriteRun(arr.getDataIndex(dom.dsiLow), dom.dsiNumIndices);
+        } else if rank > 1 {
+          const lastDim = dom.dsiDim(rank);
+          var leadDims: (rank-1)*dom.dsiDim(1).type;
+          for param d in 1..rank-1 do leadDims(d) = dom.dsiDim(d);
+          for lead in {(...leadDims)} {
+            var ind: rank*idxType;
+            if rank == 2 then ind(1) = lead;
+            else for param d in 1..rank-1 do ind(d) = lead(d);
+            ind(rank) = lastDim.first;
+            readWriteRun(arr.getDataIndex(ind), lastDim.size);
+          }
         } else {
-          f.readBytes(_ddata_shift(arr.eltType, src, idx), size);
+          // only a contiguous 1D region passes ioRowsContiguous()
+          halt("unexpected non-contiguous 1D array region in binary I/O");
         }
       } catch e: SystemError {
         f.setError(e.err);
@@ -59,8 +59,11 @@ module ExternalArray {
     return makeArrayFromExternArray(data, value.eltType);
   }
 
+  // Unless 'isBorrowed' is false, the array leaves freeing its elements to
+  // the external code; otherwise it calls value.freer on them itself.
   pragma "no copy return"
-  proc makeArrayFromExternArray(value: chpl_external_array, type eltType) {
+  proc makeArrayFromExternArray(value: chpl_external_array, type eltType,
+                                isBorrowed = true) {
     var dom = defaultDist.dsiNewRectangularDom(rank=1,
                                                idxType=int,
                                                stridable=false,
@@ -74,7 +77,7 @@ module ExternalArray {
                                                   data=value.elts: _ddata(eltType),
                                                   externFreeFunc=value.freer,
                                                   externArr=true,
-                                                  _borrowed=true);
+                                                  _borrowed=isBorrowed);
     dom.add_arr(arr, locking = false);
     return _newArray(arr);
   }
@@ -68,8 +68,10 @@ module LocaleModelHelpFlat {
     } else {
       var tls = chpl_task_getChapelData();
       chpl_task_data_setup(chpl_comm_on_bundle_task_bundle(args), tls);
+      chpl_comm_diags_prof_begin();
       chpl_comm_execute_on(node, chpl_sublocFromLocaleID(loc),
                            fn, args, args_size);
+      chpl_comm_diags_prof_end();
     }
   }
 
@@ -91,8 +93,10 @@ module LocaleModelHelpFlat {
     } else {
       var tls = chpl_task_getChapelData();
       chpl_task_data_setup(chpl_comm_on_bundle_task_bundle(args), tls);
+      chpl_comm_diags_prof_begin();
       chpl_comm_execute_on_fast(node, chpl_sublocFromLocaleID(loc),
                                 fn, args, args_size);
+      chpl_comm_diags_prof_end();
     }
   }
 
@@ -91,7 +91,9 @@ module LocaleModelHelpNUMA {
     if dnode != chpl_nodeID {
       var tls = chpl_task_getChapelData();
       chpl_task_data_setup(chpl_comm_on_bundle_task_bundle(args), tls);
+      chpl_comm_diags_prof_begin();
       chpl_comm_execute_on(dnode, dsubloc, fn, args, args_size);
+      chpl_comm_diags_prof_end();
     } else {
       // run directly on this node
       var origSubloc = chpl_task_getRequestedSubloc();
@@ -124,7 +126,9 @@ module LocaleModelHelpNUMA {
     if dnode != chpl_nodeID {
       var tls = chpl_task_getChapelData();
       chpl_task_data_setup(chpl_comm_on_bundle_task_bundle(args), tls);
+      chpl_comm_diags_prof_begin();
       chpl_comm_execute_on_fast(dnode, dsubloc, fn, args, args_size);
+      chpl_comm_diags_prof_end();
     } else {
       var origSubloc = chpl_task_getRequestedSubloc();
       if (dsubloc==origSubloc ||
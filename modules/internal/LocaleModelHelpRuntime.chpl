@@ -114,6 +114,9 @@ module LocaleModelHelpRuntime {
                                          args: chpl_comm_on_bundle_p, args_size: size_t,
                                          subloc_id: int): void;
   extern proc chpl_ftable_call(fn: int, args: chpl_comm_on_bundle_p): void;
+  // bracket blocking "on"s for per-call-site comm profiling
+  extern proc chpl_comm_diags_prof_begin(): void;
+  extern proc chpl_comm_diags_prof_end(): void;
   extern proc chpl_ftable_call(fn: int, args: chpl_task_bundle_p): void;
 
   //////////////////////////////////////////
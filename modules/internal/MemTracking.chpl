@@ -30,6 +30,7 @@ module MemTracking
     memLeaks: bool = false,
     memMax: uint = 0,
     memThreshold: uint = 0,
+    memProfileInterval: uint = 0,
     memLog: string;
 
   pragma "no auto destroy"
@@ -53,9 +54,11 @@ module MemTracking
   config const
     memLeaksByDesc: string;
 
-  // Safely cast to size_t instances of memMax and memThreshold.
+  // Safely cast to size_t instances of memMax, memThreshold, and
+  // memProfileInterval.
   const cMemMax = memMax.safeCast(size_t),
-    cMemThreshold = memThreshold.safeCast(size_t);
+    cMemThreshold = memThreshold.safeCast(size_t),
+    cMemProfileInterval = memProfileInterval.safeCast(size_t);
 
   //
   // This communicates the settings of the various memory tracking
@@ -77,6 +80,7 @@ module MemTracking
                                          ref ret_memLeaks: bool,
                                          ref ret_memMax: size_t,
                                          ref ret_memThreshold: size_t,
+                                         ref ret_memProfileInterval: size_t,
                                          ref ret_memLog: c_string,
                                          ref ret_memLeaksLog: c_string) {
     ret_memTrack = memTrack;
@@ -85,6 +89,7 @@ module MemTracking
     ret_memLeaks = memLeaks;
     ret_memMax = cMemMax;
     ret_memThreshold = cMemThreshold;
+    ret_memProfileInterval = cMemProfileInterval;
 
     if (here.id != 0) {
       if memLeaksByDesc.length != 0 {
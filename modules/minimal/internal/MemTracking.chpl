@@ -34,6 +34,7 @@ module MemTracking
                                          ref ret_memLeaksTable: bool,
                                          ref ret_memMax: uint(64),       // **
                                          ref ret_memThreshold: uint(64), // **
+                                         ref ret_memProfileInterval: uint(64), // **
                                          ref ret_memLog: c_string,
                                          ref ret_memLeaksLog: c_string) {
 
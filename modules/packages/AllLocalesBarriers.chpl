@@ -59,9 +59,10 @@
        }
      }
 
-   The implementation is dependent on the communication layer and the
-   underlying hardware, but typically some sort of tree or dissemination based
-   barrier that's optimized for the network will be used.
+   Once all the participating tasks on a locale have arrived, one of them
+   joins the runtime's dissemination barrier across locales, which finishes
+   in ``ceil(log2(numLocales))`` rounds of one-sided PUTs on any
+   communication layer.  See also the :mod:`Collectives` module.
 */
 module AllLocalesBarriers {
   use BlockDist, Barriers;
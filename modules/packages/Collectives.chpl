@@ -0,0 +1,210 @@
+/*
+ * Copyright 2004-2020 Hewlett Packard Enterprise Development LP
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+   Collective operations across all locales.
+
+   .. warning::
+     This module represents work in progress. The API is unstable and likely to
+     change over time.
+
+   This module provides reductions, broadcasts, gathers and a barrier for
+   programs written in an SPMD style, where one task on each locale works on
+   that locale's part of the data.  They are similar to ``MPI_Allreduce()``,
+   ``MPI_Bcast()``, ``MPI_Allgather()`` and ``MPI_Barrier()`` on
+   ``MPI_COMM_WORLD``:
+
+   .. code-block:: chapel
+
+     use Collectives;
+
+     coforall loc in Locales do on loc {
+       const mySum = + reduce localPartOfTheData();
+       const total = allReduce(mySum);          // the same on every locale
+       const biggest = allReduce(mySum, reduceOp.max);
+       const sums = allGather(mySum);           // sums[i] is locale i's
+       var n: int;
+       if here.id == 0 then n = readInput();
+       broadcast(n);                            // locale 0's, everywhere
+       barrier();
+     }
+
+   Exactly one task on each locale must call each of these, and all locales
+   must make the same sequence of calls with the same arguments other than
+   the values being combined.  Calling them in any other way, or from more
+   than one task per locale at a time, will hang or produce wrong answers.
+
+   They are implemented in the runtime on top of the communication layer's
+   PUTs.  The barrier is a dissemination barrier, which finishes in
+   ``ceil(log2(numLocales))`` rounds.  The other operations run up and down
+   a spanning tree with a fanout of ``CHPL_RT_COMM_BCAST_FANOUT`` (default
+   4), so they take a number of steps proportional to the log of the number
+   of locales rather than having locale 0 communicate with every other one.
+
+   The values combined or copied must be of a numeric type, or local
+   non-strided rectangular arrays of such values.  :proc:`allReduce`
+   supports ``int(32)``, ``int(64)``, ``uint(32)``, ``uint(64)``,
+   ``real(32)`` and ``real(64)``.
+*/
+module Collectives {
+  private use SysCTypes;
+
+  /* The ways :proc:`allReduce` can combine values.  The bitwise ones are
+     only supported for integral types. */
+  enum reduceOp { sum, product, min, max, bitAnd, bitOr, bitXor }
+
+  pragma "no doc"
+  extern type chpl_comm_coll_type_t = c_int;
+  pragma "no doc"
+  extern type chpl_comm_coll_op_t = c_int;
+
+  private extern const CHPL_COMM_COLL_INT32: chpl_comm_coll_type_t;
+  private extern const CHPL_COMM_COLL_INT64: chpl_comm_coll_type_t;
+  private extern const CHPL_COMM_COLL_UINT32: chpl_comm_coll_type_t;
+  private extern const CHPL_COMM_COLL_UINT64: chpl_comm_coll_type_t;
+  private extern const CHPL_COMM_COLL_REAL32: chpl_comm_coll_type_t;
+  private extern const CHPL_COMM_COLL_REAL64: chpl_comm_coll_type_t;
+
+  private extern const CHPL_COMM_COLL_SUM: chpl_comm_coll_op_t;
+  private extern const CHPL_COMM_COLL_PROD: chpl_comm_coll_op_t;
+  private extern const CHPL_COMM_COLL_MIN: chpl_comm_coll_op_t;
+  private extern const CHPL_COMM_COLL_MAX: chpl_comm_coll_op_t;
+  private extern const CHPL_COMM_COLL_BAND: chpl_comm_coll_op_t;
+  private extern const CHPL_COMM_COLL_BOR: chpl_comm_coll_op_t;
+  private extern const CHPL_COMM_COLL_BXOR: chpl_comm_coll_op_t;
+
+  private extern proc chpl_comm_coll_barrier();
+  private extern proc chpl_comm_coll_broadcast(buf: c_void_ptr, size: size_t,
+                                               root: c_int);
+  private extern proc chpl_comm_coll_allgather(mine: c_void_ptr,
+                                               all: c_void_ptr,
+                                               size: size_t);
+  private extern proc chpl_comm_coll_allreduce(buf: c_void_ptr,
+                                               count: size_t,
+                                               eltType: chpl_comm_coll_type_t,
+                                               op: chpl_comm_coll_op_t);
+
+  private proc isReduceType(type t) param {
+    return t == int(32) || t == int(64) || t == uint(32) || t == uint(64) ||
+           t == real(32) || t == real(64);
+  }
+
+  private proc collType(type t): chpl_comm_coll_type_t {
+    if t == int(32) then return CHPL_COMM_COLL_INT32;
+    else if t == int(64) then return CHPL_COMM_COLL_INT64;
+    else if t == uint(32) then return CHPL_COMM_COLL_UINT32;
+    else if t == uint(64) then return CHPL_COMM_COLL_UINT64;
+    else if t == real(32) then return CHPL_COMM_COLL_REAL32;
+    else return CHPL_COMM_COLL_REAL64;
+  }
+
+  private proc collOp(type t, op: reduceOp): chpl_comm_coll_op_t {
+    if isRealType(t) && op >= reduceOp.bitAnd then
+      halt("allReduce() of ", t:string, " values doesn't support ", op:string);
+    select op {
+      when reduceOp.sum do return CHPL_COMM_COLL_SUM;
+      when reduceOp.product do return CHPL_COMM_COLL_PROD;
+      when reduceOp.min do return CHPL_COMM_COLL_MIN;
+      when reduceOp.max do return CHPL_COMM_COLL_MAX;
+      when reduceOp.bitAnd do return CHPL_COMM_COLL_BAND;
+      when reduceOp.bitOr do return CHPL_COMM_COLL_BOR;
+      otherwise do return CHPL_COMM_COLL_BXOR;
+    }
+  }
+
+  private proc checkLocalArray(A: []) {
+    if !A._instance.isDefaultRectangular() || A.domain.stridable then
+      compilerError("collective operations on arrays require local " +
+                    "non-strided rectangular arrays", 2);
+  }
+
+  /*
+     Block until every locale has called :proc:`barrier`.
+   */
+  proc barrier() {
+    chpl_comm_coll_barrier();
+  }
+
+  /*
+     Combine the values of `x` on all the locales using `op`.
+
+     :arg x: this locale's value
+     :arg op: how to combine the values
+     :returns: the combined value, on every locale
+   */
+  proc allReduce(x: ?t, op: reduceOp = reduceOp.sum): t
+    where isReduceType(t) {
+    var result = x;
+    chpl_comm_coll_allreduce(c_ptrTo(result), 1, collType(t), collOp(t, op));
+    return result;
+  }
+
+  /*
+     Combine the arrays `A` on all the locales elementwise using `op`,
+     leaving the result in `A` on every locale.  `A` must have the same
+     number of elements on all of them.
+   */
+  proc allReduce(ref A: [] ?t, op: reduceOp = reduceOp.sum)
+    where isReduceType(t) {
+    checkLocalArray(A);
+    if A.size > 0 then
+      chpl_comm_coll_allreduce(c_ptrTo(A), A.size: size_t,
+                               collType(t), collOp(t, op));
+  }
+
+  /*
+     Copy `x` from locale `root` to every other locale.
+
+     :arg x: the value to send, on `root`, and to overwrite elsewhere
+     :arg root: the locale whose value is copied
+   */
+  proc broadcast(ref x: ?t, root: locale = Locales[0])
+    where isNumericType(t) {
+    chpl_comm_coll_broadcast(c_ptrTo(x), numBytes(t): size_t,
+                             root.id: c_int);
+  }
+
+  /*
+     Copy the array `A` from locale `root` to every other locale.  `A`
+     must have the same number of elements on all of them.
+   */
+  proc broadcast(ref A: [] ?t, root: locale = Locales[0])
+    where isNumericType(t) {
+    checkLocalArray(A);
+    if A.size > 0 then
+      chpl_comm_coll_broadcast(c_ptrTo(A), (A.size * numBytes(t)): size_t,
+                               root.id: c_int);
+  }
+
+  /*
+     Gather the values of `x` from all the locales.
+
+     :arg x: this locale's value
+     :returns: an array over ``LocaleSpace`` whose element ``i`` is
+               locale ``i``'s value, on every locale
+   */
+  proc allGather(x: ?t): [LocaleSpace] t
+    where isNumericType(t) {
+    var mine = x;
+    var all: [LocaleSpace] t;
+    chpl_comm_coll_allgather(c_ptrTo(mine), c_ptrTo(all),
+                             numBytes(t): size_t);
+    return all;
+  }
+}
@@ -0,0 +1,734 @@
+/*
+ * Copyright 2004-2020 Hewlett Packard Enterprise Development LP
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+
+Read and write gzip and zstd compressed files as channels.
+
+A compressed file is opened with :proc:`openCompressed`, which returns a
+:record:`~IO.file` whose channels read the decompressed data or compress
+what is written to them. Formatted and binary I/O work on these channels
+just as they do on an uncompressed file, so data can be streamed directly
+from a compressed file without decompressing it first.
+
+.. code-block:: chapel
+
+  use CompressedIO;
+
+  var w = openCompressedWriter("numbers.txt.gz");
+  for i in 1..1000 do
+    w.writeln(i);
+  w.close();
+
+  var r = openCompressedReader("numbers.txt.gz");
+  var sum = 0;
+  for x in r.lines() do
+    sum += x:int;
+  writeln(sum);
+
+The compression format is chosen from the file name (``.gz`` for gzip and
+``.zst`` for zstd) unless it is given with the ``format`` argument.
+
+Writing splits the data into blocks of :config:`compressionBlockSize`
+bytes and compresses as many blocks in parallel as there are tasks
+available. Each block is stored as a separate gzip member or zstd frame,
+which the standard ``gzip`` and ``zstd`` tools read as one stream.
+Reading decompresses serially, and reads files with any number of
+members or frames.
+
+Compressed files can be opened for reading (``iomode.r``) or for
+writing (``iomode.cw``), but not both, and they are not seekable. A
+reader starting at an offset other than 0 decompresses and discards the
+data before that offset.
+
+Dependencies
+------------
+
+This module requires zlib and, for zstd support, libzstd. Their headers
+and libraries must be available to the C compiler, for example by
+setting ``CHPL_INCLUDE_PATH`` and ``CHPL_LIB_PATH``. To use this module
+without libzstd, compile with ``-scompressedIOZstd=false``.
+
+CompressedIO Types and Functions
+--------------------------------
+
+ */
+module CompressedIO {
+
+  public use IO;
+  private use SysBasic, SysCTypes;
+
+  /* Set this to ``false`` to use this module without libzstd, in which
+     case only gzip files can be opened. */
+  config param compressedIOZstd = true;
+
+  /* The number of bytes compressed at a time by each task when
+     writing. */
+  config const compressionBlockSize = 1 << 20;
+
+  require "zlib.h", "-lz";
+  if compressedIOZstd {
+    require "zstd.h", "-lzstd";
+  }
+
+  /* The compression formats supported by :proc:`openCompressed`. */
+  enum compressor {
+    /* gzip, as read and written by the ``gzip`` tool */
+    gzip,
+    /* zstd, as read and written by the ``zstd`` tool */
+    zstd
+  }
+
+  // zlib
+
+  pragma "no doc"
+  extern record z_stream {
+    var next_in: c_ptr(uint(8));
+    var avail_in: c_uint;
+    var next_out: c_ptr(uint(8));
+    var avail_out: c_uint;
+  }
+
+  private extern const Z_OK: c_int;
+  private extern const Z_STREAM_END: c_int;
+  private extern const Z_BUF_ERROR: c_int;
+  private extern const Z_NO_FLUSH: c_int;
+  private extern const Z_FINISH: c_int;
+  private extern const Z_DEFLATED: c_int;
+  private extern const Z_DEFAULT_STRATEGY: c_int;
+
+  private extern proc deflateInit2(strm: c_ptr(z_stream), level: c_int,
+                                   method: c_int, windowBits: c_int,
+                                   memLevel: c_int, strategy: c_int): c_int;
+  private extern proc deflateBound(strm: c_ptr(z_stream),
+                                   sourceLen: c_ulong): c_ulong;
+  private extern proc deflate(strm: c_ptr(z_stream), flush: c_int): c_int;
+  private extern proc deflateEnd(strm: c_ptr(z_stream)): c_int;
+  private extern proc inflateInit2(strm: c_ptr(z_stream),
+                                   windowBits: c_int): c_int;
+  private extern proc inflate(strm: c_ptr(z_stream), flush: c_int): c_int;
+  private extern proc inflateReset(strm: c_ptr(z_stream)): c_int;
+  private extern proc inflateEnd(strm: c_ptr(z_stream)): c_int;
+
+  // 15 bits of window, +16 to write a gzip header, +32 to read either
+  // a gzip or a zlib header
+  private param gzipWriteBits = 15 + 16;
+  private param gzipReadBits = 15 + 32;
+
+  // zstd
+
+  pragma "no doc"
+  extern record ZSTD_inBuffer {
+    var src: c_void_ptr;
+    var size: size_t;
+    var pos: size_t;
+  }
+  pragma "no doc"
+  extern record ZSTD_outBuffer {
+    var dst: c_void_ptr;
+    var size: size_t;
+    var pos: size_t;
+  }
+
+  private extern proc ZSTD_compressBound(srcSize: size_t): size_t;
+  private extern proc ZSTD_compress(dst: c_void_ptr, dstCapacity: size_t,
+                                    src: c_void_ptr, srcSize: size_t,
+                                    compressionLevel: c_int): size_t;
+  private extern proc ZSTD_isError(code: size_t): c_uint;
+  private extern proc ZSTD_createDStream(): c_void_ptr;
+  private extern proc ZSTD_initDStream(zds: c_void_ptr): size_t;
+  private extern proc ZSTD_freeDStream(zds: c_void_ptr): size_t;
+  private extern proc ZSTD_DStreamInSize(): size_t;
+  private extern proc ZSTD_decompressStream(zds: c_void_ptr,
+                                            ref output: ZSTD_outBuffer,
+                                            ref input: ZSTD_inBuffer): size_t;
+
+  // QIO
+
+  private extern proc qio_strdup(s: c_string): c_string;
+  private extern proc qio_channel_writable(ch:qio_channel_ptr_t):bool;
+  private extern proc qio_channel_read(threadsafe:c_int, ch:qio_channel_ptr_t, ptr:c_void_ptr, len:ssize_t, ref amt_read:ssize_t):syserr;
+  private extern proc qio_channel_write_amt(threadsafe:c_int, ch:qio_channel_ptr_t, ptr:c_void_ptr, len:ssize_t):syserr;
+  private extern proc qio_channel_get_allocated_ptr_unlocked(ch:qio_channel_ptr_t, amt_requested:int(64), ref ptr_out:c_void_ptr, ref len_out:ssize_t, ref offset_out:int(64)):syserr;
+  private extern proc qio_channel_advance_available_end_unlocked(ch:qio_channel_ptr_t, len:ssize_t);
+  private extern proc qio_channel_get_write_behind_ptr_unlocked(ch:qio_channel_ptr_t, ref ptr_out:c_void_ptr, ref len_out:ssize_t, ref offset_out:int(64)):syserr;
+  private extern proc qio_channel_advance_write_behind_unlocked(ch:qio_channel_ptr_t, len:ssize_t);
+
+  /*
+    Return the compression format for a file name: :enum:`compressor.gzip`
+    for a name ending in ``.gz`` and :enum:`compressor.zstd` for one
+    ending in ``.zst``.
+
+    :throws IllegalArgumentError: Thrown if the name has neither ending.
+   */
+  proc compressorFor(path: string): compressor throws {
+    if path.endsWith(".gz") then
+      return compressor.gzip;
+    if path.endsWith(".zst") then
+      return compressor.zstd;
+    throw new owned IllegalArgumentError("path",
+        "cannot tell the compression format of '" + path + "'");
+  }
+
+  /*
+    Open a compressed file. Reading channels on the returned file
+    decompress its data and writing channels compress the data written.
+
+    :arg path: the path of the file to open
+    :arg mode: ``iomode.r`` to read the file or ``iomode.cw`` to
+               create or truncate it for writing
+    :arg format: the compression format, by default chosen from the
+                 file name with :proc:`compressorFor`
+    :arg level: the compression level to write with, or -1 for the
+                default level of the format
+    :arg style: the default :record:`~IO.iostyle` of channels on the file
+    :returns: an open :record:`~IO.file`
+
+    :throws IllegalArgumentError: Thrown for an unsupported mode or format.
+    :throws SystemError: Thrown if the file could not be opened.
+   */
+  proc openCompressed(path: string, mode: iomode = iomode.r,
+                      format: compressor = compressorFor(path),
+                      level: int = -1,
+                      style: iostyle = defaultIOStyle()): file throws {
+    if mode != iomode.r && mode != iomode.cw then
+      throw new owned IllegalArgumentError("mode",
+          "compressed files can only be opened with iomode.r or iomode.cw");
+    if format == compressor.zstd && !compressedIOZstd then
+      throw new owned IllegalArgumentError("format",
+          "zstd support was disabled with compressedIOZstd=false");
+    if compressionBlockSize <= 0 || compressionBlockSize > max(int(32)) then
+      throw new owned IllegalArgumentError("compressionBlockSize",
+          "must be between 1 and " + max(int(32)):string);
+
+    var raw = open(path, mode, style=style);
+    var fl = new unmanaged CompressedFile(raw, path, format, level);
+
+    var ret: file;
+    try {
+      ret = openplugin(fl, mode, seekable=false, style);
+    } catch e {
+      fl.close();
+      delete fl;
+      throw e;
+    }
+    return ret;
+  }
+
+  /*
+    Open a compressed file and return a channel reading its
+    decompressed data, as :proc:`IO.openreader` does for an
+    uncompressed file.
+
+    :arg path: the path of the file to read
+    :arg kind: :type:`~IO.iokind` compile-time argument to determine the
+               corresponding parameter of the :record:`~IO.channel` type.
+    :arg locking: compile-time argument to determine whether or not the
+                  channel should use locking.
+    :arg start: zero-based byte offset in the decompressed data
+                indicating where the channel should start reading.
+    :arg end: zero-based byte offset in the decompressed data
+              indicating where the channel should no longer be allowed
+              to read.
+    :arg format: the compression format, by default chosen from the
+                 file name with :proc:`compressorFor`
+    :returns: an open reading channel
+
+    :throws SystemError: Thrown if the file could not be opened.
+   */
+  proc openCompressedReader(path: string,
+                            param kind=iokind.dynamic, param locking=true,
+                            start:int(64) = 0, end:int(64) = max(int(64)),
+                            format: compressor = compressorFor(path),
+                            style:iostyle = defaultIOStyle())
+                           : channel(false, kind, locking) throws {
+    var f = openCompressed(path, iomode.r, format, style=style);
+    return f.reader(kind=kind, locking=locking, start=start, end=end);
+  }
+
+  /*
+    Create a compressed file and return a channel writing to it, as
+    :proc:`IO.openwriter` does for an uncompressed file. The data is
+    compressed as it is written, and the end of the compressed data is
+    written when the channel is closed.
+
+    :arg path: the path of the file to write
+    :arg kind: :type:`~IO.iokind` compile-time argument to determine the
+               corresponding parameter of the :record:`~IO.channel` type.
+    :arg locking: compile-time argument to determine whether or not the
+                  channel should use locking.
+    :arg format: the compression format, by default chosen from the
+                 file name with :proc:`compressorFor`
+    :arg level: the compression level, or -1 for the default level of
+                the format
+    :returns: an open writing channel
+
+    :throws SystemError: Thrown if the file could not be opened.
+   */
+  proc openCompressedWriter(path: string,
+                            param kind=iokind.dynamic, param locking=true,
+                            format: compressor = compressorFor(path),
+                            level: int = -1,
+                            style:iostyle = defaultIOStyle())
+                           : channel(true, kind, locking) throws {
+    var f = openCompressed(path, iomode.cw, format, level, style);
+    return f.writer(kind=kind, locking=locking);
+  }
+
+  private proc toSyserr(e: borrowed Error): syserr {
+    const se = e: borrowed SystemError?;
+    if se != nil then
+      return se!.err;
+    return EIO;
+  }
+
+  // Make dst hold at least bound bytes.
+  private proc reserveBlock(ref dst: c_ptr(uint(8)), ref dstCap: int,
+                            bound: int): bool {
+    if bound > dstCap {
+      c_free(dst);
+      dst = c_malloc(uint(8), bound);
+      dstCap = if dst == nil then 0 else bound;
+    }
+    return dst != nil;
+  }
+
+  // Compress n bytes from src into dst, allocating or growing dst as
+  // needed, as one gzip member or zstd frame.
+  private proc compressBlock(format: compressor, level: int,
+                             src: c_ptr(uint(8)), n: int,
+                             ref dst: c_ptr(uint(8)), ref dstCap: int,
+                             ref dstLen: int): syserr {
+    if format == compressor.gzip {
+      var strm = c_calloc(z_stream, 1);
+      if strm == nil then
+        return ENOMEM;
+      defer c_free(strm);
+
+      if deflateInit2(strm, level:c_int, Z_DEFLATED, gzipWriteBits,
+                      8, Z_DEFAULT_STRATEGY) != Z_OK then
+        return ENOMEM;
+      defer deflateEnd(strm);
+
+      const bound = deflateBound(strm, n:c_ulong):int;
+      if !reserveBlock(dst, dstCap, bound) then
+        return ENOMEM;
+
+      strm.deref().next_in = src;
+      strm.deref().avail_in = n:c_uint;
+      strm.deref().next_out = dst;
+      strm.deref().avail_out = bound:c_uint;
+      if deflate(strm, Z_FINISH) != Z_STREAM_END then
+        return EIO;
+      dstLen = bound - strm.deref().avail_out:int;
+    } else if compressedIOZstd {
+      const bound = ZSTD_compressBound(n:size_t):int;
+      if !reserveBlock(dst, dstCap, bound) then
+        return ENOMEM;
+
+      // zstd's default level is 0
+      const zlevel = if level < 0 then 0 else level;
+      const rc = ZSTD_compress(dst, bound:size_t, src, n:size_t,
+                               zlevel:c_int);
+      if ZSTD_isError(rc) then
+        return EIO;
+      dstLen = rc:int;
+    }
+    return ENOERR;
+  }
+
+  pragma "no doc"
+  class CompressedFile : QioPluginFile {
+    var raw: file;
+    var path: string;
+    var format: compressor;
+    var level: int;
+    // An error from the last writing channel to close, which could not
+    // be reported when it closed.
+    var closeError: syserr = ENOERR;
+
+    proc init(raw: file, path: string, format: compressor, level: int) {
+      this.raw = raw;
+      this.path = path;
+      this.format = format;
+      this.level = level;
+    }
+
+    override proc setupChannel(out pluginChannel:unmanaged QioPluginChannel?,
+                               start:int(64),
+                               end:int(64),
+                               qioChannelPtr:qio_channel_ptr_t):syserr {
+      const writing = qio_channel_writable(qioChannelPtr);
+      if writing && start != 0 then
+        return EINVAL;
+
+      var ch = new unmanaged CompressedChannel(this:unmanaged, qioChannelPtr,
+                                               writing, start);
+      var err = ch.setup();
+      if err {
+        ch.close();
+        delete ch;
+        return err;
+      }
+      pluginChannel = ch;
+      return ENOERR;
+    }
+
+    override proc filelength(out length:int(64)):syserr {
+      // The decompressed length is not known without decompressing.
+      return ENOTSUP;
+    }
+    override proc getpath(out path:c_string, out len:int(64)):syserr {
+      path = qio_strdup(this.path.c_str());
+      len = this.path.numBytes;
+      return ENOERR;
+    }
+
+    override proc fsync():syserr {
+      if closeError then
+        return closeError;
+      try {
+        raw.fsync();
+      } catch e {
+        return toSyserr(e);
+      }
+      return ENOERR;
+    }
+    override proc getChunk(out length:int(64)):syserr {
+      return ENOSYS;
+    }
+    override proc getLocalesForRegion(start:int(64), end:int(64), out
+        localeNames:c_ptr(c_string), ref nLocales:int(64)):syserr {
+      return ENOSYS;
+    }
+
+    override proc close():syserr {
+      var err = closeError;
+      try {
+        raw.close();
+      } catch e {
+        if !err then err = toSyserr(e);
+      }
+      return err;
+    }
+  }
+
+  pragma "no doc"
+  class CompressedChannel : QioPluginChannel {
+    var file: unmanaged CompressedFile;
+    var qio_ch: qio_channel_ptr_t;
+    var writing: bool;
+    var rawOpen: bool;
+
+    // Reading
+    var rawReader: channel(false, iokind.dynamic, false);
+    // decompressed bytes to discard before the channel's start
+    var skip: int(64);
+    var inBuf: c_ptr(uint(8));
+    var inCap: int;
+    var inLen: int;
+    var inPos: int;
+    var inEOF: bool;
+    // true in the middle of a gzip member or zstd frame
+    var inMember: bool;
+    // true if the last step filled its output, so more may be pending
+    var outPending: bool;
+    var strm: c_ptr(z_stream);
+    var zds: c_void_ptr;
+
+    // Writing
+    var rawWriter: channel(true, iokind.dynamic, false);
+    var numBlocks: int;
+    var blockSize: int;
+    var stage: c_ptr(uint(8));
+    var staged: int;
+    var wroteAny: bool;
+    var outDom: domain(1);
+    var outBufs: [outDom] c_ptr(uint(8));
+    var outCaps: [outDom] int;
+    var outLens: [outDom] int;
+
+    proc init(file: unmanaged CompressedFile, qio_ch: qio_channel_ptr_t,
+              writing: bool, start: int(64)) {
+      this.file = file;
+      this.qio_ch = qio_ch;
+      this.writing = writing;
+      this.skip = start;
+    }
+
+    proc setup(): syserr {
+      try {
+        if writing then
+          rawWriter = file.raw.writer(locking=false);
+        else
+          rawReader = file.raw.reader(locking=false);
+        rawOpen = true;
+      } catch e {
+        return toSyserr(e);
+      }
+
+      if writing {
+        numBlocks = if dataParTasksPerLocale == 0 then here.maxTaskPar
+                    else dataParTasksPerLocale;
+        numBlocks = max(1, numBlocks);
+        blockSize = compressionBlockSize;
+        stage = c_malloc(uint(8), numBlocks * blockSize);
+        if stage == nil then
+          return ENOMEM;
+        outDom = {0..#numBlocks};
+        return ENOERR;
+      }
+
+      inCap = 128 * 1024;
+      if file.format == compressor.gzip {
+        strm = c_calloc(z_stream, 1);
+        if strm == nil then
+          return ENOMEM;
+        if inflateInit2(strm, gzipReadBits) != Z_OK {
+          c_free(strm);
+          strm = nil;
+          return ENOMEM;
+        }
+      } else if compressedIOZstd {
+        inCap = ZSTD_DStreamInSize():int;
+        zds = ZSTD_createDStream();
+        if zds == nil then
+          return ENOMEM;
+        if ZSTD_isError(ZSTD_initDStream(zds)) then
+          return ENOMEM;
+      }
+      inBuf = c_malloc(uint(8), inCap);
+      if inBuf == nil then
+        return ENOMEM;
+      return ENOERR;
+    }
+
+    // Read more compressed data into inBuf once it has all been used.
+    proc fill(): syserr {
+      var got: ssize_t = 0;
+      var err = qio_channel_read(false, rawReader._channel_internal,
+                                 inBuf, inCap, got);
+      inLen = got;
+      inPos = 0;
+      if err == EEOF {
+        inEOF = true;
+        err = ENOERR;
+      }
+      return err;
+    }
+
+    // Decompress up to len bytes into dst, setting got to the number of
+    // bytes produced. Returns once some bytes have been produced and the
+    // compressed data read so far is used up, so got is 0 only at the
+    // end of the data.
+    proc decompress(dst: c_ptr(uint(8)), len: int, out got: int): syserr {
+      got = 0;
+      while got < len {
+        if inPos == inLen && !outPending {
+          if got > 0 || inEOF then break;
+          var err = fill();
+          if err then return err;
+          if inPos == inLen then break;
+        }
+
+        const space = min(len - got, max(c_uint):int);
+        if file.format == compressor.gzip {
+          strm.deref().next_in = inBuf + inPos;
+          strm.deref().avail_in = (inLen - inPos):c_uint;
+          strm.deref().next_out = dst + got;
+          strm.deref().avail_out = space:c_uint;
+          const rc = inflate(strm, Z_NO_FLUSH);
+          inPos = inLen - strm.deref().avail_in:int;
+          got += space - strm.deref().avail_out:int;
+          outPending = strm.deref().avail_out == 0;
+          if rc == Z_STREAM_END {
+            // Another member may follow.
+            inMember = false;
+            inflateReset(strm);
+          } else if rc == Z_OK {
+            inMember = true;
+          } else if rc != Z_BUF_ERROR {
+            return EFORMAT;
+          }
+        } else if compressedIOZstd {
+          var input: ZSTD_inBuffer;
+          input.src = inBuf;
+          input.size = inLen:size_t;
+          input.pos = inPos:size_t;
+          var output: ZSTD_outBuffer;
+          output.dst = dst + got;
+          output.size = space:size_t;
+          output.pos = 0;
+          const rc = ZSTD_decompressStream(zds, output, input);
+          if ZSTD_isError(rc) then
+            return EFORMAT;
+          inPos = input.pos:int;
+          got += output.pos:int;
+          outPending = output.pos:int == space;
+          inMember = rc != 0;
+        }
+      }
+
+      if got == 0 && inMember {
+        // The data ends in the middle of a member or frame.
+        return EFORMAT;
+      }
+      return ENOERR;
+    }
+
+    override proc readAtLeast(amt:int(64)):syserr {
+      var err:syserr = ENOERR;
+
+      // Discard the data before the start of the channel.
+      while skip > 0 {
+        var scratch: c_array(uint(8), 4096);
+        var got = 0;
+        err = decompress(c_ptrTo(scratch[0]), min(skip, 4096), got);
+        if err then
+          return err;
+        if got == 0 then
+          return EEOF;
+        skip -= got;
+      }
+
+      var remaining = amt;
+      while remaining > 0 {
+        var ptr:c_void_ptr = c_nil;
+        var len = 0:ssize_t;
+        var offset = 0;
+        err = qio_channel_get_allocated_ptr_unlocked(qio_ch, remaining,
+                                                     ptr, len, offset);
+        if err then
+          return err;
+        if ptr == nil || len == 0 then
+          return EINVAL;
+
+        var got = 0;
+        err = decompress(ptr:c_ptr(uint(8)), len, got);
+        if err then
+          return err;
+        if got == 0 then
+          return EEOF;
+
+        qio_channel_advance_available_end_unlocked(qio_ch, got);
+        remaining -= got;
+      }
+      return ENOERR;
+    }
+
+    // Compress the staged data in parallel, one block per task, and
+    // write the blocks in order. With nothing written yet and nothing
+    // staged, this writes one empty member or frame, so that the file
+    // is valid.
+    proc flushStage(): syserr {
+      const nb = if staged == 0 && !wroteAny then 1
+                 else (staged + blockSize - 1) / blockSize;
+      var errs: [0..#nb] syserr;
+
+      forall i in 0..#nb with (ref errs) {
+        const lo = i * blockSize;
+        const n = min(blockSize, staged - lo);
+        errs[i] = compressBlock(file.format, file.level, stage + lo, n,
+                                outBufs[i], outCaps[i], outLens[i]);
+      }
+
+      for i in 0..#nb {
+        if errs[i] then
+          return errs[i];
+        var err = qio_channel_write_amt(false, rawWriter._channel_internal,
+                                        outBufs[i], outLens[i]);
+        if err then
+          return err;
+      }
+      staged = 0;
+      wroteAny = true;
+      return ENOERR;
+    }
+
+    override proc write(amt:int(64)):syserr {
+      var err:syserr = ENOERR;
+      var remaining = amt;
+      while remaining > 0 {
+        var ptr:c_void_ptr = c_nil;
+        var len = 0:ssize_t;
+        var offset = 0;
+        err = qio_channel_get_write_behind_ptr_unlocked(qio_ch, ptr, len,
+                                                        offset);
+        if err then
+          return err;
+        if ptr == nil || len == 0 then
+          return EINVAL;
+
+        const n = min(len:int, remaining, numBlocks * blockSize - staged);
+        c_memcpy(stage + staged, ptr, n);
+        staged += n;
+        qio_channel_advance_write_behind_unlocked(qio_ch, n);
+        remaining -= n;
+
+        if staged == numBlocks * blockSize {
+          err = flushStage();
+          if err then
+            return err;
+        }
+      }
+      return ENOERR;
+    }
+
+    override proc close():syserr {
+      var err:syserr = ENOERR;
+
+      if writing && rawOpen {
+        // Write what is left, or an empty member or frame so that the
+        // file is valid even with no data.
+        if stage != nil && (staged > 0 || !wroteAny) then
+          err = flushStage();
+        try {
+          rawWriter.close();
+        } catch e {
+          if !err then err = toSyserr(e);
+        }
+        // The qio channel's close does not report plugin errors, so
+        // save this one for the file.
+        if err then
+          file.closeError = err;
+      } else if rawOpen {
+        try {
+          rawReader.close();
+        } catch e {
+          err = toSyserr(e);
+        }
+      }
+
+      if strm != nil {
+        inflateEnd(strm);
+        c_free(strm);
+      }
+      if compressedIOZstd {
+        if zds != nil then
+          ZSTD_freeDStream(zds);
+      }
+      c_free(inBuf);
+      c_free(stage);
+      for p in outBufs do
+        c_free(p);
+      return err;
+    }
+  }
+
+} /* end of module */
@@ -95,6 +95,35 @@ Example 2
   for r in N.stream() do
     writeln(r);
 
+Delimited records
+-----------------
+
+Text with one record per line and fields separated by a delimiter, such
+as comma-separated values, can be read much faster with a
+:class:`DelimitedReader`, which parses batches of records directly from
+the channel's buffer and converts each field to the type of the
+corresponding record field.  :proc:`readDelimited` reads a whole file
+this way, in parallel.
+
+.. code-block:: chapel
+
+  use RecordParser;
+
+  record Sample {
+    var station: string;
+    var day: int;
+    var temperature: real;
+  }
+
+  // read "station,day,temperature" lines after a header line
+  var f = open("samples.csv", iomode.r);
+  var D = new owned DelimitedReader(Sample, f.reader(), header=true);
+  for s in D.stream() do
+    writeln(s);
+
+  // or read them all at once
+  var A = readDelimited(Sample, f, header=true);
+
 RecordParser Types and Functions
 --------------------------------
 
@@ -102,6 +131,19 @@ RecordParser Types and Functions
 module RecordParser {
 
 use IO, Regexp, Reflection;
+private use SysCTypes;
+
+pragma "no doc"
+extern type qio_delimited_batch_ptr_t;
+
+private extern proc qio_delimited_batch_create():qio_delimited_batch_ptr_t;
+private extern proc qio_delimited_batch_destroy(batch:qio_delimited_batch_ptr_t);
+private extern proc qio_channel_read_delimited(threadsafe:c_int, ch:qio_channel_ptr_t, delimiter:int(32), quote:int(32), nfields:int(64), max_records:int(64), end_offset:int(64), batch:qio_delimited_batch_ptr_t):syserr;
+private extern proc qio_delimited_batch_nrecords(batch:qio_delimited_batch_ptr_t):int(64);
+private extern proc qio_delimited_field_ptr(batch:qio_delimited_batch_ptr_t, i:int(64)):c_string;
+private extern proc qio_delimited_field_len(batch:qio_delimited_batch_ptr_t, i:int(64)):int(64);
+private extern proc qio_delimited_field_to_int(batch:qio_delimited_batch_ptr_t, i:int(64), ptr:c_void_ptr, len:size_t, issigned:c_int):syserr;
+private extern proc qio_delimited_field_to_float(batch:qio_delimited_batch_ptr_t, i:int(64), ptr:c_void_ptr, len:size_t):syserr;
 
 
 /* A class providing the ability to read records matching a regular expression.
@@ -250,4 +292,237 @@ class RecordReader {
 
 }
 
+
+/* A class providing the ability to read records from delimited text,
+   such as comma-separated values.
+
+   Each line of the text is a record, with one field for each field of
+   the record type :type:`t`, in the same order, separated by the
+   delimiter.  A field may be enclosed in quotes, in which case it can
+   contain the delimiter, newlines, and doubled quotes standing for a
+   quote.  Lines end with ``\n`` or ``\r\n``, and blank lines are
+   skipped.
+
+   Integral and real fields are read as decimal numbers, string fields
+   are read as they are, and other fields are cast from a string.  An
+   empty field leaves the record field with its default value.
+ */
+class DelimitedReader {
+  /* The record type to populate */
+  type t;
+  /* The channel to read from */
+  var myReader;
+  /* The single-byte delimiter between fields */
+  var delimiter: string;
+  /* The single-byte quote around fields, or "" to read quotes as text */
+  var quote: string;
+  /* Skip a header record before the first record */
+  var header: bool;
+  /* The number of records to parse at a time in :proc:`stream` */
+  var batchSize: int;
+  pragma "no doc"
+  param num_fields = numFields(t);
+  pragma "no doc"
+  var _batch: qio_delimited_batch_ptr_t;
+  // Stop before a record starting at this offset, if it's not -1.
+  pragma "no doc"
+  var _end: int(64) = -1;
+  pragma "no doc"
+  var _started = false;
+
+  /* Create a DelimitedReader.
+
+     :arg t: the record type to read
+     :arg myReader: the channel to read from
+     :arg delimiter: the single-byte delimiter between fields
+     :arg quote: the single-byte quote around fields, or ""
+     :arg header: skip a header record before the first record
+     :arg batchSize: the number of records to parse at a time in
+                     :proc:`stream`
+   */
+  proc init(type t, myReader, delimiter = ",", quote = "\"",
+            header = false, batchSize = 1024) {
+    this.t = t;
+    this.myReader = myReader;
+    this.delimiter = delimiter;
+    this.quote = quote;
+    this.header = header;
+    this.batchSize = max(1, batchSize);
+    this.complete();
+    _batch = qio_delimited_batch_create();
+  }
+
+  pragma "no doc"
+  proc deinit() {
+    qio_delimited_batch_destroy(_batch);
+  }
+
+  /* Read records into the elements of A, in order, stopping at the end
+     of the channel.  Returns the number of records read, which is 0
+     when there are no more.
+   */
+  proc readBatch(ref A: [] t): int throws {
+    const n = _readRecords(A.size);
+    var k = 0;
+    for a in A {
+      if k == n then break;
+      a = _toRecord(k);
+      k += 1;
+    }
+    return n;
+  }
+
+  /* Read the next record */
+  proc get() throws {
+    var A: [0..0] t;
+    if readBatch(A) == 0 then
+      halt("EOF reached -- record not populated");
+    return A[0];
+  }
+
+  /* Yield the records read */
+  iter stream() {
+    var A: [0..#batchSize] t;
+    try! { // TODO -- should be throws, once that is working for iterators
+      while true {
+        const n = readBatch(A);
+        if n == 0 then break;
+        for i in 0..#n do yield A[i];
+      }
+    }
+  }
+
+  // Parse up to max records into _batch and return how many.
+  pragma "no doc"
+  proc _readRecords(max: int): int throws {
+    if delimiter.numBytes != 1 || quote.numBytes > 1 then
+      throw new owned IllegalArgumentError("DelimitedReader delimiter and quote must be single bytes");
+    if here != myReader.home then
+      throw new owned IllegalArgumentError("DelimitedReader must run on its channel's locale");
+
+    if !_started {
+      _started = true;
+      if header && _readRecords(1) == 0 then return 0;
+    }
+
+    const q = if quote.numBytes == 0 then -1:int(32)
+              else quote.byte(1):int(32);
+    const err = qio_channel_read_delimited(myReader.locking:c_int,
+                                           myReader._channel_internal,
+                                           delimiter.byte(1):int(32), q,
+                                           num_fields, max, _end, _batch);
+    if err != ENOERR && err != EEOF then
+      try myReader._ch_ioerror(err, "in DelimitedReader");
+    return qio_delimited_batch_nrecords(_batch);
+  }
+
+  pragma "no doc"
+  proc _toRecord(k: int) throws {
+    var rec: t;
+    for param n in 1..num_fields do
+      _readField(getFieldRef(rec, n), k * num_fields + n - 1);
+    return rec;
+  }
+
+  pragma "no doc"
+  proc _readField(ref dst, i: int) throws {
+    type ft = dst.type;
+    const len = qio_delimited_field_len(_batch, i);
+    if len == 0 then return;
+
+    var err: syserr = ENOERR;
+    if isIntegralType(ft) then
+      err = qio_delimited_field_to_int(_batch, i, c_ptrTo(dst),
+                                       numBytes(ft):size_t,
+                                       isIntType(ft):c_int);
+    else if isRealType(ft) then
+      err = qio_delimited_field_to_float(_batch, i, c_ptrTo(dst),
+                                         numBytes(ft):size_t);
+    else {
+      const s = createStringWithNewBuffer(qio_delimited_field_ptr(_batch, i),
+                                          len);
+      if ft == string then
+        dst = s;
+      else
+        dst = s:ft;
+    }
+    if err then
+      try myReader._ch_ioerror(err, "in DelimitedReader reading field " +
+                                    (i % num_fields + 1):string);
+  }
+}
+
+pragma "no doc"
+record _DelimitedChunk {
+  type t;
+  var D: domain(1);
+  var A: [D] t;
+}
+
+/* Read all of the records in a region of a file of delimited text, as
+   with a :class:`DelimitedReader`, and return them in an array.
+
+   The region is split into chunks that are parsed in parallel, each
+   starting with the first line that starts in it.  So that a line can
+   be found from any byte, quoted fields must not contain newlines.
+
+   :arg t: the record type to read
+   :arg f: the file to read
+   :arg delimiter: the single-byte delimiter between fields
+   :arg quote: the single-byte quote around fields, or ""
+   :arg header: skip a header record at the start of the region
+   :arg start: the offset to start reading at
+   :arg end: the offset to stop reading at
+ */
+proc readDelimited(type t, f: file, delimiter = ",", quote = "\"",
+                   header = false, start: int(64) = 0,
+                   end: int(64) = max(int(64))) throws {
+  const minChunk = 64 * 1024;
+  const fileEnd = min(end, f.length());
+  const len = max(0, fileEnd - start);
+  const numTasks = if dataParTasksPerLocale == 0 then here.maxTaskPar
+                   else dataParTasksPerLocale;
+  const numChunks = max(1, min(numTasks, len / minChunk));
+  var parts: [0..#numChunks] _DelimitedChunk(t);
+
+  coforall i in 0..#numChunks with (ref parts) {
+    const lo = start + len * i / numChunks;
+    const hi = start + len * (i + 1) / numChunks;
+    var r = f.reader(locking=false, start=if i > 0 then lo - 1 else lo,
+                     end=fileEnd);
+    // The line in progress before the chunk belongs to the chunk before.
+    if i > 0 then r.readln();
+
+    var D = new owned DelimitedReader(t, r, delimiter, quote,
+                                      header=(i == 0 && header));
+    if i < numChunks - 1 then D._end = hi;
+
+    ref part = parts[i];
+    var n = 0;
+    while true {
+      const got = D._readRecords(D.batchSize);
+      if got == 0 then break;
+      if n + got > part.D.size then
+        part.D = {0..#max(2 * part.D.size, n + got)};
+      for k in 0..#got do
+        part.A[n + k] = D._toRecord(k);
+      n += got;
+    }
+    part.D = {0..#n};
+    r.close();
+  }
+
+  var offsets: [0..#numChunks] int;
+  var total = 0;
+  for i in 0..#numChunks {
+    offsets[i] = total;
+    total += parts[i].D.size;
+  }
+
+  var result: [0..#total] t;
+  forall i in 0..#numChunks do
+    result[offsets[i]..#parts[i].D.size] = parts[i].A;
+  return result;
+}
+
 }
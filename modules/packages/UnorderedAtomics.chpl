@@ -67,13 +67,18 @@
    updates to perform and the order of those operations doesn't matter.
 
    .. note::
-     Currently, these are only optimized for ``CHPL_NETWORK_ATOMICS=ugni``.
-     Processor atomics or any other implementation falls back to ordered
+     Currently, these are only optimized for ``CHPL_NETWORK_ATOMICS=ugni``,
+     ``CHPL_NETWORK_ATOMICS=ofi``, and for processor atomics under
+     ``CHPL_COMM=gasnet``. Any other implementation falls back to ordered
      operations. Under ugni these operations are internally buffered. When the
      buffers are flushed, the operations are performed all at once. Cray Linux
      Environment (CLE) 5.2.UP04 or newer is required for best performance. In
      our experience, unordered atomics can achieve up to a 5X performance
      improvement over ordered atomics for CLE 5.2UP04 or newer.
+
+     Under gasnet, and under ofi for types the network can't do atomics on,
+     these operations are buffered per destination locale and sent in bulk,
+     to be done by the target locale's active message handler.
  */
 module UnorderedAtomics {
 
@@ -83,9 +88,24 @@ module UnorderedAtomics {
     if isReal(T) then return "chpl_comm_atomic_" + s + "_real" + numBits(T):string;
   }
 
+  // Whether the comm layer buffers unordered operations on processor
+  // atomics of type T
+  private proc commBuffersProcessorAtomics(type T) param {
+    return CHPL_COMM == "gasnet" && numBits(T) >= 32;
+  }
+
   /* Unordered atomic add. */
   inline proc AtomicT.unorderedAdd(value:T): void {
-    this.add(value);
+    if commBuffersProcessorAtomics(T) {
+      pragma "insert line file info" extern externFunc("add_unordered", T)
+        proc atomic_add_unordered(ref op:T, l:int(32), obj:c_void_ptr): void;
+
+      var v = value;
+      atomic_add_unordered(v, this.locale.id:int(32),
+                           __primitive("_wide_get_addr", _v));
+    } else {
+      this.add(value);
+    }
   }
   pragma "no doc"
   inline proc RAtomicT.unorderedAdd(value:T): void {
@@ -98,7 +118,16 @@ module UnorderedAtomics {
 
   /* Unordered atomic sub. */
   inline proc AtomicT.unorderedSub(value:T): void {
-    this.sub(value);
+    if commBuffersProcessorAtomics(T) {
+      pragma "insert line file info" extern externFunc("sub_unordered", T)
+        proc atomic_sub_unordered(ref op:T, l:int(32), obj:c_void_ptr): void;
+
+      var v = value;
+      atomic_sub_unordered(v, this.locale.id:int(32),
+                           __primitive("_wide_get_addr", _v));
+    } else {
+      this.sub(value);
+    }
   }
   pragma "no doc"
   inline proc RAtomicT.unorderedSub(value:T): void {
@@ -111,7 +140,17 @@ module UnorderedAtomics {
 
   /* Unordered atomic or. */
   inline proc AtomicT.unorderedOr(value:T): void {
-    this.or(value);
+    if !isIntegral(T) then compilerError("or is only defined for integer atomic types");
+    if commBuffersProcessorAtomics(T) {
+      pragma "insert line file info" extern externFunc("or_unordered", T)
+        proc atomic_or_unordered(ref op:T, l:int(32), obj:c_void_ptr): void;
+
+      var v = value;
+      atomic_or_unordered(v, this.locale.id:int(32),
+                          __primitive("_wide_get_addr", _v));
+    } else {
+      this.or(value);
+    }
   }
   pragma "no doc"
   inline proc RAtomicT.unorderedOr(value:T): void {
@@ -125,7 +164,17 @@ module UnorderedAtomics {
 
   /* Unordered atomic and. */
   inline proc AtomicT.unorderedAnd(value:T): void {
-    this.and(value);
+    if !isIntegral(T) then compilerError("and is only defined for integer atomic types");
+    if commBuffersProcessorAtomics(T) {
+      pragma "insert line file info" extern externFunc("and_unordered", T)
+        proc atomic_and_unordered(ref op:T, l:int(32), obj:c_void_ptr): void;
+
+      var v = value;
+      atomic_and_unordered(v, this.locale.id:int(32),
+                           __primitive("_wide_get_addr", _v));
+    } else {
+      this.and(value);
+    }
   }
   pragma "no doc"
   inline proc RAtomicT.unorderedAnd(value:T): void {
@@ -139,7 +188,17 @@ module UnorderedAtomics {
 
   /* Unordered atomic xor. */
   inline proc AtomicT.unorderedXor(value:T): void {
-    this.xor(value);
+    if !isIntegral(T) then compilerError("xor is only defined for integer atomic types");
+    if commBuffersProcessorAtomics(T) {
+      pragma "insert line file info" extern externFunc("xor_unordered", T)
+        proc atomic_xor_unordered(ref op:T, l:int(32), obj:c_void_ptr): void;
+
+      var v = value;
+      atomic_xor_unordered(v, this.locale.id:int(32),
+                           __primitive("_wide_get_addr", _v));
+    } else {
+      this.xor(value);
+    }
   }
   pragma "no doc"
   inline proc RAtomicT.unorderedXor(value:T): void {
@@ -155,7 +214,7 @@ module UnorderedAtomics {
      Fence any pending unordered atomics issued by the current task.
    */
   inline proc unorderedAtomicTaskFence(): void {
-    if CHPL_NETWORK_ATOMICS != "none" {
+    if CHPL_NETWORK_ATOMICS != "none" || CHPL_COMM == "gasnet" {
       extern proc chpl_comm_atomic_unordered_task_fence();
       chpl_comm_atomic_unordered_task_fence();
     }
@@ -45,13 +45,24 @@ module VisualDebug
   */
   config const VisualDebugOn = DefaultVisualDebugOn;
 
+  /*
+    If this is `true`, events are written in a compact binary format
+    instead of the text format read by :ref:`chplvis`.  Each thread
+    buffers fixed-size records in memory and a helper thread writes
+    them out, so tracing perturbs the program much less.  The
+    ``chplvis2json`` script in ``$CHPL_HOME/tools/chplvis`` converts
+    the binary files to Chrome trace-event JSON.
+  */
+  config const VisualDebugBinary = false;
+
   private extern proc chpl_now_time():real;
 
   //
   // Data Generation for the Visual Debug tool  (offline)
   //
 
-  private extern proc chpl_vdebug_start (rootname: c_string, time:real);
+  private extern proc chpl_vdebug_start (rootname: c_string, time:real,
+                                         binary: bool);
 
   private extern proc chpl_vdebug_stop ();
 
@@ -101,7 +112,8 @@ private proc VDebugTree (what: vis_op, name: string, time: real, tagno: int,
 
      /* Do the op at the root  */
      select what {
-         when vis_op.v_start    do chpl_vdebug_start (name.localize().c_str(), time);
+         when vis_op.v_start    do chpl_vdebug_start (name.localize().c_str(), time,
+                                                       VisualDebugBinary);
          when vis_op.v_stop     do chpl_vdebug_stop ();
          when vis_op.v_tag      do chpl_vdebug_tag (tagno);
          when vis_op.v_pause    do chpl_vdebug_pause (tagno);
@@ -257,8 +257,8 @@ module Barriers {
         const myc = count.fetchSub(1);
         if myc<=1 {
           if hackIntoCommBarrier {
-            extern proc chpl_comm_barrier(msg: c_string);
-            chpl_comm_barrier("local barrier call".localize().c_str());
+            extern proc chpl_comm_coll_barrier();
+            chpl_comm_coll_barrier();
           }
           const alreadySet = done.testAndSet();
           if boundsChecking && alreadySet {
@@ -137,6 +137,52 @@
   was executed on locale 0, and a remote get and a remote put were
   executed on locale 1.
 
+  **Remote Data Cache Statistics**
+
+  When a program is compiled with ``--cache-remote``, the remote data
+  cache can also count what it does: GETs it served, GETs it had to
+  pass on to the network, readahead, write-backs of dirty data,
+  evictions from each of its queues, and memory fences.  These counts
+  are kept separately from the communication counts above and are
+  collected in the same way::
+
+    resetCacheStats();
+    startCacheStats();
+    // between start/stop calls, count remote cache activity on any locale
+    stopCacheStats();
+    writeln(getCacheStats());
+
+  There are also ``Here`` versions of each call that only affect the
+  calling locale.  When the remote data cache is not in use all of the
+  counts are zero.
+
+  **Profiling Communication by Call Site**
+
+  Counts for the whole program often don't say where the communication
+  comes from, and on-the-fly reporting is too slow to leave on for a
+  real run.  Profiling is a middle ground: communication operations are
+  counted separately for each combination of source line, operation,
+  and destination locale, along with the bytes moved and the time spent
+  waiting for blocking GETs, PUTs, and on-statements to complete::
+
+    startCommProfile();
+    // between start/stop calls, profile comm ops initiated on any locale
+    stopCommProfile();
+    printCommProfile();
+
+  :proc:`printCommProfile` writes a report for each locale to
+  ``stdout``, with the busiest call sites first.  The whole of a run
+  can also be profiled without changing the program, by setting the
+  environment variable ``CHPL_RT_COMM_PROFILE`` when running it.  If it
+  is set to ``stdout``, each locale prints its report at exit.  If it is
+  set to anything else, it is taken to be a file name prefix, and each
+  locale writes its profile at exit as comma-separated values to a file
+  named ``<prefix>.<locale id>``.
+
+  Operations the remote data cache satisfies without communicating are
+  not counted.  The readahead GETs and write-back PUTs it starts on its
+  own behalf are counted, but not attributed to a call site.
+
   **Studying Communication During Module Initialization**
 
   It is hard for a programmer to determine exactly what happens during
@@ -257,6 +303,78 @@ module CommDiagnostics
    */
   type commDiagnostics = chpl_commDiagnostics;
 
+  /* Aggregated remote data cache statistics.  Like
+     `chpl_commDiagnostics`, this duplicates the definition in the
+     runtime.
+   */
+  extern record chpl_cacheStats {
+    /*
+      GETs satisfied entirely by the cache
+     */
+    var get_hits: uint(64);
+    /*
+      GETs spanning several cache pages, some of which were in the cache
+     */
+    var get_partial_hits: uint(64);
+    /*
+      GETs for which none of the data was in the cache
+     */
+    var get_misses: uint(64);
+    /*
+      cache pages prefetched or read ahead
+     */
+    var readaheads: uint(64);
+    /*
+      prefetched or read-ahead cache pages that a later GET used
+     */
+    var readahead_useful: uint(64);
+    /*
+      PUTs started to write dirty cached data back
+     */
+    var dirty_writebacks: uint(64);
+    /*
+      pages evicted from the Ain (first use) queue
+     */
+    var ain_evictions: uint(64);
+    /*
+      page records evicted from the Aout (recently evicted) queue
+     */
+    var aout_evictions: uint(64);
+    /*
+      pages evicted from the Am (reused) queue
+     */
+    var am_evictions: uint(64);
+    /*
+      acquire fences, which discard prefetched data
+     */
+    var acquire_fences: uint(64);
+    /*
+      release fences, which complete pending PUTs
+     */
+    var release_fences: uint(64);
+
+    proc writeThis(c) throws {
+      use Reflection;
+
+      var first = true;
+      c <~> "(";
+      for param i in 1..numFields(chpl_cacheStats) {
+        const val = getField(this, i);
+        if val != 0 {
+          if first then first = false; else c <~> ", ";
+          c <~> getFieldName(this.type, i) <~> " = " <~> val;
+        }
+      }
+      if first then c <~> "<no cache activity>";
+      c <~> ")";
+    }
+  };
+
+  /*
+    The Chapel record type inherits the runtime definition of it.
+   */
+  type cacheStats = chpl_cacheStats;
+
   private extern proc chpl_comm_startVerbose(print_unstable: bool);
 
   private extern proc chpl_comm_stopVerbose();
@@ -277,6 +395,30 @@ module CommDiagnostics
 
   private extern proc chpl_comm_getDiagnosticsHere(out cd: commDiagnostics);
 
+  private extern proc chpl_comm_startCacheStats();
+
+  private extern proc chpl_comm_stopCacheStats();
+
+  private extern proc chpl_comm_startCacheStatsHere();
+
+  private extern proc chpl_comm_stopCacheStatsHere();
+
+  private extern proc chpl_comm_resetCacheStatsHere();
+
+  private extern proc chpl_comm_getCacheStatsHere(out cs: cacheStats);
+
+  private extern proc chpl_comm_startProfile();
+
+  private extern proc chpl_comm_stopProfile();
+
+  private extern proc chpl_comm_startProfileHere();
+
+  private extern proc chpl_comm_stopProfileHere();
+
+  private extern proc chpl_comm_resetProfileHere();
+
+  private extern proc chpl_comm_printProfileHere();
+
   /*
     Start on-the-fly reporting of communication initiated on any locale.
    */
@@ -370,6 +512,117 @@ module CommDiagnostics
     return cd;
   }
 
+  /*
+    Start counting remote data cache activity across the whole program.
+   */
+  proc startCacheStats() { chpl_comm_startCacheStats(); }
+
+  /*
+    Stop counting remote data cache activity across the whole program.
+   */
+  proc stopCacheStats() { chpl_comm_stopCacheStats(); }
+
+  /*
+    Start counting remote data cache activity on this locale.
+   */
+  proc startCacheStatsHere() { chpl_comm_startCacheStatsHere(); }
+
+  /*
+    Stop counting remote data cache activity on this locale.
+   */
+  proc stopCacheStatsHere() { chpl_comm_stopCacheStatsHere(); }
+
+  /*
+    Reset remote data cache counts across the whole program.
+   */
+  proc resetCacheStats() {
+    for loc in Locales do on loc do
+      resetCacheStatsHere();
+  }
+
+  /*
+    Reset remote data cache counts on the calling locale.
+   */
+  inline proc resetCacheStatsHere() {
+    chpl_comm_resetCacheStatsHere();
+  }
+
+  /*
+    Retrieve remote data cache counts for the whole program.
+
+    :returns: array of remote data cache counts for each locale
+    :rtype: `[LocaleSpace] cacheStats`
+   */
+  proc getCacheStats() {
+    var D: [LocaleSpace] cacheStats;
+    for loc in Locales do on loc {
+      D(loc.id) = getCacheStatsHere();
+    }
+    return D;
+  }
+
+  /*
+    Retrieve remote data cache counts for this locale.
+
+    :returns: remote data cache counts for this locale
+    :rtype: `cacheStats`
+   */
+  proc getCacheStatsHere() {
+    var cs: cacheStats;
+    chpl_comm_getCacheStatsHere(cs);
+    return cs;
+  }
+
+  /*
+    Start profiling communication by call site across the whole program.
+   */
+  proc startCommProfile() { chpl_comm_startProfile(); }
+
+  /*
+    Stop profiling communication by call site across the whole program.
+   */
+  proc stopCommProfile() { chpl_comm_stopProfile(); }
+
+  /*
+    Start profiling communication initiated on this locale by call site.
+   */
+  proc startCommProfileHere() { chpl_comm_startProfileHere(); }
+
+  /*
+    Stop profiling communication initiated on this locale by call site.
+   */
+  proc stopCommProfileHere() { chpl_comm_stopProfileHere(); }
+
+  /*
+    Discard the communication profiles of all locales.
+   */
+  proc resetCommProfile() {
+    for loc in Locales do on loc do
+      resetCommProfileHere();
+  }
+
+  /*
+    Discard the communication profile of the calling locale.
+   */
+  inline proc resetCommProfileHere() {
+    chpl_comm_resetProfileHere();
+  }
+
+  /*
+    Print the communication profile of each locale in turn to ``stdout``.
+   */
+  proc printCommProfile() {
+    for loc in Locales do on loc do
+      printCommProfileHere();
+  }
+
+  /*
+    Print the communication profile of the calling locale to ``stdout``.
+   */
+  inline proc printCommProfileHere() {
+    chpl_comm_printProfileHere();
+  }
+
 
   /*
     If this is set, on-the-fly reporting of communication operations
@@ -661,6 +661,8 @@ extern const QIO_METHOD_FREADFWRITE:c_int;
 pragma "no doc"
 extern const QIO_METHOD_MMAP:c_int;
 pragma "no doc"
+extern const QIO_METHOD_ASYNC:c_int;
+pragma "no doc"
 extern const QIO_METHODMASK:c_int;
 pragma "no doc"
 extern const QIO_HINT_RANDOM:c_int;
@@ -708,6 +710,20 @@ const IOHINT_CACHED = QIO_HINT_CACHED;
  */
 const IOHINT_PARALLEL = QIO_HINT_PARALLEL;
 
+/*  IOHINT_ASYNC requests that reads and writes be submitted
+    asynchronously, through io_uring where the system supports it and
+    otherwise through a pool of I/O threads. The task doing the I/O
+    yields while it waits. Large transfers are split into several
+    requests that are in flight at once, and buffered channels read
+    ahead in large pieces so that there is more to overlap. Each read or
+    write still waits for all of its requests before it returns; none are
+    left in flight between calls. Only seekable files can use it;
+    other files ignore it. Setting ``CHPL_RT_QIO_ASYNC_URING=false``
+    skips io_uring, and ``CHPL_RT_QIO_ASYNC_THREADS`` sets the size of
+    the thread pool (4 by default).
+ */
+const IOHINT_ASYNC = QIO_METHOD_ASYNC;
+
 pragma "no doc"
 extern type qio_file_ptr_t;
 private extern const QIO_FILE_PTR_NULL:qio_file_ptr_t;
@@ -1075,6 +1091,8 @@ pragma "no doc"
 // A specialization is needed for _ddata as the value is the pointer its memory
 private extern proc qio_channel_write_amt(threadsafe:c_int, ch:qio_channel_ptr_t, const ptr:_ddata, len:ssize_t):syserr;
 private extern proc qio_channel_write_byte(threadsafe:c_int, ch:qio_channel_ptr_t, byte:uint(8)):syserr;
+private extern proc qio_channel_read_elts(threadsafe:c_int, ch:qio_channel_ptr_t, ptr:c_void_ptr, len:int(64), swap_size:c_int):syserr;
+private extern proc qio_channel_write_elts(threadsafe:c_int, ch:qio_channel_ptr_t, const ptr:c_void_ptr, len:int(64), swap_size:c_int):syserr;
 
 private extern proc qio_channel_offset_unlocked(ch:qio_channel_ptr_t):int(64);
 private extern proc qio_channel_advance(threadsafe:c_int, ch:qio_channel_ptr_t, nbytes:int(64)):syserr;
@@ -1333,6 +1351,8 @@ The following :type:`iohints` constants are provided:
     cached in memory, possibly all at once.
   * :const:`IOHINT_PARALLEL` suggests to expect many channels
     working with this file in parallel.
+  * :const:`IOHINT_ASYNC` requests asynchronous reads and writes that
+    yield the calling task rather than blocking its thread.
 
 
 Other hints might be added in the future.
@@ -1524,7 +1544,9 @@ Sync a file to disk.
 
 Commits file data to the device associated with this file.
 Data written to the file by a channel will be committed
-only if the channel has been closed or flushed.
+only if the channel has been closed or flushed.  Changes to
+arrays mapped from the file with :proc:`file.mmapArray` are
+written out first.
 
 This function will typically call the ``fsync`` system call.
 
@@ -2644,6 +2666,13 @@ proc file.reader(param kind=iokind.dynamic, param locking=true, start:int(64) =
 
 /* Iterate over all of the lines in a file.
 
+   The returned object can also be iterated over in a ``forall`` loop,
+   though not zippered with anything.  Parallel iteration splits the region
+   at byte offsets, finds the line boundaries near the split points, and
+   reads each piece through its own channel, on a locale that
+   :proc:`file.localesForRegion` reports is best for it.  Lines are not
+   yielded in order in that case.
+
    :returns: an object which yields strings read from the file
 
    :throws SystemError: Thrown if an ItemReader could not be returned.
@@ -2659,13 +2688,86 @@ proc file.lines(param locking:bool = true, start:int(64) = 0, end:int(64) = max(
   on this.home {
     try this.checkAssumingLocal();
     var ch = new channel(false, kind, locking, this, err, hints, start, end, local_style);
-    ret = new ItemReader(string, kind, locking, ch);
+    const f = this;
+    ret = new ItemReader(string, kind, locking, ch, f, start, end,
+                         hints, local_style, true);
   }
   if err then try ioerror(err, "in file.lines", this.tryGetPath());
 
   return ret;
 }
 
+private extern proc qio_file_mmap_array(f:qio_file_ptr_t, start:int(64),
+                                         len:int(64), writable:c_int,
+                                         hints:c_int, ref data:c_void_ptr,
+                                         ref freer:c_void_ptr):syserr;
+
+/*
+   Map a region of a file into memory and return it as an array of
+   ``eltType`` elements indexed from 0, without copying the data.  Reading
+   the array faults the file's pages in on demand, instead of copying
+   them through a channel's buffer.  The mapping is removed when the
+   array is destroyed.
+
+   With ``writable=true`` the array shares its memory with the file, so
+   stores to it change the file, which is extended if the region goes
+   past its end.  :proc:`file.fsync` writes such changes out to the
+   device.  Otherwise the array can still be written to, but the pages
+   written are copied first, and the changes are never seen in the file.
+
+   This must be called on the locale where the file was opened, and
+   the file must have been opened with a file descriptor, e.g. with
+   :proc:`open`.
+
+   :arg eltType: the type of the array elements, which must be a POD
+                 type (see :proc:`~Types.isPODType`)
+   :arg start: zero-based byte offset of the first element in the file,
+               which must be a multiple of the element size. Defaults to 0.
+   :arg numElts: the number of elements in the array. Defaults to as
+                 many as fit between ``start`` and the end of the file.
+   :arg writable: whether writes to the array change the file. The file
+                  must be open for writing.
+   :arg hints: :const:`IOHINT_RANDOM`, :const:`IOHINT_SEQUENTIAL`, and
+               :const:`IOHINT_CACHED` advise the operating system how the
+               array will be accessed; the last also reads the whole
+               region in up front where that is supported.
+   :returns: an array of ``numElts`` elements over the file data
+
+   :throws SystemError: Thrown if the region could not be mapped.
+ */
+pragma "no copy return"
+proc file.mmapArray(type eltType, start:int(64) = 0, numElts:int = -1,
+                    writable:bool = false,
+                    hints:iohints = IOHINT_NONE) throws {
+  use ExternalArray;
+
+  if !isPODType(eltType) then
+    compilerError("file.mmapArray requires a POD element type, not " +
+                  eltType:string);
+
+  const eltSize = c_sizeof(eltType):int(64);
+  try this.checkAssumingLocal();
+  if this.home != here then
+    try ioerror(EINVAL:syserr, "file.mmapArray called off the file's locale",
+                this.tryGetPath());
+  if start % eltSize != 0 then
+    try ioerror(EINVAL:syserr, "in file.mmapArray: start offset " + start:string +
+                " is not a multiple of the element size", this.tryGetPath());
+
+  var n = numElts:int(64);
+  if n < 0 then
+    n = max(0, this.length() - start) / eltSize;
+
+  var data, freer: c_void_ptr;
+  const err = qio_file_mmap_array(_file_internal, start, n * eltSize,
+                                  writable:c_int, hints, data, freer);
+  if err then try ioerror(err, "in file.mmapArray", this.tryGetPath(), start);
+
+  var ext = chpl_make_external_array_ptr(data, n:uint);
+  ext.freer = freer;
+  return makeArrayFromExternArray(ext, eltType, isBorrowed=false);
+}
+
 /*
    Create a :record:`channel` that supports writing to a file. See
    :ref:`about-io-overview`.
@@ -4193,6 +4295,22 @@ proc channel.readBytes(x, len:ssize_t) throws {
   if err then try this._ch_ioerror(err, "in channel.readBytes");
 }
 
+// Read or write len bytes of array element data starting at ptr,
+// converting to or from the channel's byte order by swapping each
+// swapSize-byte unit (0 or 1 means no swapping). Like readBytes, this
+// expects to be called on the channel's home with the channel locked.
+pragma "no doc"
+proc channel._readWriteElts(ptr:c_void_ptr, len:int(64), swapSize:int) throws {
+  if here != this.home then
+    throw new owned IllegalArgumentError("bad remote channel._readWriteElts");
+  var err:syserr = ENOERR;
+  if writing then
+    err = qio_channel_write_elts(false, _channel_internal, ptr, len, swapSize:c_int);
+  else
+    err = qio_channel_read_elts(false, _channel_internal, ptr, len, swapSize:c_int);
+  if err then try this._ch_ioerror(err, "in channel._readWriteElts");
+}
+
 /*
 proc channel.modifyStyle(f:func(iostyle, iostyle))
 {
@@ -4219,6 +4337,22 @@ record ItemReader {
   param locking:bool;
   /* our channel */
   var ch:channel(false,kind,locking);
+
+  // When created by file.lines(), the file and the region of it that
+  // ch reads, so that parallel iteration can open its own channels.
+  pragma "no doc"
+  var _file:file;
+  pragma "no doc"
+  var _start:int(64);
+  pragma "no doc"
+  var _end:int(64);
+  pragma "no doc"
+  var _hints:iohints;
+  pragma "no doc"
+  var _style:iostyle;
+  pragma "no doc"
+  var _fromFile:bool;
+
   /* read a single item, throwing on error */
   proc read(out arg:ItemType):bool throws {
     return ch.read(arg);
@@ -4236,6 +4370,117 @@ record ItemReader {
       yield x;
     }
   }
+
+  //
+  // Parallel iteration over the lines of a file splits the region
+  // being read into chunks of bytes.  A line belongs to the chunk in
+  // which it starts, so each chunk after the first skips the line in
+  // progress at its start and then reads lines until one starts past
+  // its end.  Each chunk is read through its own channel, on one of
+  // the locales that file.localesForRegion() says is best for it.
+  //
+  // There is no leader/follower pair: the chunks are split at line
+  // boundaries, so no other iterand could follow them, nor could the
+  // lines follow another leader's indices.
+  //
+  pragma "no doc"
+  iter these(param tag: iterKind) where tag == iterKind.standalone &&
+                                        ItemType == string {
+    if !_fromFile {
+      for x in these() do yield x;
+    } else {
+      const chunks = _lineChunks();
+      coforall i in chunks.domain do on _lineChunkLocale(chunks[i], i) {
+        for x in _linesInChunk(chunks[i]) do yield x;
+      }
+    }
+  }
+
+  // Split the region into chunks of at least minChunk bytes, enough
+  // of them to give each of our tasks on each locale that is best for
+  // the region one.
+  pragma "no doc"
+  proc _lineChunks() {
+    const minChunk = 64 * 1024;
+    var fileLen:int(64);
+    try {
+      fileLen = _file.length();
+    } catch e {
+      _linesError(e);
+    }
+    const len = min(_end, fileLen) - _start;
+    const numLocs = _lineLocales(_start, _start + len).size;
+    const numTasks = if dataParTasksPerLocale == 0 then here.maxTaskPar
+                     else dataParTasksPerLocale;
+    const numChunks = max(1, min(numLocs * numTasks, len / minChunk));
+    var chunks: [0..#numChunks] range(int(64));
+    for i in 0..#numChunks {
+      const lo = _start + len * i / numChunks;
+      const hi = _start + len * (i + 1) / numChunks;
+      chunks[i] = lo..hi-1;
+    }
+    return chunks;
+  }
+
+  // The locales best for a region, or just the file's home locale
+  // if the file system doesn't say (it returns all the locales).
+  pragma "no doc"
+  proc _lineLocales(start:int(64), end:int(64)) {
+    var locs = _file.localesForRegion(start, end);
+    if locs.size == numLocales {
+      locs.clear();
+      locs += _file.home;
+    }
+    return locs;
+  }
+
+  // Spread chunks round-robin over the locales best for each one.
+  pragma "no doc"
+  proc _lineChunkLocale(chunk: range(int(64)), i: int): locale {
+    const locs = _lineLocales(chunk.low, chunk.high + 1);
+    var k = i % locs.size;
+    for loc in locs {
+      if k == 0 then return loc;
+      k -= 1;
+    }
+    return _file.home;
+  }
+
+  // Yield the lines that start in the given chunk of the region.
+  // A channel lives on its file's home locale, so when the chunk is
+  // being read somewhere else, open the file again by path here.
+  // This only happens when file.localesForRegion() named other
+  // locales, which it does for file systems that they all share.
+  pragma "no doc"
+  iter _linesInChunk(chunk: range(int(64))) {
+    try {
+      var f = _file;
+      if here != _file.home then
+        f = open(_file.path, iomode.r, _hints, _style);
+      const startAt = if chunk.low > _start then chunk.low - 1 else chunk.low;
+      var r = f.reader(kind, locking=false, start=startAt, end=_end,
+                       hints=_hints, style=_style);
+      var line:string;
+
+      // The line in progress before the chunk belongs to the chunk before.
+      if chunk.low > _start then r.read(line);
+
+      while r.offset() <= chunk.high {
+        if ! r.read(line) then break;
+        yield line;
+      }
+      r.close();
+    } catch e {
+      _linesError(e);
+    }
+  }
+
+  // Like these(), the parallel iterators cannot throw, so they report
+  // errors here.
+  pragma "no doc"
+  proc _linesError(e: borrowed Error) {
+    halt("error reading lines of ", _file.tryGetPath(), ": ", e.message());
+  }
 }
 
 /* Create and return an :record:`ItemReader` that can yield read values of
@@ -4434,7 +4679,7 @@ proc file.localesForRegion(start:int(64), end:int(64)) {
 
   proc findloc(loc:string, locs:c_ptr(c_string), end:int) {
     for i in 0..end-1 {
-      if (loc == locs[i]) then
+      if loc == locs[i]:string then
         return true;
     }
     return false;
@@ -29,24 +29,7 @@
 module Map {
   private use ChapelLocks only;
   private use HaltWrappers;
-
-  // Lock code lifted from modules/standard/Lists.chpl.
-  // Maybe they should be combined into a Locks module.
-  pragma "no doc"
-  type _lockType = ChapelLocks.chpl_LocalSpinlock;
-
-  pragma "no doc"
-  class _LockWrapper {
-    var lock$ = new _lockType();
-
-    inline proc lock() {
-      lock$.lock();
-    }
-
-    inline proc unlock() {
-      lock$.unlock();
-    }
-  }
+  private use ChapelHashtable;
 
   private use IO;
 
@@ -54,23 +37,43 @@ module Map {
     type keyType, valType;
     param parSafe = false;
 
-    var myKeys: domain(keyType, parSafe=parSafe);
-    var vals: [myKeys] valType;
+    // Keys are spread over several tables when the map is parallel safe,
+    // each with its own lock.
+    pragma "no doc"
+    var _shards: chpl__hashtableNumShards(parSafe)*chpl__hashtable(keyType,
+                                                                   valType);
 
+    pragma "no doc"
+    var _lock$ = if parSafe then new chpl__hashtableLocks(chpl__hashtableNumShards(parSafe))
+                 else none;
 
     pragma "no doc"
-    var _lock$ = if parSafe then new _LockWrapper() else none;
+    inline proc _enter(shard: int) {
+      if parSafe then
+        _lock$.lock(shard);
+    }
+
+    pragma "no doc"
+    inline proc _leave(shard: int) {
+      if parSafe then
+        _lock$.unlock(shard);
+    }
 
     pragma "no doc"
-    inline proc _enter() {
+    inline proc _enterAll() {
       if parSafe then
-        _lock$.lock();
+        _lock$.lockAll();
     }
 
     pragma "no doc"
-    inline proc _leave() {
+    inline proc _leaveAll() {
       if parSafe then
-        _lock$.unlock();
+        _lock$.unlockAll();
+    }
+
+    pragma "no doc"
+    inline proc _shardFor(hash: uint): int {
+      return chpl__hashtableShard(hash, _shards.size);
     }
 
     /*
@@ -100,13 +103,7 @@ module Map {
       this.keyType = kt;
       this.valType = vt;
       this.parSafe = ps;
-
-      this.complete();
-
-      for key in other {
-        myKeys += key;
-        vals[key] = other.vals[key];
-      }
+      this._shards = other._shards;
     }
 
     /*
@@ -118,18 +115,19 @@ module Map {
         references to the elements contained in this map.
     */
     proc clear() {
-      _enter();
-      myKeys.clear();
-      _leave();
+      _enterAll();
+      for shard in 1.._shards.size do
+        _shards[shard].clear();
+      _leaveAll();
     }
 
     /*
       The current number of keys contained in this map.
     */
     inline proc const size {
-      _enter();
-      var result = myKeys.size;
-      _leave();
+      _enterAll();
+      var result = _size();
+      _leaveAll();
       return result;
     }
 
@@ -154,9 +152,11 @@ module Map {
       :rtype: `bool`
     */
     proc const contains(const k: keyType): bool {
-      _enter();
-      var result = myKeys.contains(k);
-      _leave();
+      const hash = chpl__hashtableHash(k);
+      const shard = _shardFor(hash);
+      _enter(shard);
+      const (result, _) = _shards[shard].findFullSlot(k, hash);
+      _leave(shard);
       return result;
     }
 
@@ -168,13 +168,24 @@ module Map {
       :type m: map(keyType, valType)
     */
     proc update(const ref m: map(keyType, valType, parSafe)) {
-      _enter();
-      for key in m {
-        if !myKeys.contains(key) then
-          myKeys += key;
-        vals[key] = m.vals[key];
+      for (shard, slot) in chpl__shardedSlots(m._shards) {
+        ref entry = m._shards[shard].table[slot];
+        _addOrSet(entry.key, entry.val);
       }
-      _leave();
+    }
+
+    pragma "no doc"
+    proc _addOrSet(k: keyType, v: valType) {
+      const hash = chpl__hashtableHash(k);
+      const shard = _shardFor(hash);
+      _enter(shard);
+      ref tab = _shards[shard];
+      const (found, slot) = tab.findAvailableSlot(k, hash);
+      if found then
+        tab.table[slot].val = v;
+      else
+        tab.fillSlot(slot, k, v);
+      _leave(shard);
     }
 
     /*
@@ -186,34 +197,36 @@ module Map {
 
       :returns: Reference to the value mapped to the given key.
     */
+    // "unsafe" turns off nilability and lifetime checking here.  That is
+    // what lets 'val' below be declared without an initializer when
+    // valType is a non-nilable class: such a value starts out nil, just
+    // as the elements of the array that used to hold the values did.
+    pragma "unsafe"
     proc this(k: keyType) ref {
-      _enter();
-      var (found, slotNum) = myKeys._value._findFilledSlot(k, needLock=false);
-
-      if found {
-        ref result = vals._value.data[slotNum];
-        _leave();
-        return result;
-      } else if slotNum != -1 {
-        const (newSlot, _) = myKeys._value._addWrapper(k, slotNum, needLock=false);
-        ref result = vals._value.data[newSlot];
-        _leave();
-        return result;
-      } else {
-        boundsCheckHalt("map index out of bounds: " + k:string);
-        ref result = vals._value.data[0];
-        _leave();
-        return result;
+      const hash = chpl__hashtableHash(k);
+      const shard = _shardFor(hash);
+      _enter(shard);
+      ref tab = _shards[shard];
+      const (found, slot) = tab.findAvailableSlot(k, hash);
+      if !found {
+        var val: valType;
+        tab.fillSlot(slot, k, val);
       }
+      ref result = tab.table[slot].val;
+      _leave(shard);
+      return result;
     }
 
     pragma "no doc"
     proc const this(k: keyType) const {
-      _enter();
-      if !myKeys.contains(k) then
+      const hash = chpl__hashtableHash(k);
+      const shard = _shardFor(hash);
+      _enter(shard);
+      const (found, slot) = _shards[shard].findFullSlot(k, hash);
+      if !found then
         boundsCheckHalt("map index " + k:string + " out of bounds");
-      const result = vals[k];
-      _leave();
+      const result = _shards[shard].table[slot].val;
+      _leave(shard);
       return result;
     }
 
@@ -228,14 +241,28 @@ module Map {
       }
     }
 
+    pragma "no doc"
+    iter these(param tag) const ref where tag == iterKind.standalone {
+      forall key in this.keys() {
+        yield key;
+      }
+    }
+
     /*
       Iterates over the keys of this map.
 
       :yields: A reference to one of the keys contained in this map.
     */
     iter keys() const ref {
-      for key in myKeys {
-        yield key;
+      for (shard, slot) in chpl__shardedSlots(_shards) {
+        yield _shards[shard].table[slot].key;
+      }
+    }
+
+    pragma "no doc"
+    iter keys(param tag) const ref where tag == iterKind.standalone {
+      forall (shard, slot) in chpl__shardedSlots(_shards) {
+        yield _shards[shard].table[slot].key;
       }
     }
 
@@ -246,8 +273,17 @@ module Map {
                this map.
     */
     iter items() const ref {
-      for key in myKeys {
-        yield (key, vals[key]);
+      for (shard, slot) in chpl__shardedSlots(_shards) {
+        ref entry = _shards[shard].table[slot];
+        yield (entry.key, entry.val);
+      }
+    }
+
+    pragma "no doc"
+    iter items(param tag) const ref where tag == iterKind.standalone {
+      forall (shard, slot) in chpl__shardedSlots(_shards) {
+        ref entry = _shards[shard].table[slot];
+        yield (entry.key, entry.val);
       }
     }
 
@@ -257,8 +293,15 @@ module Map {
       :yields: A reference to one of the values contained in this map.
     */
     iter values() ref {
-      for val in vals {
-        yield val;
+      for (shard, slot) in chpl__shardedSlots(_shards) {
+        yield _shards[shard].table[slot].val;
+      }
+    }
+
+    pragma "no doc"
+    iter values(param tag) ref where tag == iterKind.standalone {
+      forall (shard, slot) in chpl__shardedSlots(_shards) {
+        yield _shards[shard].table[slot].val;
       }
     }
 
@@ -272,21 +315,22 @@ module Map {
       :arg ch: A channel to write to.
     */
     proc readWriteThis(ch: channel) throws {
-      _enter();
+      _enterAll();
       var first = true;
       //try! {
         ch <~> "{";
-        for key in myKeys {
+        for (shard, slot) in chpl__shardedSlots(_shards) {
+          ref entry = _shards[shard].table[slot];
           if first {
             first = false;
           } else {
             ch <~> ", ";
           }
-          ch <~> key <~> ": " <~> vals[key];
+          ch <~> entry.key <~> ": " <~> entry.val;
         }
         ch <~> "}";
       //}
-      _leave();
+      _leaveAll();
     }
 
     /*
@@ -304,17 +348,61 @@ module Map {
      :rtype: bool
     */
     proc add(k: keyType, v: valType): bool {
-      _enter();
-      if myKeys.contains(k) {
-        _leave();
-        return false;
+      const hash = chpl__hashtableHash(k);
+      const shard = _shardFor(hash);
+      _enter(shard);
+      ref tab = _shards[shard];
+      const (found, slot) = tab.findAvailableSlot(k, hash);
+      if !found then
+        tab.fillSlot(slot, k, v);
+      _leave(shard);
+      return !found;
+    }
+
+    /*
+      Adds each key in `keys` to the map, mapped to the value at the same
+      position in `vals`.  Keys that are already in the map keep their
+      current value.  Room for all the keys is made up front, and they are
+      added in parallel if the map is parallel safe.
+
+      :arg keys: The keys to add to the map
+      :type keys: [] keyType
+
+      :arg vals: The values that map to each of ``keys``
+      :type vals: [] valType
+    */
+    proc ref addAll(const ref keys: [] keyType, const ref vals: [] valType) {
+      if keys.size != vals.size then
+        halt("map.addAll() called with ", keys.size, " keys and ",
+             vals.size, " values");
+
+      requestCapacity(size + keys.size);
+      if parSafe {
+        // 'this' cannot have a forall intent, so go through a reference
+        ref self = this;
+        forall (k, v) in zip(keys, vals) with (ref self) do
+          self.add(k, v);
+      } else {
+        for (k, v) in zip(keys, vals) do
+          add(k, v);
       }
+    }
 
-      myKeys += k;
-      vals[k] = v;
+    /*
+      Makes room for this map to hold at least `numKeys` keys, so that
+      adding up to that many keys does not need to grow it.
 
-      _leave();
-      return true;
+      :arg numKeys: The number of keys to make room for
+      :type numKeys: int
+    */
+    proc requestCapacity(numKeys: int) {
+      // keys are spread evenly over the shards, give or take a few
+      const perShard = (numKeys + _shards.size - 1) / _shards.size;
+      const slack = if _shards.size == 1 then 0 else perShard / 8 + 1;
+      _enterAll();
+      for shard in 1.._shards.size do
+        _shards[shard].requestCapacity(perShard + slack);
+      _leaveAll();
     }
 
     /*
@@ -332,16 +420,15 @@ module Map {
      :rtype: bool
     */
     proc set(k: keyType, v: valType): bool {
-      _enter();
-      if !myKeys.contains(k) {
-        _leave();
-        return false;
-      }
-
-      vals[k] = v;
-
-      _leave();
-      return true;
+      const hash = chpl__hashtableHash(k);
+      const shard = _shardFor(hash);
+      _enter(shard);
+      ref tab = _shards[shard];
+      const (found, slot) = tab.findFullSlot(k, hash);
+      if found then
+        tab.table[slot].val = v;
+      _leave(shard);
+      return found;
     }
 
     /*
@@ -354,14 +441,17 @@ module Map {
      :rtype: bool
     */
     proc remove(k: keyType): bool {
-      _enter();
-      if !myKeys.contains(k) {
-        _leave();
-        return false;
+      const hash = chpl__hashtableHash(k);
+      const shard = _shardFor(hash);
+      _enter(shard);
+      ref tab = _shards[shard];
+      const (found, slot) = tab.findFullSlot(k, hash);
+      if found {
+        tab.clearSlot(slot);
+        tab.maybeShrinkAfterRemove();
       }
-      myKeys -= k;
-      _leave();
-      return true;
+      _leave(shard);
+      return found;
     }
 
     /*
@@ -372,12 +462,13 @@ module Map {
       :rtype: [] (keyType, valType)
     */
     proc toArray(): [] (keyType, valType) {
-      _enter();
-      var A: [1..myKeys.size] (keyType, valType);
-      for (a, key) in zip(A, myKeys) {
-        a = (key, vals[key]);
+      _enterAll();
+      var A: [1.._size()] (keyType, valType);
+      for (a, (shard, slot)) in zip(A, chpl__shardedSlots(_shards)) {
+        ref entry = _shards[shard].table[slot];
+        a = (entry.key, entry.val);
       }
-      _leave();
+      _leaveAll();
       return A;
     }
 
@@ -389,12 +480,12 @@ module Map {
       :rtype: [] keyType
     */
     proc keysToArray(): [] keyType {
-      _enter();
-      var A: [1..myKeys.size] keyType;
-      for (a, k) in zip(A, myKeys) {
-        a = k;
+      _enterAll();
+      var A: [1.._size()] keyType;
+      for (a, (shard, slot)) in zip(A, chpl__shardedSlots(_shards)) {
+        a = _shards[shard].table[slot].key;
       }
-      _leave();
+      _leaveAll();
       return A;
     }
 
@@ -406,14 +497,23 @@ module Map {
       :rtype: [] valType
     */
     proc valuesToArray(): [] valType {
-      _enter();
-      var A: [1..vals.size] valType;
-      for (a, v) in zip(A, vals) {
-        a = v;
+      _enterAll();
+      var A: [1.._size()] valType;
+      for (a, (shard, slot)) in zip(A, chpl__shardedSlots(_shards)) {
+        a = _shards[shard].table[slot].val;
       }
-      _leave();
+      _leaveAll();
       return A;
     }
+
+    // The number of keys, for callers already holding every lock
+    pragma "no doc"
+    proc const _size() {
+      var result = 0;
+      for shard in 1.._shards.size do
+        result += _shards[shard].tableNumFullSlots;
+      return result;
+    }
   } // end record map
 
   /*
@@ -430,8 +530,8 @@ module Map {
   proc =(ref lhs: map(?kt, ?vt, ?ps), const ref rhs: map(kt, vt, ps)){
     lhs.clear();
 
-    for key in rhs.myKeys {
-      lhs.add(key, rhs.vals[key]);
+    for (key, val) in rhs.items() {
+      lhs.add(key, val);
     }
   }
 
@@ -449,12 +549,12 @@ module Map {
     :rtype: `bool`
   */
   proc ==(const ref a: map(?kt, ?vt, ?ps), const ref b: map(kt, vt, ps)): bool {
-    for key in a {
-      if !b.contains(key) || a.vals[key] != b.vals[key] then
+    for (key, val) in a.items() {
+      if !b.contains(key) || val != b[key] then
         return false;
     }
-    for key in b {
-      if !a.contains(key) || a.vals[key] != b.vals[key] then
+    for (key, val) in b.items() {
+      if !a.contains(key) || a[key] != val then
         return false;
     }
     return true;
@@ -495,10 +595,9 @@ module Map {
   proc |(a: map(?keyType, ?valueType, ?parSafe),
          b: map(keyType, valueType, parSafe)) {
     var newMap = new map(keyType, valueType, parSafe);
-    newMap.myKeys = a.myKeys | b.myKeys;
 
-    for k in b do newMap[k] = b.vals[k];
-    for k in a do newMap[k] = a.vals[k];
+    for (k, v) in b.items() do newMap[k] = v;
+    for (k, v) in a.items() do newMap[k] = v;
     return newMap;
   }
 
@@ -508,16 +607,16 @@ module Map {
   proc |=(ref a: map(?keyType, ?valueType, ?parSafe),
           b: map(keyType, valueType, parSafe)) {
     // add keys/values from b to a if they weren't already in a
-    for k in b do a.add(k, b.vals[k]);
+    for (k, v) in b.items() do a.add(k, v);
   }
 
   /* Returns a new map containing the keys that are in both a and b. */
   proc &(a: map(?keyType, ?valueType, ?parSafe),
          b: map(keyType, valueType, parSafe)) {
     var newMap = new map(keyType, valueType, parSafe);
-    newMap.myKeys = a.myKeys & b.myKeys;
 
-    for k in newMap do newMap[k] = a.vals[k];
+    for (k, v) in a.items() do
+      if b.contains(k) then newMap.add(k, v);
     return newMap;
   }
 
@@ -525,7 +624,8 @@ module Map {
    */
   proc &=(ref a: map(?keyType, ?valueType, ?parSafe),
           b: map(keyType, valueType, parSafe)) {
-    for k in a {
+    // removing keys can resize the map, so don't iterate over it directly
+    for k in a.keysToArray() {
       if !b.contains(k) then a.remove(k);
     }
   }
@@ -534,9 +634,9 @@ module Map {
   proc -(a: map(?keyType, ?valueType, ?parSafe),
          b: map(keyType, valueType, parSafe)) {
     var newMap = new map(keyType, valueType, parSafe);
-    newMap.myKeys = a.myKeys - b.myKeys;
 
-    for k in newMap do newMap[k] = a.vals[k];
+    for (k, v) in a.items() do
+      if !b.contains(k) then newMap.add(k, v);
 
     return newMap;
   }
@@ -545,7 +645,7 @@ module Map {
      left-hand map, but not the right-hand map. */
   proc -=(ref a: map(?keyType, ?valueType, ?parSafe),
           b: map(keyType, valueType, parSafe)) {
-    for k in a do
+    for k in a.keysToArray() do
       if b.contains(k) then a.remove(k);
   }
 
@@ -554,12 +654,11 @@ module Map {
   proc ^(a: map(?keyType, ?valueType, ?parSafe),
          b: map(keyType, valueType, parSafe)) {
     var newMap = new map(keyType, valueType, parSafe);
-    newMap.myKeys = a.myKeys ^ b.myKeys;
 
-    for k in a do
-      if !b.contains(k) then newMap[k] = a.vals[k];
-    for k in b do
-      if !a.contains(k) then newMap[k] = b.vals[k];
+    for (k, v) in a.items() do
+      if !b.contains(k) then newMap.add(k, v);
+    for (k, v) in b.items() do
+      if !a.contains(k) then newMap.add(k, v);
     return newMap;
   }
 
@@ -569,7 +668,7 @@ module Map {
           b: map(keyType, valueType, parSafe)) {
     for k in b {
       if a.contains(k) then a.remove(k);
-      else a[k] = b.vals[k];
+      else a[k] = b[k];
     }
   }
 }
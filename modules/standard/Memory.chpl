@@ -86,6 +86,18 @@
     In multilocale executions each top-level locale produces output
     to its own file, with a dot ('.') and the locale ID appended to
     this path.
+
+  Heap profiling is separate from memory tracking, and cheap enough to
+  leave on in long-running jobs.  It is enabled by this config
+  variable:
+
+  ``memProfileInterval``: `uint`:
+    If this is set to a value greater than 0 (zero), sample about one
+    allocation per this many bytes allocated, and attribute the
+    samples to the allocation type and source line of the request.
+    The profile is reported by :proc:`printMemProfile`.  It does not
+    enable memory tracking, and setting it does not make the other
+    procedures here usable.
  */
 module Memory {
 
@@ -200,6 +212,26 @@ proc printMemAllocStats() {
   chpl_printMemAllocStats();
 }
 
+/*
+  Print the sampled heap profile of the calling locale to ``memLog``.
+  This requires ``memProfileInterval`` to be set.  The report contains
+  a table of entries, one for each allocation type and source line at
+  which sampled allocations were requested, with the busiest first.
+  Each entry shows estimates of the number of bytes and allocations
+  there, scaled up from the samples.
+
+  :arg cumulative: If `false`, the default, report only the memory
+    that is still allocated.  If `true`, report everything allocated
+    so far, including memory that has since been freed.
+  :type cumulative: `bool`
+*/
+proc printMemProfile(cumulative: bool = false) {
+  pragma "insert line file info"
+  extern proc chpl_printMemProfile(cumulative: bool);
+
+  chpl_printMemProfile(cumulative);
+}
+
 /*
   Start on-the-fly reporting of memory allocations and deallocations
   done on any locale.  Continue reporting until :proc:`stopVerboseMem`
@@ -42,6 +42,7 @@ module Set {
   // "iterable" argument has a method named "these".
   //
   private use ChapelLocks only;
+  private use ChapelHashtable;
   private use IO;
   private use Reflection;
 
@@ -57,31 +58,6 @@ module Set {
       assert(expr);
   }
 
-  //
-  // We can change the lock type later. Use a spinlock for now, even if it
-  // is suboptimal in cases where long critical sections have high
-  // contention.
-  //
-  pragma "no doc"
-  type _lockType = ChapelLocks.chpl_LocalSpinlock;
-
-  //
-  // Use a wrapper class to let set methods have a const ref receiver even
-  // when `parSafe` is `true` and the set lock is used.
-  //
-  pragma "no doc"
-  class _LockWrapper {
-    var lock$ = new _lockType();
-
-    inline proc lock() {
-      lock$.lock();
-    }
-
-    inline proc unlock() {
-      lock$.unlock();
-    }
-  }
-
   /*
     A set is a collection of unique elements. Attempting to add a duplicate
     element to a set has no effect.
@@ -112,11 +88,18 @@ module Set {
     /* If `true`, this set will perform parallel safe operations. */
     param parSafe = false;
 
+    //
+    // Elements are spread over several tables when the set is parallel
+    // safe, each with its own lock.  The locks live in a class to let set
+    // methods have a const ref receiver.
+    //
     pragma "no doc"
-    var _lock$ = if parSafe then new _LockWrapper() else none;
+    var _shards: chpl__hashtableNumShards(parSafe)*chpl__hashtable(eltType,
+                                                                   nothing);
 
     pragma "no doc"
-    var _dom: domain(eltType, parSafe);
+    var _lock$ = if parSafe then new chpl__hashtableLocks(chpl__hashtableNumShards(parSafe))
+                 else none;
 
     /*
       Initializes an empty set containing elements of the given type.
@@ -145,7 +128,7 @@ module Set {
       this.complete();
 
       for x in iterable do
-        _dom.add(x);
+        _add(x);
     }
 
     /*
@@ -158,12 +141,7 @@ module Set {
     proc init=(const ref other: set(?t, ?)) {
       this.eltType = t;
       this.parSafe = other.parSafe;
-      this.complete();
-
-      for x in other {
-        var cpy = x;
-        _dom.add(cpy);
-      }
+      this._shards = other._shards;
     }
 
     pragma "no doc"
@@ -172,21 +150,64 @@ module Set {
     }
 
     pragma "no doc"
-    inline proc _enter() {
+    inline proc _enter(shard: int) {
+      if parSafe then
+        on this {
+          _lock$.lock(shard);
+        }
+    }
+
+    pragma "no doc"
+    inline proc _leave(shard: int) {
       if parSafe then
         on this {
-          _lock$.lock();
+          _lock$.unlock(shard);
         }
     }
 
     pragma "no doc"
-    inline proc _leave() {
+    inline proc _enterAll() {
       if parSafe then
         on this {
-          _lock$.unlock();
+          _lock$.lockAll();
         }
     }
 
+    pragma "no doc"
+    inline proc _leaveAll() {
+      if parSafe then
+        on this {
+          _lock$.unlockAll();
+        }
+    }
+
+    pragma "no doc"
+    inline proc _shardFor(hash: uint): int {
+      return chpl__hashtableShard(hash, _shards.size);
+    }
+
+    // Adds 'x' to its shard, locking just that shard
+    pragma "no doc"
+    proc _add(const ref x: eltType) {
+      const hash = chpl__hashtableHash(x);
+      const shard = _shardFor(hash);
+      _enter(shard);
+      ref tab = _shards[shard];
+      const (found, slot) = tab.findAvailableSlot(x, hash);
+      if !found then
+        tab.fillSlot(slot, x, none);
+      _leave(shard);
+    }
+
+    // The number of elements, for callers already holding every lock
+    pragma "no doc"
+    proc const _size() {
+      var result = 0;
+      for shard in 1.._shards.size do
+        result += _shards[shard].tableNumFullSlots;
+      return result;
+    }
+
     /*
       Add a copy of the element `x` to this set. Does nothing if this set
       already contains an element equal to the value of `x`.
@@ -195,9 +216,47 @@ module Set {
     */
     proc add(in x: eltType) {
       on this {
-        _enter();
-        _dom.add(x);
-        _leave();
+        _add(x);
+      }
+    }
+
+    /*
+      Add a copy of each element of the array `xs` to this set.  Room for
+      all the elements is made up front, and they are added in parallel if
+      this set is parallel safe.
+
+      :arg xs: The elements to add to this set.
+    */
+    proc ref addAll(const ref xs: [] eltType) {
+      on this {
+        requestCapacity(size + xs.size);
+        if parSafe {
+          // 'this' cannot have a forall intent, so go through a reference
+          ref self = this;
+          forall x in xs with (ref self) do
+            self._add(x);
+        } else {
+          for x in xs do
+            _add(x);
+        }
+      }
+    }
+
+    /*
+      Make room for this set to hold at least `numElements` elements, so
+      that adding up to that many elements does not need to grow it.
+
+      :arg numElements: The number of elements to make room for.
+    */
+    proc requestCapacity(numElements: int) {
+      // elements are spread evenly over the shards, give or take a few
+      const perShard = (numElements + _shards.size - 1) / _shards.size;
+      const slack = if _shards.size == 1 then 0 else perShard / 8 + 1;
+      on this {
+        _enterAll();
+        for shard in 1.._shards.size do
+          _shards[shard].requestCapacity(perShard + slack);
+        _leaveAll();
       }
     }
 
@@ -213,9 +272,11 @@ module Set {
       var result = false;
     
       on this {
-        _enter();
-        result = _dom.contains(x);
-        _leave();
+        const hash = chpl__hashtableHash(x);
+        const shard = _shardFor(hash);
+        _enter(shard);
+        (result, _) = _shards[shard].findFullSlot(x, hash);
+        _leave(shard);
       }
 
       return result;
@@ -233,8 +294,6 @@ module Set {
       var result = true;
 
       on this {
-        _enter();
-
         if !(size == 0 || other.size == 0) {
 
           //
@@ -243,16 +302,15 @@ module Set {
           // undefined behavior. This means that when a container is being
           // iterated over by at least one thread, it is considered to be in a
           // "read only" state. This may only be a temporary assumption, but
-          // for now it means we only need to grab the lock on `this`.
+          // for now it means we only need to grab the locks on `this`,
+          // which `contains` does one shard at a time.
           //
           for x in other do
-            if _dom.contains(x) {
+            if contains(x) {
               result = false;
               break;
             }
         }
-        
-        _leave();
       }
 
       return result;
@@ -288,14 +346,17 @@ module Set {
       var result = false;
 
       on this {
-        _enter();
-
-        if _dom.contains(x) {
-          _dom.remove(x);
+        const hash = chpl__hashtableHash(x);
+        const shard = _shardFor(hash);
+        _enter(shard);
+        ref tab = _shards[shard];
+        const (found, slot) = tab.findFullSlot(x, hash);
+        if found {
+          tab.clearSlot(slot);
+          tab.maybeShrinkAfterRemove();
           result = true;
         }
-
-        _leave();
+        _leave(shard);
       }
 
       return result;
@@ -311,9 +372,10 @@ module Set {
     */
     proc clear() {
       on this {
-        _enter();
-        _dom.clear();
-        _leave();
+        _enterAll();
+        for shard in 1.._shards.size do
+          _shards[shard].clear();
+        _leaveAll();
       }
     }
 
@@ -329,26 +391,26 @@ module Set {
       :yields: A reference to one of the elements contained in this set.
     */
     iter these() {
-      for x in _dom.these() do
-        yield x;
+      for (shard, slot) in chpl__shardedSlots(_shards) do
+        yield _shards[shard].table[slot].key;
     }
 
     pragma "no doc"
     iter these(param tag) where tag == iterKind.standalone {
-      for x in _dom.these(tag) do
-        yield x;
+      forall (shard, slot) in chpl__shardedSlots(_shards) do
+        yield _shards[shard].table[slot].key;
     }
 
     pragma "no doc"
     iter these(param tag) where tag == iterKind.leader {
-      for followThis in _dom.these(tag) do
+      for followThis in chpl__shardedSlots(_shards, tag) do
         yield followThis;
     }
 
     pragma "no doc"
     iter these(param tag, followThis) where tag == iterKind.follower {
-      for x in _dom.these(tag, followThis) do
-        yield x;
+      for (shard, slot) in chpl__shardedSlots(_shards, tag, followThis) do
+        yield _shards[shard].table[slot].key;
     }
 
     /*
@@ -358,12 +420,14 @@ module Set {
     */
     proc const writeThis(ch: channel) throws {
       on this {
-        _enter();
+        _enterAll();
         var count = 1;
+        const size = _size();
         ch <~> "{";
 
-        for x in _dom {
-          if count <= (_dom.size - 1) {
+        for (shard, slot) in chpl__shardedSlots(_shards) {
+          const ref x = _shards[shard].table[slot].key;
+          if count <= (size - 1) {
             count += 1;
             ch <~> x <~> ", ";
           } else {
@@ -372,7 +436,7 @@ module Set {
         }
 
         ch <~> "}";
-        _leave();
+        _leaveAll();
       }
     }
 
@@ -386,9 +450,9 @@ module Set {
       var result = false;
      
       on this {
-        _enter();
-        result = _dom.isEmpty();
-        _leave();
+        _enterAll();
+        result = _size() == 0;
+        _leaveAll();
       }
 
       return result;
@@ -401,9 +465,9 @@ module Set {
       var result = 0;
 
       on this {
-        _enter();
-        result = _dom.size;
-        _leave();
+        _enterAll();
+        result = _size();
+        _leaveAll();
       }
 
       return result;
@@ -418,21 +482,21 @@ module Set {
       :rtype: `[] eltType`
     */
     proc const toArray(): [] eltType {
-      var result: [1.._dom.size] eltType;
+      var result: [1..size] eltType;
 
       on this {
-        _enter();
+        _enterAll();
 
         var count = 1;
-        var array: [1.._dom.size] eltType;
+        var array: [1.._size()] eltType;
 
-        for x in _dom {
-          array[count] = x;
+        for (shard, slot) in chpl__shardedSlots(_shards) {
+          array[count] = _shards[shard].table[slot].key;
           count += 1;
         }
 
         result = array;
-        _leave();
+        _leaveAll();
       }
 
       return result;
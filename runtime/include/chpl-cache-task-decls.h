@@ -20,9 +20,28 @@
 #ifndef _chpl_cache_task_decls_h_
 #define _chpl_cache_task_decls_h_
 
+// How many access streams adaptive readahead tracks per task.  Indexing
+// a remote array also reads its (unchanging) metadata, so a task walking
+// one array already touches a few addresses per element.
+#define CHPL_CACHE_NUM_STREAMS 8
+
+// One stream, for adaptive readahead
+typedef struct {
+  int32_t node;     // node of the stream (+1; 0 means this slot is unused)
+  int32_t run;      // how many times in a row the stride repeated
+  intptr_t stride;  // distance between the last two gets in the stream
+  uintptr_t last;   // remote address of the last get in the stream
+  uintptr_t ahead;  // next address the stream has not prefetched
+  uint32_t used;    // stream_clock when the stream was last touched
+} chpl_cache_stream_t;
+
 // This is the type of the task private data used by the cache
 typedef struct {
   int64_t last_acquire; // cache acquire barrier sets this
+
+  // Stream detection for adaptive readahead.
+  uint32_t stream_clock; // counts gets, for replacing streams
+  chpl_cache_stream_t streams[CHPL_CACHE_NUM_STREAMS];
 } chpl_cache_taskPrvData_t;
 
 #endif
@@ -89,6 +89,12 @@ void chpl_cache_comm_getput_unordered(c_nodeid_t dstnode, void* dstaddr,
                                       int ln, int32_t fn);
 void chpl_cache_comm_getput_unordered_task_fence(void);
 
+// Statistics, summed over the caches of all threads on this locale
+// (see chpl_comm_getCacheStatsHere).
+struct _chpl_cacheStats;
+void chpl_cache_getStats(struct _chpl_cacheStats* cs);
+void chpl_cache_resetStats(void);
+
 // For debugging.
 void chpl_cache_print(void);
 void chpl_cache_assert_released(void);
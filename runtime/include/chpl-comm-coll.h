@@ -0,0 +1,127 @@
+/*
+ * Copyright 2004-2020 Hewlett Packard Enterprise Development LP
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _chpl_comm_coll_h_
+#define _chpl_comm_coll_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "chpltypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//
+// Communication layer collective operations.
+//
+// NAME
+//
+//   chpl_comm_coll_barrier   - dissemination barrier across all nodes
+//   chpl_comm_coll_broadcast - copy one node's buffer to all nodes
+//   chpl_comm_coll_allgather - gather every node's buffer on all nodes
+//   chpl_comm_coll_allreduce - combine every node's buffer on all nodes
+//
+//
+// SYNOPSIS
+//
+//     #include "chpl-comm-coll.h"
+//
+//     void chpl_comm_coll_barrier(void);
+//     void chpl_comm_coll_broadcast(void* buf, size_t size,
+//                                   c_nodeid_t root);
+//     void chpl_comm_coll_allgather(const void* mine, void* all,
+//                                   size_t size);
+//     void chpl_comm_coll_allreduce(void* buf, size_t count,
+//                                   chpl_comm_coll_type_t type,
+//                                   chpl_comm_coll_op_t op);
+//
+//
+// DESCRIPTION
+//
+//   These are collective: exactly one task on every node must call
+//   each of them, and all nodes must make the same sequence of calls
+//   with the same 'size', 'count', 'type', 'op' and 'root' arguments.
+//   A call returns once this node's part of the operation is done,
+//   which for everything but the barrier need not mean that all the
+//   other nodes are done too.
+//
+//   chpl_comm_coll_barrier() returns once every node has called it.
+//   It takes ceil(log2(numNodes)) rounds, in each of which a node
+//   signals one partner and waits for a signal from another.
+//
+//   chpl_comm_coll_broadcast() copies the 'size' bytes at 'buf' on
+//   node 'root' to 'buf' on every other node.
+//
+//   chpl_comm_coll_allgather() copies the 'size' bytes at 'mine' on
+//   each node i to 'all' + i*size on every node.  'all' must have
+//   room for numNodes*size bytes.
+//
+//   chpl_comm_coll_allreduce() combines the 'count' elements of type
+//   'type' at 'buf' on all the nodes elementwise using 'op', and
+//   leaves the result in 'buf' on every node.  The bitwise operations
+//   are only supported for the integral types.  The order in which
+//   floating point values are combined is fixed for a given number of
+//   nodes and fanout, so results are reproducible run to run.
+//
+//   The operations other than the barrier run up and then down the
+//   same k-ary spanning tree that the comm layers use for broadcasts
+//   (see chpl-comm-internal.h), so they take O(log(numNodes)) steps
+//   and don't funnel through node 0.  Data moves through a per-node
+//   staging area using chpl_comm_put(), in pieces if it doesn't fit.
+//
+//   chpl_comm_coll_init() sets up the staging areas.  The runtime
+//   calls it collectively during startup, after the tasking layer
+//   and the comm layer's post-task initialization.
+//
+
+typedef enum {
+  CHPL_COMM_COLL_INT32,
+  CHPL_COMM_COLL_INT64,
+  CHPL_COMM_COLL_UINT32,
+  CHPL_COMM_COLL_UINT64,
+  CHPL_COMM_COLL_REAL32,
+  CHPL_COMM_COLL_REAL64,
+} chpl_comm_coll_type_t;
+
+typedef enum {
+  CHPL_COMM_COLL_SUM,
+  CHPL_COMM_COLL_PROD,
+  CHPL_COMM_COLL_MIN,
+  CHPL_COMM_COLL_MAX,
+  CHPL_COMM_COLL_BAND,
+  CHPL_COMM_COLL_BOR,
+  CHPL_COMM_COLL_BXOR,
+} chpl_comm_coll_op_t;
+
+void chpl_comm_coll_init(void);
+
+void chpl_comm_coll_barrier(void);
+void chpl_comm_coll_broadcast(void* buf, size_t size, c_nodeid_t root);
+void chpl_comm_coll_allgather(const void* mine, void* all, size_t size);
+void chpl_comm_coll_allreduce(void* buf, size_t count,
+                              chpl_comm_coll_type_t type,
+                              chpl_comm_coll_op_t op);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -23,6 +23,7 @@
 #ifndef LAUNCHER
 
 #include "chpl-comm.h"
+#include "chpl-comm-diags.h"
 #include "chpl-mem.h"
 #include "error.h"
 #include "chpl-wide-ptr-fns.h"
@@ -48,12 +49,15 @@ void chpl_gen_comm_get(void *addr, c_nodeid_t node, void* raddr,
 {
   if (chpl_nodeID == node) {
     chpl_memmove(addr, raddr, size);
+  } else {
+    chpl_comm_diags_prof_begin();
 #ifdef HAS_CHPL_CACHE_FNS
-  } else if( chpl_cache_enabled() ) {
-    chpl_cache_comm_get(addr, node, raddr, size, commID, ln, fn);
+    if( chpl_cache_enabled() )
+      chpl_cache_comm_get(addr, node, raddr, size, commID, ln, fn);
+    else
 #endif
-  } else {
-    chpl_comm_get(addr, node, raddr, size, commID, ln, fn);
+      chpl_comm_get(addr, node, raddr, size, commID, ln, fn);
+    chpl_comm_diags_prof_end();
   }
 }
 
@@ -89,12 +93,15 @@ void chpl_gen_comm_put(void* addr, c_nodeid_t node, void* raddr,
 {
   if (chpl_nodeID == node) {
     chpl_memmove(raddr, addr, size);
+  } else {
+    chpl_comm_diags_prof_begin();
 #ifdef HAS_CHPL_CACHE_FNS
-  } else if( chpl_cache_enabled() ) {
-    chpl_cache_comm_put(addr, node, raddr, size, commID, ln, fn);
+    if( chpl_cache_enabled() )
+      chpl_cache_comm_put(addr, node, raddr, size, commID, ln, fn);
+    else
 #endif
-  } else {
-    chpl_comm_put(addr, node, raddr, size, commID, ln, fn);
+      chpl_comm_put(addr, node, raddr, size, commID, ln, fn);
+    chpl_comm_diags_prof_end();
   }
 }
 
@@ -103,6 +110,7 @@ void chpl_gen_comm_get_strd(void *addr, void *dststr, c_nodeid_t node, void *rad
                        void *srcstr, void *count, int32_t strlevels, 
                        size_t elemSize, int32_t commID, int ln, int32_t fn)
 {
+  chpl_comm_diags_prof_begin();
   if( 0 ) {
 #ifdef HAS_CHPL_CACHE_FNS
   } else if( chpl_cache_enabled() ) {
@@ -111,6 +119,7 @@ void chpl_gen_comm_get_strd(void *addr, void *dststr, c_nodeid_t node, void *rad
   } else {
     chpl_comm_get_strd(addr, dststr, node, raddr, srcstr, count, strlevels, elemSize, commID, ln, fn);
   }
+  chpl_comm_diags_prof_end();
 }
 
 static inline
@@ -118,6 +127,7 @@ void chpl_gen_comm_put_strd(void *addr, void *dststr, c_nodeid_t node, void *rad
                        void *srcstr, void *count, int32_t strlevels, 
                        size_t elemSize, int32_t commID, int ln, int32_t fn)
 {
+  chpl_comm_diags_prof_begin();
   if( 0 ) {
 #ifdef HAS_CHPL_CACHE_FNS
   } else if( chpl_cache_enabled() ) {
@@ -126,6 +136,7 @@ void chpl_gen_comm_put_strd(void *addr, void *dststr, c_nodeid_t node, void *rad
   } else {
     chpl_comm_put_strd(addr, dststr, node, raddr, srcstr, count, strlevels, elemSize, commID, ln, fn);
   }
+  chpl_comm_diags_prof_end();
 }
 
 
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2004-2020 Hewlett Packard Enterprise Development LP
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _chpl_comm_diags_task_decls_h_
+#define _chpl_comm_diags_task_decls_h_
+
+#include <stdint.h>
+
+// This is the type of the task private data used by comm profiling.
+// It names the bucket of the first operation recorded since the task's
+// last chpl_comm_diags_prof_begin(), so that the time the task waits
+// for that operation is charged to it even if the task has moved to
+// another thread in the meantime.
+typedef struct {
+  uint64_t pending_start;  // when prof_begin() was called, or 0
+  const char* pending_op;  // NULL if no operation was recorded since
+  int32_t pending_node;
+  int pending_ln;
+  int32_t pending_fn;
+} chpl_comm_diags_taskPrvData_t;
+
+#endif
@@ -34,6 +34,8 @@
 extern int chpl_verbose_comm;     // set via startVerboseComm
 extern int chpl_comm_diagnostics; // set via startCommDiagnostics
 extern int chpl_comm_diags_print_unstable;
+extern int chpl_comm_cache_stats; // set via startCacheStats
+extern int chpl_comm_diags_profile; // set via startCommProfile
 
 #define CHPL_COMM_DIAGS_VARS_ALL(MACRO) \
   MACRO(get) \
@@ -66,6 +68,78 @@ void chpl_comm_stopDiagnosticsHere(void);
 void chpl_comm_resetDiagnosticsHere(void);
 void chpl_comm_getDiagnosticsHere(chpl_commDiagnostics *cd);
 
+//
+// Remote data cache (--cache-remote) statistics.  These are counted
+// separately by each thread's cache, so they cost only a test of
+// chpl_comm_cache_stats when they are not being collected.
+//
+#define CHPL_CACHE_STATS_VARS_ALL(MACRO) \
+  MACRO(get_hits) \
+  MACRO(get_partial_hits) \
+  MACRO(get_misses) \
+  MACRO(readaheads) \
+  MACRO(readahead_useful) \
+  MACRO(dirty_writebacks) \
+  MACRO(ain_evictions) \
+  MACRO(aout_evictions) \
+  MACRO(am_evictions) \
+  MACRO(acquire_fences) \
+  MACRO(release_fences)
+
+typedef struct _chpl_cacheStats {
+#define _CACHE_STATS_DECL(csv) uint64_t csv;
+  CHPL_CACHE_STATS_VARS_ALL(_CACHE_STATS_DECL)
+#undef _CACHE_STATS_DECL
+} chpl_cacheStats;
+
+void chpl_comm_startCacheStats(void);
+void chpl_comm_stopCacheStats(void);
+void chpl_comm_startCacheStatsHere(void);
+void chpl_comm_stopCacheStatsHere(void);
+void chpl_comm_resetCacheStatsHere(void);
+void chpl_comm_getCacheStatsHere(chpl_cacheStats *cs);
+
+//
+// Per-call-site communication profiling.  Operations are counted in
+// buckets keyed by (source line, file, operation, destination node),
+// along with the bytes moved and the time spent waiting for blocking
+// operations to complete.  Setting CHPL_RT_COMM_PROFILE profiles the
+// whole run and reports at exit: "stdout" prints a sorted report, and
+// any other value is taken as a file name prefix and each node writes
+// CSV to <prefix>.<node>.
+//
+void chpl_comm_diags_profile_init(void);
+void chpl_comm_diags_profile_exit(void);
+
+void chpl_comm_startProfile(void);
+void chpl_comm_stopProfile(void);
+void chpl_comm_startProfileHere(void);
+void chpl_comm_stopProfileHere(void);
+void chpl_comm_resetProfileHere(void);
+void chpl_comm_printProfileHere(void);
+
+void chpl_comm_diags_prof_record(const char* op, c_nodeid_t node,
+                                 size_t size, int ln, int32_t fn);
+void chpl_comm_diags_prof_do_begin(void);
+void chpl_comm_diags_prof_do_end(void);
+
+//
+// These bracket a blocking operation, so that the time spent in it
+// is charged to the bucket of the operation the comm layer recorded
+// in between (if any).
+//
+static inline
+void chpl_comm_diags_prof_begin(void) {
+  if (chpl_comm_diags_profile)
+    chpl_comm_diags_prof_do_begin();
+}
+
+static inline
+void chpl_comm_diags_prof_end(void) {
+  if (chpl_comm_diags_profile)
+    chpl_comm_diags_prof_do_end();
+}
+
 
 ////////////////////
 //
@@ -138,33 +212,66 @@ void chpl_comm_diags_verbose_printf(chpl_bool is_unstable,
   }
 }
 
+#define chpl_comm_diags_prof(op, node, size, ln, fn)                    \
+  do {                                                                  \
+    if (chpl_comm_diags_profile && chpl_comm_diags_is_enabled())        \
+      chpl_comm_diags_prof_record(op, node, size, ln, fn);              \
+  } while(0)
+
+//
+// The comm layers call these for every operation, so besides doing
+// on-the-fly reporting they also feed the profile.
+//
 #define chpl_comm_diags_verbose_rdma(op, node, size, ln, fn, commid)     \
+  do {                                                                   \
+    chpl_comm_diags_prof(op, node, size, ln, fn);                        \
+    chpl_comm_diags_verbose_rdma_print(op, node, size, ln, fn, commid);  \
+  } while(0)
+
+//
+// This only does the reporting.  The remote data cache uses it, since
+// it satisfies many GETs and PUTs without communicating and profiles
+// only the operations it actually starts.
+//
+#define chpl_comm_diags_verbose_rdma_print(op, node, size, ln, fn, commid) \
   chpl_comm_diags_verbose_printf(false,                                  \
-                                 "%s:%d: remote %s, node %d, %zu bytes, " \
-                                 "commid %d",                            \
+                                 "%s:%d: remote %s, node %d, "           \
+                                 "%zu bytes, commid %d",                 \
                                  chpl_lookupFilename(fn), ln, op,        \
                                  (int) node, size, (int) commid)
 
 #define chpl_comm_diags_verbose_rdmaStrd(op, node, ln, fn, commid)      \
-  chpl_comm_diags_verbose_printf(false,                                 \
-                                 "%s:%d: remote strided %s, node %d, "  \
-                                 "commid %d",                           \
-                                 chpl_lookupFilename(fn), ln, op,       \
-                                 (int) node, (int) commid)
+  do {                                                                  \
+    chpl_comm_diags_prof("strided " op, node, 0, ln, fn);               \
+    chpl_comm_diags_verbose_printf(false,                               \
+                                   "%s:%d: remote strided %s, node %d, " \
+                                   "commid %d",                         \
+                                   chpl_lookupFilename(fn), ln, op,     \
+                                   (int) node, (int) commid);           \
+  } while(0)
 
 #define chpl_comm_diags_verbose_amo(op, node, ln, fn)                   \
-  chpl_comm_diags_verbose_printf(true,                                  \
-                                 "%s:%d: remote %s, node %d",           \
-                                 chpl_lookupFilename(fn), ln, op,       \
-                                 (int) node)
+  do {                                                                  \
+    chpl_comm_diags_prof(op, node, 0, ln, fn);                          \
+    chpl_comm_diags_verbose_printf(true,                                \
+                                   "%s:%d: remote %s, node %d",         \
+                                   chpl_lookupFilename(fn), ln, op,     \
+                                   (int) node);                         \
+  } while(0)
 
 #define chpl_comm_diags_verbose_executeOn(kind, node, ln, fn)           \
-  chpl_comm_diags_verbose_printf(false,                                 \
-                                 "%s:%d: remote %-*sexecuteOn, node %d", \
-                                 chpl_lookupFilename(fn), ln,           \
-                                 ((int) strlen(kind)                    \
-                                  + ((strlen(kind) == 0) ? 0 : 1)),     \
-                                 kind, (int) node)
+  do {                                                                  \
+    chpl_comm_diags_prof((strlen(kind) == 0) ? "executeOn"              \
+                                             : kind " executeOn",       \
+                         node, 0, ln, fn);                              \
+    chpl_comm_diags_verbose_printf(false,                               \
+                                   "%s:%d: remote %-*sexecuteOn, "      \
+                                   "node %d",                           \
+                                   chpl_lookupFilename(fn), ln,         \
+                                   ((int) strlen(kind)                  \
+                                    + ((strlen(kind) == 0) ? 0 : 1)),   \
+                                   kind, (int) node);                   \
+  } while(0)
 
 #define chpl_comm_diags_incr(_ctr)                                      \
   do {                                                                  \
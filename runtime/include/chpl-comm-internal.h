@@ -26,13 +26,21 @@
 
 //
 // Support for broadcasting globals.  Comm layer implementations must
-// supply this.  It is called collectively.  On node 0 it must arrange
-// that all the global variable wide pointers are in a buffer that can
-// be the source of a GET from the other nodes and return either that
-// buffer's address (if it wants it freed later) or NULL.  On all other
-// nodes it should return the node-0 local address of that buffer.
+// supply this.  It is called collectively, with 'buf' pointing to a
+// buffer of chpl_numGlobalsOnHeap wide pointers on every node.  On
+// node 0 that buffer holds the global variables' wide pointers.  On
+// return, the buffer on every other node must hold a copy of node 0's.
 //
-wide_ptr_t* chpl_comm_broadcast_global_vars_helper(void);
+void chpl_comm_broadcast_global_vars_helper(wide_ptr_t* buf);
+
+//
+// Support for the collective operations in chpl-comm-coll.c.  Comm
+// layer implementations must supply this too.  It is called
+// collectively, once, during startup after the tasking layer has been
+// initialized.  On return, 'addrMap' on every node must hold every
+// node's 'addr', indexed by node.
+//
+void chpl_comm_exchange_addrs_helper(void* addr, void** addrMap);
 
 //
 // These are runtime-private copies of chpl_private_broadcast_table[]
@@ -48,6 +56,8 @@ extern size_t chpl_rt_priv_bcast_lens[];
   MACRO(chpl_verbose_comm)                   \
   MACRO(chpl_comm_diagnostics)               \
   MACRO(chpl_comm_diags_print_unstable)      \
+  MACRO(chpl_comm_cache_stats)               \
+  MACRO(chpl_comm_diags_profile)             \
   MACRO(chpl_verbose_mem)
 
 #define _RT_PRV_BCAST_M(sym)  chpl_rt_prv_tab_ ## sym ## _idx,
@@ -74,4 +84,41 @@ void chpl_comm_really_bcast_rt_private(int id) {
                               chpl_rt_priv_bcast_lens[id]);
 }
 
+//
+// Broadcast spanning tree.  Comm layers use this to do one-to-all
+// operations in O(log P) steps instead of having the root send to every
+// other node itself.  Nodes are numbered by their rank relative to the
+// root and arranged in a k-ary tree: the children of rank r are ranks
+// r*k+1 through r*k+k, and its parent is rank (r-1)/k.  The fanout k is
+// chpl_comm_bcast_fanout(); a fanout of at least numNodes-1 gives a flat
+// broadcast.
+//
+#define CHPL_COMM_BCAST_MAX_FANOUT 64
+
+static inline
+c_nodeid_t chpl_comm_bcast_tree_parent(c_nodeid_t node, c_nodeid_t root) {
+  int32_t rank = (node - root + chpl_numNodes) % chpl_numNodes;
+  int32_t prank = (rank - 1) / chpl_comm_bcast_fanout();
+  return (prank + root) % chpl_numNodes;
+}
+
+//
+// Fill 'children' (which must have room for CHPL_COMM_BCAST_MAX_FANOUT
+// entries) with the children of 'node' in the tree rooted at 'root',
+// and return how many there are.
+//
+static inline
+int chpl_comm_bcast_tree_children(c_nodeid_t node, c_nodeid_t root,
+                                  c_nodeid_t* children) {
+  const int32_t fanout = chpl_comm_bcast_fanout();
+  int32_t rank = (node - root + chpl_numNodes) % chpl_numNodes;
+  int numChildren = 0;
+  for (int32_t crank = rank * fanout + 1;
+       crank <= rank * fanout + fanout && crank < chpl_numNodes;
+       crank++) {
+    children[numChildren++] = (crank + root) % chpl_numNodes;
+  }
+  return numChildren;
+}
+
 #endif
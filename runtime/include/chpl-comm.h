@@ -341,6 +341,14 @@ void chpl_comm_broadcast_global_vars(int numGlobals);
 //
 void chpl_comm_broadcast_private(int id, size_t size);
 
+//
+// Broadcasts, both the one above and the module-level ones done by
+// ChapelSerializedBroadcast, are done over a spanning tree rather than
+// by the root sending to every other node itself.  This returns the
+// tree's fanout, as set by CHPL_RT_COMM_BCAST_FANOUT.
+//
+int chpl_comm_bcast_fanout(void);
+
 //
 // Barrier for synchronization between all top-level locales; currently
 // only used for startup and teardown.  msg is a string that can be used
@@ -22,6 +22,7 @@
 #ifndef LAUNCHER
 #include <stdint.h>
 #include "chpltypes.h"
+#include "chpl-bitops.h"
 
 void chpl_privatization_init(void);
 
@@ -31,17 +32,52 @@ typedef struct chpl_privateObject_s {
   void* obj;
 } chpl_privateObject_t;
 
-// This is a dynamically-allocated array of chpl_privateObject_t.
-extern chpl_privateObject_t* chpl_privateObjects;
+// Privatized objects are kept in a table made of segments.  Segment 0
+// has 2**CHPL_PRIVATIZATION_SEG0_LOG2 entries and each segment after
+// that is twice the size of the one before it.  So the segment and
+// offset for a pid can be computed directly.  Segments are allocated
+// as they are needed and never move or go away, which lets
+// chpl_getPrivatizedClass() read the table without locking while other
+// tasks are adding to it.
+#define CHPL_PRIVATIZATION_SEG0_LOG2 8
+#define CHPL_PRIVATIZATION_NUM_SEGS (64 - CHPL_PRIVATIZATION_SEG0_LOG2)
 
-// Compiler generates accesses like chpl_privateObjects[i];
-// see chpl_getPrivatizedCopy.
-// This allows TBAA information for chpl_privateObjects to be used.
-// At the very least, inlining it would be important for performance.
+extern chpl_privateObject_t* chpl_privateObjects[CHPL_PRIVATIZATION_NUM_SEGS];
+
+static inline
+void chpl_privatization_pidToSeg(int64_t pid, int* pSeg, int64_t* pOff) {
+  const uint64_t j = (uint64_t) pid + ((uint64_t) 1
+                                       << CHPL_PRIVATIZATION_SEG0_LOG2);
+  const int seg = 63 - (int) chpl_bitops_clz_64(j)
+                  - CHPL_PRIVATIZATION_SEG0_LOG2;
+  *pSeg = seg;
+  *pOff = (int64_t) (j - ((uint64_t) 1
+                          << (seg + CHPL_PRIVATIZATION_SEG0_LOG2)));
+}
+
+// The compiler generates calls to this through chpl_getPrivatizedCopy(),
+// so it needs to be inlined.  A pid that hasn't been added yet gives
+// NULL.
+static inline
+void* chpl_getPrivatizedClass(int64_t pid) {
+  int seg;
+  int64_t off;
+  chpl_privateObject_t* segObjs;
+
+  chpl_privatization_pidToSeg(pid, &seg, &off);
+  if ((segObjs = chpl_privateObjects[seg]) == NULL)
+    return NULL;
+  return segObjs[off].obj;
+}
 
 void chpl_clearPrivatizedClass(int64_t);
 
 int64_t chpl_numPrivatizedClasses(void);
 
+// Pids are handed out by node 0.  A pid whose objects have been cleared
+// on all nodes can be given back to be reused.
+int64_t chpl_newPrivatizedPid(void);
+void chpl_freePrivatizedPid(int64_t);
+
 #endif // LAUNCHER
 #endif // _chpl_privatization_h_
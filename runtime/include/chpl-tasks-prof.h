@@ -0,0 +1,43 @@
+/*
+ * Copyright 2004-2020 Hewlett Packard Enterprise Development LP
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _chpl_tasks_prof_h_
+#define _chpl_tasks_prof_h_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//
+// Per-spawn-site task profiling, built on the tasking layer callbacks.
+// Tasks are counted in buckets keyed by the source line and file that
+// created them, along with how long they waited between being created
+// and beginning to run, how long they ran, and their total lifetime.
+// Setting CHPL_RT_TASK_PROFILE profiles the whole run and reports at
+// exit: "stdout" prints a sorted report, and any other value is taken
+// as a file name prefix and each node writes CSV to <prefix>.<node>.
+//
+void chpl_task_prof_init(void);
+void chpl_task_prof_exit(void);
+
+#ifdef __cplusplus
+} // end extern "C"
+#endif
+
+#endif // _chpl_tasks_prof_h_
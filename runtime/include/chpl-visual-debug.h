@@ -39,8 +39,8 @@ extern int chpl_dprintf(int fd, const char * format, ...)
 #endif
    ;
 
-//  start and open file if not NULL
-extern void chpl_vdebug_start(const char *, double now); 
+//  start and open file if not NULL; binary selects the binary format
+extern void chpl_vdebug_start(const char *, double now, chpl_bool binary);
 
 //  stop collecting data
 extern void chpl_vdebug_stop(void);
@@ -35,6 +35,8 @@ extern "C" {
 
 // Memory tracking activated?
 extern int chpl_memTrack;
+// Heap profile sampling activated?
+extern int chpl_memProfile;
 extern int chpl_verbose_mem;      // set via startVerboseMem
 
 ///// These entry points support the memory tracking functions provided by
@@ -51,6 +53,8 @@ void chpl_printMemAllocs(int64_t threshold,
                          int32_t lineno, int32_t filename);
 void chpl_printMemAllocsByDesc(c_string descString, int64_t threshold,
                                int32_t lineno, int32_t filename);
+void chpl_printMemProfile(chpl_bool cumulative,
+                          int32_t lineno, int32_t filename);
 void chpl_startVerboseMem(void);
 void chpl_stopVerboseMem(void);
 void chpl_startVerboseMemHere(void);
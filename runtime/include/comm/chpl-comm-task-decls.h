@@ -23,11 +23,13 @@
 #ifndef _chpl_comm_task_decls_h
 #define _chpl_comm_task_decls_h
 
+#include "chpl-comm-diags-task-decls.h"
+
 // Define the type of a n.b. communications handle.
 typedef void* chpl_comm_nb_handle_t;
 
 typedef struct {
-  int dummy;    // structs must be nonempty
+  chpl_comm_diags_taskPrvData_t diags_data;
 } chpl_comm_taskPrvData_t;
 
 //
@@ -20,6 +20,8 @@
 #ifndef _chpl_comm_impl_h_
 #define _chpl_comm_impl_h_
 
+#include "chpltypes.h"
+
 //
 // This is the comm layer sub-interface for dynamic allocation and
 // registration of memory.
@@ -28,4 +30,49 @@
     chpl_comm_impl_regMemHeapInfo(start_p, size_p)
 void chpl_comm_impl_regMemHeapInfo(void** start_p, size_t* size_p);
 
+//
+// Unordered non-fetching atomic operations on processor atomics.  The
+// operand is *operand on the local node and the target is the processor
+// atomic *object on the given node.  These are buffered by the calling
+// task and are only guaranteed to be done after a subsequent
+// chpl_comm_atomic_unordered_task_fence() or the end of the task.
+//
+#define DECL_CHPL_COMM_ATOMIC_UNORDERED(op, type)                       \
+  void chpl_comm_atomic_ ## op ## _unordered_ ## type                   \
+         (void* operand, c_nodeid_t node, void* object,                 \
+          int ln, int32_t fn);
+
+DECL_CHPL_COMM_ATOMIC_UNORDERED(and, int32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED(and, int64)
+DECL_CHPL_COMM_ATOMIC_UNORDERED(and, uint32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED(and, uint64)
+
+DECL_CHPL_COMM_ATOMIC_UNORDERED(or, int32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED(or, int64)
+DECL_CHPL_COMM_ATOMIC_UNORDERED(or, uint32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED(or, uint64)
+
+DECL_CHPL_COMM_ATOMIC_UNORDERED(xor, int32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED(xor, int64)
+DECL_CHPL_COMM_ATOMIC_UNORDERED(xor, uint32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED(xor, uint64)
+
+DECL_CHPL_COMM_ATOMIC_UNORDERED(add, int32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED(add, int64)
+DECL_CHPL_COMM_ATOMIC_UNORDERED(add, uint32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED(add, uint64)
+DECL_CHPL_COMM_ATOMIC_UNORDERED(add, real32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED(add, real64)
+
+DECL_CHPL_COMM_ATOMIC_UNORDERED(sub, int32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED(sub, int64)
+DECL_CHPL_COMM_ATOMIC_UNORDERED(sub, uint32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED(sub, uint64)
+DECL_CHPL_COMM_ATOMIC_UNORDERED(sub, real32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED(sub, real64)
+
+#undef DECL_CHPL_COMM_ATOMIC_UNORDERED
+
+void chpl_comm_atomic_unordered_task_fence(void);
+
 #endif // _chpl_comm_impl_h_
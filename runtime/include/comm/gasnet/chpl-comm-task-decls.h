@@ -22,10 +22,15 @@
 
 // The type of task private data.
 #include "chpl-cache-task-decls.h"
+#include "chpl-comm-diags-task-decls.h"
 #define HAS_CHPL_CACHE_FNS
 
 typedef struct {
     chpl_cache_taskPrvData_t cache_data;
+    chpl_comm_diags_taskPrvData_t diags_data;
+    void* amo_nf_buff;
+    void* get_buff;
+    void* put_buff;
 } chpl_comm_taskPrvData_t;
 
 //
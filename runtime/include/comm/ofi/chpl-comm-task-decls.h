@@ -30,11 +30,15 @@
 
 // The type of task private data.
 #include "chpl-cache-task-decls.h"
+#include "chpl-comm-diags-task-decls.h"
 #define HAS_CHPL_CACHE_FNS
 
 typedef struct {
   chpl_cache_taskPrvData_t cache_data;
+  chpl_comm_diags_taskPrvData_t diags_data;
   int numTxnsOut;    // number of transactions outstanding
+  void* unorderedRma; // outstanding unordered GETs, PUTs, and AMOs
+  void* amoBatches;   // buffered unordered AMOs to be done via AM
 } chpl_comm_taskPrvData_t;
 
 //
@@ -84,6 +88,20 @@ struct chpl_comm_bundleData_RMA_t {
   chpl_comm_amDone_t* pAmDone;  // initiator's 'amDone' flag; NULL means nonblk
 };
 
+//
+// Strided RMA done via AM.  The initiator's buffer at 'raddr' holds a
+// descriptor of the target-side strides and counts, 'descSize' bytes
+// long, followed by 'size' bytes of packed data.
+//
+struct chpl_comm_bundleData_strdRMA_t {
+  struct chpl_comm_bundleData_base_t b;
+  uint32_t descSize;            // number of descriptor bytes at 'raddr'
+  void* addr;                   // strided address on AM target node
+  void* raddr;                  // descriptor+data address on initiator
+  size_t size;                  // number of packed data bytes
+  chpl_comm_amDone_t* pAmDone;  // initiator's 'amDone' flag
+};
+
 typedef union {
   int32_t i32;
   uint32_t u32;
@@ -106,12 +124,41 @@ struct chpl_comm_bundleData_AMO_t {
   chpl_comm_amDone_t* pAmDone;  // initiator's 'amDone' flag; NULL means nonblk
 };
 
+//
+// A batch of non-fetching AMOs is this header followed by numAMOs
+// instances of struct chpl_comm_amoNF_t.
+//
+struct chpl_comm_amoNF_t {
+  enum fi_op ofiOp;             // ofi AMO op
+  enum fi_datatype ofiType;     // ofi object type
+  int8_t size;                  // object size (bytes)
+  void* obj;                    // object address on target node
+  chpl_amo_datum_t operand;     // operand
+};
+
+struct chpl_comm_bundleData_AMOBatch_t {
+  struct chpl_comm_bundleData_base_t b;
+  uint16_t numAMOs;             // number of AMOs following
+  chpl_comm_amDone_t* pAmDone;  // initiator's 'amDone' flag
+};
+
+struct chpl_comm_bundleData_privBcast_t {
+  struct chpl_comm_bundleData_base_t b;
+  int id;                       // private broadcast table entry
+  uint32_t size;                // number of bytes
+  c_nodeid_t root;              // root of the broadcast tree
+  chpl_comm_amDone_t* pAmDone;  // initiator's 'amDone' flag
+};
+
 typedef union {
   struct chpl_comm_bundleData_base_t b;
   struct chpl_comm_bundleData_execOn_t xo;
   struct chpl_comm_bundleData_execOnLrg_t xol;
   struct chpl_comm_bundleData_RMA_t rma;
+  struct chpl_comm_bundleData_strdRMA_t srma;
   struct chpl_comm_bundleData_AMO_t amo;
+  struct chpl_comm_bundleData_AMOBatch_t amoBatch;
+  struct chpl_comm_bundleData_privBcast_t pb;
 } chpl_comm_bundleData_t;
 
 // The type of the communication handle.
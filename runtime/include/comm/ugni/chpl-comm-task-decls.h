@@ -27,10 +27,12 @@
 
 // The type of task private data.
 #include "chpl-cache-task-decls.h"
+#include "chpl-comm-diags-task-decls.h"
 #define HAS_CHPL_CACHE_FNS
 
 typedef struct {
   chpl_cache_taskPrvData_t cache_data;
+  chpl_comm_diags_taskPrvData_t diags_data;
   uint8_t num_fma;
   void* amo_nf_buff;
   void* get_buff;
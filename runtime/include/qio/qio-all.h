@@ -24,6 +24,7 @@
 #include "qbuffer.h"
 #include "qio.h"
 #include "qio_formatted.h"
+#include "qio_delimited.h"
 #include "qio_regexp.h"
 #include "qio_style.h"
 #include "bulkget.h"
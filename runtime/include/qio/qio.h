@@ -174,6 +174,7 @@ static inline void qio_lock_destroy(qio_lock_t* x) { int rc = pthread_mutex_dest
 extern ssize_t qio_too_small_for_default_mmap;
 extern ssize_t qio_too_large_for_default_mmap;
 extern ssize_t qio_mmap_chunk_iobufs;
+extern ssize_t qio_async_readahead;
 
 #ifdef __cplusplus
 extern "C" {
@@ -225,6 +226,8 @@ char* qio_chtype_to_string(qio_chtype_t type);
      -- noreuse -- pread/pwrite
      -- cached -- mmap for reads and writes
      -- force_readwrite
+     -- async -- only when requested; pread/pwrite through io_uring or
+                 I/O threads, with several requests in flight
  */
 
 #define QIO_HINT_AFTERCHTYPE 0x0010
@@ -235,13 +238,14 @@ typedef enum {
   QIO_METHOD_FREADFWRITE = 3*QIO_HINT_AFTERCHTYPE,
   QIO_METHOD_MMAP = 4*QIO_HINT_AFTERCHTYPE,
   QIO_METHOD_MEMORY = 5*QIO_HINT_AFTERCHTYPE,
+  QIO_METHOD_ASYNC = 6*QIO_HINT_AFTERCHTYPE,
   //QIO_METHOD_LIBEVENT,
 } qio_method_t;
 #define QIO_METHODMASK 0x00f0
 #define QIO_HINT_AFTERMETHOD 0x0100
 #define QIO_METHOD_DEFAULT 0
 #define QIO_MIN_METHOD QIO_METHOD_READWRITE
-#define QIO_MAX_METHOD QIO_METHOD_MEMORY
+#define QIO_MAX_METHOD QIO_METHOD_ASYNC
 
 enum {
   QIO_HINT_RANDOM       = QIO_HINT_AFTERMETHOD,
@@ -336,6 +340,9 @@ char* qio_hints_to_string(qio_hint_t hint)
       case QIO_METHOD_MEMORY:
         strcat(buf, " memory"); ok = 1;
         break;
+      case QIO_METHOD_ASYNC:
+        strcat(buf, " async"); ok = 1;
+        break;
       // no default to get warned if any are added.
     }
   }
@@ -474,6 +481,16 @@ qioerr qio_file_close(qio_file_t* f);
 
 qioerr qio_file_sync(qio_file_t* f);
 
+// Map len bytes of a file starting at offset start into memory, for use
+// as the elements of an array.  Returns a pointer to the data and a
+// function to call on it to unmap it.  Writable mappings are shared
+// with the file, which is extended if needed, and qio_file_sync writes
+// them out before syncing the file.
+qioerr qio_file_mmap_array(qio_file_t* f, int64_t start, int64_t len,
+                           int writable, qio_hint_t hints,
+                           void** data_out, void** freer_out);
+void qio_file_munmap_array(void* data);
+
 // This one gets called automatically.
 void _qio_file_destroy(qio_file_t* f);
 
@@ -1073,6 +1090,15 @@ qioerr qio_channel_write_amt(const int threadsafe, qio_channel_t* restrict ch, c
   return err;
 }
 
+// Read or write len bytes of array elements in pieces of at most
+// QIO_BULK_CHUNK bytes, so that a large transfer goes through a channel
+// buffer of bounded size instead of one as large as the data.  If
+// swap_size is 2, 4, or 8, every unit of that many bytes is byte-swapped
+// between memory and the channel; len must be a multiple of it.
+#define QIO_BULK_CHUNK (1024*1024)
+qioerr qio_channel_write_elts(const int threadsafe, qio_channel_t* restrict ch, const void* restrict ptr, int64_t len, int swap_size);
+qioerr qio_channel_read_elts(const int threadsafe, qio_channel_t* restrict ch, void* restrict ptr, int64_t len, int swap_size);
+
 qioerr _qio_channel_require_unlocked(qio_channel_t* ch, int64_t space, int writing);
 
 static inline
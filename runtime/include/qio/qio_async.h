@@ -0,0 +1,56 @@
+/*
+ * Copyright 2004-2020 Hewlett Packard Enterprise Development LP
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _QIO_ASYNC_H_
+#define _QIO_ASYNC_H_
+
+#include "sys_basic.h"
+#include "sys.h"
+
+#include <sys/uio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Asynchronous positioned reads and writes for QIO_METHOD_ASYNC.
+ *
+ * Requests go to an io_uring instance when the kernel provides one,
+ * and otherwise to a small pool of dedicated I/O threads.  A transfer
+ * is split into segments of qio_async_segment_size bytes, up to
+ * qio_async_max_inflight of which are outstanding at once, and the
+ * calling task yields until they complete rather than blocking the
+ * thread it is running on.
+ *
+ * These have the same contract as sys_preadv and sys_pwritev: they
+ * return an errno value, report the number of bytes transferred
+ * before any short transfer or error, and a read that transfers
+ * nothing at all returns EEOF.
+ */
+extern ssize_t qio_async_segment_size;
+extern int qio_async_max_inflight;
+
+err_t qio_async_preadv(fd_t fd, const struct iovec* iov, int iovcnt, off_t seek_to_offset, ssize_t* num_read_out);
+err_t qio_async_pwritev(fd_t fd, const struct iovec* iov, int iovcnt, off_t seek_to_offset, ssize_t* num_written_out);
+
+#ifdef __cplusplus
+} // end extern "C"
+#endif
+
+#endif
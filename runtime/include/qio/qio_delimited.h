@@ -0,0 +1,96 @@
+/*
+ * Copyright 2004-2020 Hewlett Packard Enterprise Development LP
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _QIO_DELIMITED_H_
+#define _QIO_DELIMITED_H_
+
+#include "sys_basic.h"
+#include "qio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Reading records of delimiter-separated fields, such as CSV.
+ *
+ * A record is a line of fields separated by a single-byte delimiter.
+ * A field may be enclosed in quote bytes, in which case it can contain
+ * the delimiter, newlines, and doubled quotes standing for one quote.
+ * Records end with \n, \r\n, or the end of the channel; blank lines
+ * are skipped.
+ *
+ * qio_channel_read_delimited reads a batch of records at a time into a
+ * qio_delimited_batch_t, which holds the bytes of each field (with any
+ * quoting removed and a '\0' after each) and the offset and length of
+ * each field.  Field i of record r is field number r*nfields + i.
+ */
+typedef struct qio_delimited_batch_s {
+  char* data;            // field contents, each followed by a '\0'
+  int64_t data_len;
+  int64_t data_cap;
+  int64_t* fields;       // offset and length in data of each field
+  int64_t fields_len;    // number of fields (not int64_ts) in fields
+  int64_t fields_cap;
+  int64_t nrecords;      // number of complete records in the batch
+} qio_delimited_batch_t;
+
+typedef qio_delimited_batch_t* qio_delimited_batch_ptr_t;
+
+qio_delimited_batch_ptr_t qio_delimited_batch_create(void);
+void qio_delimited_batch_destroy(qio_delimited_batch_ptr_t batch);
+
+/* Reads up to max_records records of nfields fields each into batch,
+ * replacing what it held before.  Stops before a record that starts at
+ * or after the channel offset end_offset, if end_offset >= 0.  Returns
+ * EEOF if there were no more records to read, and EFORMAT for a record
+ * with the wrong number of fields or with text after a closing quote;
+ * records read before the one in error are left in the batch.
+ */
+qioerr qio_channel_read_delimited(const int threadsafe, qio_channel_t* restrict ch, int32_t delimiter, int32_t quote, int64_t nfields, int64_t max_records, int64_t end_offset, qio_delimited_batch_ptr_t batch);
+
+static inline
+int64_t qio_delimited_batch_nrecords(qio_delimited_batch_ptr_t batch)
+{
+  return batch->nrecords;
+}
+
+static inline
+const char* qio_delimited_field_ptr(qio_delimited_batch_ptr_t batch, int64_t i)
+{
+  return batch->data + batch->fields[2*i];
+}
+
+static inline
+int64_t qio_delimited_field_len(qio_delimited_batch_ptr_t batch, int64_t i)
+{
+  return batch->fields[2*i+1];
+}
+
+/* Convert a field to an integer of len bytes or to a float or double,
+ * ignoring whitespace around it.  Return EFORMAT if it isn't a number
+ * and ERANGE if it doesn't fit.
+ */
+qioerr qio_delimited_field_to_int(qio_delimited_batch_ptr_t batch, int64_t i, void* restrict out, size_t len, int issigned);
+qioerr qio_delimited_field_to_float(qio_delimited_batch_ptr_t batch, int64_t i, void* restrict out, size_t len);
+
+#ifdef __cplusplus
+} // end extern "C"
+#endif
+
+#endif
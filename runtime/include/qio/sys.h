@@ -188,6 +188,8 @@ err_t sys_mmap(void* addr, size_t length, int prot, int flags, fd_t fd, off_t of
 
 err_t sys_munmap(void* addr, size_t length);
 
+err_t sys_msync(void* addr, size_t length, int flags);
+
 err_t sys_read(fd_t fd, void* buf, size_t count, ssize_t* num_read_out);
 err_t sys_write(fd_t fd, const void* buf, size_t count, ssize_t* num_written_out);
 
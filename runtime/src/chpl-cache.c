@@ -158,7 +158,7 @@ remote address. The pointer tree uses separate chaining (ie, each hash table
 element is actually a linked list of elements that go into that bucket).
 
 The cache consists of 'cache entries', one per 'cache page'. A 'cache page' is
-1024 bytes in the current implementation. The pointer tree and the 2Q queues
+1024 bytes by default (see CHPL_RT_CACHE_PAGE_BITS below). The pointer tree and the 2Q queues
 consist of cache entries which may point to a 1024-byte cache page. However, a
 GET is always rounded up to entire 'cache line'. A cache line is currently 64
 bytes. Each cache entry tracks which cache lines are valid (ie, for which cache
@@ -195,7 +195,9 @@ then by copying the newly gotten data out of the cache and into the request
 buffer.
 
 When processing GETs on adjacent memory locations, the cache triggers
-both synchronous and asynchronous read-ahead.
+both synchronous and asynchronous read-ahead. With the adaptive readahead
+policy, the cache also notices when a task's GETs form a sequential or
+strided stream and prefetches an increasing distance ahead along it.
 
 When processing a PUT, we similarly check for the requested cache page in the
 pointer tree and use an unused page if not. We find a unused 'dirty entry' to
@@ -279,11 +281,15 @@ use.
 #include "chpl-thread-local-storage.h" // CHPL_TLS_DECL etc
 #include "chpl-cache.h"
 #include "chpl-linefile-support.h"
+#include "chpl-env.h"
+#include "error.h"
 #include "sys.h" // sys_page_size()
 #include "chpl-comm-compiler-macros.h"
 #include "chpl-comm-no-warning-macros.h" // No warnings for chpl_comm_get etc.
 #include <string.h> // memcpy, memset, etc.
+#include <strings.h> // strcasecmp
 #include <assert.h>
+#include <pthread.h>
 
 
 #ifdef HAS_CHPL_CACHE_FNS
@@ -293,53 +299,99 @@ use.
 #define VERIFY 0
 
 // We try to auto-size the cache so that we
-// can have CACHE_PAGES_PER_NODE cache pages per locale, but we
+// can have cache_pages_per_node cache pages per locale, but we
 // do so within the below bounds.
-#define CACHE_PAGES_PER_NODE 4
 #define MIN_CACHE_DATA_SIZE (1024*1024)
 #define MAX_CACHE_DATA_SIZE (256*1024*1024)
 
 // How many pending operations can we have at once?
 #define MAX_PENDING 32
 
-// CACHEPAGE_BITS 
+// The cache geometry and readahead policy can be selected at startup
+// with these environment variables:
+//
+//   CHPL_RT_CACHE_PAGE_BITS      log2 of the cache page size (default 10)
+//   CHPL_RT_CACHE_LINE_BITS      log2 of the cache line size (default 6)
+//   CHPL_RT_CACHE_PAGES_PER_NODE cache pages per locale (default 4)
+//   CHPL_RT_CACHE_PREFETCH_PAGES max pages in one prefetch (default 2)
+//   CHPL_RT_CACHE_READAHEAD      readahead policy, one of
+//                                  none, page (default), sequential, adaptive
+//   CHPL_RT_CACHE_READAHEAD_PAGES max adaptive readahead window (default 16)
+//
+// They are read once, in chpl_cache_init(), before any cache is created,
+// and are the same for every cache on a locale.
+
+// CACHEPAGE_BITS
 // Controls the cache page size - the cache manages items of this many bytes
 // but also includes facilities for partial pages (valid and dirty bits).
 //
 // Reasonable values for CACHEPAGE_BITS are between 6 and 12
 // (64 bytes and 4k bytes. CACHEPAGE_BITS should not be larger than the
 // page size) and it must currently be even.
-// Here we set it to 1k bytes (ie 2^10).
-#define CACHEPAGE_BITS 10
+// By default it is 1k bytes (ie 2^10).
+#define MIN_CACHEPAGE_BITS 6
+#define MAX_CACHEPAGE_BITS 12
+static int cachepage_bits = 10;
+#define CACHEPAGE_BITS cachepage_bits
 #define CACHEPAGE_SIZE (1 << CACHEPAGE_BITS)
 #define CACHEPAGE_MASK (CACHEPAGE_SIZE-1)
 
-// CACHELINE_BITS 
+// CACHELINE_BITS
 // Controls the cache line size - that is, the minimum number of bytes
 // that are fetched for any 'get' operation.
 //
 // Reasonable values for CACHELINE_BITS are between 6 and CACHEPAGE_BITS.
-// Here we set it to 64 bytes (ie 2^6)
-#define CACHELINE_BITS 6
+// By default it is 64 bytes (ie 2^6)
+#define MIN_CACHELINE_BITS 6
+static int cacheline_bits = 6;
+#define CACHELINE_BITS cacheline_bits
 #define CACHELINE_SIZE (1 << CACHELINE_BITS)
 #define CACHELINE_MASK (CACHELINE_SIZE-1)
 
 // What type can store the number of cache lines in a cache page?
 typedef int8_t line_per_page_t; 
-// What type for a number of lines to read ahead?
-typedef int16_t readahead_distance_t;
+// What type for a number of bytes to read ahead?
+typedef int32_t readahead_distance_t;
+
+// How many cache pages per locale do we try to have?
+static int cache_pages_per_node = 4;
 
 // When prefetching, what is the maximum number of pages
 // we are willing to prefetch? This is also the maximum
-// readahead window size for sequential access.
-#define MAX_PAGES_PER_PREFETCH 2
-
-// Should we enable sequential readahead?
-// For sequential access If we're reading  
-#define ENABLE_READAHEAD 1
+// readahead window size for sequential access, unless the
+// readahead policy is adaptive.
+static int max_pages_per_prefetch = 2;
+
+// Which readahead do we do?
+//   none       -- never read ahead
+//   page       -- read the rest of a page (and then the next pages)
+//                 once the lines before or after a miss are valid
+//   sequential -- page, and also when a miss is within a page
+//                 of the last miss
+//   adaptive   -- sequential, and also detect sequential and strided
+//                 streams per task and grow a readahead window for
+//                 each, up to max_readahead_pages
+typedef enum {
+  READAHEAD_NONE,
+  READAHEAD_PAGE,
+  READAHEAD_SEQUENTIAL,
+  READAHEAD_ADAPTIVE
+} readahead_policy_t;
+
+static readahead_policy_t readahead_policy = READAHEAD_PAGE;
+static int max_readahead_pages = 16;
+
+#define ENABLE_READAHEAD (readahead_policy != READAHEAD_NONE)
 #define ENABLE_READAHEAD_TRIGGER_WITHIN_PAGE 1
-#define ENABLE_READAHEAD_TRIGGER_SEQUENTIAL 0
-#define MAX_SEQUENTIAL_READAHEAD_BYTES (MAX_PAGES_PER_PREFETCH*CACHEPAGE_SIZE)
+#define ENABLE_READAHEAD_TRIGGER_SEQUENTIAL \
+        (readahead_policy >= READAHEAD_SEQUENTIAL)
+#define MAX_SEQUENTIAL_READAHEAD_BYTES \
+        (((readahead_policy == READAHEAD_ADAPTIVE) ? max_readahead_pages \
+                                                   : max_pages_per_prefetch) \
+         * CACHEPAGE_SIZE)
+
+// How many strides must a task's stream repeat before we prefetch for it?
+#define STREAM_CONFIRM_STRIDES 2
 
 //#define TIME
 //#define TRACE
@@ -440,8 +492,10 @@ struct rdcache_s;
 #define HALF_SIZE (1L << HALF_BITS)
 
 // How many uint64_t words do we need to create a bitmask for CACHEPAGE_SIZE?
-// Divide # bytes in cache by 64, rounding up.
+// Divide # bytes in cache by 64, rounding up.  The MAX_ version sizes
+// the bitmask arrays for the largest page we support.
 #define CACHEPAGE_BITMASK_WORDS ((CACHEPAGE_SIZE+63)/64)
+#define MAX_CACHEPAGE_BITMASK_WORDS (((1 << MAX_CACHEPAGE_BITS)+63)/64)
 
 // How many cache lines per cache page?
 #define CACHE_LINES_PER_PAGE (CACHEPAGE_SIZE/CACHELINE_SIZE)
@@ -449,6 +503,27 @@ struct rdcache_s;
 // How many uint64_t words do we need to create a bitmask for CACHE_LINES_PER_PAGE
 // ie, a mask recording a bit per cache line?
 #define CACHE_LINES_PER_PAGE_BITMASK_WORDS (((CACHEPAGE_SIZE/CACHELINE_SIZE)+63)/64)
+#define MAX_CACHE_LINES_PER_PAGE_BITMASK_WORDS \
+        ((((1 << MAX_CACHEPAGE_BITS) >> MIN_CACHELINE_BITS)+63)/64)
+
+// Per-cache statistics.  See CHPL_CACHE_STATS_VARS_ALL.
+typedef struct {
+#define _CACHE_STATS_DECL_ATOMIC(csv) atomic_uint_least64_t csv;
+  CHPL_CACHE_STATS_VARS_ALL(_CACHE_STATS_DECL_ATOMIC)
+#undef _CACHE_STATS_DECL_ATOMIC
+} cache_stats_t;
+
+// Only the owning thread increments its cache's counters, so a relaxed
+// load and store is enough; other threads only read them.
+#define CACHE_STATS_INCR(cache, csv) \
+  do { \
+    if( chpl_comm_cache_stats ) { \
+      atomic_uint_least64_t* ctr = &(cache)->stats.csv; \
+      atomic_store_explicit_uint_least64_t(ctr, \
+          atomic_load_explicit_uint_least64_t(ctr, memory_order_relaxed) + 1, \
+          memory_order_relaxed); \
+    } \
+  } while(0)
 
 struct cache_entry_base_s {
   uint32_t index_bits;
@@ -471,7 +546,7 @@ struct dirty_entry_s {
   // which cache entry are we talking about here?
   struct cache_entry_s* entry;
   // Which of the page's bytes are dirty?
-  uint64_t dirty[CACHEPAGE_BITMASK_WORDS]; // ie we need to create a put for these bytes
+  uint64_t dirty[MAX_CACHEPAGE_BITMASK_WORDS]; // ie we need to create a put for these bytes
 };
 
 #define QUEUE_FREE 0
@@ -501,6 +576,8 @@ struct cache_entry_s {
   // Readahead information.
   readahead_distance_t readahead_skip;
   readahead_distance_t readahead_len; // == 0 if this page doesn't trigger readahead.
+  // Was data prefetched into this page that no get has used yet?
+  int prefetched;
   // These are the queue links. Am is LRU but Ain and Aout are FIFO
   struct cache_entry_s* next; // next entry in Ain/Aout/Am
   struct cache_entry_s* prev; // previous entry in An/Aout/Am
@@ -508,7 +585,7 @@ struct cache_entry_s {
   // This refers to CACHEPAGE_SIZE bytes of memory.
   unsigned char* page;
   // Which of the cache lines have we done 'get's for?
-  uint64_t valid_lines[CACHE_LINES_PER_PAGE_BITMASK_WORDS];
+  uint64_t valid_lines[MAX_CACHE_LINES_PER_PAGE_BITMASK_WORDS];
   // dirty info if this cache page is dirty, NULL otherwise.
   struct dirty_entry_s* dirty;
   // What is the minimum sequence number stored in this cache entry?
@@ -547,7 +624,7 @@ static int set_valid_lines(uint64_t* valid, uintptr_t skip, uintptr_t len)
 // Note skip/len are in line numbers, NOT byte offsets!
 static void unset_valid_lines(uint64_t* valid, uintptr_t skip, uintptr_t len)
 {
-  uint64_t myvalid[CACHE_LINES_PER_PAGE_BITMASK_WORDS];
+  uint64_t myvalid[MAX_CACHE_LINES_PER_PAGE_BITMASK_WORDS];
   unset_valids_for_skip_len(valid, myvalid, skip, len, CACHE_LINES_PER_PAGE_BITMASK_WORDS);  
 }
 /*
@@ -667,11 +744,79 @@ struct rdcache_s {
 
   // The entry into the 'pointer tree' hashtable structure.
   struct top_entry_s* top_index_list[TOP_SIZE];
+
+  // Statistics, updated only by the thread that owns this cache.
+  // All caches are on a list so that they can be summed up.
+  cache_stats_t stats;
+  struct rdcache_s* stats_prev;
+  struct rdcache_s* stats_next;
 };
 
 static void validate_cache(struct rdcache_s* tree);
 
 
+static
+int cache_num_pages(void) {
+  int cache_pages;
+
+  cache_pages = cache_pages_per_node * chpl_numNodes;
+  if( cache_pages < MIN_CACHE_DATA_SIZE/CACHEPAGE_SIZE )
+    cache_pages = MIN_CACHE_DATA_SIZE/CACHEPAGE_SIZE;
+  if( cache_pages > MAX_CACHE_DATA_SIZE/CACHEPAGE_SIZE )
+    cache_pages = MAX_CACHE_DATA_SIZE/CACHEPAGE_SIZE;
+
+  return cache_pages;
+}
+
+// All of the caches on this locale, for summing their statistics.
+// The counts from caches whose threads have exited are kept in
+// cache_stats_retired, and cache_stats_base holds the totals as of the
+// last reset.
+static pthread_mutex_t cache_stats_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct rdcache_s* cache_stats_list;
+static chpl_cacheStats cache_stats_retired;
+static chpl_cacheStats cache_stats_base;
+
+static
+void cache_stats_link(struct rdcache_s* cache) {
+  pthread_mutex_lock(&cache_stats_lock);
+  cache->stats_prev = NULL;
+  cache->stats_next = cache_stats_list;
+  if( cache_stats_list ) cache_stats_list->stats_prev = cache;
+  cache_stats_list = cache;
+  pthread_mutex_unlock(&cache_stats_lock);
+}
+
+static
+void cache_stats_unlink(struct rdcache_s* cache) {
+  pthread_mutex_lock(&cache_stats_lock);
+#define _CACHE_STATS_RETIRE(csv) \
+  cache_stats_retired.csv += \
+    atomic_load_explicit_uint_least64_t(&cache->stats.csv, \
+                                        memory_order_relaxed);
+  CHPL_CACHE_STATS_VARS_ALL(_CACHE_STATS_RETIRE)
+#undef _CACHE_STATS_RETIRE
+  if( cache->stats_prev ) cache->stats_prev->stats_next = cache->stats_next;
+  else cache_stats_list = cache->stats_next;
+  if( cache->stats_next ) cache->stats_next->stats_prev = cache->stats_prev;
+  pthread_mutex_unlock(&cache_stats_lock);
+}
+
+// Sum the statistics of every cache.  Call with cache_stats_lock held.
+static
+void cache_stats_sum(chpl_cacheStats* cs) {
+  struct rdcache_s* cache;
+
+  *cs = cache_stats_retired;
+  for( cache = cache_stats_list; cache; cache = cache->stats_next ) {
+#define _CACHE_STATS_ADD(csv) \
+    cs->csv += atomic_load_explicit_uint_least64_t(&cache->stats.csv, \
+                                                   memory_order_relaxed);
+    CHPL_CACHE_STATS_VARS_ALL(_CACHE_STATS_ADD)
+#undef _CACHE_STATS_ADD
+  }
+}
+
 static
 struct rdcache_s* cache_create(void) {
   struct rdcache_s* c;
@@ -693,11 +838,7 @@ struct rdcache_s* cache_create(void) {
   unsigned char* buffer;
   unsigned char* pages;
 
-  cache_pages = CACHE_PAGES_PER_NODE * chpl_numNodes;
-  if( cache_pages < MIN_CACHE_DATA_SIZE/CACHEPAGE_SIZE )
-    cache_pages = MIN_CACHE_DATA_SIZE/CACHEPAGE_SIZE;
-  if( cache_pages > MAX_CACHE_DATA_SIZE/CACHEPAGE_SIZE )
-    cache_pages = MAX_CACHE_DATA_SIZE/CACHEPAGE_SIZE;
+  cache_pages = cache_num_pages();
 
   ain_pages = cache_pages / 4; // 2Q: "Kin should be 25% of page slots"
   aout_pages = cache_pages / 2; // 2Q: "Kout should hold identifiers for as
@@ -848,6 +989,11 @@ struct rdcache_s* cache_create(void) {
   // clear top_index_list.
   memset(&c->top_index_list[0], 0, sizeof(struct top_entry_s*) * TOP_SIZE);
 
+#define _CACHE_STATS_INIT(csv) atomic_init_uint_least64_t(&c->stats.csv, 0);
+  CHPL_CACHE_STATS_VARS_ALL(_CACHE_STATS_INIT)
+#undef _CACHE_STATS_INIT
+  cache_stats_link(c);
+
   if( VERIFY ) validate_cache(c);
 
   return c;
@@ -855,6 +1001,7 @@ struct rdcache_s* cache_create(void) {
 
 static
 void cache_destroy(struct rdcache_s *cache) {
+  cache_stats_unlink(cache);
   chpl_free(cache);
 }
 
@@ -1129,6 +1276,7 @@ void aout_evict(struct rdcache_s* cache)
   // Remove the tail element from Aout
   DOUBLE_REMOVE_TAIL(cache, aout);
   cache->aout_current--;
+  CACHE_STATS_INCR(cache, aout_evictions);
 
   // Remove entry (which we are kicking off of Aout) from the tree
   tree_remove(cache, z);
@@ -1167,6 +1315,7 @@ void ain_evict(struct rdcache_s* cache, struct cache_entry_s* dont_evict_me)
   // immediately wait for them to complete, before we modify the contents
   // of Ain in any way (or reuse the associated page).
   flush_entry(cache, y, FLUSH_EVICT, 0, CACHEPAGE_SIZE);
+  CACHE_STATS_INCR(cache, ain_evictions);
 
   DOUBLE_REMOVE_TAIL(cache, ain);
   cache->ain_current--;
@@ -1205,6 +1354,7 @@ void am_evict(struct rdcache_s *cache, struct cache_entry_s* dont_evict_me) {
   // immediately wait for them to complete, before we modify the contents
   // of Ain in any way (or reuse the associated page).
   flush_entry(cache, y, FLUSH_EVICT, 0, CACHEPAGE_SIZE);
+  CACHE_STATS_INCR(cache, am_evictions);
 
   DOUBLE_REMOVE_TAIL(cache, am_lru);
   cache->am_current--;
@@ -1741,6 +1891,9 @@ void flush_entry(struct rdcache_s* cache, struct cache_entry_s* entry, int op,
 
           // Save the handle in the list of pending requests.
           entry->max_put_sequence_number = pending_push(cache, handle);
+          CACHE_STATS_INCR(cache, dirty_writebacks);
+          chpl_comm_diags_prof("put", entry->base.node, got_len,
+                               0, CHPL_FILE_IDX_UNKNOWN);
 
           // Move past this region of 1s in dirty bits.
           start = got_skip + got_len;
@@ -1878,6 +2031,7 @@ struct cache_entry_s* make_entry(struct rdcache_s* tree,
     bottom_match->queue = QUEUE_AM;
     bottom_match->readahead_skip = 0;
     bottom_match->readahead_len = 0;
+    bottom_match->prefetched = 0;
     // Set the page to the one the caller already allocated
     bottom_match->page = page;
     // Clear the valid lines
@@ -1904,6 +2058,7 @@ struct cache_entry_s* make_entry(struct rdcache_s* tree,
     bottom_tmp->queue = QUEUE_AIN;
     bottom_tmp->readahead_skip = 0;
     bottom_tmp->readahead_len = 0;
+    bottom_tmp->prefetched = 0;
 
     bottom_tmp->next = NULL;
     bottom_tmp->prev = NULL;
@@ -2252,6 +2407,9 @@ void cache_get(struct rdcache_s* cache,
   chpl_comm_nb_handle_t handle;
   uintptr_t readahead_len, readahead_skip;
   int ra;
+  int max_pages;
+  int missed = 0;
+  int hit = 0;
 #ifdef TIME
   struct timespec start_get1, start_get2, wait1, wait2;
 #endif
@@ -2278,8 +2436,12 @@ void cache_get(struct rdcache_s* cache,
 
   // If the request is too large to reasonably fit in the cache, limit
   // the amount of data prefetched. (or do nothing?)
-  if( isprefetch && (ra_last_page-ra_first_page)/CACHEPAGE_SIZE+1 > MAX_PAGES_PER_PREFETCH ) {
-    ra_last_page = ra_first_page + CACHEPAGE_SIZE*MAX_PAGES_PER_PREFETCH;
+  // Readahead has its own (possibly larger) window.
+  max_pages = ( sequential_readahead_length != 0 ) ?
+              MAX_SEQUENTIAL_READAHEAD_BYTES/CACHEPAGE_SIZE :
+              max_pages_per_prefetch;
+  if( isprefetch && (ra_last_page-ra_first_page)/CACHEPAGE_SIZE+1 > max_pages ) {
+    ra_last_page = ra_first_page + CACHEPAGE_SIZE*max_pages;
   }
 
   // Try to find it in the cache. Go through one page at a time.
@@ -2405,7 +2567,12 @@ void cache_get(struct rdcache_s* cache,
         // If the cache line is in Am, move it to the front of Am.
         use_entry(cache, entry);
         if( ! isprefetch ) {
-      
+          if( entry->prefetched ) {
+            entry->prefetched = 0;
+            CACHE_STATS_INCR(cache, readahead_useful);
+          }
+          hit = 1;
+
           //printf("cache hit on page %i:%p %p ra_len %i\n", 
           //       node, (void*) ra_page, (void*) requested_start,
           //       (int) entry->readahead_len);
@@ -2482,6 +2649,13 @@ void cache_get(struct rdcache_s* cache,
     clock_gettime(CLOCK_REALTIME, &start_get2);
 #endif
 
+    // Readahead isn't charged to the call site that happened to trigger it.
+    if( isprefetch )
+      chpl_comm_diags_prof("prefetch", node, ra_line_end - ra_line,
+                           0, CHPL_FILE_IDX_UNKNOWN);
+    else
+      chpl_comm_diags_prof("get", node, ra_line_end - ra_line, ln, fn);
+
     // Now, while that get is going, plumb into the tree.
 
     if( entry ) {
@@ -2490,6 +2664,13 @@ void cache_get(struct rdcache_s* cache,
       entry = make_entry(cache, node, ra_page, page);
     }
 
+    if( isprefetch ) {
+      entry->prefetched = 1;
+      CACHE_STATS_INCR(cache, readaheads);
+    } else {
+      missed = 1;
+    }
+
     // Set the valid lines
     set_valid_lines(entry->valid_lines,
                     (ra_line - ra_page) >> CACHELINE_BITS,
@@ -2578,6 +2759,17 @@ void cache_get(struct rdcache_s* cache,
     }
   }
 
+  if( ! isprefetch ) {
+    // A partial hit found some of its pages in the cache but had to
+    // get the others.
+    if( missed && hit )
+      CACHE_STATS_INCR(cache, get_partial_hits);
+    else if( missed )
+      CACHE_STATS_INCR(cache, get_misses);
+    else
+      CACHE_STATS_INCR(cache, get_hits);
+  }
+
   if( VERIFY ) validate_cache(cache);
 
 #ifdef DUMP
@@ -2587,6 +2779,135 @@ void cache_get(struct rdcache_s* cache,
 }
 
 
+//
+// Adaptive readahead.  Each task tracks up to CHPL_CACHE_NUM_STREAMS
+// streams of gets.  A get that lands one stride past the end of a
+// stream extends it.  A get that re-reads the address a stream last read
+// (as a loop does with the metadata of an array it indexes) leaves the
+// streams alone, so interleaved accesses like that don't break up the
+// streams around them.  Any other get starts a new stream, in the least
+// recently used slot, whose stride is the distance from the nearest
+// stream on the same node.  Once a stream's
+// stride has repeated STREAM_CONFIRM_STRIDES times in a row we prefetch
+// along it, and the window of prefetched pages doubles each time the
+// stride repeats again, up to max_readahead_pages.  Strides shorter than
+// a page (sequential access) are prefetched a whole page at a time;
+// longer ones prefetch just the part of each page the task will read.
+//
+// As in cache_get_trigger_readahead(), if guard pages are in use or the
+// comm layer can't tell us that the remote memory is there we only
+// prefetch within the system page(s) holding the current request.
+//
+static
+void cache_stream_readahead(struct rdcache_s* cache,
+                            chpl_cache_taskPrvData_t* task_local,
+                            c_nodeid_t node, raddr_t raddr, size_t size,
+                            int32_t commID, int ln, int32_t fn)
+{
+  chpl_cache_stream_t* streams = task_local->streams;
+  chpl_cache_stream_t* s = NULL;
+  chpl_cache_stream_t* near = NULL;
+  chpl_cache_stream_t* victim = NULL;
+  uint32_t clock = ++task_local->stream_clock;
+  uintptr_t dist, near_dist = 0;
+  intptr_t stride;
+  intptr_t step;
+  raddr_t start, end, ahead;
+  raddr_t req_first, req_last;
+  size_t len;
+  size_t page_size;
+  int window, doublings;
+  int i;
+
+  for( i = 0; i < CHPL_CACHE_NUM_STREAMS; i++ ) {
+    chpl_cache_stream_t* t = &streams[i];
+    if( t->node != node + 1 )
+      continue;
+    if( t->last == raddr ) {
+      t->used = clock;
+      return;
+    }
+    if( t->stride != 0 && raddr == t->last + t->stride )
+      s = t;
+  }
+
+  if( s != NULL ) {
+    if( s->run < INT32_MAX ) s->run++;
+  } else {
+    for( i = 0; i < CHPL_CACHE_NUM_STREAMS; i++ ) {
+      chpl_cache_stream_t* t = &streams[i];
+      if( t->node == node + 1 ) {
+        dist = (raddr > t->last) ? raddr - t->last : t->last - raddr;
+        if( near == NULL || dist < near_dist ) {
+          near = t;
+          near_dist = dist;
+        }
+      }
+      if( victim == NULL ||
+          ( victim->node != 0 &&
+            ( t->node == 0 || (int32_t) (t->used - victim->used) < 0 ) ) )
+        victim = t;
+    }
+
+    stride = (near != NULL) ? (intptr_t) (raddr - near->last) : 0;
+    s = victim;
+    s->node = node + 1;
+    s->stride = stride;
+    s->run = 0;
+    s->ahead = 0;
+  }
+  s->last = raddr;
+  s->used = clock;
+  stride = s->stride;
+
+  if( s->run < STREAM_CONFIRM_STRIDES || is_congested(cache) )
+    return;
+
+  if( stride > -CACHEPAGE_SIZE && stride < CACHEPAGE_SIZE ) {
+    step = (stride > 0) ? CACHEPAGE_SIZE : -CACHEPAGE_SIZE;
+    start = round_down_to_mask(raddr, CACHEPAGE_MASK);
+    len = CACHEPAGE_SIZE;
+  } else {
+    step = stride;
+    start = raddr;
+    len = size;
+  }
+
+  doublings = s->run - STREAM_CONFIRM_STRIDES;
+  window = max_readahead_pages;
+  if( doublings < 30 && (1 << doublings) < window )
+    window = 1 << doublings;
+
+  // Pick up where this stream's readahead left off, unless the task
+  // has caught up with it.
+  ahead = s->ahead;
+  if( ahead == 0 ||
+      (step > 0 && ahead <= start) || (step < 0 && ahead >= start) )
+    ahead = start + step;
+
+  end = start + step * window;
+  page_size = sys_page_size();
+  req_first = round_down_to_mask(raddr, page_size-1);
+  req_last = round_down_to_mask(raddr+size-1, page_size-1);
+
+  while( (step > 0) ? (ahead <= end) : (ahead >= end) ) {
+    if( ( chpl_task_guardPagesInUse() ||
+          ! chpl_comm_addr_gettable(node, (void*) ahead, len) ) &&
+        ( round_down_to_mask(ahead, page_size-1) < req_first ||
+          round_down_to_mask(ahead+len-1, page_size-1) > req_last ) )
+      break;
+
+    INFO_PRINT(("%i stream readahead %i:%p len %i stride %i\n",
+                (int) chpl_nodeID, (int) node, (void*) ahead, (int) len,
+                (int) stride));
+    cache_get(cache, NULL /* prefetch */, node, ahead, len,
+              task_local->last_acquire, 0, commID, ln, fn);
+    ahead += step;
+  }
+
+  s->ahead = ahead;
+}
+
 static
 void cache_invalidate(struct rdcache_s* cache,
                        c_nodeid_t node, raddr_t raddr, size_t size)
@@ -2697,12 +3018,84 @@ void destroy_pthread_local_cache(void* arg)
   cache_destroy(s);
 }
 
+// Read the cache geometry and readahead policy from the environment.
+static
+void cache_configure(void)
+{
+  const char* policy;
+  int max_line_bits;
+  int sys_page_bits;
+  char msg[200];
+
+  for( sys_page_bits = 0;
+       ((size_t) 1 << (sys_page_bits+1)) <= sys_page_size();
+       sys_page_bits++ ) ;
+
+  cachepage_bits = (int) chpl_env_rt_get_int("CACHE_PAGE_BITS", cachepage_bits);
+  if( cachepage_bits < MIN_CACHEPAGE_BITS ||
+      cachepage_bits > MAX_CACHEPAGE_BITS ||
+      cachepage_bits > sys_page_bits ||
+      cachepage_bits % 2 != 0 ) {
+    snprintf(msg, sizeof(msg),
+             "CHPL_RT_CACHE_PAGE_BITS must be even, between %d and %d, "
+             "and fit in a system page",
+             MIN_CACHEPAGE_BITS, MAX_CACHEPAGE_BITS);
+    chpl_error(msg, 0, 0);
+  }
+
+  max_line_bits = cachepage_bits;
+  cacheline_bits = (int) chpl_env_rt_get_int("CACHE_LINE_BITS", cacheline_bits);
+  if( cacheline_bits < MIN_CACHELINE_BITS || cacheline_bits > max_line_bits ) {
+    snprintf(msg, sizeof(msg),
+             "CHPL_RT_CACHE_LINE_BITS must be between %d and "
+             "CHPL_RT_CACHE_PAGE_BITS (%d)",
+             MIN_CACHELINE_BITS, cachepage_bits);
+    chpl_error(msg, 0, 0);
+  }
+
+  cache_pages_per_node = (int) chpl_env_rt_get_int("CACHE_PAGES_PER_NODE",
+                                                   cache_pages_per_node);
+  if( cache_pages_per_node < 1 )
+    chpl_error("CHPL_RT_CACHE_PAGES_PER_NODE must be > 0", 0, 0);
+
+  max_pages_per_prefetch = (int) chpl_env_rt_get_int("CACHE_PREFETCH_PAGES",
+                                                     max_pages_per_prefetch);
+  if( max_pages_per_prefetch < 1 )
+    chpl_error("CHPL_RT_CACHE_PREFETCH_PAGES must be > 0", 0, 0);
+
+  policy = chpl_env_rt_get("CACHE_READAHEAD", NULL);
+  if( policy != NULL ) {
+    if( strcasecmp(policy, "none") == 0 )
+      readahead_policy = READAHEAD_NONE;
+    else if( strcasecmp(policy, "page") == 0 )
+      readahead_policy = READAHEAD_PAGE;
+    else if( strcasecmp(policy, "sequential") == 0 )
+      readahead_policy = READAHEAD_SEQUENTIAL;
+    else if( strcasecmp(policy, "adaptive") == 0 )
+      readahead_policy = READAHEAD_ADAPTIVE;
+    else
+      chpl_error("CHPL_RT_CACHE_READAHEAD must be one of "
+                 "none, page, sequential, or adaptive", 0, 0);
+  }
+
+  // Keep the readahead window well within the Ain queue (a quarter of
+  // the cache), so a stream can't evict its own prefetched pages.
+  max_readahead_pages = (int) chpl_env_rt_get_int("CACHE_READAHEAD_PAGES",
+                                                  max_readahead_pages);
+  if( max_readahead_pages < 1 )
+    chpl_error("CHPL_RT_CACHE_READAHEAD_PAGES must be > 0", 0, 0);
+  if( max_readahead_pages > cache_num_pages() / 8 )
+    max_readahead_pages = cache_num_pages() / 8;
+}
+
 static
 void chpl_cache_do_init(void)
 {
   static int inited = 0;
   if( ! inited ) {
-  
+
+    cache_configure();
+
     // Quick configuration check...
     assert(OTHER_BITS+TOP_BITS+OTHER_BITS+BOTTOM_BITS+CACHEPAGE_BITS == 64);
     assert(HALF_BITS + HALF_BITS + CACHEPAGE_BITS == 64);
@@ -2738,6 +3131,23 @@ void chpl_cache_exit(void)
 }
 
 
+void chpl_cache_getStats(chpl_cacheStats* cs)
+{
+  pthread_mutex_lock(&cache_stats_lock);
+  cache_stats_sum(cs);
+#define _CACHE_STATS_SUB(csv) cs->csv -= cache_stats_base.csv;
+  CHPL_CACHE_STATS_VARS_ALL(_CACHE_STATS_SUB)
+#undef _CACHE_STATS_SUB
+  pthread_mutex_unlock(&cache_stats_lock);
+}
+
+void chpl_cache_resetStats(void)
+{
+  pthread_mutex_lock(&cache_stats_lock);
+  cache_stats_sum(&cache_stats_base);
+  pthread_mutex_unlock(&cache_stats_lock);
+}
+
 void chpl_cache_fence(int acquire, int release, int ln, int32_t fn)
 {
   if( acquire == 0 && release == 0 ) return;
@@ -2758,11 +3168,13 @@ void chpl_cache_fence(int acquire, int release, int ln, int32_t fn)
     if( acquire ) {
       task_local->last_acquire = cache->next_request_number;
       cache->next_request_number++;
+      CACHE_STATS_INCR(cache, acquire_fences);
     }
 
     if( release ) {
       cache_clean_dirty(cache);
       wait_all(cache);
+      CACHE_STATS_INCR(cache, release_fences);
     }
 #ifdef DUMP
     DEBUG_PRINT(("%d: task %d after fence\n", chpl_nodeID, (int) chpl_task_getId()));
@@ -2795,7 +3207,7 @@ void chpl_cache_comm_put(void* addr, c_nodeid_t node, void* raddr,
                "from %p\n",
                chpl_nodeID, (int)chpl_task_getId(), chpl_lookupFilename(fn), ln,
                (int)size, node, raddr, addr));
-  chpl_comm_diags_verbose_rdma("get", node, size, ln, fn, commID);
+  chpl_comm_diags_verbose_rdma_print("put", node, size, ln, fn, commID);
 
 #ifdef DUMP
   chpl_cache_print();
@@ -2823,7 +3235,7 @@ void chpl_cache_comm_get(void *addr, c_nodeid_t node, void* raddr,
                "%d:%p to %p\n",
                chpl_nodeID, (int)chpl_task_getId(), chpl_lookupFilename(fn), ln,
                (int)size, node, raddr, addr));
-  chpl_comm_diags_verbose_rdma("put", node, size, ln, fn, commID);
+  chpl_comm_diags_verbose_rdma_print("get", node, size, ln, fn, commID);
 
 #ifdef DUMP
   chpl_cache_print();
@@ -2833,6 +3245,10 @@ void chpl_cache_comm_get(void *addr, c_nodeid_t node, void* raddr,
   cache_get(cache, addr, node, (raddr_t)raddr, size, task_local->last_acquire,
             0, commID, ln, fn);
 
+  if( readahead_policy == READAHEAD_ADAPTIVE )
+    cache_stream_readahead(cache, task_local, node, (raddr_t)raddr, size,
+                           commID, ln, fn);
+
   return;
 }
 
@@ -2842,7 +3258,7 @@ void chpl_cache_comm_prefetch(c_nodeid_t node, void* raddr,
   struct rdcache_s* cache = tls_cache_remote_data();
   chpl_cache_taskPrvData_t* task_local = task_private_cache_data();
   TRACE_PRINT(("%d: in chpl_cache_comm_prefetch\n", chpl_nodeID));
-  chpl_comm_diags_verbose_rdma("prefetch", node, size, ln, fn, commID);
+  chpl_comm_diags_verbose_rdma_print("prefetch", node, size, ln, fn, commID);
   // Always use the cache for prefetches.
   //saturating_increment(&info->prefetch_since_acquire);
   cache_get(cache, NULL, node, (raddr_t)raddr, size, task_local->last_acquire,
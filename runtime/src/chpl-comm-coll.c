@@ -0,0 +1,445 @@
+/*
+ * Copyright 2004-2020 Hewlett Packard Enterprise Development LP
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// Collective operations, implemented once for all comm layers on top
+// of chpl_comm_put().  See chpl-comm-coll.h for the interface.
+//
+#include "chplrt.h"
+#include "chpl-atomics.h"
+#include "chpl-comm.h"
+#include "chpl-comm-coll.h"
+#include "chpl-comm-compiler-macros.h"
+#include "chpl-comm-internal.h"
+#include "chpl-mem.h"
+#include "chpl-tasks.h"
+#include "error.h"
+
+// Don't get warning macros for chpl_comm_get etc.
+#include "chpl-comm-no-warning-macros.h"
+
+#include <stdint.h>
+#include <string.h>
+
+//
+// Every node has one of these, which the other nodes PUT into.
+//
+// The flags hold sequence numbers rather than booleans, so they never
+// have to be reset: a flag has been signaled for a given operation
+// once it is at least that operation's sequence number.  The barrier
+// has its own sequence because it doesn't use the tree.
+//
+// In the tree operations the data area is used in one of two ways.
+// Allreduce and broadcast divide it into fanout+1 slots: a child's
+// contribution comes up into slot 1+(its index among our children),
+// and the result comes down from our parent into slot 0.  Allgather
+// treats it as one array of per-node pieces, holding our subtree's
+// pieces in preorder on the way up and everyone's on the way down.
+//
+#define COLL_MAX_BAR_ROUNDS 64
+#define COLL_MIN_DATA_SIZE (64 * 1024)
+#define COLL_MIN_ALLGATHER_PIECE 8
+
+typedef struct {
+  volatile uint64_t barFlags[COLL_MAX_BAR_ROUNDS];
+  volatile uint64_t upFlags[CHPL_COMM_BCAST_MAX_FANOUT];
+  volatile uint64_t downFlag;
+  char data[];
+} coll_area_t;
+
+static coll_area_t* collArea;
+static coll_area_t** collAreaMap;
+static size_t collDataSize;
+static size_t collSlotSize;
+
+static uint64_t collBarSeq;
+static uint64_t collTreeSeq;
+
+
+void chpl_comm_coll_init(void) {
+  const int fanout = chpl_comm_bcast_fanout();
+
+  collDataSize = COLL_MIN_DATA_SIZE;
+  if (collDataSize < chpl_numNodes * COLL_MIN_ALLGATHER_PIECE) {
+    collDataSize = chpl_numNodes * COLL_MIN_ALLGATHER_PIECE;
+  }
+
+  // Keep the slots aligned for any element type.
+  collSlotSize = (collDataSize / (fanout + 1)) & ~(size_t) 7;
+
+  collArea = (coll_area_t*)
+             chpl_mem_alloc(sizeof(*collArea) + collDataSize,
+                            CHPL_RT_MD_COMM_XMIT_RCV_BUF, 0, 0);
+  memset(collArea, 0, sizeof(*collArea));
+
+  collAreaMap = (coll_area_t**)
+                chpl_mem_allocMany(chpl_numNodes, sizeof(collAreaMap[0]),
+                                   CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
+  chpl_comm_exchange_addrs_helper(collArea, (void**) collAreaMap);
+}
+
+
+static inline
+void coll_put(void* addr, c_nodeid_t node, void* raddr, size_t size) {
+  chpl_comm_put(addr, node, raddr, size, CHPL_COMM_UNKNOWN_ID, 0, -1);
+}
+
+static inline
+void coll_signal(c_nodeid_t node, volatile uint64_t* rflag, uint64_t seq) {
+  coll_put(&seq, node, (void*) rflag, sizeof(seq));
+}
+
+static inline
+void coll_wait(volatile uint64_t* flag, uint64_t seq) {
+  while (*flag < seq) {
+    chpl_task_yield();
+  }
+  chpl_atomic_thread_fence(memory_order_acquire);
+}
+
+
+void chpl_comm_coll_barrier(void) {
+  const uint64_t seq = ++collBarSeq;
+  int round;
+  c_nodeid_t dist;
+
+  //
+  // In round i we tell the node 2**i ahead of us we're here and wait
+  // for the node 2**i behind us to tell us the same.  After the last
+  // round everyone has heard, directly or indirectly, from everyone.
+  //
+  for (round = 0, dist = 1; dist < chpl_numNodes; round++, dist *= 2) {
+    c_nodeid_t partner = (chpl_nodeID + dist) % chpl_numNodes;
+    coll_signal(partner, &collAreaMap[partner]->barFlags[round], seq);
+    coll_wait(&collArea->barFlags[round], seq);
+  }
+}
+
+
+//
+// Tree support.  All the tree operations use the spanning tree rooted
+// at node 0, so that each node always has the same parent and children
+// and the flags and slots can be reused from one operation to the next
+// without any extra handshaking.  A node can't start operation n+1
+// until its parent has sent it the result of operation n, and by then
+// its parent is done reading anything it sent up for operation n.
+// Results are sent down from buffers other than the data area, so
+// children can start sending up again as soon as they get them.
+//
+static inline
+int coll_tree_children(c_nodeid_t* children) {
+  return chpl_comm_bcast_tree_children(chpl_nodeID, 0, children);
+}
+
+static inline
+int coll_child_idx(c_nodeid_t node) {
+  return (node - 1) % chpl_comm_bcast_fanout();
+}
+
+static inline
+void coll_wait_up(int numChildren, uint64_t seq) {
+  int i;
+  for (i = 0; i < numChildren; i++) {
+    coll_wait(&collArea->upFlags[i], seq);
+  }
+}
+
+static inline
+void coll_send_up(void* src, size_t size, size_t offset, uint64_t seq) {
+  c_nodeid_t parent = chpl_comm_bcast_tree_parent(chpl_nodeID, 0);
+  coll_area_t* pArea = collAreaMap[parent];
+  if (size > 0) {
+    coll_put(src, parent, pArea->data + offset, size);
+  }
+  coll_signal(parent, &pArea->upFlags[coll_child_idx(chpl_nodeID)], seq);
+}
+
+static inline
+void coll_wait_down(uint64_t seq) {
+  coll_wait(&collArea->downFlag, seq);
+}
+
+static inline
+void coll_send_down(c_nodeid_t* children, int numChildren,
+                    void* src, size_t size, uint64_t seq) {
+  int i;
+  for (i = 0; i < numChildren; i++) {
+    coll_area_t* cArea = collAreaMap[children[i]];
+    coll_put(src, children[i], cArea->data, size);
+    coll_signal(children[i], &cArea->downFlag, seq);
+  }
+}
+
+
+void chpl_comm_coll_broadcast(void* buf, size_t size, c_nodeid_t root) {
+  c_nodeid_t children[CHPL_COMM_BCAST_MAX_FANOUT];
+  const int numChildren = coll_tree_children(children);
+  size_t start;
+
+  //
+  // If the root isn't node 0 it puts the data directly into node 0's
+  // slot 0, which nothing else uses there.  Going up the tree is then
+  // just an acknowledgement that everyone is ready for the data, and
+  // node 0 can't see it until the root's acknowledgement has reached
+  // it, so the data has to be there.
+  //
+  for (start = 0; start < size; start += collSlotSize) {
+    size_t thisSize = size - start;
+    char* p = (char*) buf + start;
+    const uint64_t seq = ++collTreeSeq;
+
+    if (thisSize > collSlotSize)
+      thisSize = collSlotSize;
+
+    if (chpl_nodeID == root && root != 0) {
+      coll_put(p, 0, collAreaMap[0]->data, thisSize);
+    }
+
+    coll_wait_up(numChildren, seq);
+    if (chpl_nodeID != 0) {
+      coll_send_up(NULL, 0, 0, seq);
+      coll_wait_down(seq);
+    }
+    if (chpl_nodeID != root) {
+      memcpy(p, collArea->data, thisSize);
+    }
+    coll_send_down(children, numChildren, p, thisSize, seq);
+  }
+}
+
+
+//
+// Allgather support.  A node's subtree, listed in preorder, is itself
+// followed by each of its children's subtrees in preorder.  So if each
+// node sends its parent its subtree's pieces in preorder, and the
+// parent places them right after its own piece and those of earlier
+// children, node 0 ends up with everyone's pieces in preorder.
+//
+static
+size_t coll_subtree_size(c_nodeid_t node) {
+  const size_t fanout = chpl_comm_bcast_fanout();
+  size_t first = node, last = node;
+  size_t size = 0;
+
+  while (first < (size_t) chpl_numNodes) {
+    size += ((last < (size_t) chpl_numNodes) ? last : chpl_numNodes - 1)
+            - first + 1;
+    first = first * fanout + 1;
+    last = last * fanout + fanout;
+  }
+  return size;
+}
+
+static
+void coll_preorder(c_nodeid_t node, c_nodeid_t* order, size_t* pos) {
+  c_nodeid_t children[CHPL_COMM_BCAST_MAX_FANOUT];
+  int numChildren, i;
+
+  order[(*pos)++] = node;
+  numChildren = chpl_comm_bcast_tree_children(node, 0, children);
+  for (i = 0; i < numChildren; i++) {
+    coll_preorder(children[i], order, pos);
+  }
+}
+
+void chpl_comm_coll_allgather(const void* mine, void* all, size_t size) {
+  c_nodeid_t children[CHPL_COMM_BCAST_MAX_FANOUT];
+  const int numChildren = coll_tree_children(children);
+  const size_t maxPiece = collDataSize / chpl_numNodes;
+  const size_t mySubtreeSize = coll_subtree_size(chpl_nodeID);
+  size_t myOffset = 0;
+  c_nodeid_t* order;
+  char* tmp;
+  size_t pos, start;
+
+  if (size == 0)
+    return;
+
+  //
+  // Where our subtree's pieces go in our parent's data area, in units
+  // of pieces: after its own and our earlier siblings' subtrees.
+  //
+  if (chpl_nodeID != 0) {
+    c_nodeid_t parent = chpl_comm_bcast_tree_parent(chpl_nodeID, 0);
+    c_nodeid_t sibling;
+    myOffset = 1;
+    for (sibling = parent * chpl_comm_bcast_fanout() + 1;
+         sibling < chpl_nodeID;
+         sibling++) {
+      myOffset += coll_subtree_size(sibling);
+    }
+  }
+
+  order = (c_nodeid_t*)
+          chpl_mem_allocMany(chpl_numNodes, sizeof(order[0]),
+                             CHPL_RT_MD_COMM_UTIL, 0, 0);
+  pos = 0;
+  coll_preorder(0, order, &pos);
+
+  tmp = (char*) chpl_mem_allocMany(chpl_numNodes,
+                                   (size < maxPiece) ? size : maxPiece,
+                                   CHPL_RT_MD_COMM_UTIL, 0, 0);
+
+  for (start = 0; start < size; start += maxPiece) {
+    size_t thisSize = size - start;
+    const uint64_t seq = ++collTreeSeq;
+
+    if (thisSize > maxPiece)
+      thisSize = maxPiece;
+
+    memcpy(collArea->data, (const char*) mine + start, thisSize);
+    coll_wait_up(numChildren, seq);
+    if (chpl_nodeID != 0) {
+      coll_send_up(collArea->data, mySubtreeSize * thisSize,
+                   myOffset * thisSize, seq);
+      coll_wait_down(seq);
+    }
+    memcpy(tmp, collArea->data, chpl_numNodes * thisSize);
+    coll_send_down(children, numChildren,
+                   tmp, chpl_numNodes * thisSize, seq);
+
+    for (pos = 0; pos < (size_t) chpl_numNodes; pos++) {
+      memcpy((char*) all + order[pos] * size + start,
+             tmp + pos * thisSize, thisSize);
+    }
+  }
+
+  chpl_mem_free(tmp, 0, 0);
+  chpl_mem_free(order, 0, 0);
+}
+
+
+//
+// Allreduce support.
+//
+static
+size_t coll_type_size(chpl_comm_coll_type_t type) {
+  switch (type) {
+  case CHPL_COMM_COLL_INT32:  return sizeof(int32_t);
+  case CHPL_COMM_COLL_INT64:  return sizeof(int64_t);
+  case CHPL_COMM_COLL_UINT32: return sizeof(uint32_t);
+  case CHPL_COMM_COLL_UINT64: return sizeof(uint64_t);
+  case CHPL_COMM_COLL_REAL32: return sizeof(_real32);
+  case CHPL_COMM_COLL_REAL64: return sizeof(_real64);
+  }
+  chpl_internal_error("unknown collective element type");
+  return 0;
+}
+
+#define COLL_COMBINE_LOOP(T, expr)                                      \
+  do {                                                                  \
+    T* a = (T*) acc;                                                    \
+    const T* b = (const T*) in;                                         \
+    size_t i;                                                           \
+    for (i = 0; i < count; i++) {                                       \
+      a[i] = (expr);                                                    \
+    }                                                                   \
+  } while (0)
+
+#define COLL_COMBINE_ARITH(T)                                           \
+  case CHPL_COMM_COLL_SUM:                                              \
+    COLL_COMBINE_LOOP(T, a[i] + b[i]); return;                          \
+  case CHPL_COMM_COLL_PROD:                                             \
+    COLL_COMBINE_LOOP(T, a[i] * b[i]); return;                          \
+  case CHPL_COMM_COLL_MIN:                                              \
+    COLL_COMBINE_LOOP(T, (b[i] < a[i]) ? b[i] : a[i]); return;          \
+  case CHPL_COMM_COLL_MAX:                                              \
+    COLL_COMBINE_LOOP(T, (b[i] > a[i]) ? b[i] : a[i]); return;
+
+#define COLL_COMBINE_INT(T)                                             \
+  switch (op) {                                                         \
+  COLL_COMBINE_ARITH(T)                                                 \
+  case CHPL_COMM_COLL_BAND:                                             \
+    COLL_COMBINE_LOOP(T, a[i] & b[i]); return;                          \
+  case CHPL_COMM_COLL_BOR:                                              \
+    COLL_COMBINE_LOOP(T, a[i] | b[i]); return;                          \
+  case CHPL_COMM_COLL_BXOR:                                             \
+    COLL_COMBINE_LOOP(T, a[i] ^ b[i]); return;                          \
+  }                                                                     \
+  break
+
+#define COLL_COMBINE_REAL(T)                                            \
+  switch (op) {                                                         \
+  COLL_COMBINE_ARITH(T)                                                 \
+  default:                                                              \
+    break;                                                              \
+  }                                                                     \
+  break
+
+static
+void coll_combine(chpl_comm_coll_type_t type, chpl_comm_coll_op_t op,
+                  void* acc, const void* in, size_t count) {
+  switch (type) {
+  case CHPL_COMM_COLL_INT32:  COLL_COMBINE_INT(int32_t);
+  case CHPL_COMM_COLL_INT64:  COLL_COMBINE_INT(int64_t);
+  case CHPL_COMM_COLL_UINT32: COLL_COMBINE_INT(uint32_t);
+  case CHPL_COMM_COLL_UINT64: COLL_COMBINE_INT(uint64_t);
+  case CHPL_COMM_COLL_REAL32: COLL_COMBINE_REAL(_real32);
+  case CHPL_COMM_COLL_REAL64: COLL_COMBINE_REAL(_real64);
+  }
+  chpl_internal_error("unsupported collective reduction");
+}
+
+#undef COLL_COMBINE_REAL
+#undef COLL_COMBINE_INT
+#undef COLL_COMBINE_ARITH
+#undef COLL_COMBINE_LOOP
+
+void chpl_comm_coll_allreduce(void* buf, size_t count,
+                              chpl_comm_coll_type_t type,
+                              chpl_comm_coll_op_t op) {
+  c_nodeid_t children[CHPL_COMM_BCAST_MAX_FANOUT];
+  const int numChildren = coll_tree_children(children);
+  const size_t eltSize = coll_type_size(type);
+  const size_t maxCount = collSlotSize / eltSize;
+  size_t start;
+  int i;
+
+  if ((type == CHPL_COMM_COLL_REAL32 || type == CHPL_COMM_COLL_REAL64)
+      && (op == CHPL_COMM_COLL_BAND || op == CHPL_COMM_COLL_BOR
+          || op == CHPL_COMM_COLL_BXOR)) {
+    chpl_internal_error("bitwise collective reduction of real values");
+  }
+
+  //
+  // Combine our children's contributions into ours in child order, so
+  // that the combining order only depends on the tree shape.
+  //
+  for (start = 0; start < count; start += maxCount) {
+    size_t thisCount = count - start;
+    char* p = (char*) buf + start * eltSize;
+    const uint64_t seq = ++collTreeSeq;
+
+    if (thisCount > maxCount)
+      thisCount = maxCount;
+
+    coll_wait_up(numChildren, seq);
+    for (i = 0; i < numChildren; i++) {
+      coll_combine(type, op, p, collArea->data + (i + 1) * collSlotSize,
+                   thisCount);
+    }
+    if (chpl_nodeID != 0) {
+      coll_send_up(p, thisCount * eltSize,
+                   (coll_child_idx(chpl_nodeID) + 1) * collSlotSize, seq);
+      coll_wait_down(seq);
+      memcpy(p, collArea->data, thisCount * eltSize);
+    }
+    coll_send_down(children, numChildren, p, thisCount * eltSize, seq);
+  }
+}
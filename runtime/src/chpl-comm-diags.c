@@ -24,19 +24,31 @@
 #include "chplrt.h"
 #include "chpl-env-gen.h"
 
+#include "chpl-cache.h"
 #include "chpl-comm.h"
 #include "chpl-comm-diags.h"
 #include "chpl-comm-internal.h"
+#include "chpl-env.h"
+#include "chpl-linefile-support.h"
 #include "chpl-mem-consistency.h"
+#include "chpl-mem-sys.h"
+#include "chpl-tasks.h"
+#include "chpl-thread-local-storage.h"
 #include "error.h"
 
+#include <inttypes.h>
+#include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 int chpl_verbose_comm = 0;
 int chpl_comm_diagnostics = 0;
 int chpl_comm_diags_print_unstable = 0;
+int chpl_comm_cache_stats = 0;
+int chpl_comm_diags_profile = 0;
 
 static pthread_once_t bcastPrintUnstable_once = PTHREAD_ONCE_INIT;
 
@@ -134,3 +146,427 @@ void chpl_comm_resetDiagnosticsHere() {
 void chpl_comm_getDiagnosticsHere(chpl_commDiagnostics *cd) {
   chpl_comm_diags_copy(cd);
 }
+
+
+void chpl_comm_startCacheStats() {
+  chpl_comm_cache_stats = 1;
+  chpl_comm_diags_disable();
+  chpl_comm_bcast_rt_private(chpl_comm_cache_stats);
+  chpl_comm_diags_enable();
+}
+
+
+void chpl_comm_stopCacheStats() {
+  chpl_comm_cache_stats = 0;
+  chpl_comm_diags_disable();
+  chpl_comm_bcast_rt_private(chpl_comm_cache_stats);
+  chpl_comm_diags_enable();
+}
+
+
+void chpl_comm_startCacheStatsHere() {
+  chpl_comm_cache_stats = 1;
+}
+
+
+void chpl_comm_stopCacheStatsHere() {
+  chpl_comm_cache_stats = 0;
+}
+
+
+void chpl_comm_resetCacheStatsHere() {
+#ifdef HAS_CHPL_CACHE_FNS
+  chpl_cache_resetStats();
+#endif
+}
+
+
+void chpl_comm_getCacheStatsHere(chpl_cacheStats *cs) {
+#ifdef HAS_CHPL_CACHE_FNS
+  chpl_cache_getStats(cs);
+#else
+  memset(cs, 0, sizeof(*cs));
+#endif
+}
+
+
+////////////////////////////////////////
+//
+// Per-call-site communication profiling
+//
+
+//
+// Each thread records into its own open-addressed hash table, so the
+// only synchronization is an uncontended lock that lets a report read
+// the tables of other threads.  All the tables on a node are on a
+// list, and are never freed.  What a task is waiting for between
+// prof_begin() and prof_end() is kept in its task private data
+// instead, because the task may be switched to another thread while it
+// waits.
+//
+typedef struct {
+  const char* op;          // NULL if this slot is unused
+  int32_t fn;
+  int ln;
+  c_nodeid_t node;
+  uint64_t count;
+  uint64_t bytes;
+  uint64_t wait_ns;
+} prof_bucket_t;
+
+typedef struct prof_table_s {
+  pthread_mutex_t lock;
+  size_t size;             // number of slots, a power of 2
+  size_t used;
+  prof_bucket_t* buckets;
+  struct prof_table_s* next;
+} prof_table_t;
+
+static pthread_mutex_t prof_tables_lock = PTHREAD_MUTEX_INITIALIZER;
+static prof_table_t* prof_tables;
+CHPL_TLS_DECL(prof_table_t*, prof_table);
+
+static const char* prof_report = NULL;  // CHPL_RT_COMM_PROFILE
+
+static
+uint64_t prof_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static
+size_t prof_hash(const char* op, c_nodeid_t node, int ln, int32_t fn) {
+  uint64_t h = (uintptr_t) op;
+  h = (h ^ (uint64_t) ln) * 0x9e3779b97f4a7c15ULL;
+  h = (h ^ (uint64_t) fn) * 0x9e3779b97f4a7c15ULL;
+  h = (h ^ (uint64_t) node) * 0x9e3779b97f4a7c15ULL;
+  return (size_t) (h >> 32);
+}
+
+static
+prof_bucket_t* prof_find(prof_bucket_t* buckets, size_t size,
+                         const char* op, c_nodeid_t node,
+                         int ln, int32_t fn) {
+  size_t i = prof_hash(op, node, ln, fn) & (size - 1);
+  while (buckets[i].op != NULL
+         && (buckets[i].op != op || buckets[i].node != node
+             || buckets[i].ln != ln || buckets[i].fn != fn)) {
+    i = (i + 1) & (size - 1);
+  }
+  return &buckets[i];
+}
+
+static
+void prof_grow(prof_table_t* t) {
+  size_t new_size = (t->size == 0) ? 256 : 2 * t->size;
+  prof_bucket_t* new_buckets = sys_calloc(new_size, sizeof(*new_buckets));
+  if (new_buckets == NULL) {
+    chpl_internal_error("cannot allocate comm profile table");
+  }
+  for (size_t i = 0; i < t->size; i++) {
+    prof_bucket_t* b = &t->buckets[i];
+    if (b->op != NULL) {
+      *prof_find(new_buckets, new_size, b->op, b->node, b->ln, b->fn) = *b;
+    }
+  }
+  sys_free(t->buckets);
+  t->buckets = new_buckets;
+  t->size = new_size;
+}
+
+// The task's comm profiling state, or NULL before tasking is up.
+static
+chpl_comm_diags_taskPrvData_t* prof_task_data(void) {
+  chpl_task_prvData_t* p = chpl_task_getPrvData();
+  return (p == NULL) ? NULL : &p->comm_data.diags_data;
+}
+
+static
+prof_table_t* prof_my_table(void) {
+  prof_table_t* t = CHPL_TLS_GET(prof_table);
+  if (t == NULL) {
+    if ((t = sys_calloc(1, sizeof(*t))) == NULL) {
+      chpl_internal_error("cannot allocate comm profile table");
+    }
+    pthread_mutex_init(&t->lock, NULL);
+    pthread_mutex_lock(&prof_tables_lock);
+    t->next = prof_tables;
+    prof_tables = t;
+    pthread_mutex_unlock(&prof_tables_lock);
+    CHPL_TLS_SET(prof_table, t);
+  }
+  return t;
+}
+
+
+// Find or add the bucket for an operation.  The caller holds t->lock.
+static
+prof_bucket_t* prof_bucket(prof_table_t* t, const char* op,
+                           c_nodeid_t node, int ln, int32_t fn) {
+  prof_bucket_t* b;
+
+  if (2 * (t->used + 1) > t->size) {
+    prof_grow(t);
+  }
+  b = prof_find(t->buckets, t->size, op, node, ln, fn);
+  if (b->op == NULL) {
+    b->op = op;
+    b->node = node;
+    b->ln = ln;
+    b->fn = fn;
+    t->used++;
+  }
+  return b;
+}
+
+
+void chpl_comm_diags_prof_record(const char* op, c_nodeid_t node,
+                                 size_t size, int ln, int32_t fn) {
+  prof_table_t* t = prof_my_table();
+  prof_bucket_t* b;
+
+  pthread_mutex_lock(&t->lock);
+  b = prof_bucket(t, op, node, ln, fn);
+  b->count++;
+  b->bytes += size;
+  pthread_mutex_unlock(&t->lock);
+
+  chpl_comm_diags_taskPrvData_t* d = prof_task_data();
+  if (d != NULL && d->pending_start != 0 && d->pending_op == NULL) {
+    d->pending_op = op;
+    d->pending_node = node;
+    d->pending_ln = ln;
+    d->pending_fn = fn;
+  }
+}
+
+
+void chpl_comm_diags_prof_do_begin(void) {
+  chpl_comm_diags_taskPrvData_t* d = prof_task_data();
+  if (d != NULL) {
+    d->pending_op = NULL;
+    d->pending_start = prof_now_ns();
+  }
+}
+
+
+//
+// Charge the wait to the pending operation's bucket in the table of
+// the thread the task is on now.  That may not be the table the
+// operation was counted in, but reports combine the tables.
+//
+void chpl_comm_diags_prof_do_end(void) {
+  chpl_comm_diags_taskPrvData_t* d = prof_task_data();
+  if (d == NULL) {
+    return;
+  }
+  if (d->pending_start != 0 && d->pending_op != NULL) {
+    prof_table_t* t = prof_my_table();
+    prof_bucket_t* b;
+
+    pthread_mutex_lock(&t->lock);
+    b = prof_bucket(t, d->pending_op, d->pending_node,
+                    d->pending_ln, d->pending_fn);
+    b->wait_ns += prof_now_ns() - d->pending_start;
+    pthread_mutex_unlock(&t->lock);
+  }
+  d->pending_op = NULL;
+  d->pending_start = 0;
+}
+
+
+//
+// Gather the buckets of all threads, combining those for the same
+// call site, operation, and destination.  Returns the number of
+// buckets in *result, which the caller must free.
+//
+static
+int prof_cmp_site(const void* p1, const void* p2) {
+  const prof_bucket_t* b1 = p1;
+  const prof_bucket_t* b2 = p2;
+  int c;
+  if (b1->fn != b2->fn) return (b1->fn < b2->fn) ? -1 : 1;
+  if (b1->ln != b2->ln) return (b1->ln < b2->ln) ? -1 : 1;
+  if ((c = strcmp(b1->op, b2->op)) != 0) return c;
+  if (b1->node != b2->node) return (b1->node < b2->node) ? -1 : 1;
+  return 0;
+}
+
+static
+int prof_cmp_count(const void* p1, const void* p2) {
+  const prof_bucket_t* b1 = p1;
+  const prof_bucket_t* b2 = p2;
+  if (b1->count != b2->count) return (b1->count > b2->count) ? -1 : 1;
+  if (b1->bytes != b2->bytes) return (b1->bytes > b2->bytes) ? -1 : 1;
+  return prof_cmp_site(p1, p2);
+}
+
+static
+size_t prof_gather(prof_bucket_t** result) {
+  prof_bucket_t* all;
+  size_t n = 0, len = 0;
+
+  pthread_mutex_lock(&prof_tables_lock);
+  for (prof_table_t* t = prof_tables; t != NULL; t = t->next) {
+    pthread_mutex_lock(&t->lock);
+    len += t->used;
+    pthread_mutex_unlock(&t->lock);
+  }
+
+  // Threads may add buckets while we copy, so just skip any extras.
+  if ((all = sys_calloc(len + 1, sizeof(*all))) == NULL) {
+    chpl_internal_error("cannot allocate comm profile report");
+  }
+  for (prof_table_t* t = prof_tables; t != NULL; t = t->next) {
+    pthread_mutex_lock(&t->lock);
+    for (size_t i = 0; i < t->size && n < len; i++) {
+      if (t->buckets[i].op != NULL) {
+        all[n++] = t->buckets[i];
+      }
+    }
+    pthread_mutex_unlock(&t->lock);
+  }
+  pthread_mutex_unlock(&prof_tables_lock);
+
+  if (n > 0) {
+    size_t m = 0;
+    qsort(all, n, sizeof(*all), prof_cmp_site);
+    for (size_t i = 1; i < n; i++) {
+      if (prof_cmp_site(&all[m], &all[i]) == 0) {
+        all[m].count += all[i].count;
+        all[m].bytes += all[i].bytes;
+        all[m].wait_ns += all[i].wait_ns;
+      } else {
+        all[++m] = all[i];
+      }
+    }
+    n = m + 1;
+    qsort(all, n, sizeof(*all), prof_cmp_count);
+  }
+
+  *result = all;
+  return n;
+}
+
+static
+void prof_print(FILE* f) {
+  prof_bucket_t* all;
+  size_t n = prof_gather(&all);
+
+  fprintf(f, "%" PRI_c_nodeid_t ": comm profile, %zu call sites\n",
+          chpl_nodeID, n);
+  if (n > 0) {
+    fprintf(f, "%" PRI_c_nodeid_t ": %12s %14s %12s %-26s %6s  %s\n",
+            chpl_nodeID, "count", "bytes", "wait (us)", "operation", "node",
+            "location");
+  }
+  for (size_t i = 0; i < n; i++) {
+    fprintf(f, "%" PRI_c_nodeid_t ": %12" PRIu64 " %14" PRIu64 " %12.1f "
+            "%-26s %6" PRI_c_nodeid_t "  %s:%d\n",
+            chpl_nodeID, all[i].count, all[i].bytes, all[i].wait_ns / 1e3,
+            all[i].op, all[i].node,
+            chpl_lookupFilename(all[i].fn), all[i].ln);
+  }
+  fflush(f);
+  sys_free(all);
+}
+
+static
+void prof_write_csv(const char* prefix) {
+  char path[1024];
+  prof_bucket_t* all;
+  size_t n;
+  FILE* f;
+
+  snprintf(path, sizeof(path), "%s.%" PRI_c_nodeid_t, prefix, chpl_nodeID);
+  if ((f = fopen(path, "w")) == NULL) {
+    char msg[1100];
+    snprintf(msg, sizeof(msg), "cannot open comm profile file %s", path);
+    chpl_warning(msg, 0, 0);
+    return;
+  }
+
+  n = prof_gather(&all);
+  fprintf(f, "node,file,line,op,dest,count,bytes,wait_ns\n");
+  for (size_t i = 0; i < n; i++) {
+    fprintf(f, "%" PRI_c_nodeid_t ",\"%s\",%d,\"%s\",%" PRI_c_nodeid_t
+            ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 "\n",
+            chpl_nodeID, chpl_lookupFilename(all[i].fn), all[i].ln,
+            all[i].op, all[i].node,
+            all[i].count, all[i].bytes, all[i].wait_ns);
+  }
+  fclose(f);
+  sys_free(all);
+}
+
+
+void chpl_comm_diags_profile_init(void) {
+  CHPL_TLS_INIT(prof_table);
+
+  prof_report = chpl_env_rt_get("COMM_PROFILE", NULL);
+  if (prof_report != NULL && prof_report[0] != '\0') {
+    chpl_comm_diags_profile = 1;
+  } else {
+    prof_report = NULL;
+  }
+}
+
+
+void chpl_comm_diags_profile_exit(void) {
+  if (prof_report == NULL) {
+    return;
+  }
+
+  chpl_comm_diags_profile = 0;
+  if (strcmp(prof_report, "stdout") == 0) {
+    prof_print(stdout);
+  } else {
+    prof_write_csv(prof_report);
+  }
+}
+
+
+void chpl_comm_startProfile() {
+  chpl_comm_diags_profile = 1;
+  chpl_comm_diags_disable();
+  chpl_comm_bcast_rt_private(chpl_comm_diags_profile);
+  chpl_comm_diags_enable();
+}
+
+
+void chpl_comm_stopProfile() {
+  chpl_comm_diags_profile = 0;
+  chpl_comm_diags_disable();
+  chpl_comm_bcast_rt_private(chpl_comm_diags_profile);
+  chpl_comm_diags_enable();
+}
+
+
+void chpl_comm_startProfileHere() {
+  chpl_comm_diags_profile = 1;
+}
+
+
+void chpl_comm_stopProfileHere() {
+  chpl_comm_diags_profile = 0;
+}
+
+
+void chpl_comm_resetProfileHere() {
+  pthread_mutex_lock(&prof_tables_lock);
+  for (prof_table_t* t = prof_tables; t != NULL; t = t->next) {
+    pthread_mutex_lock(&t->lock);
+    if (t->buckets != NULL) {
+      memset(t->buckets, 0, t->size * sizeof(t->buckets[0]));
+    }
+    t->used = 0;
+    pthread_mutex_unlock(&t->lock);
+  }
+  pthread_mutex_unlock(&prof_tables_lock);
+}
+
+
+void chpl_comm_printProfileHere() {
+  prof_print(stdout);
+}
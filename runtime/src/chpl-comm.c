@@ -52,41 +52,66 @@ void chpl_comm_register_global_var(int i, wide_ptr_t *ptr_to_wide_ptr) {
 void chpl_comm_broadcast_global_vars(int numGlobals) {
   //
   // On node 0: gather up the global variables' wide pointers into a
-  //            buffer; return that buffer if it needs deallocating
-  //            after the communication, otherwise NULL.
-  // On other nodes: retrieve the node 0 local address of that buffer.
+  //            buffer.
+  // On all nodes: have the comm layer broadcast that buffer to the
+  //               others.  It uses a spanning tree to do so, so that
+  //               node 0 doesn't have to serve every other node itself.
   //
-  wide_ptr_t* buf_on_0;
-  buf_on_0 = chpl_comm_broadcast_global_vars_helper();
+  wide_ptr_t* buf;
+  size_t size = chpl_numGlobalsOnHeap * sizeof(*buf);
+  buf = (wide_ptr_t*)
+        chpl_mem_alloc(size, CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
+  if (chpl_nodeID == 0) {
+    for (int i = 0; i < chpl_numGlobalsOnHeap; i++) {
+      buf[i] = *chpl_globals_registry[i];
+    }
+  }
+
+  chpl_comm_broadcast_global_vars_helper(buf);
 
   //
-  // On node 0: barrier to ensure the other nodes have the global vars;
-  //            free the buffer if needed.
-  // On other nodes: GET the buffer of wide pointers; scatter it into
-  //                 our copies of the global vars; barrier to indicate
-  //                 we're done.  Node 0 could actually free the buffer
-  //                 as soon as we GET it, but we also have to prevent
-  //                 node 0 from running any Chapel code until all the
-  //                 other nodes have recorded the wide pointers.  So,
-  //                 we delay our barrier to achieve both goals.
+  // On other nodes: scatter the buffer into our copies of the global
+  //                 vars.
+  // On all nodes: barrier to prevent node 0 from running any Chapel
+  //               code until all the other nodes have recorded the
+  //               wide pointers.
   //
-  if (chpl_nodeID == 0) {
-    chpl_comm_barrier("broadcast global vars");
-    if (buf_on_0 != NULL) {
-      chpl_mem_free(buf_on_0, 0, 0);
-    }
-  } else {
-    wide_ptr_t* buf;
-    size_t size = chpl_numGlobalsOnHeap * sizeof(*buf);
-    buf = (wide_ptr_t*)
-          chpl_mem_alloc(size, CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
-    chpl_comm_get(buf, 0, buf_on_0, size, CHPL_COMM_UNKNOWN_ID, 0, -1);
+  if (chpl_nodeID != 0) {
     for (int i = 0; i < chpl_numGlobalsOnHeap; i++) {
       *chpl_globals_registry[i] = buf[i];
     }
-    chpl_comm_barrier("broadcast global vars");
-    chpl_mem_free(buf, 0, 0);
   }
+  chpl_comm_barrier("broadcast global vars");
+  chpl_mem_free(buf, 0, 0);
+}
+
+
+static pthread_once_t bcastFanout_once = PTHREAD_ONCE_INIT;
+static int bcastFanout;
+
+static
+void set_bcastFanout(void)
+{
+  const char* ev = "COMM_BCAST_FANOUT";
+
+  int64_t fanout = chpl_env_rt_get_int(ev, 4);
+  if (fanout < 1) {
+    chpl_warning("CHPL_RT_COMM_BCAST_FANOUT must be positive; using 1",
+                 0, 0);
+    fanout = 1;
+  } else if (fanout > CHPL_COMM_BCAST_MAX_FANOUT) {
+    fanout = CHPL_COMM_BCAST_MAX_FANOUT;
+  }
+  bcastFanout = (int) fanout;
+}
+
+int chpl_comm_bcast_fanout(void)
+{
+  if (pthread_once(&bcastFanout_once, set_bcastFanout) != 0) {
+    chpl_internal_error("pthread_once(&bcastFanout_once) failed");
+  }
+
+  return bcastFanout;
 }
 
 
@@ -25,6 +25,8 @@
 #include "chplcgfns.h"
 #include "chpl-cache.h"
 #include "chpl-comm.h"
+#include "chpl-comm-coll.h"
+#include "chpl-comm-diags.h"
 #include "chplexit.h"
 #include "chplio.h"
 #include "chpl-init.h"
@@ -32,6 +34,7 @@
 #include "chplmemtrack.h"
 #include "chpl-privatization.h"
 #include "chpl-tasks.h"
+#include "chpl-tasks-prof.h"
 #include "chpl-topo.h"
 #include "chpl-linefile-support.h"
 #include "chplsys.h"
@@ -198,10 +201,13 @@ void chpl_rt_init(int argc, char* argv[]) {
   // tasking layer is initialized.
   //
   chpl_comm_post_task_init();
+  chpl_comm_diags_profile_init();
+  chpl_task_prof_init();
 #ifdef HAS_CHPL_CACHE_FNS
   chpl_cache_init();
 #endif
   chpl_comm_rollcall();
+  chpl_comm_coll_init();
 
   //
   // Make sure the runtime is fully set up on all locales before we start
@@ -19,74 +19,154 @@
 
 #include "chplrt.h"
 #include "chpl-privatization.h"
+#include "chpl-atomics.h"
 #include "chpl-mem.h"
-#include "chpl-tasks.h"
 
-static int64_t chpl_capPrivateObjects = 0;
-static chpl_sync_aux_t privatizationSync;
+chpl_privateObject_t* chpl_privateObjects[CHPL_PRIVATIZATION_NUM_SEGS];
 
-chpl_privateObject_t* chpl_privateObjects = NULL;
+//
+// Free list of pids, used only on node 0.  It is a lock-free stack
+// whose links are kept in a segmented table shaped like the one for the
+// objects.  The head holds the top pid+1 (0 when the list is empty) in
+// its low bits and a count that changes on every push and pop in its
+// high bits, so that a pop can't succeed using a stale link if the top
+// pid was popped and pushed again in the meantime.
+//
+static atomic_int_least64_t nextPid;
+static atomic_uint_least64_t freePidHead;
+static int64_t* freePidLinks[CHPL_PRIVATIZATION_NUM_SEGS];
+
+#define FREE_PID_BITS 40
+#define FREE_PID_MASK ((((uint_least64_t) 1) << FREE_PID_BITS) - 1)
+#define FREE_PID_TAG_ONE (((uint_least64_t) 1) << FREE_PID_BITS)
 
 void chpl_privatization_init(void) {
-    chpl_sync_initAux(&privatizationSync);
+  atomic_init_int_least64_t(&nextPid, 0);
+  atomic_init_uint_least64_t(&freePidHead, 0);
+}
+
+//
+// Return the given segment of the object or free list link table,
+// allocating it first if need be.  If more than one task tries to
+// allocate the same segment at once, one of them wins and the others
+// free theirs.
+//
+static inline
+void* allocSeg(int seg, size_t eltSize) {
+  return chpl_mem_allocManyZero((size_t) 1
+                                << (seg + CHPL_PRIVATIZATION_SEG0_LOG2),
+                                eltSize, CHPL_RT_MD_COMM_PRV_OBJ_ARRAY, 0, 0);
+}
+
+static
+chpl_privateObject_t* getObjSeg(int seg) {
+  chpl_privateObject_t* p = chpl_privateObjects[seg];
+  if (p == NULL) {
+    chpl_privateObject_t* newSeg = allocSeg(seg, sizeof(*p));
+    if (__sync_bool_compare_and_swap(&chpl_privateObjects[seg], NULL, newSeg)) {
+      p = newSeg;
+    } else {
+      chpl_mem_free(newSeg, 0, 0);
+      p = chpl_privateObjects[seg];
+    }
+  }
+  return p;
 }
 
-static inline int64_t max(int64_t a, int64_t b) {
-  return a > b ? a : b;
+static
+int64_t* getLinkSeg(int seg) {
+  int64_t* p = freePidLinks[seg];
+  if (p == NULL) {
+    int64_t* newSeg = allocSeg(seg, sizeof(*p));
+    if (__sync_bool_compare_and_swap(&freePidLinks[seg], NULL, newSeg)) {
+      p = newSeg;
+    } else {
+      chpl_mem_free(newSeg, 0, 0);
+      p = freePidLinks[seg];
+    }
+  }
+  return p;
 }
 
 // Note that this function can be called in parallel and more notably it can be
 // called with non-monotonic pid's. e.g. this may be called with pid 27, and
-// then pid 2, so it has to ensure that the privatized array has at least pid+1
-// elements. Be __very__ careful if you have to update it.
+// then pid 2, so it has to make sure the segment holding pid exists.  Be
+// __very__ careful if you have to update it.
 void chpl_newPrivatizedClass(void* v, int64_t pid) {
-  chpl_sync_lock(&privatizationSync);
-
-  // initialize array to a default size
-  if (chpl_privateObjects == NULL) {
-    chpl_capPrivateObjects = 2*max(pid, 4);
-    chpl_privateObjects =
-        chpl_mem_allocManyZero(chpl_capPrivateObjects,
-                               sizeof(chpl_privateObject_t),
-                               CHPL_RT_MD_COMM_PRV_OBJ_ARRAY, 0, 0);
-  } else {
-    // if we're out of space, double (or more) the array size
-    if (pid >= chpl_capPrivateObjects) {
-      chpl_privateObject_t* tmp;
-      int64_t oldCap;
-
-      oldCap = chpl_capPrivateObjects;
-      chpl_capPrivateObjects = 2*max(pid, oldCap);
-
-      tmp = chpl_mem_allocManyZero(chpl_capPrivateObjects,
-                                   sizeof(chpl_privateObject_t),
-                                   CHPL_RT_MD_COMM_PRV_OBJ_ARRAY, 0, 0);
-      chpl_memcpy((void*)tmp, (void*)chpl_privateObjects,
-                  (oldCap)*sizeof(chpl_privateObject_t));
-      chpl_privateObjects = tmp;
-      // purposely leak old copies of chpl_privateObject to avoid the need to
-      // lock chpl_getPrivatizedClass; TODO: fix with lock free data structure
-    }
-  }
-  chpl_privateObjects[pid].obj = v;
+  int seg;
+  int64_t off;
 
-  chpl_sync_unlock(&privatizationSync);
+  chpl_privatization_pidToSeg(pid, &seg, &off);
+  getObjSeg(seg)[off].obj = v;
 }
 
 void chpl_clearPrivatizedClass(int64_t i) {
-  chpl_sync_lock(&privatizationSync);
-  chpl_privateObjects[i].obj = NULL;
-  chpl_sync_unlock(&privatizationSync);
+  int seg;
+  int64_t off;
+
+  chpl_privatization_pidToSeg(i, &seg, &off);
+  if (chpl_privateObjects[seg] != NULL)
+    chpl_privateObjects[seg][off].obj = NULL;
 }
 
 // Used to check for leaks of privatized classes
 int64_t chpl_numPrivatizedClasses(void) {
   int64_t ret = 0;
-  chpl_sync_lock(&privatizationSync);
-  for (int64_t i = 0; i < chpl_capPrivateObjects; i++) {
-    if (chpl_privateObjects[i].obj)
-      ret++;
+  for (int seg = 0; seg < CHPL_PRIVATIZATION_NUM_SEGS; seg++) {
+    chpl_privateObject_t* segObjs = chpl_privateObjects[seg];
+    if (segObjs == NULL)
+      continue;
+    for (int64_t i = 0;
+         i < ((int64_t) 1 << (seg + CHPL_PRIVATIZATION_SEG0_LOG2));
+         i++) {
+      if (segObjs[i].obj)
+        ret++;
+    }
   }
-  chpl_sync_unlock(&privatizationSync);
   return ret;
 }
+
+int64_t chpl_newPrivatizedPid(void) {
+  uint_least64_t head = atomic_load_uint_least64_t(&freePidHead);
+  while ((head & FREE_PID_MASK) != 0) {
+    const int64_t pid = (int64_t) (head & FREE_PID_MASK) - 1;
+    int seg;
+    int64_t off;
+
+    // The link may be overwritten while we read it, if another task pops
+    // this pid and pushes it back.  But then the tag will have changed
+    // and the exchange will fail.
+    chpl_privatization_pidToSeg(pid, &seg, &off);
+    const uint_least64_t next = freePidLinks[seg][off];
+    const uint_least64_t newHead = ((head & ~FREE_PID_MASK) + FREE_PID_TAG_ONE)
+                                   | next;
+    if (atomic_compare_exchange_strong_uint_least64_t(&freePidHead,
+                                                      head, newHead)) {
+      return pid;
+    }
+    head = atomic_load_uint_least64_t(&freePidHead);
+  }
+
+  return atomic_fetch_add_int_least64_t(&nextPid, 1);
+}
+
+void chpl_freePrivatizedPid(int64_t pid) {
+  // Pids too big to fit in the free list just aren't reused.
+  if ((uint_least64_t) pid + 1 > FREE_PID_MASK)
+    return;
+
+  int seg;
+  int64_t off;
+  chpl_privatization_pidToSeg(pid, &seg, &off);
+  int64_t* link = &getLinkSeg(seg)[off];
+
+  uint_least64_t head;
+  uint_least64_t newHead;
+  do {
+    head = atomic_load_uint_least64_t(&freePidHead);
+    *link = (int64_t) (head & FREE_PID_MASK);
+    newHead = ((head & ~FREE_PID_MASK) + FREE_PID_TAG_ONE)
+              | (uint_least64_t) (pid + 1);
+  } while (!atomic_compare_exchange_strong_uint_least64_t(&freePidHead,
+                                                          head, newHead));
+}
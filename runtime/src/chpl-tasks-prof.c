@@ -0,0 +1,538 @@
+/*
+ * Copyright 2004-2020 Hewlett Packard Enterprise Development LP
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chplrt.h"
+
+#include "chpl-comm.h"
+#include "chpl-env.h"
+#include "chpl-linefile-support.h"
+#include "chpl-mem-sys.h"
+#include "chpl-tasks-callbacks.h"
+#include "chpl-tasks-prof.h"
+#include "chpl-thread-local-storage.h"
+#include "error.h"
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+static const char* prof_report = NULL;  // CHPL_RT_TASK_PROFILE
+static volatile int prof_on = 0;
+
+static
+uint64_t prof_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+
+////////////////////
+//
+// Live tasks
+//
+// The create, begin, and end events for a task can each happen on a
+// different thread, so the times of the first two are kept in a table
+// keyed by task ID until the task ends.  The table is split into
+// shards by ID, each with its own lock, so that threads creating and
+// running tasks at the same time rarely contend.
+//
+typedef struct task_rec_s {
+  uint64_t id;
+  uint64_t create_ns;      // 0 if we did not see the task created
+  uint64_t begin_ns;
+  struct task_rec_s* next;
+} task_rec_t;
+
+typedef struct {
+  pthread_mutex_t lock;
+  size_t size;             // number of chains, a power of 2
+  size_t used;
+  task_rec_t** heads;
+  task_rec_t* free;
+} task_shard_t;
+
+#define NUM_TASK_SHARDS 64
+
+static task_shard_t task_shards[NUM_TASK_SHARDS];
+
+static inline
+task_shard_t* task_shard(uint64_t id) {
+  return &task_shards[id % NUM_TASK_SHARDS];
+}
+
+static inline
+task_rec_t** task_chain(task_shard_t* s, uint64_t id) {
+  return &s->heads[(id / NUM_TASK_SHARDS) & (s->size - 1)];
+}
+
+static
+void task_shard_grow(task_shard_t* s) {
+  size_t old_size = s->size;
+  task_rec_t** old_heads = s->heads;
+
+  s->size = (old_size == 0) ? 64 : 2 * old_size;
+  if ((s->heads = sys_calloc(s->size, sizeof(*s->heads))) == NULL) {
+    chpl_internal_error("cannot allocate task profile table");
+  }
+  for (size_t i = 0; i < old_size; i++) {
+    task_rec_t* r = old_heads[i];
+    while (r != NULL) {
+      task_rec_t* next = r->next;
+      task_rec_t** c = task_chain(s, r->id);
+      r->next = *c;
+      *c = r;
+      r = next;
+    }
+  }
+  sys_free(old_heads);
+}
+
+//
+// Find the record for a task, adding one if there isn't one yet.
+// The caller holds the shard lock.
+//
+static
+task_rec_t* task_rec_get(task_shard_t* s, uint64_t id) {
+  task_rec_t* r;
+  task_rec_t** c;
+
+  if (s->size > 0) {
+    for (r = *task_chain(s, id); r != NULL; r = r->next) {
+      if (r->id == id) {
+        return r;
+      }
+    }
+  }
+
+  if (s->used + 1 > s->size) {
+    task_shard_grow(s);
+  }
+  if ((r = s->free) != NULL) {
+    s->free = r->next;
+  } else if ((r = sys_malloc(sizeof(*r))) == NULL) {
+    chpl_internal_error("cannot allocate task profile record");
+  }
+  r->id = id;
+  r->create_ns = 0;
+  r->begin_ns = 0;
+  c = task_chain(s, id);
+  r->next = *c;
+  *c = r;
+  s->used++;
+  return r;
+}
+
+//
+// Remove the record for a task, returning a copy of it.  Returns 0
+// if there was no record.  The caller holds the shard lock.
+//
+static
+int task_rec_remove(task_shard_t* s, uint64_t id, task_rec_t* copy) {
+  if (s->size == 0) {
+    return 0;
+  }
+  for (task_rec_t** pr = task_chain(s, id); *pr != NULL;
+       pr = &(*pr)->next) {
+    task_rec_t* r = *pr;
+    if (r->id == id) {
+      *copy = *r;
+      *pr = r->next;
+      r->next = s->free;
+      s->free = r;
+      s->used--;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+
+////////////////////
+//
+// Spawn sites
+//
+// Finished tasks are charged to buckets in per-thread tables keyed by
+// (source line, file, on-statement or not), so the common case takes
+// only an uncontended lock.  The lock lets the report read the tables
+// of other threads.  All the tables on a node are on a list, and are
+// never freed.
+//
+typedef struct {
+  int32_t fn;
+  int ln;
+  int is_on;
+  uint64_t count;          // 0 if this slot is unused
+  uint64_t queue_ns;
+  uint64_t queue_max_ns;
+  uint64_t run_ns;
+  uint64_t run_max_ns;
+  uint64_t life_ns;
+} prof_site_t;
+
+typedef struct prof_table_s {
+  pthread_mutex_t lock;
+  size_t size;             // number of slots, a power of 2
+  size_t used;
+  prof_site_t* sites;
+  struct prof_table_s* next;
+} prof_table_t;
+
+static pthread_mutex_t prof_tables_lock = PTHREAD_MUTEX_INITIALIZER;
+static prof_table_t* prof_tables;
+CHPL_TLS_DECL(prof_table_t*, task_prof_table);
+
+static
+size_t prof_hash(int32_t fn, int ln, int is_on) {
+  uint64_t h = (uint64_t) ln;
+  h = (h ^ (uint64_t) fn) * 0x9e3779b97f4a7c15ULL;
+  h = (h ^ (uint64_t) is_on) * 0x9e3779b97f4a7c15ULL;
+  return (size_t) (h >> 32);
+}
+
+static
+prof_site_t* prof_find(prof_site_t* sites, size_t size,
+                       int32_t fn, int ln, int is_on) {
+  size_t i = prof_hash(fn, ln, is_on) & (size - 1);
+  while (sites[i].count != 0
+         && (sites[i].ln != ln || sites[i].fn != fn
+             || sites[i].is_on != is_on)) {
+    i = (i + 1) & (size - 1);
+  }
+  return &sites[i];
+}
+
+static
+void prof_grow(prof_table_t* t) {
+  size_t new_size = (t->size == 0) ? 64 : 2 * t->size;
+  prof_site_t* new_sites = sys_calloc(new_size, sizeof(*new_sites));
+  if (new_sites == NULL) {
+    chpl_internal_error("cannot allocate task profile table");
+  }
+  for (size_t i = 0; i < t->size; i++) {
+    prof_site_t* b = &t->sites[i];
+    if (b->count != 0) {
+      *prof_find(new_sites, new_size, b->fn, b->ln, b->is_on) = *b;
+    }
+  }
+  sys_free(t->sites);
+  t->sites = new_sites;
+  t->size = new_size;
+}
+
+static
+prof_table_t* prof_my_table(void) {
+  prof_table_t* t = CHPL_TLS_GET(task_prof_table);
+  if (t == NULL) {
+    if ((t = sys_calloc(1, sizeof(*t))) == NULL) {
+      chpl_internal_error("cannot allocate task profile table");
+    }
+    pthread_mutex_init(&t->lock, NULL);
+    pthread_mutex_lock(&prof_tables_lock);
+    t->next = prof_tables;
+    prof_tables = t;
+    pthread_mutex_unlock(&prof_tables_lock);
+    CHPL_TLS_SET(task_prof_table, t);
+  }
+  return t;
+}
+
+static
+void prof_record(int32_t fn, int ln, int is_on,
+                 uint64_t queue_ns, uint64_t run_ns, uint64_t life_ns) {
+  prof_table_t* t = prof_my_table();
+  prof_site_t* b;
+
+  pthread_mutex_lock(&t->lock);
+  if (2 * (t->used + 1) > t->size) {
+    prof_grow(t);
+  }
+  b = prof_find(t->sites, t->size, fn, ln, is_on);
+  if (b->count == 0) {
+    b->fn = fn;
+    b->ln = ln;
+    b->is_on = is_on;
+    t->used++;
+  }
+  b->count++;
+  b->queue_ns += queue_ns;
+  if (queue_ns > b->queue_max_ns) {
+    b->queue_max_ns = queue_ns;
+  }
+  b->run_ns += run_ns;
+  if (run_ns > b->run_max_ns) {
+    b->run_max_ns = run_ns;
+  }
+  b->life_ns += life_ns;
+  pthread_mutex_unlock(&t->lock);
+}
+
+
+////////////////////
+//
+// Tasking layer callbacks
+//
+static
+void prof_task_create(const chpl_task_cb_info_t* info) {
+  uint64_t id = info->iu.full.id;
+  task_shard_t* s = task_shard(id);
+  uint64_t now = prof_now_ns();
+
+  if (!prof_on) {
+    return;
+  }
+  pthread_mutex_lock(&s->lock);
+  task_rec_get(s, id)->create_ns = now;
+  pthread_mutex_unlock(&s->lock);
+}
+
+static
+void prof_task_begin(const chpl_task_cb_info_t* info) {
+  uint64_t id = info->iu.full.id;
+  task_shard_t* s = task_shard(id);
+  uint64_t now = prof_now_ns();
+
+  if (!prof_on) {
+    return;
+  }
+  pthread_mutex_lock(&s->lock);
+  task_rec_get(s, id)->begin_ns = now;
+  pthread_mutex_unlock(&s->lock);
+}
+
+static
+void prof_task_end(const chpl_task_cb_info_t* info) {
+  uint64_t id = info->iu.full.id;
+  task_shard_t* s = task_shard(id);
+  uint64_t now = prof_now_ns();
+  uint64_t queue_ns, run_ns, life_ns;
+  task_rec_t r;
+  int found;
+
+  if (!prof_on) {
+    return;
+  }
+  pthread_mutex_lock(&s->lock);
+  found = task_rec_remove(s, id, &r);
+  pthread_mutex_unlock(&s->lock);
+  if (!found || r.begin_ns == 0) {
+    return;
+  }
+
+  //
+  // Tasks that were created before profiling started are still
+  // counted, but they only contribute their run time.
+  //
+  run_ns = now - r.begin_ns;
+  if (r.create_ns != 0 && r.create_ns <= r.begin_ns) {
+    queue_ns = r.begin_ns - r.create_ns;
+    life_ns = now - r.create_ns;
+  } else {
+    queue_ns = 0;
+    life_ns = run_ns;
+  }
+  prof_record(info->iu.full.filename, info->iu.full.lineno,
+              info->iu.full.is_executeOn != 0, queue_ns, run_ns, life_ns);
+}
+
+
+////////////////////
+//
+// Reporting
+//
+// Gather the buckets of all threads, combining those for the same
+// spawn site.  Returns the number of sites in *result, which the
+// caller must free.
+//
+static
+int prof_cmp_site(const void* p1, const void* p2) {
+  const prof_site_t* b1 = p1;
+  const prof_site_t* b2 = p2;
+  if (b1->fn != b2->fn) return (b1->fn < b2->fn) ? -1 : 1;
+  if (b1->ln != b2->ln) return (b1->ln < b2->ln) ? -1 : 1;
+  if (b1->is_on != b2->is_on) return (b1->is_on < b2->is_on) ? -1 : 1;
+  return 0;
+}
+
+static
+int prof_cmp_count(const void* p1, const void* p2) {
+  const prof_site_t* b1 = p1;
+  const prof_site_t* b2 = p2;
+  if (b1->count != b2->count) return (b1->count > b2->count) ? -1 : 1;
+  return prof_cmp_site(p1, p2);
+}
+
+static
+size_t prof_gather(prof_site_t** result) {
+  prof_site_t* all;
+  size_t n = 0, len = 0;
+
+  pthread_mutex_lock(&prof_tables_lock);
+  for (prof_table_t* t = prof_tables; t != NULL; t = t->next) {
+    pthread_mutex_lock(&t->lock);
+    len += t->used;
+    pthread_mutex_unlock(&t->lock);
+  }
+
+  // Threads may add sites while we copy, so just skip any extras.
+  if ((all = sys_calloc(len + 1, sizeof(*all))) == NULL) {
+    chpl_internal_error("cannot allocate task profile report");
+  }
+  for (prof_table_t* t = prof_tables; t != NULL; t = t->next) {
+    pthread_mutex_lock(&t->lock);
+    for (size_t i = 0; i < t->size && n < len; i++) {
+      if (t->sites[i].count != 0) {
+        all[n++] = t->sites[i];
+      }
+    }
+    pthread_mutex_unlock(&t->lock);
+  }
+  pthread_mutex_unlock(&prof_tables_lock);
+
+  if (n > 0) {
+    size_t m = 0;
+    qsort(all, n, sizeof(*all), prof_cmp_site);
+    for (size_t i = 1; i < n; i++) {
+      if (prof_cmp_site(&all[m], &all[i]) == 0) {
+        all[m].count += all[i].count;
+        all[m].queue_ns += all[i].queue_ns;
+        all[m].run_ns += all[i].run_ns;
+        all[m].life_ns += all[i].life_ns;
+        if (all[i].queue_max_ns > all[m].queue_max_ns) {
+          all[m].queue_max_ns = all[i].queue_max_ns;
+        }
+        if (all[i].run_max_ns > all[m].run_max_ns) {
+          all[m].run_max_ns = all[i].run_max_ns;
+        }
+      } else {
+        all[++m] = all[i];
+      }
+    }
+    n = m + 1;
+    qsort(all, n, sizeof(*all), prof_cmp_count);
+  }
+
+  *result = all;
+  return n;
+}
+
+static
+void prof_print(FILE* f) {
+  prof_site_t* all;
+  size_t n = prof_gather(&all);
+
+  fprintf(f, "%" PRI_c_nodeid_t ": task profile, %zu spawn sites\n",
+          chpl_nodeID, n);
+  if (n > 0) {
+    fprintf(f, "%" PRI_c_nodeid_t ": %10s %12s %12s %12s %12s %12s %4s  %s\n",
+            chpl_nodeID, "tasks", "queue (us)", "max queue", "run (us)",
+            "max run", "life (us)", "kind", "location");
+  }
+  for (size_t i = 0; i < n; i++) {
+    double c = (double) all[i].count;
+    fprintf(f, "%" PRI_c_nodeid_t ": %10" PRIu64
+            " %12.1f %12.1f %12.1f %12.1f %12.1f %4s  %s:%d\n",
+            chpl_nodeID, all[i].count,
+            all[i].queue_ns / c / 1e3, all[i].queue_max_ns / 1e3,
+            all[i].run_ns / c / 1e3, all[i].run_max_ns / 1e3,
+            all[i].life_ns / c / 1e3,
+            all[i].is_on ? "on" : "task",
+            chpl_lookupFilename(all[i].fn), all[i].ln);
+  }
+  fflush(f);
+  sys_free(all);
+}
+
+static
+void prof_write_csv(const char* prefix) {
+  char path[1024];
+  prof_site_t* all;
+  size_t n;
+  FILE* f;
+
+  snprintf(path, sizeof(path), "%s.%" PRI_c_nodeid_t, prefix, chpl_nodeID);
+  if ((f = fopen(path, "w")) == NULL) {
+    char msg[1100];
+    snprintf(msg, sizeof(msg), "cannot open task profile file %s", path);
+    chpl_warning(msg, 0, 0);
+    return;
+  }
+
+  n = prof_gather(&all);
+  fprintf(f, "node,file,line,kind,tasks,queue_ns,queue_max_ns,"
+          "run_ns,run_max_ns,life_ns\n");
+  for (size_t i = 0; i < n; i++) {
+    fprintf(f, "%" PRI_c_nodeid_t ",\"%s\",%d,%s,%" PRIu64 ",%" PRIu64
+            ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 "\n",
+            chpl_nodeID, chpl_lookupFilename(all[i].fn), all[i].ln,
+            all[i].is_on ? "on" : "task", all[i].count,
+            all[i].queue_ns, all[i].queue_max_ns,
+            all[i].run_ns, all[i].run_max_ns, all[i].life_ns);
+  }
+  fclose(f);
+  sys_free(all);
+}
+
+
+void chpl_task_prof_init(void) {
+  prof_report = chpl_env_rt_get("TASK_PROFILE", NULL);
+  if (prof_report == NULL || prof_report[0] == '\0') {
+    prof_report = NULL;
+    return;
+  }
+
+  CHPL_TLS_INIT(task_prof_table);
+  for (int i = 0; i < NUM_TASK_SHARDS; i++) {
+    pthread_mutex_init(&task_shards[i].lock, NULL);
+  }
+
+  if (chpl_task_install_callback(chpl_task_cb_event_kind_create,
+                                 chpl_task_cb_info_kind_full,
+                                 prof_task_create) != 0
+      || chpl_task_install_callback(chpl_task_cb_event_kind_begin,
+                                    chpl_task_cb_info_kind_full,
+                                    prof_task_begin) != 0
+      || chpl_task_install_callback(chpl_task_cb_event_kind_end,
+                                    chpl_task_cb_info_kind_full,
+                                    prof_task_end) != 0) {
+    chpl_warning("cannot install task profile callbacks", 0, 0);
+    prof_report = NULL;
+    return;
+  }
+  prof_on = 1;
+}
+
+
+void chpl_task_prof_exit(void) {
+  if (prof_report == NULL) {
+    return;
+  }
+
+  prof_on = 0;
+  if (strcmp(prof_report, "stdout") == 0) {
+    prof_print(stdout);
+  } else {
+    prof_write_csv(prof_report);
+  }
+}
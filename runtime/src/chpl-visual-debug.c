@@ -28,6 +28,10 @@
 #include "chpl-tasks-callbacks.h"
 #include "chpl-comm-callbacks.h"
 #include "chpl-linefile-support.h"
+#include "chpl-mem-sys.h"
+#include "chpl-thread-local-storage.h"
+#include "error.h"
+#include <pthread.h>
 #include <stdint.h>
 #include <string.h>
 #include <unistd.h>
@@ -40,6 +44,7 @@
 #include <sys/stat.h>
 #include <sys/resource.h>
 #include <sys/param.h>
+#include <time.h>
 
 #include "chplcgfns.h"
 
@@ -86,6 +91,258 @@ int chpl_dprintf (int fd, const char * format, ...) {
   return -1;
 }
 
+//
+// Binary trace support.  Formatting and writing every event as it
+// happens distorts the timings we are trying to observe, so in binary
+// mode each thread appends fixed-size records to its own ring buffer
+// and a helper thread writes the rings to the file periodically.  A
+// thread whose ring fills up writes it out itself.  Timestamps come
+// from the monotonic clock, relative to the time in the ChplVdebug
+// record.  See tools/chplvis/BinaryDataFormat.txt for the layout.
+//
+
+typedef enum {
+  vdb_rec_task = 1,
+  vdb_rec_btask,
+  vdb_rec_etask,
+  vdb_rec_nb_put,
+  vdb_rec_nb_get,
+  vdb_rec_put,
+  vdb_rec_get,
+  vdb_rec_st_put,
+  vdb_rec_st_get,
+  vdb_rec_fork,
+  vdb_rec_fork_nb,
+  vdb_rec_f_fork,
+  vdb_rec_tag,
+  vdb_rec_pause,
+  vdb_rec_mark,
+  vdb_rec_tname,
+  vdb_rec_end
+} vdb_rec_kind_t;
+
+typedef struct {
+  uint64_t time;              // ns since start
+  uint64_t taskID;            // task logging the event
+  union {
+    struct {
+      uint64_t addr;
+      uint64_t raddr;
+      uint64_t length;
+      int32_t  remote;
+      int32_t  elemSize;
+    } ev;
+    char name[32];            // tname only, NUL padded
+  } u;
+  int32_t  id;                // commID, fid or tag number
+  int32_t  lineno;
+  int32_t  fileno;
+  uint16_t kind;              // vdb_rec_kind_t
+  uint16_t thread;            // ring (thread) that logged this
+} vdb_rec_t;
+
+#define VDB_RING_RECS 4096    // must be a power of 2
+
+typedef struct vdb_ring_s {
+  vdb_rec_t          recs[VDB_RING_RECS];
+  volatile uint64_t  head;    // next slot to fill; only the owner writes
+  volatile uint64_t  tail;    // next slot to write to the file
+  uint16_t           thread;
+  struct vdb_ring_s* next;
+} vdb_ring_t;
+
+static int vdb_binary = 0;            // are we writing binary records?
+static uint64_t vdb_time_base;        // monotonic ns at start
+static pthread_mutex_t vdb_rings_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t vdb_flush_lock = PTHREAD_MUTEX_INITIALIZER;
+static vdb_ring_t* vdb_rings = NULL;
+static uint16_t vdb_num_rings = 0;
+static int vdb_tls_initialized = 0;
+CHPL_TLS_DECL(vdb_ring_t*, vdb_ring);
+
+static pthread_t vdb_flusher;
+static int vdb_flusher_running = 0;
+static volatile int vdb_flusher_stop;
+
+#define VDB_FLUSH_INTERVAL_NS 10000000  // 10 ms
+
+static inline
+uint64_t vdb_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static vdb_ring_t* vdb_my_ring(void) {
+  vdb_ring_t* r = CHPL_TLS_GET(vdb_ring);
+  if (r == NULL) {
+    if ((r = sys_malloc(sizeof(*r))) == NULL)
+      chpl_error("out of memory allocating Visual Debug buffer", 0, 0);
+    r->head = r->tail = 0;
+    pthread_mutex_lock(&vdb_rings_lock);
+    r->thread = vdb_num_rings++;
+    r->next = vdb_rings;
+    vdb_rings = r;
+    pthread_mutex_unlock(&vdb_rings_lock);
+    CHPL_TLS_SET(vdb_ring, r);
+  }
+  return r;
+}
+
+//
+// Write a ring's pending records to the file.  Caller holds
+// vdb_flush_lock.
+//
+static void vdb_flush_ring(vdb_ring_t* r) {
+  uint64_t head = r->head;
+  uint64_t tail = r->tail;
+
+  __sync_synchronize();
+  while (tail < head) {
+    uint64_t idx = tail & (VDB_RING_RECS - 1);
+    uint64_t n = head - tail;
+    if (n > VDB_RING_RECS - idx)
+      n = VDB_RING_RECS - idx;
+    if (chpl_vdebug_fd >= 0)
+      (void) write(chpl_vdebug_fd, &r->recs[idx], n * sizeof(vdb_rec_t));
+    tail += n;
+  }
+  __sync_synchronize();
+  r->tail = tail;
+}
+
+static void vdb_flush_all(void) {
+  vdb_ring_t* r;
+
+  pthread_mutex_lock(&vdb_rings_lock);
+  r = vdb_rings;
+  pthread_mutex_unlock(&vdb_rings_lock);
+
+  pthread_mutex_lock(&vdb_flush_lock);
+  for ( ; r != NULL; r = r->next)
+    vdb_flush_ring(r);
+  pthread_mutex_unlock(&vdb_flush_lock);
+}
+
+static void* vdb_flusher_fn(void* ignore) {
+  struct timespec ts = { 0, VDB_FLUSH_INTERVAL_NS };
+
+  while (!vdb_flusher_stop) {
+    nanosleep(&ts, NULL);
+    vdb_flush_all();
+  }
+  return NULL;
+}
+
+//
+// Get the next record slot in this thread's ring, with the common
+// fields filled in.  Zeroes the rest.  Follow with vdb_rec_commit().
+//
+static inline
+vdb_rec_t* vdb_rec_new(vdb_ring_t** pr, vdb_rec_kind_t kind,
+                       chpl_taskID_t taskID) {
+  vdb_ring_t* r = vdb_my_ring();
+  vdb_rec_t* rec;
+
+  if (r->head - r->tail >= VDB_RING_RECS) {
+    pthread_mutex_lock(&vdb_flush_lock);
+    vdb_flush_ring(r);
+    pthread_mutex_unlock(&vdb_flush_lock);
+  }
+
+  rec = &r->recs[r->head & (VDB_RING_RECS - 1)];
+  memset(rec, 0, sizeof(*rec));
+  rec->time = vdb_now_ns() - vdb_time_base;
+  rec->taskID = (uint64_t) taskID;
+  rec->kind = (uint16_t) kind;
+  rec->thread = r->thread;
+
+  *pr = r;
+  return rec;
+}
+
+static inline
+void vdb_rec_commit(vdb_ring_t* r) {
+  __sync_synchronize();
+  r->head++;
+}
+
+static void vdb_log_comm(vdb_rec_kind_t kind, const chpl_comm_cb_info_t *info,
+                         uint64_t addr, uint64_t raddr, size_t elemSize,
+                         size_t length, int commID, int lineno, int fileno) {
+  vdb_ring_t* r;
+  vdb_rec_t* rec = vdb_rec_new(&r, kind, chpl_task_getId());
+  rec->u.ev.addr = addr;
+  rec->u.ev.raddr = raddr;
+  rec->u.ev.length = length;
+  rec->u.ev.remote = info->remoteNodeID;
+  rec->u.ev.elemSize = (int32_t) elemSize;
+  rec->id = commID;
+  rec->lineno = lineno;
+  rec->fileno = fileno;
+  vdb_rec_commit(r);
+}
+
+static void vdb_log_fork(vdb_rec_kind_t kind, const chpl_comm_cb_info_t *info) {
+  const struct chpl_comm_info_comm_executeOn *cm = &info->iu.executeOn;
+  vdb_ring_t* r;
+  vdb_rec_t* rec = vdb_rec_new(&r, kind, chpl_task_getId());
+  rec->u.ev.addr = (uint64_t) (uintptr_t) cm->arg;
+  rec->u.ev.raddr = cm->arg_size;
+  rec->u.ev.remote = info->remoteNodeID;
+  rec->u.ev.elemSize = cm->subloc;
+  rec->id = cm->fid;
+  rec->lineno = cm->lineno;
+  rec->fileno = cm->filename;
+  vdb_rec_commit(r);
+}
+
+//
+// Tag, Pause and End records carry the rusage times, in microseconds.
+//
+static void vdb_log_times(vdb_rec_kind_t kind, int tagno,
+                          const struct rusage *ru) {
+  vdb_ring_t* r;
+  vdb_rec_t* rec = vdb_rec_new(&r, kind, chpl_task_getId());
+  rec->u.ev.raddr = (uint64_t) ru->ru_utime.tv_sec * 1000000
+                    + ru->ru_utime.tv_usec;
+  rec->u.ev.length = (uint64_t) ru->ru_stime.tv_sec * 1000000
+                     + ru->ru_stime.tv_usec;
+  rec->id = tagno;
+  vdb_rec_commit(r);
+}
+
+static void vdb_start(uint64_t time_base) {
+  if (!vdb_tls_initialized) {
+    CHPL_TLS_INIT(vdb_ring);
+    vdb_tls_initialized = 1;
+  }
+
+  chpl_dprintf (chpl_vdebug_fd, "Binary: ver 1.0 recsize %d\n",
+                (int) sizeof(vdb_rec_t));
+
+  vdb_time_base = time_base;
+  vdb_binary = 1;
+
+  vdb_flusher_stop = 0;
+  vdb_flusher_running =
+    (pthread_create(&vdb_flusher, NULL, vdb_flusher_fn, NULL) == 0);
+  if (!vdb_flusher_running)
+    chpl_warning("Visual Debug could not start its flush thread; "
+                 "buffers will be written only when full", 0, 0);
+}
+
+static void vdb_stop(void) {
+  if (vdb_flusher_running) {
+    vdb_flusher_stop = 1;
+    (void) pthread_join(vdb_flusher, NULL);
+    vdb_flusher_running = 0;
+  }
+  vdb_flush_all();
+  vdb_binary = 0;
+}
+
+
 static int chpl_make_vdebug_file (const char *rootname) {
     char fname[MAXPATHLEN]; 
     struct stat sb;
@@ -124,13 +381,15 @@ static int chpl_make_vdebug_file (const char *rootname) {
 //  tid # -- taskID
 //  seq time.sec -- unique number for this run
 
-void chpl_vdebug_start (const char *fileroot, double now) {
+void chpl_vdebug_start (const char *fileroot, double now, chpl_bool binary) {
   const char * rootname;
   struct rusage ru;
   struct timeval tv;
+  uint64_t mono;
   chpl_taskID_t startTask = chpl_task_getId();
   char buff[CHPL_TASK_ID_STRING_MAX_LEN];
   (void) gettimeofday (&tv, NULL);
+  mono = vdb_now_ns();
 
   install_callbacks();
 
@@ -191,6 +450,10 @@ void chpl_vdebug_start (const char *fileroot, double now) {
                     chpl_finfo[ix].lineno, chpl_finfo[ix].fileno,
                     chpl_finfo[ix].name);
   }
+
+  // In binary mode, fixed-size records follow the text header
+  if (binary)
+    vdb_start(mono);
   
   chpl_vdebug = 1;
 }
@@ -219,12 +482,17 @@ void chpl_vdebug_stop (void) {
       ru.ru_stime.tv_usec = 0;
     }
     // Generate the End record
-    chpl_dprintf (chpl_vdebug_fd, "End: %lld.%06ld %ld.%06ld %ld.%06ld %d %s\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec,
-                  (long) ru.ru_utime.tv_sec, (long) ru.ru_utime.tv_usec,
-                  (long) ru.ru_stime.tv_sec, (long) ru.ru_stime.tv_usec,
-                  chpl_nodeID, TID_STRING(buff, stopTask));
+    if (vdb_binary) {
+      vdb_log_times(vdb_rec_end, 0, &ru);
+      vdb_stop();
+    } else
+      chpl_dprintf (chpl_vdebug_fd, "End: %lld.%06ld %ld.%06ld %ld.%06ld %d %s\n",
+                    (long long) tv.tv_sec, (long) tv.tv_usec,
+                    (long) ru.ru_utime.tv_sec, (long) ru.ru_utime.tv_usec,
+                    (long) ru.ru_stime.tv_sec, (long) ru.ru_stime.tv_usec,
+                    chpl_nodeID, TID_STRING(buff, stopTask));
     close (chpl_vdebug_fd);
+    chpl_vdebug_fd = -1;
   }
 }
 
@@ -238,6 +506,12 @@ void chpl_vdebug_mark (void) {
   struct timeval tv;
   chpl_taskID_t tagTask = chpl_task_getId();
   char buff[CHPL_TASK_ID_STRING_MAX_LEN];
+  if (vdb_binary) {
+    vdb_ring_t* r;
+    (void) vdb_rec_new(&r, vdb_rec_mark, tagTask);
+    vdb_rec_commit(r);
+    return;
+  }
   (void) gettimeofday (&tv, NULL);
   chpl_dprintf (chpl_vdebug_fd, "VdbMark: %lld.%06ld %d %s\n",
                 (long long) tv.tv_sec, (long) tv.tv_usec, chpl_nodeID, TID_STRING(buff, tagTask) );
@@ -246,6 +520,14 @@ void chpl_vdebug_mark (void) {
 // Record>  tname: tag# tagname
 
 void chpl_vdebug_tagname (const char* tagname, int tagno) {
+  if (vdb_binary) {
+    vdb_ring_t* r;
+    vdb_rec_t* rec = vdb_rec_new(&r, vdb_rec_tname, chpl_task_getId());
+    strncpy(rec->u.name, tagname, sizeof(rec->u.name) - 1);
+    rec->id = tagno;
+    vdb_rec_commit(r);
+    return;
+  }
   chpl_dprintf (chpl_vdebug_fd, "tname: %d %s\n", tagno, tagname);
 }
 
@@ -265,6 +547,11 @@ void chpl_vdebug_tag (int tagno) {
     ru.ru_stime.tv_sec = 0;
     ru.ru_stime.tv_usec = 0;
   }
+  if (vdb_binary) {
+    vdb_log_times(vdb_rec_tag, tagno, &ru);
+    chpl_vdebug = 1;
+    return;
+  }
   chpl_dprintf (chpl_vdebug_fd, "Tag: %lld.%06ld %ld.%06ld %ld.%06ld %d %s %d\n",
                 (long long) tv.tv_sec, (long) tv.tv_usec,
                 (long) ru.ru_utime.tv_sec, (long) ru.ru_utime.tv_usec,
@@ -289,11 +576,14 @@ void chpl_vdebug_pause (int tagno) {
       ru.ru_stime.tv_sec = 0;
       ru.ru_stime.tv_usec = 0;
     }
-    chpl_dprintf (chpl_vdebug_fd, "Pause: %lld.%06ld %ld.%06ld %ld.%06ld %d %s %d\n",
-                  (long long) tv.tv_sec, (long) tv.tv_usec,
-                  (long) ru.ru_utime.tv_sec, (long) ru.ru_utime.tv_usec,
-                  (long) ru.ru_stime.tv_sec, (long) ru.ru_stime.tv_usec,
-                  chpl_nodeID, TID_STRING(buff, pauseTask), tagno);
+    if (vdb_binary)
+      vdb_log_times(vdb_rec_pause, tagno, &ru);
+    else
+      chpl_dprintf (chpl_vdebug_fd, "Pause: %lld.%06ld %ld.%06ld %ld.%06ld %d %s %d\n",
+                    (long long) tv.tv_sec, (long) tv.tv_usec,
+                    (long) ru.ru_utime.tv_sec, (long) ru.ru_utime.tv_usec,
+                    (long) ru.ru_stime.tv_sec, (long) ru.ru_stime.tv_usec,
+                    chpl_nodeID, TID_STRING(buff, pauseTask), tagno);
     chpl_vdebug = 0;
   }
 }
@@ -312,6 +602,12 @@ void cb_comm_put_nb (const chpl_comm_cb_info_t *info) {
   if (chpl_vdebug) {
     struct timeval tv;
     const struct chpl_comm_info_comm *cm = &info->iu.comm;
+    if (vdb_binary) {
+      vdb_log_comm(vdb_rec_nb_put, info, (uintptr_t) cm->addr,
+                   (uintptr_t) cm->raddr, 1, cm->size,
+                   cm->commID, cm->lineno, cm->filename);
+      return;
+    }
     chpl_taskID_t commTask = chpl_task_getId();
     char buff[CHPL_TASK_ID_STRING_MAX_LEN];
     (void) gettimeofday (&tv, NULL);
@@ -333,6 +629,12 @@ void cb_comm_get_nb (const chpl_comm_cb_info_t *info) {
   if (chpl_vdebug) {
     struct timeval tv;
     const struct chpl_comm_info_comm *cm = &info->iu.comm;
+    if (vdb_binary) {
+      vdb_log_comm(vdb_rec_nb_get, info, (uintptr_t) cm->addr,
+                   (uintptr_t) cm->raddr, 1, cm->size,
+                   cm->commID, cm->lineno, cm->filename);
+      return;
+    }
     chpl_taskID_t commTask = chpl_task_getId();
     char buff[CHPL_TASK_ID_STRING_MAX_LEN];
     (void) gettimeofday (&tv, NULL);
@@ -353,6 +655,12 @@ void cb_comm_put (const chpl_comm_cb_info_t *info) {
   if (chpl_vdebug) {
     struct timeval tv;
     const struct chpl_comm_info_comm *cm = &info->iu.comm;
+    if (vdb_binary) {
+      vdb_log_comm(vdb_rec_put, info, (uintptr_t) cm->addr,
+                   (uintptr_t) cm->raddr, 1, cm->size,
+                   cm->commID, cm->lineno, cm->filename);
+      return;
+    }
     chpl_taskID_t commTask = chpl_task_getId();
     char buff[CHPL_TASK_ID_STRING_MAX_LEN];
     (void) gettimeofday (&tv, NULL);
@@ -374,6 +682,12 @@ void cb_comm_get (const chpl_comm_cb_info_t *info) {
   if (chpl_vdebug) {
     struct timeval tv;
     const struct chpl_comm_info_comm *cm = &info->iu.comm;
+    if (vdb_binary) {
+      vdb_log_comm(vdb_rec_get, info, (uintptr_t) cm->addr,
+                   (uintptr_t) cm->raddr, 1, cm->size,
+                   cm->commID, cm->lineno, cm->filename);
+      return;
+    }
     chpl_taskID_t commTask = chpl_task_getId();
     char buff[CHPL_TASK_ID_STRING_MAX_LEN];
     (void) gettimeofday (&tv, NULL);
@@ -403,6 +717,13 @@ void cb_comm_put_strd (const chpl_comm_cb_info_t *info) {
       length *= cm->count[i];
     }
 
+    if (vdb_binary) {
+      vdb_log_comm(vdb_rec_st_put, info, (uintptr_t) cm->srcaddr,
+                   (uintptr_t) cm->dstaddr, cm->elemSize, length,
+                   cm->commID, cm->lineno, cm->filename);
+      return;
+    }
+
     chpl_dprintf (chpl_vdebug_fd,
                   VDEBUG_GETPUT_FORMAT_STRING, "st_put",
                   (long long) tv.tv_sec, (long) tv.tv_usec,  info->localNodeID, 
@@ -433,6 +754,13 @@ void cb_comm_get_strd (const chpl_comm_cb_info_t *info) {
       length *= cm->count[i];
     }
 
+    if (vdb_binary) {
+      vdb_log_comm(vdb_rec_st_get, info, (uintptr_t) cm->dstaddr,
+                   (uintptr_t) cm->srcaddr, cm->elemSize, length,
+                   cm->commID, cm->lineno, cm->filename);
+      return;
+    }
+
     chpl_dprintf (chpl_vdebug_fd,
                   VDEBUG_GETPUT_FORMAT_STRING, "st_get",
                   (long long) tv.tv_sec, (long) tv.tv_usec, info->localNodeID,
@@ -449,6 +777,10 @@ void cb_comm_executeOn (const chpl_comm_cb_info_t *info) {
 
   // Visual Debug Support
   if (chpl_vdebug) {
+    if (vdb_binary) {
+      vdb_log_fork(vdb_rec_fork, info);
+      return;
+    }
     const struct chpl_comm_info_comm_executeOn *cm = &info->iu.executeOn;
     chpl_taskID_t executeOnTask = chpl_task_getId();
     char buff[CHPL_TASK_ID_STRING_MAX_LEN];
@@ -468,6 +800,10 @@ void cb_comm_executeOn (const chpl_comm_cb_info_t *info) {
 
 void  cb_comm_executeOn_nb (const chpl_comm_cb_info_t *info) {
   if (chpl_vdebug) {
+    if (vdb_binary) {
+      vdb_log_fork(vdb_rec_fork_nb, info);
+      return;
+    }
     const struct chpl_comm_info_comm_executeOn *cm = &info->iu.executeOn;
     chpl_taskID_t executeOnTask = chpl_task_getId();
     char buff[CHPL_TASK_ID_STRING_MAX_LEN];
@@ -485,6 +821,10 @@ void  cb_comm_executeOn_nb (const chpl_comm_cb_info_t *info) {
 
 void cb_comm_executeOn_fast (const chpl_comm_cb_info_t *info) {
   if (chpl_vdebug) {
+    if (vdb_binary) {
+      vdb_log_fork(vdb_rec_f_fork, info);
+      return;
+    }
     const struct chpl_comm_info_comm_executeOn *cm = &info->iu.executeOn;
     chpl_taskID_t executeOnTask = chpl_task_getId();
     char buff[CHPL_TASK_ID_STRING_MAX_LEN];
@@ -600,6 +940,17 @@ int uninstall_callbacks (void) {
 void cb_task_create (const chpl_task_cb_info_t *info) {
   struct timeval tv;
   if (!chpl_vdebug) return;
+  if (vdb_binary) {
+    vdb_ring_t* r;
+    vdb_rec_t* rec = vdb_rec_new(&r, vdb_rec_task, chpl_task_getId());
+    rec->u.ev.addr = info->iu.full.id;
+    rec->u.ev.elemSize = info->iu.full.is_executeOn;
+    rec->id = info->iu.full.fid;
+    rec->lineno = info->iu.full.lineno;
+    rec->fileno = info->iu.full.filename;
+    vdb_rec_commit(r);
+    return;
+  }
   if (chpl_vdebug_fd >= 0) {
     chpl_taskID_t taskId = chpl_task_getId();
     char buff[CHPL_TASK_ID_STRING_MAX_LEN];
@@ -623,6 +974,12 @@ void cb_task_create (const chpl_task_cb_info_t *info) {
 void cb_task_begin (const chpl_task_cb_info_t *info) {
   struct timeval tv;
   if (!chpl_vdebug) return;
+  if (vdb_binary) {
+    vdb_ring_t* r;
+    (void) vdb_rec_new(&r, vdb_rec_btask, info->iu.full.id);
+    vdb_rec_commit(r);
+    return;
+  }
   if (chpl_vdebug_fd >= 0) {
     (void)gettimeofday(&tv, NULL);
     chpl_dprintf (chpl_vdebug_fd, "Btask: %lld.%06ld %lld %lu\n",
@@ -637,6 +994,12 @@ void cb_task_begin (const chpl_task_cb_info_t *info) {
 void cb_task_end (const chpl_task_cb_info_t *info) {
   struct timeval tv;
   if (!chpl_vdebug) return;
+  if (vdb_binary) {
+    vdb_ring_t* r;
+    (void) vdb_rec_new(&r, vdb_rec_etask, info->iu.id_only.id);
+    vdb_rec_commit(r);
+    return;
+  }
   if (chpl_vdebug_fd >= 0) {
     (void)gettimeofday(&tv, NULL);
     chpl_dprintf (chpl_vdebug_fd, "Etask: %lld.%06ld %lld %lu\n",
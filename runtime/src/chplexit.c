@@ -21,9 +21,11 @@
 
 #include "chpl_rt_utils_static.h"
 #include "chpl-comm.h"
+#include "chpl-comm-diags.h"
 #include "chplexit.h"
 #include "chpl-mem.h"
 #include "chplmemtrack.h"
+#include "chpl-tasks-prof.h"
 #include "chpl-topo.h"
 #include "gdb.h"
 
@@ -39,6 +41,8 @@ static void chpl_exit_common(int status, int all) {
   chpl_comm_pre_task_exit(all);
   if (all) {
     chpl_task_exit();
+    chpl_comm_diags_profile_exit();
+    chpl_task_prof_exit();
     chpl_reportMemInfo();
   }
   chpl_comm_exit(all, status);
@@ -24,6 +24,7 @@
 #include "chpl-mem-desc.h"
 #include "chpl-mem-sys.h"  // mem layer not initialized yet, need system alloc
 #include "chpl-tasks.h"
+#include "chpl-thread-local-storage.h"
 #include "chpltypes.h"
 #include "chpl-comm.h"
 #include "chpl-comm-internal.h"
@@ -45,10 +46,12 @@
 
 int chpl_verbose_mem = 0;
 int chpl_memTrack = 0;
+int chpl_memProfile = 0;
 
 static void
 printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
                int32_t lineno, int32_t filename);
+static void memProfileInit(void);
 
 
 //
@@ -61,6 +64,7 @@ extern void chpl_memTracking_returnConfigVals(chpl_bool* memTrack,
                                               chpl_bool* memLeaks,
                                               size_t* memMax,
                                               size_t* memThreshold,
+                                              size_t* memProfileInterval,
                                               c_string* memLog,
                                               c_string* memLeaksLog);
 
@@ -74,16 +78,38 @@ typedef struct memTableEntry_struct { /* table entry */
   struct memTableEntry_struct* nextInBucket;
 } memTableEntry;
 
-#define NUM_HASH_SIZE_INDICES 20
+#define NUM_HASH_SIZE_INDICES 24
 
-static int hashSizes[NUM_HASH_SIZE_INDICES] = { 1543, 3079, 6151, 12289, 24593, 49157, 98317,
+static int hashSizes[NUM_HASH_SIZE_INDICES] = { 97, 193, 389, 769,
+                                                1543, 3079, 6151, 12289, 24593, 49157, 98317,
                                                 196613, 393241, 786433, 1572869, 3145739,
                                                 6291469, 12582917, 25165843, 50331653,
                                                 100663319, 201326611, 402653189, 805306457 };
-static int hashSizeIndex = 0;
-static int hashSize = 0;
 
-static memTableEntry** memTable = NULL;
+//
+// The table is split into shards by address, each with its own lock,
+// so that tasks allocating and freeing different memory don't contend
+// with each other.  Each shard also keeps a list of unused entries, so
+// that tracking an allocation doesn't usually mean making another one.
+// The padding keeps shards that are in use by different threads out
+// of each other's cache lines.
+//
+#define MEM_TABLE_SHARD_BITS 6
+#define NUM_MEM_TABLE_SHARDS (1 << MEM_TABLE_SHARD_BITS)
+
+typedef struct {
+  pthread_mutex_t lock;
+  int hashSizeIndex;
+  int hashSize;
+  memTableEntry** memTable;
+  size_t totalEntries;    /* number of entries in this shard's table */
+  size_t totalAllocated;  /* memory allocated, as tracked in this shard */
+  size_t totalFreed;      /* memory freed, as tracked in this shard */
+  memTableEntry* freeEntries;
+  char pad[64];
+} memTableShard;
+
+static memTableShard memTableShards[NUM_MEM_TABLE_SHARDS];
 
 static _Bool memStats = false;
 static _Bool memLeaksByType = false;
@@ -91,15 +117,18 @@ static c_string memLeaksByDesc = "";
 static _Bool memLeaks = false;
 static size_t memMax = 0;
 static size_t memThreshold = 0;
+static size_t memProfileInterval = 0;
 static c_string memLog = NULL;
 static FILE* memLogFile = NULL;
 static c_string memLeaksLog = NULL;
 
+//
+// These are updated with atomic operations rather than under a lock.
+// The sums of allocations and frees are kept per shard instead, since
+// nothing needs them until a report is printed.
+//
 static size_t totalMem = 0;       /* total memory currently allocated */
 static size_t maxMem = 0;         /* maximum total memory during run  */
-static size_t totalAllocated = 0; /* total memory allocated */
-static size_t totalFreed = 0;     /* total memory freed */
-static size_t totalEntries = 0;     /* number of entries in hash table */
 
 
 // We can't use a sync var for concurrency control here.  The Qthreads
@@ -109,21 +138,30 @@ static size_t totalEntries = 0;     /* number of entries in hash table */
 // the tasking layer is shut down, ends up trying to create a qthread in
 // the terminated Qthreads library.  Chaos results.  We also cannot use
 // an atomic var, because with CHPL_ATOMICS=locks those are implemented
-// by means of sync vars.  So, we use a pthread mutex.  Note that this
-// is only safe if we cannot switch tasks on a pthread while holding the
+// by means of sync vars.  So, we use pthread mutexes, one per shard,
+// and compiler intrinsics for the global counters.  Note that this is
+// only safe if we cannot switch tasks on a pthread while holding a
 // mutex and then try to lock it recursively.  Currently that is the
-// case, since we do not yield while holding the mutex.
-// 
-static pthread_mutex_t memTrack_lockVar = PTHREAD_MUTEX_INITIALIZER;
+// case, since we do not yield while holding one.
+//
+static inline
+memTableShard* memTrack_shard(void* memAlloc) {
+  // Allocations are at least 16-byte aligned, so skip those bits.  The
+  // rest are mostly multiples of the allocator's size classes, so take
+  // the shard from the top of a multiplicative (Fibonacci) hash instead
+  // of the low bits, which would put them all in a few shards.
+  uint64_t h = ((uintptr_t) memAlloc >> 4) * 0x9e3779b97f4a7c15ULL;
+  return &memTableShards[h >> (64 - MEM_TABLE_SHARD_BITS)];
+}
 
 static inline
-void memTrack_lock(void) {
-  (void) pthread_mutex_lock(&memTrack_lockVar);
+void memTrack_lock(memTableShard* shard) {
+  (void) pthread_mutex_lock(&shard->lock);
 }
 
 static inline
-void memTrack_unlock(void) {
-  (void) pthread_mutex_unlock(&memTrack_lockVar);
+void memTrack_unlock(memTableShard* shard) {
+  (void) pthread_mutex_unlock(&shard->lock);
 }
 
 
@@ -153,17 +191,17 @@ void chpl_setMemFlags(void) {
                                     &memLeaks,
                                     &memMax,
                                     &memThreshold,
+                                    &memProfileInterval,
                                     &memLog,
                                     &memLeaksLog);
 
-  chpl_memTrack = (local_memTrack
-                   || memStats
-                   || memLeaksByType
-                   || (memLeaksByDesc && strcmp(memLeaksByDesc, ""))
-                   || memLeaks
-                   || memMax > 0
-                   || memLeaksLog != NULL);
-  
+  local_memTrack = (local_memTrack
+                    || memStats
+                    || memLeaksByType
+                    || (memLeaksByDesc && strcmp(memLeaksByDesc, ""))
+                    || memLeaks
+                    || memMax > 0
+                    || memLeaksLog != NULL);
 
   if (!memLog) {
     memLogFile = stdout;
@@ -178,10 +216,29 @@ void chpl_setMemFlags(void) {
     }
   }
 
-  if (chpl_memTrack) {
-    hashSizeIndex = 0;
-    hashSize = hashSizes[hashSizeIndex];
-    memTable = sys_calloc(hashSize, sizeof(memTableEntry*));
+  //
+  // Other threads may already be allocating, and they look at
+  // chpl_memTrack without a lock.  So set up all the shards before
+  // turning tracking on, and use a release store so that no thread can
+  // see the flag set before it can see the shards.
+  //
+  if (local_memTrack) {
+    for (int i = 0; i < NUM_MEM_TABLE_SHARDS; i++) {
+      memTableShard* shard = &memTableShards[i];
+      (void) pthread_mutex_init(&shard->lock, NULL);
+      shard->hashSizeIndex = 0;
+      shard->hashSize = hashSizes[shard->hashSizeIndex];
+      shard->memTable = sys_calloc(shard->hashSize, sizeof(memTableEntry*));
+      if (!shard->memTable) {
+        chpl_error("memtrack fault: out of memory allocating memtrack table",
+                   0, 0);
+      }
+    }
+    __atomic_store_n(&chpl_memTrack, 1, __ATOMIC_RELEASE);
+  }
+
+  if (memProfileInterval > 0) {
+    memProfileInit();
   }
 }
 
@@ -198,37 +255,42 @@ static unsigned hash(void* memAlloc, int hashSize) {
 }
 
 
-static void increaseMemStat(size_t chunk, int32_t lineno, int32_t filename) {
-  totalMem += chunk;
-  totalAllocated += chunk;
-  if (memMax && (totalMem > memMax)) {
+static void increaseMemStat(memTableShard* shard, size_t chunk,
+                            int32_t lineno, int32_t filename) {
+  size_t newTotalMem = __sync_add_and_fetch(&totalMem, chunk);
+  size_t oldMaxMem;
+
+  shard->totalAllocated += chunk;
+  if (memMax && (newTotalMem > memMax)) {
     chpl_error("Exceeded memory limit", lineno, filename);
   }
-  if (totalMem > maxMem)
-    maxMem = totalMem;
+  while (newTotalMem > (oldMaxMem = maxMem)) {
+    if (__sync_bool_compare_and_swap(&maxMem, oldMaxMem, newTotalMem))
+      break;
+  }
 }
 
 
-static void decreaseMemStat(size_t chunk) {
-  totalMem -= chunk; // > totalMem ? 0 : totalMem - chunk;
-  totalFreed += chunk;
+static void decreaseMemStat(memTableShard* shard, size_t chunk) {
+  (void) __sync_sub_and_fetch(&totalMem, chunk);
+  shard->totalFreed += chunk;
 }
 
 
 static void
-resizeTable(int direction) {
+resizeTable(memTableShard* shard, int direction) {
   memTableEntry** newMemTable = NULL;
   int newHashSizeIndex, newHashSize, newHashValue;
   int i;
   memTableEntry* me;
   memTableEntry* next;
 
-  newHashSizeIndex = hashSizeIndex + direction;
+  newHashSizeIndex = shard->hashSizeIndex + direction;
   newHashSize = hashSizes[newHashSizeIndex];
   newMemTable = sys_calloc(newHashSize, sizeof(memTableEntry*));
 
-  for (i = 0; i < hashSize; i++) {
-    for (me = memTable[i]; me != NULL; me = next) {
+  for (i = 0; i < shard->hashSize; i++) {
+    for (me = shard->memTable[i]; me != NULL; me = next) {
       next = me->nextInBucket;
       newHashValue = hash(me->memAlloc, newHashSize);
       me->nextInBucket = newMemTable[newHashValue];
@@ -236,72 +298,79 @@ resizeTable(int direction) {
     }
   }
 
-  sys_free(memTable);
-  memTable = newMemTable;
-  hashSize = newHashSize;
-  hashSizeIndex = newHashSizeIndex;
+  sys_free(shard->memTable);
+  shard->memTable = newMemTable;
+  shard->hashSize = newHashSize;
+  shard->hashSizeIndex = newHashSizeIndex;
 }
 
-static void addMemTableEntry(void *memAlloc, size_t number, size_t size,
+static void addMemTableEntry(memTableShard* shard,
+                             void *memAlloc, size_t number, size_t size,
                              chpl_mem_descInt_t description, int32_t lineno,
                              int32_t filename) {
   unsigned hashValue;
   memTableEntry* memEntry;
 
-  if ((totalEntries+1)*2 > hashSize && hashSizeIndex < NUM_HASH_SIZE_INDICES-1)
-    resizeTable(1);
+  if ((shard->totalEntries+1)*2 > shard->hashSize
+      && shard->hashSizeIndex < NUM_HASH_SIZE_INDICES-1)
+    resizeTable(shard, 1);
 
-  memEntry = (memTableEntry*) sys_calloc(1, sizeof(memTableEntry));
-  if (!memEntry) {
-    chpl_error("memtrack fault: out of memory allocating memtrack table",
-               lineno, filename);
+  if ((memEntry = shard->freeEntries) != NULL) {
+    shard->freeEntries = memEntry->nextInBucket;
+  } else {
+    memEntry = (memTableEntry*) sys_calloc(1, sizeof(memTableEntry));
+    if (!memEntry) {
+      chpl_error("memtrack fault: out of memory allocating memtrack table",
+                 lineno, filename);
+    }
   }
 
-  hashValue = hash(memAlloc, hashSize);
-  memEntry->nextInBucket = memTable[hashValue];
-  memTable[hashValue] = memEntry;
+  hashValue = hash(memAlloc, shard->hashSize);
+  memEntry->nextInBucket = shard->memTable[hashValue];
+  shard->memTable[hashValue] = memEntry;
   memEntry->description = description;
   memEntry->memAlloc = memAlloc;
   memEntry->lineno = lineno;
   memEntry->filename = filename;
   memEntry->number = number;
   memEntry->size = size;
-  increaseMemStat(number*size, lineno, filename);
-  totalEntries += 1;
+  increaseMemStat(shard, number*size, lineno, filename);
+  shard->totalEntries += 1;
 }
 
 
-static memTableEntry* removeMemTableEntry(void* address) {
-  unsigned hashValue = hash(address, hashSize);
-  memTableEntry* thisBucketEntry = memTable[hashValue];
+//
+// Remove the entry for the given address, copying it to *removed.
+// Returns true if there was one.
+//
+static _Bool removeMemTableEntry(memTableShard* shard, void* address,
+                                 memTableEntry* removed) {
+  unsigned hashValue = hash(address, shard->hashSize);
+  memTableEntry** link;
   memTableEntry* deletedBucket = NULL;
 
-  if (!thisBucketEntry)
-    return NULL;
+  for (link = &shard->memTable[hashValue];
+       *link != NULL;
+       link = &(*link)->nextInBucket) {
+    if ((*link)->memAlloc == address) {
+      deletedBucket = *link;
+      *link = deletedBucket->nextInBucket;
+      break;
+    }
+  }
 
-  if (thisBucketEntry->memAlloc == address) {
-    memTable[hashValue] = thisBucketEntry->nextInBucket;
-    deletedBucket = thisBucketEntry;
-  } else {
-    for (thisBucketEntry = memTable[hashValue];
-         thisBucketEntry != NULL;
-         thisBucketEntry = thisBucketEntry->nextInBucket) {
+  if (!deletedBucket)
+    return false;
 
-      memTableEntry* nextBucketEntry = thisBucketEntry->nextInBucket;
+  *removed = *deletedBucket;
+  deletedBucket->nextInBucket = shard->freeEntries;
+  shard->freeEntries = deletedBucket;
 
-      if (nextBucketEntry && nextBucketEntry->memAlloc == address) {
-        thisBucketEntry->nextInBucket = nextBucketEntry->nextInBucket;
-        deletedBucket = nextBucketEntry;
-      }
-    }
-  }
-  if (deletedBucket) {
-    decreaseMemStat(deletedBucket->number * deletedBucket->size);
-    totalEntries -= 1;
-    if (totalEntries*8 < hashSize && hashSizeIndex > 0)
-      resizeTable(-1);
-  }
-  return deletedBucket;
+  decreaseMemStat(shard, removed->number * removed->size);
+  shard->totalEntries -= 1;
+  if (shard->totalEntries*8 < shard->hashSize && shard->hashSizeIndex > 0)
+    resizeTable(shard, -1);
+  return true;
 }
 
 
@@ -344,17 +413,28 @@ void chpl_printMemAllocStats(int32_t lineno, int32_t filename) {
   }
 
   //
-  // Take a pre-run through the descriptions and values to figure
-  // out how long each line will need to be.
+  // Take a snapshot of the values, merging the per-shard sums, and a
+  // pre-run through the descriptions and values to figure out how long
+  // each line will need to be.
   //
-  static const struct {
+  size_t totalAllocated = 0;
+  size_t totalFreed = 0;
+  for (int i = 0; i < NUM_MEM_TABLE_SHARDS; i++) {
+    memTableShard* shard = &memTableShards[i];
+    memTrack_lock(shard);
+    totalAllocated += shard->totalAllocated;
+    totalFreed += shard->totalFreed;
+    memTrack_unlock(shard);
+  }
+
+  const struct {
     const char* desc;
-    size_t* val;
+    size_t val;
   } descsVals[] = {
-    { "Allocated Now:", &totalMem },
-    { "Allocation High Water Mark:", &maxMem },
-    { "Sum of Allocations:", &totalAllocated },
-    { "Sum of Frees:", &totalFreed },
+    { "Allocated Now:", totalMem },
+    { "Allocation High Water Mark:", maxMem },
+    { "Sum of Allocations:", totalAllocated },
+    { "Sum of Frees:", totalFreed },
   };
   const int nDescsVals = sizeof(descsVals) / sizeof(descsVals[0]);
 
@@ -366,9 +446,9 @@ void chpl_printMemAllocStats(int32_t lineno, int32_t filename) {
     if (thisDescWidth > descWidth)
       descWidth = thisDescWidth;
     const int thisMemWidth =
-                (*descsVals[i].val == 0)
+                (descsVals[i].val == 0)
                 ? 1
-                : (int) lrint(ceil(log10((double) *descsVals[i].val)));
+                : (int) lrint(ceil(log10((double) descsVals[i].val)));
     if (thisMemWidth > memWidth)
       memWidth = thisMemWidth;
   }
@@ -380,19 +460,15 @@ void chpl_printMemAllocStats(int32_t lineno, int32_t filename) {
   char buf[4 * (strlen(prefixBuf) + 1 + descWidth + 1 + memWidth + 1) + 1];
   size_t len;
 
-  memTrack_lock();
-
   len = 0;
   for (int i = 0; i < nDescsVals; i++) {
     len += snprintf(buf + len, sizeof(buf) - len,
                     "%s %-*s %*zd\n",
                     prefixBuf,
                     descWidth, descsVals[i].desc,
-                    memWidth, *descsVals[i].val);
+                    memWidth, descsVals[i].val);
   }
 
-  memTrack_unlock();
-
   fputs(buf, memLogFile);
 }
 
@@ -420,12 +496,17 @@ static void printMemAllocsByType(_Bool forLeaks,
 
   table = (size_t*)sys_calloc(numEntries, 3*sizeof(size_t));
 
-  for (i = 0; i < hashSize; i++) {
-    for (me = memTable[i]; me != NULL; me = me->nextInBucket) {
-      table[3*me->description] += me->number*me->size;
-      table[3*me->description+1] += 1;
-      table[3*me->description+2] = me->description;
+  for (int s = 0; s < NUM_MEM_TABLE_SHARDS; s++) {
+    memTableShard* shard = &memTableShards[s];
+    memTrack_lock(shard);
+    for (i = 0; i < shard->hashSize; i++) {
+      for (me = shard->memTable[i]; me != NULL; me = me->nextInBucket) {
+        table[3*me->description] += me->number*me->size;
+        table[3*me->description+1] += 1;
+        table[3*me->description+2] = me->description;
+      }
     }
+    memTrack_unlock(shard);
   }
 
   qsort(table, numEntries, 3*sizeof(size_t), memTableEntryCmp);
@@ -489,8 +570,8 @@ void chpl_printMemAllocsByDesc(const char* descString, int64_t threshold,
 
 
 static int descCmp(const void* p1, const void* p2) {
-  memTableEntry* m1 = *(memTableEntry**)p1;
-  memTableEntry* m2 = *(memTableEntry**)p2;
+  const memTableEntry* m1 = (const memTableEntry*)p1;
+  const memTableEntry* m2 = (const memTableEntry*)p2;
   c_string m1Filename;
   c_string m2Filename;
 
@@ -526,9 +607,9 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
 
   memTableEntry* memEntry;
   c_string memEntryFilename;
-  int n, i;
+  int maxN, n, i;
   char* loc;
-  memTableEntry** table;
+  memTableEntry* table;
 
   if (!chpl_memTrack) {
     chpl_warning("invalid call to printMemAllocs(); rerun with --memTrack",
@@ -536,24 +617,59 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
     return;
   }
 
+  //
+  // Copy the matching entries out of the shards, so that we needn't
+  // hold any locks while sorting and printing them.  Entries may come
+  // and go between the counting pass and the copying pass; we just
+  // report at most as many as we counted.
+  //
+  maxN = 0;
+  for (int s = 0; s < NUM_MEM_TABLE_SHARDS; s++) {
+    memTableShard* shard = &memTableShards[s];
+    memTrack_lock(shard);
+    for (i = 0; i < shard->hashSize; i++) {
+      for (memEntry = shard->memTable[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
+        size_t chunk = memEntry->number * memEntry->size;
+        if (chunk < threshold)
+          continue;
+        if (description != -1 && memEntry->description != description)
+          continue;
+        maxN += 1;
+      }
+    }
+    memTrack_unlock(shard);
+  }
+
+  table = (memTableEntry*)sys_malloc((maxN+1)*sizeof(memTableEntry));
+  if (!table)
+    chpl_error("out of memory printing memory table", lineno, filename);
+
   n = 0;
   filenameWidth = strlen("Allocated Memory (Bytes)");
-  for (i = 0; i < hashSize; i++) {
-    for (memEntry = memTable[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
-      size_t chunk = memEntry->number * memEntry->size;
-      if (chunk < threshold)
-        continue;
-      if (description != -1 && memEntry->description != description)
-        continue;
-      n += 1;
-      if (memEntry->filename) {
-        memEntryFilename = chpl_lookupFilename(memEntry->filename);
-        filenameLength = strlen(memEntryFilename);
-        if (filenameLength > filenameWidth)
-          filenameWidth = filenameLength;
+  for (int s = 0; s < NUM_MEM_TABLE_SHARDS; s++) {
+    memTableShard* shard = &memTableShards[s];
+    memTrack_lock(shard);
+    for (i = 0; i < shard->hashSize && n < maxN; i++) {
+      for (memEntry = shard->memTable[i]; memEntry != NULL && n < maxN; memEntry = memEntry->nextInBucket) {
+        size_t chunk = memEntry->number * memEntry->size;
+        if (chunk < threshold)
+          continue;
+        if (description != -1 && memEntry->description != description)
+          continue;
+        table[n++] = *memEntry;
+        if (memEntry->filename) {
+          memEntryFilename = chpl_lookupFilename(memEntry->filename);
+          filenameLength = strlen(memEntryFilename);
+          if (filenameLength > filenameWidth)
+            filenameWidth = filenameLength;
+        }
       }
     }
+    memTrack_unlock(shard);
   }
+  qsort(table, n, sizeof(memTableEntry), descCmp);
+
+  loc = (char*)sys_malloc((filenameWidth+numberWidth+1)*sizeof(char));
 
   totalWidth = filenameWidth+numberWidth*4+descWidth+20;
   for (i = 0; i < totalWidth; i++)
@@ -570,27 +686,8 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
     fprintf(memLogFile, "=");
   fprintf(memLogFile, "\n");
 
-  table = (memTableEntry**)sys_malloc(n*sizeof(memTableEntry*));
-  if (!table)
-    chpl_error("out of memory printing memory table", lineno, filename);
-
-  n = 0;
-  for (i = 0; i < hashSize; i++) {
-    for (memEntry = memTable[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
-      size_t chunk = memEntry->number * memEntry->size;
-      if (chunk < threshold)
-        continue;
-      if (description != -1 && memEntry->description != description)
-        continue;
-      table[n++] = memEntry;
-    }
-  }
-  qsort(table, n, sizeof(memTableEntry*), descCmp);
-
-  loc = (char*)sys_malloc((filenameWidth+numberWidth+1)*sizeof(char));
-
   for (i = 0; i < n; i++) {
-    memEntry = table[i];
+    memEntry = &table[i];
     if (memEntry->filename) {
       memEntryFilename = chpl_lookupFilename(memEntry->filename);
       sprintf(loc, "%s:%" PRId32, memEntryFilename, memEntry->lineno);
@@ -646,14 +743,401 @@ void chpl_reportMemInfo() {
 }
 
 
+//
+// Sampling heap profile.
+//
+// When memProfileInterval is set, about one allocation per that many
+// bytes is sampled, independent of memory tracking.  Each thread
+// counts down the bytes it allocates, and when its count runs out the
+// allocation that did it is recorded and a new count is drawn from an
+// exponential distribution with memProfileInterval as its mean.  A
+// sample for an allocation of size S stands for 1/(1-exp(-S/interval))
+// allocations of that size, which makes the estimates unbiased.
+//
+// Sampled allocations are charged to their site, which is the memory
+// descriptor and source line and file of the request.  Each site has
+// cumulative and live estimates.  Live samples are kept in a table by
+// address so their frees can be matched up.  To avoid taking the lock
+// on every free, a table of counts by address hash says which frees
+// might be of sampled allocations; only those look any further.
+//
+typedef struct {
+  chpl_mem_descInt_t description;
+  int32_t lineno;
+  int32_t filename;
+  double allocNumber;   /* estimated number of allocations */
+  double allocBytes;    /* estimated bytes allocated */
+  double liveNumber;    /* estimated number of allocations still live */
+  double liveBytes;     /* estimated bytes still allocated */
+} memProfSite;
+
+typedef struct memProfSample_struct {
+  void* memAlloc;
+  int site;             /* index in memProfSites */
+  double number;        /* allocations this sample stands for */
+  double bytes;         /* bytes this sample stands for */
+  struct memProfSample_struct* nextInBucket;
+} memProfSample;
+
+typedef struct {
+  int64_t bytesUntilSample;
+  uint64_t rngState;
+} memProfThreadState;
+
+#define MEM_PROF_FILTER_BITS 16
+#define MEM_PROF_FILTER_SIZE (1 << MEM_PROF_FILTER_BITS)
+
+static pthread_mutex_t memProf_lockVar = PTHREAD_MUTEX_INITIALIZER;
+static memProfSite* memProfSites = NULL;
+static int memProfNumSites = 0;
+static int memProfSitesSize = 0;
+static int* memProfSiteIndex = NULL;      /* open addressing, -1 if empty */
+static int memProfSiteIndexSize = 0;      /* a power of 2 */
+static memProfSample** memProfSampleTable = NULL;
+static int memProfSampleHashSizeIndex = 0;
+static int memProfNumSamples = 0;
+static memProfSample* memProfFreeSamples = NULL;
+//
+// Counts of the live samples whose addresses hash to each slot, so that
+// most frees can skip the lock.  A 16-bit count could wrap with 64K
+// samples in one slot, which would make frees of those samples skip the
+// lookup and leave them live forever.
+//
+static uint32_t* memProfFilter = NULL;
+CHPL_TLS_DECL(memProfThreadState*, memProfThreadState_tls);
+
+
+static void memProfileInit(void) {
+  CHPL_TLS_INIT(memProfThreadState_tls);
+  memProfSampleTable = sys_calloc(hashSizes[memProfSampleHashSizeIndex],
+                                  sizeof(memProfSample*));
+  memProfFilter = sys_calloc(MEM_PROF_FILTER_SIZE, sizeof(uint32_t));
+  if (!memProfSampleTable || !memProfFilter) {
+    chpl_error("memtrack fault: out of memory allocating heap profile", 0, 0);
+  }
+  chpl_memProfile = 1;
+}
+
+
+static inline
+unsigned memProfFilterIdx(void* memAlloc) {
+  uint64_t h = ((uintptr_t) memAlloc >> 4) * 0x9e3779b97f4a7c15ULL;
+  return (unsigned) (h >> (64 - MEM_PROF_FILTER_BITS));
+}
+
+
+static int64_t memProfNextInterval(memProfThreadState* ts) {
+  // xorshift64*, then map the top 53 bits to (0, 1]
+  uint64_t x = ts->rngState;
+  double u;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  ts->rngState = x;
+  u = ((x * 0x2545f4914f6cdd1dULL) >> 11) * (1.0 / 9007199254740992.0);
+  return (int64_t) (-log(1.0 - u) * (double) memProfileInterval) + 1;
+}
+
+
+static memProfThreadState* memProfMyThreadState(void) {
+  memProfThreadState* ts = CHPL_TLS_GET(memProfThreadState_tls);
+  if (ts == NULL) {
+    if ((ts = sys_malloc(sizeof(*ts))) == NULL) {
+      chpl_error("memtrack fault: out of memory allocating heap profile",
+                 0, 0);
+    }
+    ts->rngState = ((uint64_t) (uintptr_t) ts * 0x9e3779b97f4a7c15ULL) | 1;
+    ts->bytesUntilSample = memProfNextInterval(ts);
+    CHPL_TLS_SET(memProfThreadState_tls, ts);
+  }
+  return ts;
+}
+
+
+static int memProfFindSite(chpl_mem_descInt_t description,
+                           int32_t lineno, int32_t filename) {
+  uint64_t h;
+  int i;
+
+  if ((memProfNumSites + 1) * 2 > memProfSiteIndexSize) {
+    int newSize = (memProfSiteIndexSize == 0) ? 256 : 2 * memProfSiteIndexSize;
+    int* newIndex = sys_malloc(newSize * sizeof(int));
+    if (!newIndex) {
+      chpl_error("memtrack fault: out of memory allocating heap profile",
+                 lineno, filename);
+    }
+    memset(newIndex, -1, newSize * sizeof(int));
+    for (int s = 0; s < memProfNumSites; s++) {
+      memProfSite* site = &memProfSites[s];
+      h = ((((uint64_t) site->description * 0x9e3779b97f4a7c15ULL)
+            ^ (uint64_t) site->lineno) * 0x9e3779b97f4a7c15ULL
+           ^ (uint64_t) site->filename) * 0x9e3779b97f4a7c15ULL;
+      for (i = (int) (h >> 32) & (newSize - 1);
+           newIndex[i] != -1;
+           i = (i + 1) & (newSize - 1))
+        ;
+      newIndex[i] = s;
+    }
+    sys_free(memProfSiteIndex);
+    memProfSiteIndex = newIndex;
+    memProfSiteIndexSize = newSize;
+  }
+
+  h = ((((uint64_t) description * 0x9e3779b97f4a7c15ULL)
+        ^ (uint64_t) lineno) * 0x9e3779b97f4a7c15ULL
+       ^ (uint64_t) filename) * 0x9e3779b97f4a7c15ULL;
+  for (i = (int) (h >> 32) & (memProfSiteIndexSize - 1);
+       memProfSiteIndex[i] != -1;
+       i = (i + 1) & (memProfSiteIndexSize - 1)) {
+    memProfSite* site = &memProfSites[memProfSiteIndex[i]];
+    if (site->description == description
+        && site->lineno == lineno && site->filename == filename)
+      return memProfSiteIndex[i];
+  }
+
+  if (memProfNumSites == memProfSitesSize) {
+    int newSize = (memProfSitesSize == 0) ? 128 : 2 * memProfSitesSize;
+    memProfSite* newSites = sys_realloc(memProfSites,
+                                        newSize * sizeof(memProfSite));
+    if (!newSites) {
+      chpl_error("memtrack fault: out of memory allocating heap profile",
+                 lineno, filename);
+    }
+    memProfSites = newSites;
+    memProfSitesSize = newSize;
+  }
+  memset(&memProfSites[memProfNumSites], 0, sizeof(memProfSite));
+  memProfSites[memProfNumSites].description = description;
+  memProfSites[memProfNumSites].lineno = lineno;
+  memProfSites[memProfNumSites].filename = filename;
+  memProfSiteIndex[i] = memProfNumSites;
+  return memProfNumSites++;
+}
+
+
+static void memProfGrowSampleTable(void) {
+  const int oldSize = hashSizes[memProfSampleHashSizeIndex];
+  const int newSize = hashSizes[memProfSampleHashSizeIndex + 1];
+  memProfSample** newTable = sys_calloc(newSize, sizeof(memProfSample*));
+  memProfSample* sample;
+  memProfSample* next;
+
+  if (!newTable)
+    return;  // just live with longer chains
+  for (int i = 0; i < oldSize; i++) {
+    for (sample = memProfSampleTable[i]; sample != NULL; sample = next) {
+      unsigned hashValue = hash(sample->memAlloc, newSize);
+      next = sample->nextInBucket;
+      sample->nextInBucket = newTable[hashValue];
+      newTable[hashValue] = sample;
+    }
+  }
+  sys_free(memProfSampleTable);
+  memProfSampleTable = newTable;
+  memProfSampleHashSizeIndex++;
+}
+
+
+static void memProfRecordSample(void* memAlloc, size_t size,
+                                chpl_mem_descInt_t description,
+                                int32_t lineno, int32_t filename) {
+  const double ratio = (double) size / (double) memProfileInterval;
+  const double number = (ratio > 0) ? 1.0 / (1.0 - exp(-ratio)) : 1.0;
+  unsigned hashValue;
+  memProfSample* sample;
+  memProfSite* site;
+
+  (void) pthread_mutex_lock(&memProf_lockVar);
+
+  if ((memProfNumSamples+1)*2 > hashSizes[memProfSampleHashSizeIndex]
+      && memProfSampleHashSizeIndex < NUM_HASH_SIZE_INDICES-1)
+    memProfGrowSampleTable();
+  hashValue = hash(memAlloc, hashSizes[memProfSampleHashSizeIndex]);
+  memProfNumSamples++;
+
+  if ((sample = memProfFreeSamples) != NULL) {
+    memProfFreeSamples = sample->nextInBucket;
+  } else if ((sample = sys_malloc(sizeof(*sample))) == NULL) {
+    chpl_error("memtrack fault: out of memory allocating heap profile",
+               lineno, filename);
+  }
+
+  sample->memAlloc = memAlloc;
+  sample->site = memProfFindSite(description, lineno, filename);
+  sample->number = number;
+  sample->bytes = number * size;
+  sample->nextInBucket = memProfSampleTable[hashValue];
+  memProfSampleTable[hashValue] = sample;
+
+  site = &memProfSites[sample->site];
+  site->allocNumber += sample->number;
+  site->allocBytes += sample->bytes;
+  site->liveNumber += sample->number;
+  site->liveBytes += sample->bytes;
+
+  (void) __sync_add_and_fetch(&memProfFilter[memProfFilterIdx(memAlloc)], 1);
+
+  (void) pthread_mutex_unlock(&memProf_lockVar);
+}
+
+
+static inline
+void memProfileMalloc(void* memAlloc, size_t size,
+                      chpl_mem_descInt_t description,
+                      int32_t lineno, int32_t filename) {
+  memProfThreadState* ts = memProfMyThreadState();
+  if ((ts->bytesUntilSample -= (int64_t) size) <= 0) {
+    do {
+      ts->bytesUntilSample += memProfNextInterval(ts);
+    } while (ts->bytesUntilSample <= 0);
+    memProfRecordSample(memAlloc, size, description, lineno, filename);
+  }
+}
+
+
+static inline
+void memProfileFree(void* memAlloc) {
+  unsigned hashValue;
+  memProfSample** link;
+
+  if (memAlloc == NULL || memProfFilter[memProfFilterIdx(memAlloc)] == 0)
+    return;
+
+  (void) pthread_mutex_lock(&memProf_lockVar);
+  hashValue = hash(memAlloc, hashSizes[memProfSampleHashSizeIndex]);
+  for (link = &memProfSampleTable[hashValue];
+       *link != NULL;
+       link = &(*link)->nextInBucket) {
+    if ((*link)->memAlloc == memAlloc) {
+      memProfSample* sample = *link;
+      memProfSite* site = &memProfSites[sample->site];
+      site->liveNumber -= sample->number;
+      site->liveBytes -= sample->bytes;
+      *link = sample->nextInBucket;
+      sample->nextInBucket = memProfFreeSamples;
+      memProfFreeSamples = sample;
+      memProfNumSamples--;
+      (void) __sync_sub_and_fetch(&memProfFilter[memProfFilterIdx(memAlloc)],
+                                  1);
+      break;
+    }
+  }
+  (void) pthread_mutex_unlock(&memProf_lockVar);
+}
+
+
+static int memProfSiteCmp(const void* p1, const void* p2) {
+  const double b1 = ((const double*) p1)[0];
+  const double b2 = ((const double*) p2)[0];
+  return (b1 < b2) ? 1 : ((b1 > b2) ? -1 : 0);
+}
+
+
+void chpl_printMemProfile(chpl_bool cumulative,
+                          int32_t lineno, int32_t filename) {
+  const int numberWidth = 12;
+  const int descWidth   = 33;
+  int filenameWidth     = strlen("Location");
+  int totalWidth;
+  int n, i;
+  struct { double bytes; double number; memProfSite site; }* table;
+  char* loc;
+
+  if (!chpl_memProfile) {
+    chpl_warning("invalid call to printMemProfile(); rerun with "
+                 "--memProfileInterval",
+                 lineno, filename);
+    return;
+  }
+
+  //
+  // Copy out the sites with anything to report, so that we needn't
+  // hold the lock while sorting and printing them.
+  //
+  (void) pthread_mutex_lock(&memProf_lockVar);
+  table = sys_malloc((memProfNumSites + 1) * sizeof(*table));
+  if (!table)
+    chpl_error("out of memory printing heap profile", lineno, filename);
+  n = 0;
+  for (i = 0; i < memProfNumSites; i++) {
+    memProfSite* site = &memProfSites[i];
+    const double bytes = cumulative ? site->allocBytes : site->liveBytes;
+    const double number = cumulative ? site->allocNumber : site->liveNumber;
+    if (bytes < 0.5)
+      continue;
+    table[n].bytes = bytes;
+    table[n].number = number;
+    table[n].site = *site;
+    n++;
+  }
+  (void) pthread_mutex_unlock(&memProf_lockVar);
+
+  qsort(table, n, sizeof(*table), memProfSiteCmp);
+
+  for (i = 0; i < n; i++) {
+    if (table[i].site.filename) {
+      const int filenameLength =
+        strlen(chpl_lookupFilename(table[i].site.filename));
+      if (filenameLength > filenameWidth)
+        filenameWidth = filenameLength;
+    }
+  }
+  loc = (char*)sys_malloc((filenameWidth+numberWidth+1)*sizeof(char));
+
+  totalWidth = numberWidth*2+descWidth+1+filenameWidth+numberWidth;
+  for (i = 0; i < totalWidth; i++)
+    fprintf(memLogFile, "=");
+  fprintf(memLogFile, "\n");
+  fprintf(memLogFile, "%s Heap Profile (sampled every %zu bytes)\n",
+          cumulative ? "Cumulative" : "Live", memProfileInterval);
+  for (i = 0; i < totalWidth; i++)
+    fprintf(memLogFile, "=");
+  fprintf(memLogFile, "\n");
+  fprintf(memLogFile, "%-*s%-*s%-*s %s\n",
+          numberWidth, "Bytes",
+          numberWidth, "Number",
+          descWidth, "Description",
+          "Location");
+  for (i = 0; i < totalWidth; i++)
+    fprintf(memLogFile, "=");
+  fprintf(memLogFile, "\n");
+
+  for (i = 0; i < n; i++) {
+    if (table[i].site.filename) {
+      sprintf(loc, "%s:%" PRId32,
+              chpl_lookupFilename(table[i].site.filename),
+              table[i].site.lineno);
+    } else {
+      sprintf(loc, "--");
+    }
+    fprintf(memLogFile, "%-*.0f%-*.0f%-*s %s\n",
+            numberWidth, table[i].bytes,
+            numberWidth, table[i].number,
+            descWidth, chpl_mem_descString(table[i].site.description),
+            loc);
+  }
+  for (i = 0; i < totalWidth; i++)
+    fprintf(memLogFile, "=");
+  fprintf(memLogFile, "\n");
+
+  sys_free(table);
+  sys_free(loc);
+}
+
+
 void chpl_track_malloc(void* memAlloc, size_t number, size_t size,
                        chpl_mem_descInt_t description,
                        int32_t lineno, int32_t filename) {
+  if (chpl_memProfile) {
+    memProfileMalloc(memAlloc, number * size, description, lineno, filename);
+  }
   if (number * size > memThreshold) {
     if (chpl_memTrack && chpl_mem_descTrack(description)) {
-      memTrack_lock();
-      addMemTableEntry(memAlloc, number, size, description, lineno, filename);
-      memTrack_unlock();
+      memTableShard* shard = memTrack_shard(memAlloc);
+      memTrack_lock(shard);
+      addMemTableEntry(shard, memAlloc, number, size, description,
+                       lineno, filename);
+      memTrack_unlock(shard);
     }
     if (chpl_verbose_mem) {
       fprintf(memLogFile, "%" PRI_c_nodeid_t ": %s:%" PRId32
@@ -667,22 +1151,24 @@ void chpl_track_malloc(void* memAlloc, size_t number, size_t size,
 
 
 void chpl_track_free(void* memAlloc, int32_t lineno, int32_t filename) {
-  memTableEntry* memEntry = NULL;
+  if (chpl_memProfile) {
+    memProfileFree(memAlloc);
+  }
   if (chpl_memTrack) {
-    memTrack_lock();
-    memEntry = removeMemTableEntry(memAlloc);
-    if (memEntry) {
-      if (chpl_verbose_mem) {
-        fprintf(memLogFile, "%" PRI_c_nodeid_t ": %s:%" PRId32
-                            ": free %zuB of %s at %p\n",
-                chpl_nodeID, (filename ? chpl_lookupFilename(filename) : "--"),
-                lineno, memEntry->number * memEntry->size,
-                chpl_mem_descString(memEntry->description), memAlloc);
-      }
-      sys_free(memEntry);
+    memTableShard* shard = memTrack_shard(memAlloc);
+    memTableEntry memEntry;
+    _Bool found;
+    memTrack_lock(shard);
+    found = removeMemTableEntry(shard, memAlloc, &memEntry);
+    memTrack_unlock(shard);
+    if (found && chpl_verbose_mem) {
+      fprintf(memLogFile, "%" PRI_c_nodeid_t ": %s:%" PRId32
+                          ": free %zuB of %s at %p\n",
+              chpl_nodeID, (filename ? chpl_lookupFilename(filename) : "--"),
+              lineno, memEntry.number * memEntry.size,
+              chpl_mem_descString(memEntry.description), memAlloc);
     }
-    memTrack_unlock();
-  } else if (chpl_verbose_mem && !memEntry) {
+  } else if (chpl_verbose_mem) {
     fprintf(memLogFile, "%" PRI_c_nodeid_t ": %s:%" PRId32 ": free at %p\n",
             chpl_nodeID, (filename ? chpl_lookupFilename(filename) : "--"),
             lineno, memAlloc);
@@ -693,16 +1179,15 @@ void chpl_track_free(void* memAlloc, int32_t lineno, int32_t filename) {
 void chpl_track_realloc_pre(void* memAlloc, size_t size,
                          chpl_mem_descInt_t description,
                          int32_t lineno, int32_t filename) {
-  memTableEntry* memEntry = NULL;
-
-  if (chpl_memTrack && size > memThreshold) {
-    memTrack_lock();
-    if (memAlloc) {
-      memEntry = removeMemTableEntry(memAlloc);
-      if (memEntry)
-        sys_free(memEntry);
-    }
-    memTrack_unlock();
+  if (chpl_memProfile) {
+    memProfileFree(memAlloc);
+  }
+  if (chpl_memTrack && size > memThreshold && memAlloc) {
+    memTableShard* shard = memTrack_shard(memAlloc);
+    memTableEntry memEntry;
+    memTrack_lock(shard);
+    (void) removeMemTableEntry(shard, memAlloc, &memEntry);
+    memTrack_unlock(shard);
   }
 }
 
@@ -711,11 +1196,16 @@ void chpl_track_realloc_post(void* moreMemAlloc,
                          void* memAlloc, size_t size,
                          chpl_mem_descInt_t description,
                          int32_t lineno, int32_t filename) {
+  if (chpl_memProfile && moreMemAlloc) {
+    memProfileMalloc(moreMemAlloc, size, description, lineno, filename);
+  }
   if (size > memThreshold) {
     if (chpl_memTrack && chpl_mem_descTrack(description)) {
-      memTrack_lock();
-      addMemTableEntry(moreMemAlloc, 1, size, description, lineno, filename);
-      memTrack_unlock();
+      memTableShard* shard = memTrack_shard(moreMemAlloc);
+      memTrack_lock(shard);
+      addMemTableEntry(shard, moreMemAlloc, 1, size, description,
+                       lineno, filename);
+      memTrack_unlock(shard);
     }
     if (chpl_verbose_mem) {
       fprintf(memLogFile, "%" PRI_c_nodeid_t ": %s:%" PRId32
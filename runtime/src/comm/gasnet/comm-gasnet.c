@@ -213,6 +213,31 @@ typedef struct {
   char    data[0];  // data
 } priv_bcast_t;
 
+//
+// A private broadcast id that refers to the global variables buffer
+// instead of an entry in the private broadcast table.
+//
+#define PRIV_BCAST_ID_GLOBALS (-1)
+
+//
+// Likewise, one that refers to the address map being built by
+// chpl_comm_exchange_addrs_helper().
+//
+#define PRIV_BCAST_ID_ADDR_MAP (-2)
+
+typedef struct {
+  void*      ack;     // parent's done_t, signaled when subtree is done
+  int        caller;  // parent node
+  int        id;      // private broadcast table entry to forward
+  int        size;    // size of data
+  c_nodeid_t root;    // root of the broadcast tree
+} priv_bcast_fwd_t;
+
+typedef struct {
+  chpl_comm_on_bundle_t bundle;
+  priv_bcast_fwd_t      fwd;
+} priv_bcast_fwd_task_t;
+
 typedef struct {
   void* ack;
   int   id;       // private broadcast table entry to update
@@ -221,6 +246,11 @@ typedef struct {
   char  data[0];  // data
 } priv_bcast_large_t;
 
+typedef struct {
+  c_nodeid_t node;  // node whose address this is
+  void*      addr;  // its address
+} exch_addr_t;
+
 typedef struct {
   void* ack; // acknowledgement object
   void* tgt; // target memory address
@@ -246,11 +276,15 @@ typedef enum {
   SIGNAL_LONG,          // ack to a done_t via gasnet_AMReplyLongM()
   PRIV_BCAST,           // put data at addr (used for private broadcast)
   PRIV_BCAST_LARGE,     // put data at addr (used for private broadcast)
+  PRIV_BCAST_FWD,       // forward private broadcast to our subtree
+  EXCH_ADDR,            // record a node's address in node 0's address map
   FREE,                 // free data at addr
   SHUTDOWN,             // tell nodes to get ready for shutdown
   BCAST_SEGINFO,        // broadcast for segment info table
   DO_REPLY_PUT,         // do a PUT here from another locale
-  DO_COPY_PAYLOAD       // copy AM payload to another address
+  DO_COPY_PAYLOAD,      // copy AM payload to another address
+  DO_UNORDERED_PUTS,    // copy a batch of unordered PUTs to their addresses
+  DO_UNORDERED_AMOS     // do a batch of unordered non-fetching AMOs
 } AM_handler_function_idx_t;
 
 static void AM_fork_fast(gasnet_token_t token, void* buf, size_t nbytes) {
@@ -502,9 +536,31 @@ static void AM_signal_long(gasnet_token_t token, void *buf, size_t nbytes,
     done->flag = 1;
 }
 
+static wide_ptr_t* globals_bcast_buf;
+static void** exch_addrs_buf;
+static done_t exch_addrs_done;
+
+static inline
+void* priv_bcast_addr(int id) {
+  switch (id) {
+  case PRIV_BCAST_ID_GLOBALS:  return (void*) globals_bcast_buf;
+  case PRIV_BCAST_ID_ADDR_MAP: return (void*) exch_addrs_buf;
+  default:                     return chpl_rt_priv_bcast_tab[id];
+  }
+}
+
+static void priv_bcast_subtree(int id, size_t size, c_nodeid_t root);
+
+static void priv_bcast_fwd_wrapper(priv_bcast_fwd_task_t* f) {
+  priv_bcast_subtree(f->fwd.id, f->fwd.size, f->fwd.root);
+
+  GASNET_Safe(gasnet_AMRequestShort2(f->fwd.caller, SIGNAL,
+                                     Arg0(f->fwd.ack), Arg1(f->fwd.ack)));
+}
+
 static void AM_priv_bcast(gasnet_token_t token, void* buf, size_t nbytes) {
   priv_bcast_t* pbp = buf;
-  chpl_memcpy(chpl_rt_priv_bcast_tab[pbp->id], pbp->data, pbp->size);
+  chpl_memcpy(priv_bcast_addr(pbp->id), pbp->data, pbp->size);
 
   // Signal that the handler has completed
   GASNET_Safe(gasnet_AMReplyShort2(token, SIGNAL,
@@ -513,13 +569,42 @@ static void AM_priv_bcast(gasnet_token_t token, void* buf, size_t nbytes) {
 
 static void AM_priv_bcast_large(gasnet_token_t token, void* buf, size_t nbytes) {
   priv_bcast_large_t* pblp = buf;
-  chpl_memcpy((char*)chpl_rt_priv_bcast_tab[pblp->id]+pblp->offset, pblp->data, pblp->size);
+  chpl_memcpy((char*)priv_bcast_addr(pblp->id)+pblp->offset, pblp->data, pblp->size);
 
   // Signal that the handler has completed
   GASNET_Safe(gasnet_AMReplyShort2(token, SIGNAL,
                                    Arg0(pblp->ack), Arg1(pblp->ack)));
 }
 
+//
+// We can't communicate from within a handler, so forwarding a private
+// broadcast on down the tree is done by a task.
+//
+static void AM_priv_bcast_fwd(gasnet_token_t token, void* buf, size_t nbytes) {
+  priv_bcast_fwd_task_t task;
+
+  assert(nbytes == sizeof(priv_bcast_fwd_t));
+  memset(&task.bundle, 0, sizeof(task.bundle));
+  task.fwd = *(priv_bcast_fwd_t*) buf;
+
+  chpl_task_startMovedTask(FID_NONE, (chpl_fn_p)priv_bcast_fwd_wrapper,
+                           chpl_comm_on_bundle_task_bundle(&task.bundle),
+                           sizeof(task), c_sublocid_any, chpl_nullTaskID);
+}
+
+static void AM_exch_addr(gasnet_token_t token, void* buf, size_t nbytes) {
+  exch_addr_t* eap = buf;
+  uint_least32_t prev;
+
+  assert(nbytes == sizeof(exch_addr_t));
+  exch_addrs_buf[eap->node] = eap->addr;
+
+  prev = atomic_fetch_add_explicit_uint_least32_t(&exch_addrs_done.count, 1,
+                                                  memory_order_seq_cst);
+  if (prev + 1 == exch_addrs_done.target)
+    exch_addrs_done.flag = 1;
+}
+
 static void AM_free(gasnet_token_t token, gasnet_handlerarg_t a0, gasnet_handlerarg_t a1) {
   void* to_free = get_ptr_from_args(a0, a1);
   
@@ -570,6 +655,113 @@ void AM_copy_payload(gasnet_token_t token, void* buf, size_t nbytes,
   GASNET_Safe(gasnet_AMReplyShort2(token, SIGNAL, ack0, ack1));
 }
 
+//
+// Each unordered PUT in a batch is a header followed by its data,
+// padded so that the next header is aligned.
+//
+typedef struct {
+  void*  addr;
+  size_t size;
+} unordered_put_hdr_t;
+
+#define UNORDERED_PUT_ALIGN(size) (((size) + 7) & ~((size_t) 7))
+
+// Copy each PUT in a batch of unordered PUTs to its destination.
+static
+void AM_unordered_puts(gasnet_token_t token, void* buf, size_t nbytes,
+                       gasnet_handlerarg_t ack0, gasnet_handlerarg_t ack1)
+{
+  char* p = buf;
+  char* end = p + nbytes;
+
+  while (p < end) {
+    unordered_put_hdr_t hdr;
+    memcpy(&hdr, p, sizeof(hdr));
+    p += sizeof(hdr);
+    memcpy(hdr.addr, p, hdr.size);
+    p += UNORDERED_PUT_ALIGN(hdr.size);
+  }
+
+  GASNET_Safe(gasnet_AMReplyShort2(token, SIGNAL, ack0, ack1));
+}
+
+//
+// An unordered non-fetching AMO on a processor atomic, as buffered by
+// the initiating task and sent in a batch.  The operand is in the
+// low-order bytes of 'opnd' for 32-bit types.
+//
+typedef enum {
+  unordered_amo_add,
+  unordered_amo_or,
+  unordered_amo_and,
+  unordered_amo_xor
+} unordered_amo_op_t;
+
+typedef enum {
+  unordered_amo_int32,
+  unordered_amo_int64,
+  unordered_amo_uint32,
+  unordered_amo_uint64,
+  unordered_amo_real32,
+  unordered_amo_real64
+} unordered_amo_type_t;
+
+typedef struct {
+  void*    obj;
+  uint64_t opnd;
+  uint8_t  op;
+  uint8_t  type;
+} unordered_amo_t;
+
+static inline
+void do_unordered_amo(unordered_amo_t* amo) {
+#define DO_INT_AMO(cType)                                                     \
+  {                                                                           \
+    atomic_ ## cType* obj = (atomic_ ## cType*) amo->obj;                     \
+    cType opnd;                                                               \
+    memcpy(&opnd, &amo->opnd, sizeof(opnd));                                  \
+    switch ((unordered_amo_op_t) amo->op) {                                   \
+    case unordered_amo_add: (void) atomic_fetch_add_ ## cType(obj, opnd); break; \
+    case unordered_amo_or:  (void) atomic_fetch_or_ ## cType(obj, opnd); break;  \
+    case unordered_amo_and: (void) atomic_fetch_and_ ## cType(obj, opnd); break; \
+    case unordered_amo_xor: (void) atomic_fetch_xor_ ## cType(obj, opnd); break; \
+    }                                                                         \
+  }
+#define DO_REAL_AMO(cType)                                                    \
+  {                                                                           \
+    cType opnd;                                                               \
+    memcpy(&opnd, &amo->opnd, sizeof(opnd));                                  \
+    (void) atomic_fetch_add_ ## cType((atomic_ ## cType*) amo->obj, opnd);    \
+  }
+
+  switch ((unordered_amo_type_t) amo->type) {
+  case unordered_amo_int32:  DO_INT_AMO(int_least32_t);  break;
+  case unordered_amo_int64:  DO_INT_AMO(int_least64_t);  break;
+  case unordered_amo_uint32: DO_INT_AMO(uint_least32_t); break;
+  case unordered_amo_uint64: DO_INT_AMO(uint_least64_t); break;
+  case unordered_amo_real32: DO_REAL_AMO(_real32);       break;
+  case unordered_amo_real64: DO_REAL_AMO(_real64);       break;
+  }
+
+#undef DO_INT_AMO
+#undef DO_REAL_AMO
+}
+
+// Do each AMO in a batch of unordered AMOs.
+static
+void AM_unordered_amos(gasnet_token_t token, void* buf, size_t nbytes,
+                       gasnet_handlerarg_t ack0, gasnet_handlerarg_t ack1)
+{
+  unordered_amo_t* amo_v = buf;
+  size_t num_amos = nbytes / sizeof(unordered_amo_t);
+
+  for (size_t i = 0; i < num_amos; i++) {
+    do_unordered_amo(&amo_v[i]);
+  }
+
+  GASNET_Safe(gasnet_AMReplyShort2(token, SIGNAL, ack0, ack1));
+}
+
 static gasnet_handlerentry_t ftable[] = {
   {FORK,          AM_fork},
   {FORK_SMALL,    AM_fork_small},
@@ -583,13 +775,162 @@ static gasnet_handlerentry_t ftable[] = {
   {SIGNAL_LONG,   AM_signal_long},
   {PRIV_BCAST,    AM_priv_bcast},
   {PRIV_BCAST_LARGE, AM_priv_bcast_large},
+  {PRIV_BCAST_FWD, AM_priv_bcast_fwd},
+  {EXCH_ADDR,     AM_exch_addr},
   {FREE,          AM_free},
   {SHUTDOWN,      AM_shutdown},
   {BCAST_SEGINFO, AM_bcast_seginfo},
   {DO_REPLY_PUT,  AM_reply_put},
-  {DO_COPY_PAYLOAD, AM_copy_payload}
+  {DO_COPY_PAYLOAD, AM_copy_payload},
+  {DO_UNORDERED_PUTS, AM_unordered_puts},
+  {DO_UNORDERED_AMOS, AM_unordered_amos}
 };
 
+//
+// Common code for task local buffering
+//
+
+#define MAX_UNORDERED_TRANS_SZ 1024
+#define MAX_BUFFERED_PUT_LEN 64
+#define MAX_BUFFERED_GET_LEN 64
+#define MAX_UNORDERED_AMO_LEN 128
+
+static inline
+chpl_comm_taskPrvData_t* get_comm_taskPrvdata(void) {
+  chpl_task_prvData_t* task_prvData = chpl_task_getPrvData();
+  if (task_prvData != NULL) return &task_prvData->comm_data;
+  return NULL;
+}
+
+enum BuffType {
+  amo_nf_buff = 1 << 0,
+  get_buff    = 1 << 1,
+  put_buff    = 1 << 2
+};
+
+// The unordered AMOs buffered for one destination node
+typedef struct {
+  int             vi;
+  chpl_bool       listed;   // is this node in the task's node_v?
+  unordered_amo_t amo_v[MAX_UNORDERED_AMO_LEN];
+} amo_nf_node_buff_t;
+
+// Per task information about non-fetching AMO buffers.  AMOs are
+// buffered per destination node, and a node's buffer is sent as soon
+// as it fills.  The buffers are only waited for at a flush.
+typedef struct {
+  int                  vi;        // number of nodes with buffered AMOs
+  c_nodeid_t*          node_v;    // nodes with buffered AMOs
+  amo_nf_node_buff_t** buff_v;    // per node buffers, allocated on demand
+  uint_least32_t       num_sent;  // number of batches sent
+  done_t               done;      // acks for the batches sent
+} amo_nf_buff_task_info_t;
+
+// Per task information about GET buffers.  These are non-blocking
+// GETs that have been started but not yet waited for.
+typedef struct {
+  int             vi;
+  gasnet_handle_t handle_v[MAX_BUFFERED_GET_LEN];
+} get_buff_task_info_t;
+
+// Per task information about PUT buffers.  The PUTs themselves are
+// deferred until the buffer is flushed, when all the PUTs to a given
+// node are sent to it together in as few AMs as possible.
+typedef struct {
+  int           vi;
+  void*         tgt_addr_v[MAX_BUFFERED_PUT_LEN];
+  c_nodeid_t    locale_v[MAX_BUFFERED_PUT_LEN];
+  size_t        size_v[MAX_BUFFERED_PUT_LEN];
+  char          src_v[MAX_BUFFERED_PUT_LEN][MAX_UNORDERED_TRANS_SZ];
+} put_buff_task_info_t;
+
+// Acquire a task local buffer, initializing if needed
+static inline
+void* task_local_buff_acquire(enum BuffType t) {
+  chpl_comm_taskPrvData_t* prvData = get_comm_taskPrvdata();
+  if (prvData == NULL) return NULL;
+
+#define DEFINE_INIT(TYPE, TLS_NAME)                                           \
+  if (t == TLS_NAME) {                                                        \
+    TYPE* info = prvData->TLS_NAME;                                           \
+    if (info == NULL) {                                                       \
+      prvData->TLS_NAME = chpl_mem_calloc(1, sizeof(TYPE),                    \
+                                          CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);\
+      info = prvData->TLS_NAME;                                               \
+      info->vi = 0;                                                           \
+    }                                                                         \
+    return info;                                                              \
+  }
+
+  DEFINE_INIT(amo_nf_buff_task_info_t, amo_nf_buff);
+  DEFINE_INIT(get_buff_task_info_t, get_buff);
+  DEFINE_INIT(put_buff_task_info_t, put_buff);
+
+#undef DEFINE_INIT
+  return NULL;
+}
+
+static void amo_nf_buff_task_info_flush(amo_nf_buff_task_info_t* info);
+static void get_buff_task_info_flush(get_buff_task_info_t* info);
+static void put_buff_task_info_flush(put_buff_task_info_t* info);
+
+static void amo_nf_buff_task_info_free(amo_nf_buff_task_info_t* info);
+static void task_local_buff_free(void* info);
+
+// Flush one or more task local buffers
+static inline
+void task_local_buff_flush(enum BuffType t) {
+  chpl_comm_taskPrvData_t* prvData = get_comm_taskPrvdata();
+  if (prvData == NULL) return;
+
+#define DEFINE_FLUSH(TYPE, TLS_NAME, FLUSH_NAME)                              \
+  if (t & TLS_NAME) {                                                         \
+    TYPE* info = prvData->TLS_NAME;                                           \
+    if (info != NULL && info->vi > 0) {                                       \
+      FLUSH_NAME(info);                                                       \
+    }                                                                         \
+  }
+
+  DEFINE_FLUSH(amo_nf_buff_task_info_t, amo_nf_buff, amo_nf_buff_task_info_flush);
+  DEFINE_FLUSH(get_buff_task_info_t, get_buff, get_buff_task_info_flush);
+  DEFINE_FLUSH(put_buff_task_info_t, put_buff, put_buff_task_info_flush);
+
+#undef DEFINE_FLUSH
+}
+
+// Flush and destroy one or more task local buffers
+static inline
+void task_local_buff_end(enum BuffType t) {
+  chpl_comm_taskPrvData_t* prvData = get_comm_taskPrvdata();
+  if (prvData == NULL) return;
+
+#define DEFINE_END(TYPE, TLS_NAME, FLUSH_NAME, FREE_NAME)                     \
+  if (t & TLS_NAME) {                                                         \
+    TYPE* info = prvData->TLS_NAME;                                           \
+    if (info != NULL) {                                                       \
+      if (info->vi > 0) {                                                     \
+        FLUSH_NAME(info);                                                     \
+      }                                                                       \
+      FREE_NAME(info);                                                        \
+      prvData->TLS_NAME = NULL;                                               \
+    }                                                                         \
+  }
+
+  DEFINE_END(amo_nf_buff_task_info_t, amo_nf_buff, amo_nf_buff_task_info_flush,
+             amo_nf_buff_task_info_free);
+  DEFINE_END(get_buff_task_info_t, get_buff, get_buff_task_info_flush,
+             task_local_buff_free);
+  DEFINE_END(put_buff_task_info_t, put_buff, put_buff_task_info_flush,
+             task_local_buff_free);
+
+#undef DEFINE_END
+}
+
+static
+void task_local_buff_free(void* info) {
+  chpl_mem_free(info, 0, 0);
+}
+
 //
 // Chapel interface starts here
 //
@@ -909,91 +1250,130 @@ void chpl_comm_rollcall(void) {
 
 void chpl_comm_impl_regMemHeapInfo(void** start_p, size_t* size_p) {
 #if defined(GASNET_SEGMENT_FAST) || defined(GASNET_SEGMENT_LARGE)
-  *start_p = chpl_numGlobalsOnHeap * sizeof(wide_ptr_t) 
-             + (char*)seginfo_table[chpl_nodeID].addr;
-  *size_p  = seginfo_table[chpl_nodeID].size
-             - chpl_numGlobalsOnHeap * sizeof(wide_ptr_t);
+  *start_p = seginfo_table[chpl_nodeID].addr;
+  *size_p  = seginfo_table[chpl_nodeID].size;
 #else /* GASNET_SEGMENT_EVERYTHING */
   *start_p = NULL;
   *size_p  = 0;
 #endif
 }
 
-wide_ptr_t* chpl_comm_broadcast_global_vars_helper(void) {
+void chpl_comm_broadcast_global_vars_helper(wide_ptr_t* buf) {
   //
-  // Gather the global variables' wide pointers on node 0 into the
-  // buffer at the front of our communicable segment.  We don't have
-  // to communicate that because everyone already knows where it is.
-  // We do need to delay returning on the non-0 nodes until after
-  // node 0 has filled in that buffer, however.
+  // Everyone needs to know where their buffer is before node 0 can
+  // start sending, and no one can look at theirs until it's done.
   //
+  globals_bcast_buf = buf;
+  chpl_comm_barrier("ready for globals broadcast");
   if (chpl_nodeID == 0) {
-    for (int i = 0; i < chpl_numGlobalsOnHeap; i++) {
-      ((wide_ptr_t*) seginfo_table[0].addr)[i] = *chpl_globals_registry[i];
-    }
-    chpl_comm_barrier("fill node 0 globals buf");
-    return NULL; // so common code won't try to free it!
-  } else {
-    chpl_comm_barrier("fill node 0 globals buf");
-    return (wide_ptr_t*) seginfo_table[0].addr;
+    priv_bcast_subtree(PRIV_BCAST_ID_GLOBALS,
+                       chpl_numGlobalsOnHeap * sizeof(*buf), 0);
   }
+  chpl_comm_barrier("globals broadcast done");
+  globals_bcast_buf = NULL;
 }
 
-void chpl_comm_broadcast_private(int id, size_t size) {
-  int  node, offset;
+void chpl_comm_exchange_addrs_helper(void* addr, void** addrMap) {
+  //
+  // Everyone sends node 0 their address, and then node 0 broadcasts
+  // the completed map over the spanning tree.  Node 0's map has to be
+  // set up before anyone sends to it.
+  //
+  exch_addrs_buf = addrMap;
+  addrMap[chpl_nodeID] = addr;
+  if (chpl_nodeID == 0) {
+    init_done_obj(&exch_addrs_done, chpl_numNodes - 1);
+  }
+  chpl_comm_barrier("ready for address exchange");
+  if (chpl_nodeID != 0) {
+    exch_addr_t ea = { .node = chpl_nodeID, .addr = addr };
+    GASNET_Safe(gasnet_AMRequestMedium0(0, EXCH_ADDR, &ea, sizeof(ea)));
+  } else if (chpl_numNodes > 1) {
+    wait_done_obj(&exch_addrs_done, true);
+    priv_bcast_subtree(PRIV_BCAST_ID_ADDR_MAP,
+                       chpl_numNodes * sizeof(addrMap[0]), 0);
+  }
+  chpl_comm_barrier("address exchange done");
+  exch_addrs_buf = NULL;
+}
+
+//
+// Send the data for a private broadcast id from this node to its
+// children in the spanning tree rooted at 'root', and then have each
+// child that has children of its own forward it on to them.  Returns
+// once the whole subtree has the data.  The data has to have arrived
+// at a child before it starts forwarding, because AMs aren't ordered.
+//
+static void priv_bcast_subtree(int id, size_t size, c_nodeid_t root) {
+  c_nodeid_t children[CHPL_COMM_BCAST_MAX_FANOUT];
+  c_nodeid_t grandchildren[CHPL_COMM_BCAST_MAX_FANOUT];
+  int  numChildren, numFwds, i;
   int  payloadSize = size + sizeof(priv_bcast_t);
-  done_t* done;
-  int numOffsets=1;
+  void* data = priv_bcast_addr(id);
+  done_t done;
+
+  numChildren = chpl_comm_bcast_tree_children(chpl_nodeID, root, children);
+  if (numChildren == 0)
+    return;
 
-  // This can use the system allocator because it involves internode communication.
-  done = (done_t*) chpl_mem_allocManyZero(chpl_numNodes, sizeof(*done),
-                                          CHPL_RT_MD_COMM_FRK_DONE_FLAG,
-                                          0, 0);
   if (payloadSize <= gasnet_AMMaxMedium()) {
     priv_bcast_t* pbp = chpl_mem_allocMany(1, payloadSize, CHPL_RT_MD_COMM_PRV_BCAST_DATA, 0, 0);
-    chpl_memcpy(pbp->data, chpl_rt_priv_bcast_tab[id], size);
+    chpl_memcpy(pbp->data, data, size);
+    pbp->ack = &done;
     pbp->id = id;
     pbp->size = size;
-    for (node = 0; node < chpl_numNodes; node++) {
-      if (node != chpl_nodeID) {
-        pbp->ack = &done[node];
-        init_done_obj(&done[node], 1);
-        GASNET_Safe(gasnet_AMRequestMedium0(node, PRIV_BCAST, pbp, payloadSize));
-      }
+    init_done_obj(&done, numChildren);
+    for (i = 0; i < numChildren; i++) {
+      GASNET_Safe(gasnet_AMRequestMedium0(children[i], PRIV_BCAST, pbp, payloadSize));
     }
+    wait_done_obj(&done, false);
     chpl_mem_free(pbp, 0, 0);
   } else {
     size_t maxpayloadsize = gasnet_AMMaxMedium();
     size_t maxsize = maxpayloadsize - sizeof(priv_bcast_large_t);
     priv_bcast_large_t* pblp = chpl_mem_allocMany(1, maxpayloadsize, CHPL_RT_MD_COMM_PRV_BCAST_DATA, 0, 0);
+    int numOffsets = (size+maxsize-1)/maxsize;
+    size_t offset;
+    pblp->ack = &done;
     pblp->id = id;
-    numOffsets = (size+maxsize)/maxsize;
-    for (node = 0; node < chpl_numNodes; node++) {
-      if (node != chpl_nodeID)
-        init_done_obj(&done[node], numOffsets);
-    }
+    init_done_obj(&done, numChildren * numOffsets);
     for (offset = 0; offset < size; offset += maxsize) {
       size_t thissize = size - offset;
       if (thissize > maxsize)
         thissize = maxsize;
       pblp->offset = offset;
       pblp->size = thissize;
-      chpl_memcpy(pblp->data, (char*)chpl_rt_priv_bcast_tab[id]+offset, thissize);
-      for (node = 0; node < chpl_numNodes; node++) {
-        if (node != chpl_nodeID) {
-          pblp->ack = &done[node];
-          GASNET_Safe(gasnet_AMRequestMedium0(node, PRIV_BCAST_LARGE, pblp, sizeof(priv_bcast_large_t)+thissize));
-        }
+      chpl_memcpy(pblp->data, (char*)data+offset, thissize);
+      for (i = 0; i < numChildren; i++) {
+        GASNET_Safe(gasnet_AMRequestMedium0(children[i], PRIV_BCAST_LARGE, pblp, sizeof(priv_bcast_large_t)+thissize));
       }
     }
+    wait_done_obj(&done, false);
     chpl_mem_free(pblp, 0, 0);
   }
-  // wait for the handlers to complete
-  for (node = 0; node < chpl_numNodes; node++) {
-    if (node != chpl_nodeID)
-      GASNET_BLOCKUNTIL(done[node].flag);
+
+  //
+  // Now have the interior children pass it on.  Leaves have no one to
+  // forward to, so we don't bother them.
+  //
+  numFwds = 0;
+  for (i = 0; i < numChildren; i++) {
+    if (chpl_comm_bcast_tree_children(children[i], root, grandchildren) > 0)
+      children[numFwds++] = children[i];
+  }
+  if (numFwds > 0) {
+    priv_bcast_fwd_t fwd = { .ack = &done, .caller = chpl_nodeID,
+                             .id = id, .size = size, .root = root };
+    init_done_obj(&done, numFwds);
+    for (i = 0; i < numFwds; i++) {
+      GASNET_Safe(gasnet_AMRequestMedium0(children[i], PRIV_BCAST_FWD, &fwd, sizeof(fwd)));
+    }
+    wait_done_obj(&done, false);
   }
-  chpl_mem_free(done, 0, 0);
+}
+
+void chpl_comm_broadcast_private(int id, size_t size) {
+  priv_bcast_subtree(id, size, chpl_nodeID);
 }
 
 void chpl_comm_barrier(const char *msg) {
@@ -1335,7 +1715,6 @@ void  chpl_comm_put_strd(void* dstaddr, size_t* dststrides, c_nodeid_t dstnode_i
   gasnet_puts_bulk(dstnode, dstaddr, dststr, srcaddr, srcstr, cnt, strlvls); 
 }
 
-#define MAX_UNORDERED_TRANS_SZ 1024
 void chpl_comm_getput_unordered(c_nodeid_t dstnode, void* dstaddr,
                                 c_nodeid_t srcnode, void* srcaddr,
                                 size_t size, int32_t commID,
@@ -1352,14 +1731,15 @@ void chpl_comm_getput_unordered(c_nodeid_t dstnode, void* dstaddr,
   }
 
   if (dstnode == chpl_nodeID) {
-    chpl_comm_get(dstaddr, srcnode, srcaddr, size, commID, ln, fn);
+    chpl_comm_get_unordered(dstaddr, srcnode, srcaddr, size, commID, ln, fn);
   } else if (srcnode == chpl_nodeID) {
-    chpl_comm_put(srcaddr, dstnode, dstaddr, size, commID, ln, fn);
+    chpl_comm_put_unordered(srcaddr, dstnode, dstaddr, size, commID, ln, fn);
   } else {
     if (size <= MAX_UNORDERED_TRANS_SZ) {
+      // The PUT copies from buf before it returns, so it can be unordered.
       char buf[MAX_UNORDERED_TRANS_SZ];
       chpl_comm_get(buf, srcnode, srcaddr, size, commID, ln, fn);
-      chpl_comm_put(buf, dstnode, dstaddr, size, commID, ln, fn);
+      chpl_comm_put_unordered(buf, dstnode, dstaddr, size, commID, ln, fn);
     } else {
       // Note, we do not expect this case to trigger, but if it does we may
       // want to do on-stmt to src node and then transfer
@@ -1371,17 +1751,344 @@ void chpl_comm_getput_unordered(c_nodeid_t dstnode, void* dstaddr,
   }
 }
 
+//
+// Unordered GETs from the remote segment are started as non-blocking
+// GETs and only waited for when the task's buffer of outstanding
+// handles fills up, or at a fence.  Anything else is a regular GET.
+//
 void chpl_comm_get_unordered(void* addr, c_nodeid_t node, void* raddr,
                              size_t size, int32_t commID, int ln, int32_t fn) {
-  chpl_comm_get(addr, node, raddr, size, commID, ln, fn);
+  int remote_in_segment;
+  get_buff_task_info_t* info;
+
+  if (chpl_nodeID == node) {
+    memmove(addr, raddr, size);
+    return;
+  }
+
+#ifdef GASNET_SEGMENT_EVERYTHING
+  remote_in_segment = 1;
+#else
+  remote_in_segment = chpl_comm_addr_gettable(node, raddr, size);
+#endif
+
+  if (!remote_in_segment
+      || (info = task_local_buff_acquire(get_buff)) == NULL) {
+    chpl_comm_get(addr, node, raddr, size, commID, ln, fn);
+    return;
+  }
+
+  // Communications callback support
+  if (chpl_comm_have_callbacks(chpl_comm_cb_event_kind_get)) {
+    chpl_comm_cb_info_t cb_data =
+      {chpl_comm_cb_event_kind_get, chpl_nodeID, node,
+       .iu.comm={addr, raddr, size, commID, ln, fn}};
+    chpl_comm_do_callbacks (&cb_data);
+  }
+
+  chpl_comm_diags_verbose_rdma("unordered get", node, size, ln, fn, commID);
+  chpl_comm_diags_incr(get);
+
+  info->handle_v[info->vi] = gasnet_get_nb_bulk(addr, node, raddr, size);
+  info->vi++;
+
+  if (info->vi == MAX_BUFFERED_GET_LEN) {
+    get_buff_task_info_flush(info);
+  }
 }
 
+static
+void get_buff_task_info_flush(get_buff_task_info_t* info) {
+  gasnet_wait_syncnb_all(info->handle_v, info->vi);
+  info->vi = 0;
+}
+
+//
+// Unordered PUTs of up to MAX_UNORDERED_TRANS_SZ bytes are copied into
+// the task's PUT buffer.  When that fills up, or at a fence, the PUTs
+// are sent in batches, one AM per destination node where they fit, and
+// the remote AM handler copies each one into place.  Larger PUTs, and
+// those that would not fit in an AM by themselves along with their
+// header, are just regular PUTs.
+//
 void chpl_comm_put_unordered(void* addr, c_nodeid_t node, void* raddr,
                              size_t size, int32_t commID, int ln, int32_t fn) {
-  chpl_comm_put(addr, node, raddr, size, commID, ln, fn);
+  put_buff_task_info_t* info;
+
+  if (chpl_nodeID == node) {
+    memmove(raddr, addr, size);
+    return;
+  }
+
+  if (size > MAX_UNORDERED_TRANS_SZ
+      || sizeof(unordered_put_hdr_t) + UNORDERED_PUT_ALIGN(size)
+         > gasnet_AMMaxMedium()
+      || (info = task_local_buff_acquire(put_buff)) == NULL) {
+    chpl_comm_put(addr, node, raddr, size, commID, ln, fn);
+    return;
+  }
+
+  // Communications callback support
+  if (chpl_comm_have_callbacks(chpl_comm_cb_event_kind_put)) {
+    chpl_comm_cb_info_t cb_data =
+      {chpl_comm_cb_event_kind_put, chpl_nodeID, node,
+       .iu.comm={addr, raddr, size, commID, ln, fn}};
+    chpl_comm_do_callbacks (&cb_data);
+  }
+
+  chpl_comm_diags_verbose_rdma("unordered put", node, size, ln, fn, commID);
+  chpl_comm_diags_incr(put);
+
+  int vi = info->vi;
+  memcpy(info->src_v[vi], addr, size);
+  info->tgt_addr_v[vi] = raddr;
+  info->locale_v[vi] = node;
+  info->size_v[vi] = size;
+  info->vi++;
+
+  if (info->vi == MAX_BUFFERED_PUT_LEN) {
+    put_buff_task_info_flush(info);
+  }
+}
+
+static
+void put_buff_task_info_flush(put_buff_task_info_t* info) {
+  const size_t max_payload = gasnet_AMMaxMedium();
+  char* payload = chpl_mem_alloc(max_payload,
+                                 CHPL_RT_MD_COMM_XMIT_RCV_BUF, 0, 0);
+  chpl_bool sent[MAX_BUFFERED_PUT_LEN] = { false };
+  uint_least32_t num_batches = 0;
+  done_t done;
+
+  // The target is never reached; we wait on the count instead.
+  init_done_obj(&done, 0);
+
+  for (int i = 0; i < info->vi; i++) {
+    if (sent[i]) continue;
+
+    // Pack as many of the PUTs to this node as fit into one AM.  The
+    // first always fits, because chpl_comm_put_unordered() doesn't
+    // buffer PUTs that wouldn't.
+    c_nodeid_t node = info->locale_v[i];
+    size_t len = 0;
+    for (int j = i; j < info->vi; j++) {
+      if (sent[j] || info->locale_v[j] != node) continue;
+
+      size_t rec_size = sizeof(unordered_put_hdr_t)
+                        + UNORDERED_PUT_ALIGN(info->size_v[j]);
+      if (len + rec_size > max_payload) continue;
+
+      unordered_put_hdr_t hdr = { info->tgt_addr_v[j], info->size_v[j] };
+      memcpy(payload + len, &hdr, sizeof(hdr));
+      memcpy(payload + len + sizeof(hdr), info->src_v[j], info->size_v[j]);
+      len += rec_size;
+      sent[j] = true;
+    }
+
+    GASNET_Safe(gasnet_AMRequestMedium2(node, DO_UNORDERED_PUTS,
+                                        payload, len,
+                                        Arg0(&done), Arg1(&done)));
+    num_batches++;
+  }
+
+  chpl_mem_free(payload, 0, 0);
+
+  // Wait for all the batches to be copied into place.
+#ifndef CHPL_COMM_YIELD_TASK_WHILE_POLLING
+  GASNET_BLOCKUNTIL(atomic_load_uint_least32_t(&done.count) == num_batches);
+#else
+  while (atomic_load_uint_least32_t(&done.count) < num_batches) {
+    (void) gasnet_AMPoll();
+  }
+#endif
+
+  info->vi = 0;
+}
+
+void chpl_comm_getput_unordered_task_fence(void) {
+  task_local_buff_flush(get_buff | put_buff);
 }
 
-void chpl_comm_getput_unordered_task_fence(void) { }
+//
+// Unordered non-fetching AMOs on processor atomics.  Each task buffers
+// these per destination node, and sends a node's buffer in one AM when
+// it fills, or at a fence, or at task end.  The AM handler on the
+// target node does the AMOs with processor atomics, so this is only
+// consistent with other operations on the same objects that are also
+// done with processor atomics, which is all of them with gasnet.
+//
+static
+void do_unordered_amo_nf(c_nodeid_t node, void* object,
+                         unordered_amo_op_t op, unordered_amo_type_t type,
+                         const void* operand, size_t size,
+                         int ln, int32_t fn) {
+  amo_nf_buff_task_info_t* info;
+
+  unordered_amo_t amo = { .obj = object, .opnd = 0,
+                          .op = op, .type = type };
+  memcpy(&amo.opnd, operand, size);
+
+  if (node == chpl_nodeID) {
+    do_unordered_amo(&amo);
+    return;
+  }
+
+  chpl_comm_diags_verbose_amo("unordered amo", node, ln, fn);
+  chpl_comm_diags_incr(amo);
+
+  if ((info = task_local_buff_acquire(amo_nf_buff)) == NULL) {
+    //
+    // No task private data; send this one by itself and wait for it.
+    //
+    done_t done;
+    init_done_obj(&done, 1);
+    GASNET_Safe(gasnet_AMRequestMedium2(node, DO_UNORDERED_AMOS,
+                                        &amo, sizeof(amo),
+                                        Arg0(&done), Arg1(&done)));
+    wait_done_obj(&done, false);
+    return;
+  }
+
+  if (info->buff_v == NULL) {
+    info->node_v = chpl_mem_allocMany(chpl_numNodes, sizeof(info->node_v[0]),
+                                      CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
+    info->buff_v = chpl_mem_calloc(chpl_numNodes, sizeof(info->buff_v[0]),
+                                   CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
+    info->num_sent = 0;
+    // The target is never reached; we wait on the count instead.
+    init_done_obj(&info->done, 0);
+  }
+
+  amo_nf_node_buff_t* buff = info->buff_v[node];
+  if (buff == NULL) {
+    buff = chpl_mem_alloc(sizeof(*buff), CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
+    buff->vi = 0;
+    buff->listed = false;
+    info->buff_v[node] = buff;
+  }
+
+  //
+  // A node stays listed after its full buffer is sent, until the next
+  // flush, so that each node is in node_v at most once.
+  //
+  if (!buff->listed) {
+    info->node_v[info->vi++] = node;
+    buff->listed = true;
+  }
+  buff->amo_v[buff->vi++] = amo;
+
+  if (buff->vi == MAX_UNORDERED_AMO_LEN
+      || (buff->vi + 1) * sizeof(unordered_amo_t) > gasnet_AMMaxMedium()) {
+    GASNET_Safe(gasnet_AMRequestMedium2(node, DO_UNORDERED_AMOS,
+                                        buff->amo_v,
+                                        buff->vi * sizeof(unordered_amo_t),
+                                        Arg0(&info->done),
+                                        Arg1(&info->done)));
+    info->num_sent++;
+    buff->vi = 0;
+  }
+}
+
+static
+void amo_nf_buff_task_info_flush(amo_nf_buff_task_info_t* info) {
+  for (int i = 0; i < info->vi; i++) {
+    c_nodeid_t node = info->node_v[i];
+    amo_nf_node_buff_t* buff = info->buff_v[node];
+    if (buff->vi > 0) {
+      GASNET_Safe(gasnet_AMRequestMedium2(node, DO_UNORDERED_AMOS,
+                                          buff->amo_v,
+                                          buff->vi * sizeof(unordered_amo_t),
+                                          Arg0(&info->done),
+                                          Arg1(&info->done)));
+      info->num_sent++;
+      buff->vi = 0;
+    }
+    buff->listed = false;
+  }
+  info->vi = 0;
+
+  // Wait for all the batches we've sent to be done.
+#ifndef CHPL_COMM_YIELD_TASK_WHILE_POLLING
+  GASNET_BLOCKUNTIL(atomic_load_uint_least32_t(&info->done.count)
+                    == info->num_sent);
+#else
+  while (atomic_load_uint_least32_t(&info->done.count) < info->num_sent) {
+    (void) gasnet_AMPoll();
+  }
+#endif
+}
+
+static
+void amo_nf_buff_task_info_free(amo_nf_buff_task_info_t* info) {
+  if (info->buff_v != NULL) {
+    for (int node = 0; node < chpl_numNodes; node++) {
+      if (info->buff_v[node] != NULL) {
+        chpl_mem_free(info->buff_v[node], 0, 0);
+      }
+    }
+    chpl_mem_free(info->buff_v, 0, 0);
+    chpl_mem_free(info->node_v, 0, 0);
+  }
+  chpl_mem_free(info, 0, 0);
+}
+
+#define DEFN_CHPL_COMM_ATOMIC_UNORDERED(fnOp, amoOp, fnType, amoType, Type)  \
+  void chpl_comm_atomic_##fnOp##_unordered_##fnType                     \
+         (void* operand, c_nodeid_t node, void* object,                 \
+          int ln, int32_t fn) {                                         \
+    do_unordered_amo_nf(node, object, amoOp, amoType,                   \
+                        operand, sizeof(Type), ln, fn);                 \
+  }
+
+#define DEFN_CHPL_COMM_ATOMIC_UNORDERED_SUB(fnType, amoType, Type, negate)   \
+  void chpl_comm_atomic_sub_unordered_##fnType                          \
+         (void* operand, c_nodeid_t node, void* object,                 \
+          int ln, int32_t fn) {                                         \
+    Type myOpnd = negate(*(Type*) operand);                             \
+    do_unordered_amo_nf(node, object, unordered_amo_add, amoType,       \
+                        &myOpnd, sizeof(Type), ln, fn);                 \
+  }
+
+DEFN_CHPL_COMM_ATOMIC_UNORDERED(and, unordered_amo_and, int32, unordered_amo_int32, int32_t)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED(and, unordered_amo_and, int64, unordered_amo_int64, int64_t)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED(and, unordered_amo_and, uint32, unordered_amo_uint32, uint32_t)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED(and, unordered_amo_and, uint64, unordered_amo_uint64, uint64_t)
+
+DEFN_CHPL_COMM_ATOMIC_UNORDERED(or, unordered_amo_or, int32, unordered_amo_int32, int32_t)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED(or, unordered_amo_or, int64, unordered_amo_int64, int64_t)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED(or, unordered_amo_or, uint32, unordered_amo_uint32, uint32_t)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED(or, unordered_amo_or, uint64, unordered_amo_uint64, uint64_t)
+
+DEFN_CHPL_COMM_ATOMIC_UNORDERED(xor, unordered_amo_xor, int32, unordered_amo_int32, int32_t)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED(xor, unordered_amo_xor, int64, unordered_amo_int64, int64_t)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED(xor, unordered_amo_xor, uint32, unordered_amo_uint32, uint32_t)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED(xor, unordered_amo_xor, uint64, unordered_amo_uint64, uint64_t)
+
+DEFN_CHPL_COMM_ATOMIC_UNORDERED(add, unordered_amo_add, int32, unordered_amo_int32, int32_t)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED(add, unordered_amo_add, int64, unordered_amo_int64, int64_t)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED(add, unordered_amo_add, uint32, unordered_amo_uint32, uint32_t)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED(add, unordered_amo_add, uint64, unordered_amo_uint64, uint64_t)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED(add, unordered_amo_add, real32, unordered_amo_real32, _real32)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED(add, unordered_amo_add, real64, unordered_amo_real64, _real64)
+
+#define NEGATE_I32(x) ((x) == INT32_MIN ? (x) : -(x))
+#define NEGATE_I64(x) ((x) == INT64_MIN ? (x) : -(x))
+#define NEGATE_U_OR_R(x) (-(x))
+
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_SUB(int32, unordered_amo_int32, int32_t, NEGATE_I32)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_SUB(int64, unordered_amo_int64, int64_t, NEGATE_I64)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_SUB(uint32, unordered_amo_uint32, uint32_t, NEGATE_U_OR_R)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_SUB(uint64, unordered_amo_uint64, uint64_t, NEGATE_U_OR_R)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_SUB(real32, unordered_amo_real32, _real32, NEGATE_U_OR_R)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_SUB(real64, unordered_amo_real64, _real64, NEGATE_U_OR_R)
+
+#undef NEGATE_I32
+#undef NEGATE_I64
+#undef NEGATE_U_OR_R
+
+void chpl_comm_atomic_unordered_task_fence(void) {
+  task_local_buff_flush(amo_nf_buff);
+}
 
 static inline
 void  execute_on_common(c_nodeid_t node, c_sublocid_t subloc,
@@ -1571,4 +2278,6 @@ void  chpl_comm_execute_on_fast(c_nodeid_t node, c_sublocid_t subloc,
   }
 }
 
-void chpl_comm_task_end(void) { }
+void chpl_comm_task_end(void) {
+  task_local_buff_end(get_buff | put_buff | amo_nf_buff);
+}
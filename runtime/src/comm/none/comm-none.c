@@ -133,7 +133,11 @@ void chpl_comm_rollcall(void) {
   chpl_msg(2, "executing on a single node\n");
 }
 
-wide_ptr_t* chpl_comm_broadcast_global_vars_helper(void) { return NULL; }
+void chpl_comm_broadcast_global_vars_helper(wide_ptr_t* buf) { }
+
+void chpl_comm_exchange_addrs_helper(void* addr, void** addrMap) {
+  addrMap[0] = addr;
+}
 
 void chpl_comm_broadcast_private(int id, size_t size) { }
 
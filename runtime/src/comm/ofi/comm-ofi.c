@@ -85,15 +85,12 @@ static struct fid_fabric* ofi_fabric;   // fabric domain
 static struct fid_domain* ofi_domain;   // fabric access domain
 static int useScalableTxEp;             // use a scalable tx endpoint?
 static struct fid_ep* ofi_txEpScal;     // scalable transmit endpoint
-static struct fid_wait* ofi_amhWaitSet; // wait set for AM handler
-static bool useWaitset = true;          // should we use the waitset?
+static bool useWaitset = true;          // should we use wait sets?
 //
 // We direct RMA traffic and AM traffic to different endpoints so we can
 // spread the progress load across all the threads when we're doing
 // manual progress.
 //
-static struct fid_ep* ofi_rxEp;         // AM req receive endpoint
-static struct fid_cq* ofi_rxCQ;         // AM req receive endpoint CQ
 static struct fid_ep* ofi_rxEpRma;      // RMA/AMO target endpoint
 static struct fid_cq* ofi_rxCQRma;      // RMA/AMO target endpoint CQ
 static struct fid_cntr* ofi_rxCntrRma;  // RMA/AMO target endpoint counter
@@ -101,8 +98,14 @@ static struct fid_cntr* ofi_rxCntrRma;  // RMA/AMO target endpoint counter
 static struct fid_av* ofi_av;           // address vector
 static fi_addr_t* ofi_rxAddrs;          // table of remote endpoint addresses
 
-#define rxMsgAddr(tcip, n) (ofi_rxAddrs[2 * (n)])
-#define rxRmaAddr(tcip, n) (ofi_rxAddrs[2 * (n) + 1])
+//
+// Each node has one AM request receive endpoint per AM handler, followed
+// by its RMA/AMO target endpoint.
+//
+#define numRxAddrsPerNode  (numAmHandlers + 1)
+#define rxMsgAddr(tcip, n, h) (ofi_rxAddrs[numRxAddrsPerNode * (n) + (h)])
+#define rxRmaAddr(tcip, n) (ofi_rxAddrs[numRxAddrsPerNode * (n) \
+                                        + numAmHandlers])
 
 //
 // Transmit support.
@@ -149,11 +152,39 @@ static memTab_t* memTabMap;
 //
 #define AM_MAX_MSG_SIZE (sizeof(chpl_comm_on_bundle_t) + 1024)
 
+// How many non-fetching AMOs fit in a batch AM
+#define MAX_AMO_BATCH_LEN                                               \
+  ((AM_MAX_MSG_SIZE                                                     \
+    - offsetof(chpl_comm_on_bundle_t, comm)                             \
+    - sizeof(struct chpl_comm_bundleData_AMOBatch_t))                   \
+   / sizeof(struct chpl_comm_amoNF_t))
+
+//
+// We can have more than one AM handler.  Each has its own receive
+// endpoint and multi-receive buffer, so they can process requests in
+// parallel.  Initiators spread their requests across a target node's
+// AM handlers, except that AMOs from a given initiator always go to
+// the same one so that they're done in the order they were sent.
+//
+#define MAX_AM_HANDLERS 16
+
 static int numAmHandlers = 1;
 
-static void* amLZs;
-static struct iovec ofi_iov_reqs;
-static struct fi_msg ofi_msg_reqs;
+struct perAmHandlerInfo_t {
+  struct fid_wait* waitSet; // wait set, or NULL if polling
+  struct fid_ep* rxEp;      // AM req receive endpoint
+  struct fid_cq* rxCQ;      // AM req receive endpoint CQ
+  void* amLZs;              // AM req landing zones
+  struct iovec iovReqs;
+  struct fi_msg msgReqs;
+};
+
+static struct perAmHandlerInfo_t* amhTab;
+
+//
+// Strided RMA support.
+//
+static size_t strdPackMaxChunk = 512;   // largest chunk we pack, bytes
 
 
 ////////////////////////////////////////
@@ -164,7 +195,7 @@ static struct fi_msg ofi_msg_reqs;
 static void emit_delayedFixedHeapMsgs(void);
 
 static inline struct perTxCtxInfo_t* tciAlloc(void);
-static inline struct perTxCtxInfo_t* tciAllocForAmHandler(void);
+static inline struct perTxCtxInfo_t* tciAllocForAmHandler(int);
 static inline chpl_bool tciTryRealloc(struct perTxCtxInfo_t*);
 static inline void tciFree(struct perTxCtxInfo_t*);
 static inline chpl_comm_nb_handle_t ofi_put(const void*, c_nodeid_t,
@@ -184,6 +215,30 @@ static void waitForCntrAllTxns(struct perTxCtxInfo_t*);
 static inline uint64_t getTxCntr(struct perTxCtxInfo_t*);
 static void* allocBounceBuf(size_t);
 static void freeBounceBuf(void*);
+
+#define MAX_UNORDERED_TRANS_SZ 1024
+#define MAX_UNORDERED_RMA_LEN 64
+
+// Per task information about outstanding unordered GETs and PUTs
+typedef struct {
+  struct perTxCtxInfo_t* tcip;   // tx context they were initiated on
+  int numTxns;                   // number initiated since last retired
+  char putSrc_v[MAX_UNORDERED_RMA_LEN][MAX_UNORDERED_TRANS_SZ];
+} unorderedRmaInfo_t;
+
+// Per task unordered AMOs waiting to be sent to each node in a batch
+typedef struct {
+  int numNodes;                     // number of nodes with buffered AMOs
+  c_nodeid_t* node_v;               // the nodes with buffered AMOs
+  chpl_comm_on_bundle_t** batch_v;  // per node batch AMs, made on demand
+} amoBatchInfo_t;
+
+static unorderedRmaInfo_t* unorderedRmaAcquire(void);
+static inline void unorderedRmaCount(unorderedRmaInfo_t*);
+static void unorderedRmaRetire(chpl_bool);
+static void amoBatchAdd(c_nodeid_t, void*, const void*,
+                        enum fi_op, enum fi_datatype, size_t);
+static void amoBatchFlush(chpl_bool);
 static inline void local_yield(void);
 
 static void time_init(void);
@@ -383,15 +438,15 @@ typedef struct {
 
 static inline
 void* txnTrkEncode(txnTrkType_t typ, void* p) {
-  return (void*) (  ((uint64_t) typ << 63)
-                  | ((uint64_t) p & 0x7fffffffffffffffUL));
+  return (void*) (  ((uint64_t) typ << 62)
+                  | ((uint64_t) p & 0x3fffffffffffffffUL));
 }
 
 static inline
 txnTrkCtx_t txnTrkDecode(void* ctx) {
   const uint64_t u = (uint64_t) ctx;
-  return (txnTrkCtx_t) { .typ = (u >> 63) & 1,
-                         .ptr = (void*) (u & 0x7fffffffffffffffUL) };
+  return (txnTrkCtx_t) { .typ = (u >> 62) & 3,
+                         .ptr = (void*) (u & 0x3fffffffffffffffUL) };
 }
 
 
@@ -400,7 +455,7 @@ chpl_comm_taskPrvData_t* get_comm_taskPrvdata(void) {
   chpl_task_prvData_t* task_prvData = chpl_task_getPrvData();
   if (task_prvData != NULL) return &task_prvData->comm_data;
 
-  static chpl_comm_taskPrvData_t amHandlerCommData;
+  static __thread chpl_comm_taskPrvData_t amHandlerCommData;
   assert(isAmHandler);
   return &amHandlerCommData;
 }
@@ -487,9 +542,11 @@ void init_ofi(void) {
   init_ofiForAms();
 
   DBG_PRINTF(DBG_CFG,
-             "AM config: recv buf size %zd MiB, %s, responses use %s",
-             ofi_iov_reqs.iov_len / (1L << 20),
-             (ofi_amhWaitSet == NULL) ? "polling" : "wait set",
+             "AM config: %d handler%s, recv buf size %zd MiB each, %s, "
+             "responses use %s",
+             numAmHandlers, (numAmHandlers == 1) ? "" : "s",
+             amhTab[0].iovReqs.iov_len / (1L << 20),
+             (amhTab[0].waitSet == NULL) ? "polling" : "wait sets",
              (tciTab[tciTabLen - 1].txCQ != NULL) ? "CQ" : "counter");
   if (useScalableTxEp) {
     DBG_PRINTF(DBG_CFG,
@@ -699,37 +756,45 @@ void init_ofiDoProviderChecks(void) {
 static
 void init_ofiEp(void) {
   //
-  // The AM handler is responsible not only for AM handling and progress
-  // on any RMA it initiates but also progress on inbound RMA, if that
-  // is needed.  It uses a wait set to organize this.
+  // Compute numbers of transmit and receive contexts, and then create
+  // the transmit context table.
   //
-  {
+  useScalableTxEp = (ofi_info->domain_attr->max_ep_tx_ctx > 1
+                     && chpl_env_rt_get_bool("COMM_OFI_USE_SCALABLE_EP",
+                                             true));
+  init_ofiEpNumCtxs();
+
+  tciTabLen = numTxCtxs;
+  CHPL_CALLOC(tciTab, tciTabLen);
+
+  //
+  // Each AM handler is responsible not only for AM handling and
+  // progress on any RMA it initiates but also, for the first one,
+  // progress on inbound RMA, if that is needed.  Each uses a wait set
+  // of its own to organize this, so that it wakes only for its own
+  // completions.  If the provider has no wait sets, they poll.
+  //
+  CHPL_CALLOC(amhTab, numAmHandlers);
+  for (int i = 0; i < numAmHandlers; i++) {
     struct fi_wait_attr waitSetAttr = (struct fi_wait_attr)
                                       { .wait_obj = FI_WAIT_UNSPEC, };
     int ret;
     if (useWaitset) {
-      OFI_CHK_2(fi_wait_open(ofi_fabric, &waitSetAttr, &ofi_amhWaitSet),
+      OFI_CHK_2(fi_wait_open(ofi_fabric, &waitSetAttr, &amhTab[i].waitSet),
                 ret, -FI_ENOSYS);
     } else {
       ret = -FI_ENOSYS;
     }
     if (ret != FI_SUCCESS) {
-      ofi_amhWaitSet = NULL;
+      for (int j = 0; j < i; j++) {
+        OFI_CHK(fi_close(&amhTab[j].waitSet->fid));
+        amhTab[j].waitSet = NULL;
+      }
+      amhTab[i].waitSet = NULL;
+      break;
     }
   }
 
-  //
-  // Compute numbers of transmit and receive contexts, and then create
-  // the transmit context table.
-  //
-  useScalableTxEp = (ofi_info->domain_attr->max_ep_tx_ctx > 1
-                     && chpl_env_rt_get_bool("COMM_OFI_USE_SCALABLE_EP",
-                                             true));
-  init_ofiEpNumCtxs();
-
-  tciTabLen = numTxCtxs;
-  CHPL_CALLOC(tciTab, tciTabLen);
-
   //
   // Create transmit contexts.
   //
@@ -743,7 +808,7 @@ void init_ofiEp(void) {
   //
   struct fi_av_attr avAttr = (struct fi_av_attr)
                              { .type = FI_AV_TABLE,
-                               .count = chpl_numNodes * 2 /* AM, RMA+AMO */,
+                               .count = chpl_numNodes * numRxAddrsPerNode,
                                .name = NULL,
                                .rx_ctx_bits = 0, };
   if (provCtl_sizeAvsByNumEps) {
@@ -788,27 +853,28 @@ void init_ofiEp(void) {
   //
   // TX contexts for the AM handler(s) can just use counters, if the
   // provider supports them.  Otherwise, they have to use CQs also.
+  // AM handler i has tciTab[numWorkerTxCtxs + i], tied to its wait set.
   //
-  const enum fi_wait_obj waitObj = (ofi_amhWaitSet == NULL)
+  const enum fi_wait_obj waitObj = (amhTab[0].waitSet == NULL)
                                    ? FI_WAIT_NONE
                                    : FI_WAIT_SET;
-  if (ofi_info->domain_attr->cntr_cnt > 0) {
-    cntrAttr = (struct fi_cntr_attr)
-               { .events = FI_CNTR_EVENTS_COMP,
+  for (int i = 0; i < numAmHandlers; i++) {
+    if (ofi_info->domain_attr->cntr_cnt > 0) {
+      cntrAttr = (struct fi_cntr_attr)
+                 { .events = FI_CNTR_EVENTS_COMP,
+                   .wait_obj = waitObj,
+                   .wait_set = amhTab[i].waitSet, };
+      init_ofiEpTxCtx(numWorkerTxCtxs + i, true /*isAMHandler*/,
+                      NULL, &cntrAttr);
+    } else {
+      cqAttr = (struct fi_cq_attr)
+               { .format = FI_CQ_FORMAT_MSG,
+                 .size = 100, // TODO
                  .wait_obj = waitObj,
-                 .wait_set = ofi_amhWaitSet, };
-    for (int i = numWorkerTxCtxs; i < tciTabLen; i++) {
-      init_ofiEpTxCtx(i, true /*isAMHandler*/, NULL, &cntrAttr);
-    }
-  } else {
-    cqAttr = (struct fi_cq_attr)
-             { .format = FI_CQ_FORMAT_MSG,
-               .size = 100, // TODO
-               .wait_obj = waitObj,
-               .wait_cond = FI_CQ_COND_NONE,
-               .wait_set = ofi_amhWaitSet, };
-    for (int i = numWorkerTxCtxs; i < tciTabLen; i++) {
-      init_ofiEpTxCtx(i, true /*isAMHandler*/, &cqAttr, NULL);
+                 .wait_cond = FI_CQ_COND_NONE,
+                 .wait_set = amhTab[i].waitSet, };
+      init_ofiEpTxCtx(numWorkerTxCtxs + i, true /*isAMHandler*/,
+                      &cqAttr, NULL);
     }
   }
 
@@ -818,23 +884,35 @@ void init_ofiEp(void) {
   // For the CQ length, allow for an appreciable proportion of the job
   // to send requests to us at once.
   //
+  for (int i = 0; i < numAmHandlers; i++) {
+    struct perAmHandlerInfo_t* amhip = &amhTab[i];
+    cqAttr = (struct fi_cq_attr)
+             { .size = chpl_numNodes * numWorkerTxCtxs,
+               .format = FI_CQ_FORMAT_DATA,
+               .wait_obj = waitObj,
+               .wait_cond = FI_CQ_COND_NONE,
+               .wait_set = amhip->waitSet, };
+    OFI_CHK(fi_endpoint(ofi_domain, ofi_info, &amhip->rxEp, NULL));
+    OFI_CHK(fi_ep_bind(amhip->rxEp, &ofi_av->fid, 0));
+    OFI_CHK(fi_cq_open(ofi_domain, &cqAttr, &amhip->rxCQ, NULL));
+    OFI_CHK(fi_ep_bind(amhip->rxEp, &amhip->rxCQ->fid,
+                       FI_TRANSMIT | FI_RECV));
+    OFI_CHK(fi_enable(amhip->rxEp));
+  }
+
+  //
+  // Inbound RMA progress wakes the first AM handler.
+  //
   cqAttr = (struct fi_cq_attr)
            { .size = chpl_numNodes * numWorkerTxCtxs,
              .format = FI_CQ_FORMAT_DATA,
              .wait_obj = waitObj,
              .wait_cond = FI_CQ_COND_NONE,
-             .wait_set = ofi_amhWaitSet, };
+             .wait_set = amhTab[0].waitSet, };
   cntrAttr = (struct fi_cntr_attr)
              { .events = FI_CNTR_EVENTS_COMP,
                .wait_obj = waitObj,
-               .wait_set = ofi_amhWaitSet, };
-
-  OFI_CHK(fi_endpoint(ofi_domain, ofi_info, &ofi_rxEp, NULL));
-  OFI_CHK(fi_ep_bind(ofi_rxEp, &ofi_av->fid, 0));
-  OFI_CHK(fi_cq_open(ofi_domain, &cqAttr, &ofi_rxCQ, NULL));
-  OFI_CHK(fi_ep_bind(ofi_rxEp, &ofi_rxCQ->fid,
-                     FI_TRANSMIT | FI_RECV));
-  OFI_CHK(fi_enable(ofi_rxEp));
+               .wait_set = amhTab[0].waitSet, };
 
   OFI_CHK(fi_endpoint(ofi_domain, ofi_info, &ofi_rxEpRma, NULL));
   OFI_CHK(fi_ep_bind(ofi_rxEpRma, &ofi_av->fid, 0));
@@ -853,8 +931,6 @@ void init_ofiEp(void) {
 
 static
 void init_ofiEpNumCtxs(void) {
-  CHK_TRUE(numAmHandlers == 1); // force reviewing this if #AM handlers changes
-
   //
   // Note for future maintainers: if interoperability between Chapel
   // and other languages someday results in non-tasking layer threads
@@ -869,12 +945,55 @@ void init_ofiEpNumCtxs(void) {
   // Initially, just make sure there are enough for each AM handler to
   // have its own, plus at least one more.
   //
+  // With regular transmit endpoints every transmit context is an
+  // endpoint, and those share the domain's endpoint count with the
+  // receiving ones: one per AM handler, plus one for RMA.
+  //
   const struct fi_domain_attr* dom_attr = ofi_info->domain_attr;
-  int maxWorkerTxCtxs;
-  if (useScalableTxEp)
-    maxWorkerTxCtxs = dom_attr->max_ep_tx_ctx - numAmHandlers;
-  else
-    maxWorkerTxCtxs = dom_attr->ep_cnt - numAmHandlers;
+  const int maxTxCtxs = useScalableTxEp
+                        ? dom_attr->max_ep_tx_ctx
+                        : dom_attr->ep_cnt;
+
+  //
+  // Decide how many AM handlers to have.  Each needs a transmit context
+  // of its own, and a regular endpoint of its own to receive on, and we
+  // have to leave at least one transmit context for everyone else.
+  //
+  numAmHandlers = chpl_env_rt_get_int("COMM_OFI_NUM_AM_HANDLERS", 1);
+  if (numAmHandlers < 1) {
+    chpl_warning("CHPL_RT_COMM_OFI_NUM_AM_HANDLERS < 1, using 1", 0, 0);
+    numAmHandlers = 1;
+  } else {
+    int maxAmHandlers = MAX_AM_HANDLERS;
+    if (useScalableTxEp) {
+      // The tx contexts come from the scalable endpoint, which itself
+      // is one more endpoint along with the RMA receiving one.
+      if (maxAmHandlers > maxTxCtxs - 1)
+        maxAmHandlers = maxTxCtxs - 1;
+      if (maxAmHandlers > (int) dom_attr->ep_cnt - 2)
+        maxAmHandlers = (int) dom_attr->ep_cnt - 2;
+    } else {
+      // Each AM handler uses two endpoints, one to transmit and one to
+      // receive.  Leave one for a worker and one for RMA.
+      if (maxAmHandlers > (maxTxCtxs - 2) / 2)
+        maxAmHandlers = (maxTxCtxs - 2) / 2;
+    }
+    if (maxAmHandlers < 1)
+      maxAmHandlers = 1;
+    if (numAmHandlers > maxAmHandlers) {
+      char msg[100];
+      (void) snprintf(msg, sizeof(msg),
+                      "CHPL_RT_COMM_OFI_NUM_AM_HANDLERS > %d, using %d",
+                      maxAmHandlers, maxAmHandlers);
+      chpl_warning(msg, 0, 0);
+      numAmHandlers = maxAmHandlers;
+    }
+  }
+
+  int maxWorkerTxCtxs = maxTxCtxs - numAmHandlers;
+  if (!useScalableTxEp) {
+    maxWorkerTxCtxs -= numAmHandlers + 1; // the receiving endpoints
+  }
 
   CHK_TRUE(maxWorkerTxCtxs > 0);
 
@@ -926,10 +1045,10 @@ void init_ofiEpNumCtxs(void) {
   }
 
   //
-  // Receive contexts are much easier -- we just need one
-  // for each AM handler.
+  // Receive contexts are much easier -- we just need one for each AM
+  // handler, on the handler's own endpoint.
   //
-  CHK_TRUE(dom_attr->max_ep_rx_ctx >= numAmHandlers);
+  CHK_TRUE(dom_attr->max_ep_rx_ctx >= 1);
   numRxCtxs = numAmHandlers;
 }
 
@@ -978,7 +1097,13 @@ void init_ofiExchangeAvInfo(void) {
     size_t len = 0;
     size_t lenRma = 0;
 
-    OFI_CHK_1(fi_getname(&ofi_rxEp->fid, NULL, &len), -FI_ETOOSMALL);
+    OFI_CHK_1(fi_getname(&amhTab[0].rxEp->fid, NULL, &len), -FI_ETOOSMALL);
+    for (int i = 1; i < numAmHandlers; i++) {
+      size_t lenAmh = 0;
+      OFI_CHK_1(fi_getname(&amhTab[i].rxEp->fid, NULL, &lenAmh),
+                -FI_ETOOSMALL);
+      CHK_TRUE(len == lenAmh);
+    }
     OFI_CHK_1(fi_getname(&ofi_rxEpRma->fid, NULL, &lenRma), -FI_ETOOSMALL);
     CHK_TRUE(len == lenRma);
 
@@ -996,27 +1121,32 @@ void init_ofiExchangeAvInfo(void) {
   char* addrs;
   size_t my_addr_len = 0;
 
-  OFI_CHK_1(fi_getname(&ofi_rxEp->fid, NULL, &my_addr_len), -FI_ETOOSMALL);
-  CHPL_CALLOC_SZ(my_addr, 2 * my_addr_len, 1);
-  OFI_CHK(fi_getname(&ofi_rxEp->fid, my_addr, &my_addr_len));
-  OFI_CHK(fi_getname(&ofi_rxEpRma->fid, my_addr + my_addr_len, &my_addr_len));
-  CHPL_CALLOC_SZ(addrs, chpl_numNodes, 2 * my_addr_len);
+  OFI_CHK_1(fi_getname(&amhTab[0].rxEp->fid, NULL, &my_addr_len),
+            -FI_ETOOSMALL);
+  CHPL_CALLOC_SZ(my_addr, numRxAddrsPerNode * my_addr_len, 1);
+  for (int i = 0; i < numAmHandlers; i++) {
+    size_t len = my_addr_len;
+    OFI_CHK(fi_getname(&amhTab[i].rxEp->fid, my_addr + i * my_addr_len,
+                       &len));
+  }
+  OFI_CHK(fi_getname(&ofi_rxEpRma->fid,
+                     my_addr + numAmHandlers * my_addr_len, &my_addr_len));
+  CHPL_CALLOC_SZ(addrs, chpl_numNodes, numRxAddrsPerNode * my_addr_len);
   if (DBG_TEST_MASK(DBG_CFGAV)) {
-    char nameBuf[128];
-    size_t nameLen;
-    nameLen = sizeof(nameBuf);
-    char nameBuf2[128];
-    size_t nameLen2;
-    nameLen2 = sizeof(nameBuf2);
-    (void) fi_av_straddr(ofi_av, my_addr, nameBuf, &nameLen);
-    (void) fi_av_straddr(ofi_av, my_addr + my_addr_len, nameBuf2, &nameLen2);
-    DBG_PRINTF(DBG_CFGAV, "my_addrs: %.*s%s, %.*s%s",
-               (int) nameLen, nameBuf,
-               (nameLen <= sizeof(nameBuf)) ? "" : "[...]",
-               (int) nameLen2, nameBuf2,
-               (nameLen2 <= sizeof(nameBuf2)) ? "" : "[...]");
-  }
-  chpl_comm_ofi_oob_allgather(my_addr, addrs, 2 * my_addr_len);
+    for (int i = 0; i < numRxAddrsPerNode; i++) {
+      char nameBuf[128];
+      size_t nameLen;
+      nameLen = sizeof(nameBuf);
+      (void) fi_av_straddr(ofi_av, my_addr + i * my_addr_len,
+                           nameBuf, &nameLen);
+      DBG_PRINTF(DBG_CFGAV, "my_addrs[%d] (%s): %.*s%s",
+                 i, (i < numAmHandlers) ? "AM" : "RMA",
+                 (int) nameLen, nameBuf,
+                 (nameLen <= sizeof(nameBuf)) ? "" : "[...]");
+    }
+  }
+  chpl_comm_ofi_oob_allgather(my_addr, addrs,
+                              numRxAddrsPerNode * my_addr_len);
 
   //
   // Insert the addresses into the address vector and build up a vector
@@ -1028,9 +1158,10 @@ void init_ofiExchangeAvInfo(void) {
   // Only when the provider cannot support scalable EPs and we have
   // multiple actual endpoints are the AVs individualized to those.
   //
-  CHPL_CALLOC(ofi_rxAddrs, 2 * chpl_numNodes);
-  CHK_TRUE(fi_av_insert(ofi_av, addrs, 2 * chpl_numNodes, ofi_rxAddrs, 0, NULL)
-           == 2 * chpl_numNodes);
+  const size_t numRxAddrs = numRxAddrsPerNode * chpl_numNodes;
+  CHPL_CALLOC(ofi_rxAddrs, numRxAddrs);
+  CHK_TRUE(fi_av_insert(ofi_av, addrs, numRxAddrs, ofi_rxAddrs, 0, NULL)
+           == numRxAddrs);
 
   CHPL_FREE(my_addr);
   CHPL_FREE(addrs);
@@ -1105,6 +1236,13 @@ void init_ofiForRma(void) {
   // initialize its internals.  The datatype here doesn't matter.
   //
   (void) isAtomicValid(FI_INT32);
+
+  //
+  // Strided transfers whose contiguous chunks are no larger than this
+  // are packed and done via AM rather than with RMA.
+  //
+  strdPackMaxChunk = chpl_env_rt_get_size("COMM_OFI_STRD_PACK_MAX",
+                                          strdPackMaxChunk);
 }
 
 
@@ -1120,9 +1258,10 @@ void init_ofiForAms(void) {
   // comm=ugni AM handler can handle just over 150k "fast" AM requests
   // in 0.1 sec.  Assuming an average AM request size of 256 bytes, a 40
   // MiB buffer is enough to give us the desired 0.1 sec lifetime before
-  // it needs renewing.
+  // it needs renewing.  Requests are spread across the AM handlers, so
+  // each of them can get by with its share of that.
   //
-  const size_t amLZSize = (size_t) 40 << 20;
+  const size_t amLZSize = ((size_t) 40 << 20) / numAmHandlers;
 
   //
   // Set the minimum multi-receive buffer space.  Some providers don't
@@ -1130,31 +1269,35 @@ void init_ofiForAms(void) {
   // case.  Note, however, that if it does fail and we get overruns,
   // we'll die.
   //
-  {
-    const size_t sz = AM_MAX_MSG_SIZE;
-    int ret;
-    OFI_CHK_2(fi_setopt(&ofi_rxEp->fid, FI_OPT_ENDPOINT,
-                        FI_OPT_MIN_MULTI_RECV, &sz, sizeof(sz)),
-              ret, -FI_ENOSYS);
-  }
+  for (int i = 0; i < numAmHandlers; i++) {
+    struct perAmHandlerInfo_t* amhip = &amhTab[i];
 
-  //
-  // Pre-post multi-receive buffer for inbound AM requests.
-  //
-  CHPL_CALLOC_SZ(amLZs, 1, amLZSize);
+    {
+      const size_t sz = AM_MAX_MSG_SIZE;
+      int ret;
+      OFI_CHK_2(fi_setopt(&amhip->rxEp->fid, FI_OPT_ENDPOINT,
+                          FI_OPT_MIN_MULTI_RECV, &sz, sizeof(sz)),
+                ret, -FI_ENOSYS);
+    }
 
-  ofi_iov_reqs.iov_base = amLZs;
-  ofi_iov_reqs.iov_len = amLZSize;
-  ofi_msg_reqs.msg_iov = &ofi_iov_reqs;
-  ofi_msg_reqs.desc = NULL;
-  ofi_msg_reqs.iov_count = 1;
-  ofi_msg_reqs.addr = FI_ADDR_UNSPEC;
-  ofi_msg_reqs.context = NULL;
-  ofi_msg_reqs.data = 0x0;
-  OFI_CHK(fi_recvmsg(ofi_rxEp, &ofi_msg_reqs, FI_MULTI_RECV));
-  DBG_PRINTF(DBG_AM | DBG_AMRECV,
-             "pre-post fi_recvmsg(AMLZs, len %zd)",
-             ofi_msg_reqs.msg_iov->iov_len);
+    //
+    // Pre-post multi-receive buffer for inbound AM requests.
+    //
+    CHPL_CALLOC_SZ(amhip->amLZs, 1, amLZSize);
+
+    amhip->iovReqs.iov_base = amhip->amLZs;
+    amhip->iovReqs.iov_len = amLZSize;
+    amhip->msgReqs.msg_iov = &amhip->iovReqs;
+    amhip->msgReqs.desc = NULL;
+    amhip->msgReqs.iov_count = 1;
+    amhip->msgReqs.addr = FI_ADDR_UNSPEC;
+    amhip->msgReqs.context = NULL;
+    amhip->msgReqs.data = 0x0;
+    OFI_CHK(fi_recvmsg(amhip->rxEp, &amhip->msgReqs, FI_MULTI_RECV));
+    DBG_PRINTF(DBG_AM | DBG_AMRECV,
+               "pre-post fi_recvmsg(AMLZs[%d], len %zd)",
+               i, amhip->msgReqs.msg_iov->iov_len);
+  }
 
   init_amHandling();
 }
@@ -1180,25 +1323,38 @@ void chpl_comm_rollcall(void) {
 // Chapel global and private variable support
 //
 
-wide_ptr_t* chpl_comm_broadcast_global_vars_helper(void) {
+//
+// A private broadcast id that refers to the global variables buffer
+// instead of an entry in the private broadcast table.
+//
+#define PRIV_BCAST_ID_GLOBALS (-1)
+
+static void*** chplPrivBcastTabMap;
+static wide_ptr_t** globalsBcastBufMap;
+
+static void privBcastSubtree(int, size_t, c_nodeid_t);
+
+void chpl_comm_broadcast_global_vars_helper(wide_ptr_t* buf) {
   //
-  // Gather the global variables' wide pointers on node 0 into a
-  // buffer, and broadcast the address of that buffer to the other
-  // nodes.
+  // Share the addresses of everyone's buffers, then have node 0 put
+  // its buffer's contents into the others' over the broadcast tree.
+  // No one can look at their buffer until that's done.
   //
-  wide_ptr_t* buf;
+  CHPL_CALLOC(globalsBcastBufMap, chpl_numNodes);
+  chpl_comm_ofi_oob_allgather(&buf, globalsBcastBufMap, sizeof(buf));
   if (chpl_nodeID == 0) {
-    CHPL_CALLOC(buf, chpl_numGlobalsOnHeap);
-    for (int i = 0; i < chpl_numGlobalsOnHeap; i++) {
-      buf[i] = *chpl_globals_registry[i];
-    }
+    privBcastSubtree(PRIV_BCAST_ID_GLOBALS,
+                     chpl_numGlobalsOnHeap * sizeof(*buf), 0);
   }
-  chpl_comm_ofi_oob_bcast(&buf, sizeof(buf));
-  return buf;
+  chpl_comm_barrier("globals broadcast done");
+  CHPL_FREE(globalsBcastBufMap);
 }
 
 
-static void*** chplPrivBcastTabMap;
+void chpl_comm_exchange_addrs_helper(void* addr, void** addrMap) {
+  chpl_comm_ofi_oob_allgather(&addr, addrMap, sizeof(addr));
+}
+
 
 static
 void init_broadcast_private(void) {
@@ -1219,16 +1375,6 @@ void init_broadcast_private(void) {
 }
 
 
-void chpl_comm_broadcast_private(int id, size_t size) {
-  for (int i = 0; i < chpl_numNodes; i++) {
-    if (i != chpl_nodeID) {
-      (void) ofi_put(chpl_rt_priv_bcast_tab[id], i,
-                     chplPrivBcastTabMap[i][id], size);
-    }
-  }
-}
-
-
 ////////////////////////////////////////
 //
 // Interface: shutdown
@@ -1307,12 +1453,14 @@ void fini_ofi(void) {
 
   CHPL_FREE(memTabMap);
 
-  CHPL_FREE(amLZs);
-
   CHPL_FREE(ofi_rxAddrs);
 
-  OFI_CHK(fi_close(&ofi_rxEp->fid));
-  OFI_CHK(fi_close(&ofi_rxCQ->fid));
+  for (int i = 0; i < numAmHandlers; i++) {
+    OFI_CHK(fi_close(&amhTab[i].rxEp->fid));
+    OFI_CHK(fi_close(&amhTab[i].rxCQ->fid));
+    CHPL_FREE(amhTab[i].amLZs);
+  }
+
   OFI_CHK(fi_close(&ofi_rxEpRma->fid));
   if (ofi_rxCQRma != NULL) {
     OFI_CHK(fi_close(&ofi_rxCQRma->fid));
@@ -1335,9 +1483,12 @@ void fini_ofi(void) {
 
   OFI_CHK(fi_close(&ofi_av->fid));
 
-  if (ofi_amhWaitSet != NULL) {
-    OFI_CHK(fi_close(&ofi_amhWaitSet->fid));
+  for (int i = 0; i < numAmHandlers; i++) {
+    if (amhTab[i].waitSet != NULL) {
+      OFI_CHK(fi_close(&amhTab[i].waitSet->fid));
+    }
   }
+  CHPL_FREE(amhTab);
 
   OFI_CHK(fi_close(&ofi_domain->fid));
   OFI_CHK(fi_close(&ofi_fabric->fid));
@@ -1606,7 +1757,11 @@ typedef enum {
   am_opGet,                             // do an RMA GET
   am_opPut,                             // do an RMA PUT
   am_opAMO,                             // do an AMO
+  am_opAMOBatch,                        // do a batch of non-fetching AMOs
   am_opShutdown,                        // signal main process for shutdown
+  am_opPrivBcast,                       // forward a private broadcast
+  am_opGetUnpack,                       // GET packed data, unpack strided
+  am_opPackPut,                         // pack strided data, PUT it
 } amOp_t;
 
 #ifdef CHPL_COMM_DEBUG
@@ -1619,6 +1774,8 @@ static void amRequestExecOn(c_nodeid_t, c_sublocid_t, chpl_fn_int_t,
                             chpl_comm_on_bundle_t*, size_t,
                             chpl_bool, chpl_bool);
 static void amRequestRMA(c_nodeid_t, amOp_t, void*, void*, size_t);
+static void amRequestStrdRMA(c_nodeid_t, amOp_t, void*, void*, size_t,
+                             size_t);
 static void amRequestAMO(c_nodeid_t, void*, const void*, const void*, void*,
                          int, enum fi_datatype, size_t);
 static void amRequestCommon(c_nodeid_t, chpl_comm_on_bundle_t*, size_t,
@@ -1627,19 +1784,29 @@ static void amRequestCommon(c_nodeid_t, chpl_comm_on_bundle_t*, size_t,
 
 static inline
 void ensure_progress(void) {
+  //
+  // All the AM handlers share the RMA target endpoint, so only let one
+  // of them at a time drive progress on it.
+  //
+  static atomic_bool rxRmaProgressBusy;
   if (isAmHandler
-      && ofi_info->domain_attr->data_progress == FI_PROGRESS_MANUAL) {
+      && ofi_info->domain_attr->data_progress == FI_PROGRESS_MANUAL
+      && !atomic_exchange_bool(&rxRmaProgressBusy, true)) {
     if (ofi_rxCQRma != NULL) {
       struct fi_cq_data_entry cqe;
       (void) readCQ(ofi_rxCQRma, &cqe, 1);
     } else {
       (void) fi_cntr_read(ofi_rxCntrRma);
     }
+    atomic_store_bool(&rxRmaProgressBusy, false);
   }
 }
 
 
-void chpl_comm_task_end(void) { }
+void chpl_comm_task_end(void) {
+  amoBatchFlush(true /*free*/);
+  unorderedRmaRetire(true /*free*/);
+}
 
 
 void chpl_comm_execute_on(c_nodeid_t node, c_sublocid_t subloc,
@@ -1784,6 +1951,30 @@ void amRequestRMA(c_nodeid_t node, amOp_t op,
 }
 
 
+//
+// Have the target node do its side of a strided transfer.  The buffer
+// at 'buf' on this node holds 'descSize' bytes of stride descriptor
+// followed by 'size' bytes of packed data.
+//
+static
+void amRequestStrdRMA(c_nodeid_t node, amOp_t op, void* raddr, void* buf,
+                      size_t descSize, size_t size) {
+  chpl_comm_on_bundle_t arg;
+  arg.comm.srma = (struct chpl_comm_bundleData_strdRMA_t)
+                    { .b = (struct chpl_comm_bundleData_base_t)
+                           { .op = op, .node = chpl_nodeID },
+                      .descSize = descSize,
+                      .addr = raddr,
+                      .raddr = buf,
+                      .size = size,
+                      .pAmDone = NULL };
+  amRequestCommon(node, &arg,
+                  (offsetof(chpl_comm_on_bundle_t, comm)
+                   + sizeof(arg.comm.srma)),
+                  &arg.comm.srma.pAmDone, false, true);
+}
+
+
 static inline
 void amRequestAMO(c_nodeid_t node, void* object,
                   const void* operand1, const void* operand2, void* result,
@@ -1833,6 +2024,32 @@ void amRequestAMO(c_nodeid_t node, void* object,
   }
 }
 
+static inline
+struct chpl_comm_amoNF_t* amoBatchAMOs(
+                            struct chpl_comm_bundleData_AMOBatch_t* ab) {
+  return (struct chpl_comm_amoNF_t*) (ab + 1);
+}
+
+
+//
+// Send a batch of non-fetching AMOs and wait for the target to have
+// done them all.  The batch is empty afterward.
+//
+static
+void amRequestAMOBatch(c_nodeid_t node, chpl_comm_on_bundle_t* arg) {
+  struct chpl_comm_bundleData_AMOBatch_t* ab = &arg->comm.amoBatch;
+  DBG_PRINTF(DBG_AMO,
+             "AMO batch via AM: node %d, numAMOs %d",
+             (int) node, (int) ab->numAMOs);
+  amRequestCommon(node, arg,
+                  (offsetof(chpl_comm_on_bundle_t, comm)
+                   + sizeof(*ab)
+                   + ab->numAMOs * sizeof(struct chpl_comm_amoNF_t)),
+                  &ab->pAmDone, false, true);
+  ab->numAMOs = 0;
+}
+
+
 static inline
 void amRequestShutdown(c_nodeid_t node) {
   chpl_comm_on_bundle_t arg;
@@ -1929,13 +2146,25 @@ void amRequestCommon(c_nodeid_t node,
     ctx = txnTrkEncode(txnTrkDone, &txnDone);
   }
 
+  //
+  // Pick the target AM handler.  AMOs (singly or in batches) from this
+  // node always go to the same one, which does them in arrival order.
+  // Everything else is spread across them by transmit context.
+  //
+  int amh;
+  if (myArg->comm.b.op == am_opAMO || myArg->comm.b.op == am_opAMOBatch) {
+    amh = chpl_nodeID % numAmHandlers;
+  } else {
+    amh = (tcip - tciTab) % numAmHandlers;
+  }
+
   DBG_PRINTF(DBG_AM | DBG_AMSEND,
-             "tx AM req to %d: seqId %d:%" PRIu64 ", %s, size %zd, "
+             "tx AM req to %d/%d: seqId %d:%" PRIu64 ", %s, size %zd, "
              "pAmDone %p, ctx %p",
-             node, chpl_nodeID, myArg->comm.b.seq,
+             node, amh, chpl_nodeID, myArg->comm.b.seq,
              am_opName(myArg->comm.b.op), argSize, pAmDone, ctx);
   OFI_RIDE_OUT_EAGAIN(fi_send(tcip->txCtx, myArg, argSize,
-                              mrDesc, rxMsgAddr(tcip, node), ctx),
+                              mrDesc, rxMsgAddr(tcip, node, amh), ctx),
                       checkTxCQ(tcip));
 
   //
@@ -1982,6 +2211,83 @@ void amRequestCommon(c_nodeid_t node,
 }
 
 
+////////////////////////////////////////
+//
+// Private broadcast support
+//
+
+static inline
+void* privBcastAddr(c_nodeid_t node, int id) {
+  return (id == PRIV_BCAST_ID_GLOBALS)
+         ? (void*) globalsBcastBufMap[node]
+         : chplPrivBcastTabMap[node][id];
+}
+
+
+//
+// PUT the data for a private broadcast id from this node to its
+// children in the spanning tree rooted at 'root', and then have each
+// child that has children of its own forward it on to them, via AM.
+// Returns once the whole subtree has the data.
+//
+static
+void privBcastSubtree(int id, size_t size, c_nodeid_t root) {
+  c_nodeid_t children[CHPL_COMM_BCAST_MAX_FANOUT];
+  c_nodeid_t grandchildren[CHPL_COMM_BCAST_MAX_FANOUT];
+  const int numChildren = chpl_comm_bcast_tree_children(chpl_nodeID, root,
+                                                        children);
+  void* data = privBcastAddr(chpl_nodeID, id);
+  int numFwds = 0;
+  for (int i = 0; i < numChildren; i++) {
+    (void) ofi_put(data, children[i], privBcastAddr(children[i], id), size);
+    if (chpl_comm_bcast_tree_children(children[i], root, grandchildren) > 0) {
+      children[numFwds++] = children[i];
+    }
+  }
+
+  if (numFwds == 0) {
+    return;
+  }
+
+  //
+  // Start all the forwards before waiting for any of them, so that the
+  // subtrees proceed in parallel.
+  //
+  chpl_comm_amDone_t* amDones = allocBounceBuf(numFwds * sizeof(*amDones));
+  for (int i = 0; i < numFwds; i++) {
+    amDones[i] = 0;
+  }
+  chpl_atomic_thread_fence(memory_order_release);
+
+  for (int i = 0; i < numFwds; i++) {
+    chpl_comm_on_bundle_t arg;
+    arg.comm.pb = (struct chpl_comm_bundleData_privBcast_t)
+                    { .b = (struct chpl_comm_bundleData_base_t)
+                           { .op = am_opPrivBcast, .node = chpl_nodeID },
+                      .id = id,
+                      .size = size,
+                      .root = root,
+                      .pAmDone = &amDones[i] };
+    amRequestCommon(children[i], &arg,
+                    (offsetof(chpl_comm_on_bundle_t, comm)
+                     + sizeof(arg.comm.pb)),
+                    NULL, false, true);
+  }
+
+  for (int i = 0; i < numFwds; i++) {
+    while (!*(volatile chpl_comm_amDone_t*) &amDones[i]) {
+      local_yield();
+    }
+  }
+  freeBounceBuf(amDones);
+}
+
+
+void chpl_comm_broadcast_private(int id, size_t size) {
+  privBcastSubtree(id, size, chpl_nodeID);
+}
+
+
 ////////////////////////////////////////
 //
 // Internal active message support
@@ -1994,14 +2300,20 @@ static pthread_mutex_t amStartStopMutex = PTHREAD_MUTEX_INITIALIZER;
 
 
 static void amHandler(void*);
-static void processRxAmReq(struct perTxCtxInfo_t*);
+static void processRxAmReq(struct perTxCtxInfo_t*,
+                           struct perAmHandlerInfo_t*);
 static void amHandleExecOn(chpl_comm_on_bundle_t*);
 static inline void amWrapExecOnBody(void*);
 static void amHandleExecOnLrg(chpl_comm_on_bundle_t*);
 static void amWrapExecOnLrgBody(void*);
 static void amWrapGet(void*);
 static void amWrapPut(void*);
+static void amWrapGetUnpack(void*);
+static void amWrapPackPut(void*);
+static void strdCopyDesc(chpl_bool, char*, size_t, void*);
+static void amWrapPrivBcast(void*);
 static void amHandleAMO(struct perTxCtxInfo_t*, chpl_comm_on_bundle_t*);
+static void amHandleAMOBatch(chpl_comm_on_bundle_t*);
 static inline void amSendDone(struct chpl_comm_bundleData_base_t*,
                               chpl_comm_amDone_t*);
 
@@ -2018,8 +2330,8 @@ void init_amHandling(void) {
   atomic_init_bool(&amHandlersExit, false);
 
   PTHREAD_CHK(pthread_mutex_lock(&amStartStopMutex));
-  for (int i = 0; i < numAmHandlers; i++) {
-    CHK_TRUE(chpl_task_createCommTask(amHandler, NULL) == 0);
+  for (intptr_t i = 0; i < numAmHandlers; i++) {
+    CHK_TRUE(chpl_task_createCommTask(amHandler, (void*) i) == 0);
   }
   PTHREAD_CHK(pthread_cond_wait(&amStartStopCond, &amStartStopMutex));
   PTHREAD_CHK(pthread_mutex_unlock(&amStartStopMutex));
@@ -2045,16 +2357,18 @@ void fini_amHandling(void) {
 
 
 //
-// The AM handler runs this.
+// The AM handlers run this.  The argument is the handler's index.
 //
 static
-void amHandler(void* argNil) {
+void amHandler(void* arg) {
+  const int amh = (int) (intptr_t) arg;
+  struct perAmHandlerInfo_t* amhip = &amhTab[amh];
   struct perTxCtxInfo_t* tcip;
-  CHK_TRUE((tcip = tciAllocForAmHandler()) != NULL);
+  CHK_TRUE((tcip = tciAllocForAmHandler(amh)) != NULL);
 
   isAmHandler = true;
 
-  DBG_PRINTF(DBG_THREADS, "AM handler running");
+  DBG_PRINTF(DBG_THREADS, "AM handler %d running", amh);
 
   //
   // Count this AM handler thread as running.  The creator thread
@@ -2071,14 +2385,14 @@ void amHandler(void* argNil) {
   //
   while (!atomic_load_bool(&amHandlersExit)) {
     int ret;
-    if (ofi_amhWaitSet != NULL) {
-      OFI_CHK_2(fi_wait(ofi_amhWaitSet, 100 /*ms*/), ret, -FI_ETIMEDOUT);
+    if (amhip->waitSet != NULL) {
+      OFI_CHK_2(fi_wait(amhip->waitSet, 100 /*ms*/), ret, -FI_ETIMEDOUT);
     } else {
       sched_yield();
       ret = FI_SUCCESS;
     }
     if (ret == FI_SUCCESS) {
-      processRxAmReq(tcip);
+      processRxAmReq(tcip, amhip);
       if (tcip->txCQ != NULL) {
         checkTxCQ(tcip);
       } else {
@@ -2097,23 +2411,24 @@ void amHandler(void* argNil) {
     PTHREAD_CHK(pthread_cond_signal(&amStartStopCond));
   PTHREAD_CHK(pthread_mutex_unlock(&amStartStopMutex));
 
-  DBG_PRINTF(DBG_THREADS, "AM handler done");
+  DBG_PRINTF(DBG_THREADS, "AM handler %d done", amh);
 }
 
 
 static
-void processRxAmReq(struct perTxCtxInfo_t* tcip) {
+void processRxAmReq(struct perTxCtxInfo_t* tcip,
+                    struct perAmHandlerInfo_t* amhip) {
   //
-  // Process requests received on the AM request endpoint.
+  // Process requests received on this AM handler's request endpoint.
   //
   struct fi_cq_data_entry cqes[5];
   const size_t maxEvents = sizeof(cqes) / sizeof(cqes[0]);
   ssize_t ret;
-  CHK_TRUE((ret = fi_cq_read(ofi_rxCQ, cqes, maxEvents)) > 0
+  CHK_TRUE((ret = fi_cq_read(amhip->rxCQ, cqes, maxEvents)) > 0
            || ret == -FI_EAGAIN
            || ret == -FI_EAVAIL);
   if (ret == -FI_EAVAIL) {
-    reportCQError(ofi_rxCQ);
+    reportCQError(amhip->rxCQ);
   }
 
   const size_t numEvents = (ret == -FI_EAGAIN) ? 0 : ret;
@@ -2127,7 +2442,7 @@ void processRxAmReq(struct perTxCtxInfo_t* tcip) {
       DBG_PRINTF(DBG_AM | DBG_AMRECV,
                  "CQ rx AM req @ buffer offset %zd: "
                  "seqId %d:%" PRIu64 ", %s, size %zd",
-                 (char*) req - (char*) ofi_msg_reqs.msg_iov->iov_base,
+                 (char*) req - (char*) amhip->msgReqs.msg_iov->iov_base,
                  req->comm.b.node, req->comm.b.seq,
                  am_opName(req->comm.b.op), cqes[i].len);
 
@@ -2182,14 +2497,47 @@ void processRxAmReq(struct perTxCtxInfo_t* tcip) {
                                  chpl_nullTaskID);
         break;
 
+      case am_opGetUnpack:
+        //
+        // Strided transfers communicate, and packing or unpacking the
+        // data may take a while, so we use tasks for these too.
+        //
+        chpl_task_startMovedTask(FID_NONE, (chpl_fn_p) amWrapGetUnpack,
+                                 chpl_comm_on_bundle_task_bundle(req),
+                                 sizeof(*req), c_sublocid_any,
+                                 chpl_nullTaskID);
+        break;
+
+      case am_opPackPut:
+        chpl_task_startMovedTask(FID_NONE, (chpl_fn_p) amWrapPackPut,
+                                 chpl_comm_on_bundle_task_bundle(req),
+                                 sizeof(*req), c_sublocid_any,
+                                 chpl_nullTaskID);
+        break;
+
       case am_opAMO:
         amHandleAMO(tcip, req);
         break;
 
+      case am_opAMOBatch:
+        amHandleAMOBatch(req);
+        break;
+
       case am_opShutdown:
         chpl_signal_shutdown();
         break;
 
+      case am_opPrivBcast:
+        //
+        // Forwarding a private broadcast means communicating, which
+        // we shouldn't do in the AM handler itself.
+        //
+        chpl_task_startMovedTask(FID_NONE, (chpl_fn_p) amWrapPrivBcast,
+                                 chpl_comm_on_bundle_task_bundle(req),
+                                 sizeof(*req), c_sublocid_any,
+                                 chpl_nullTaskID);
+        break;
+
       default:
         INTERNAL_ERROR_V("unexpected AM op %d", req->comm.b.op);
         break;
@@ -2202,10 +2550,10 @@ void processRxAmReq(struct perTxCtxInfo_t* tcip) {
       // not be seen except on the last received event!
       //
       CHK_TRUE(i == numEvents - 1);
-      OFI_CHK(fi_recvmsg(ofi_rxEp, &ofi_msg_reqs, FI_MULTI_RECV));
+      OFI_CHK(fi_recvmsg(amhip->rxEp, &amhip->msgReqs, FI_MULTI_RECV));
       DBG_PRINTF(DBG_AM | DBG_AMRECV,
-                 "re-post fi_recvmsg(AMLZs, len %zd)",
-                 ofi_msg_reqs.msg_iov->iov_len);
+                 "re-post fi_recvmsg(AMLZs[%td], len %zd)",
+                 amhip - amhTab, amhip->msgReqs.msg_iov->iov_len);
     }
 
     CHK_TRUE((cqes[i].flags & ~(FI_MSG | FI_RECV | FI_MULTI_RECV)) == 0);
@@ -2364,6 +2712,62 @@ void amWrapPut(void* p) {
 }
 
 
+static
+void amWrapGetUnpack(void* p) {
+  chpl_comm_on_bundle_t* req = (chpl_comm_on_bundle_t*) p;
+  struct chpl_comm_bundleData_strdRMA_t* srma = &req->comm.srma;
+  DBG_PRINTF(DBG_AM | DBG_AMRECV,
+             "amWrapGetUnpack(seqId %d:%" PRIu64 "): strided %p <- %d:%p "
+             "(%zd bytes)",
+             (int) srma->b.node, srma->b.seq,
+             srma->addr, (int) srma->b.node, srma->raddr, srma->size);
+
+  const size_t bufSize = srma->descSize + srma->size;
+  char* buf = allocBounceBuf(bufSize);
+  (void) ofi_get(buf, srma->b.node, srma->raddr, bufSize);
+  strdCopyDesc(false /*pack*/, buf, srma->descSize, srma->addr);
+  freeBounceBuf(buf);
+
+  amSendDone(&srma->b, srma->pAmDone);
+}
+
+
+static
+void amWrapPackPut(void* p) {
+  chpl_comm_on_bundle_t* req = (chpl_comm_on_bundle_t*) p;
+  struct chpl_comm_bundleData_strdRMA_t* srma = &req->comm.srma;
+  DBG_PRINTF(DBG_AM | DBG_AMRECV,
+             "amWrapPackPut(seqId %d:%" PRIu64 ") %d:%p <-- strided %p "
+             "(%zd bytes)",
+             (int) srma->b.node, srma->b.seq,
+             (int) srma->b.node, srma->raddr, srma->addr, srma->size);
+
+  char* buf = allocBounceBuf(srma->descSize + srma->size);
+  (void) ofi_get(buf, srma->b.node, srma->raddr, srma->descSize);
+  strdCopyDesc(true /*pack*/, buf, srma->descSize, srma->addr);
+  (void) ofi_put(buf + srma->descSize, srma->b.node,
+                 (char*) srma->raddr + srma->descSize, srma->size);
+  freeBounceBuf(buf);
+
+  amSendDone(&srma->b, srma->pAmDone);
+}
+
+
+static
+void amWrapPrivBcast(void* p) {
+  chpl_comm_on_bundle_t* req = (chpl_comm_on_bundle_t*) p;
+  struct chpl_comm_bundleData_privBcast_t* pb = &req->comm.pb;
+  DBG_PRINTF(DBG_AM | DBG_AMRECV,
+             "amWrapPrivBcast(seqId %d:%" PRIu64 "): id %d, size %" PRIu32
+             ", root %d",
+             (int) pb->b.node, pb->b.seq, pb->id, pb->size, (int) pb->root);
+
+  privBcastSubtree(pb->id, pb->size, pb->root);
+
+  amSendDone(&pb->b, pb->pAmDone);
+}
+
+
 static
 void amHandleAMO(struct perTxCtxInfo_t* tcip, chpl_comm_on_bundle_t* req) {
   struct chpl_comm_bundleData_AMO_t* amo = &req->comm.amo;
@@ -2441,6 +2845,23 @@ void amHandleAMO(struct perTxCtxInfo_t* tcip, chpl_comm_on_bundle_t* req) {
 }
 
 
+static
+void amHandleAMOBatch(chpl_comm_on_bundle_t* req) {
+  struct chpl_comm_bundleData_AMOBatch_t* ab = &req->comm.amoBatch;
+  struct chpl_comm_amoNF_t* amos = amoBatchAMOs(ab);
+  DBG_PRINTF(DBG_AM | DBG_AMRECV | DBG_AMO,
+             "amHandleAMOBatch(seqId %d:%" PRIu64 "): numAMOs %d",
+             (int) ab->b.node, ab->b.seq, (int) ab->numAMOs);
+
+  for (int i = 0; i < ab->numAMOs; i++) {
+    doCpuAMO(amos[i].obj, &amos[i].operand, NULL, NULL,
+             amos[i].ofiOp, amos[i].ofiType, amos[i].size);
+  }
+
+  amSendDone(&ab->b, ab->pAmDone);
+}
+
+
 static inline
 void amSendDone(struct chpl_comm_bundleData_base_t* b,
                 chpl_comm_amDone_t* pAmDone) {
@@ -2577,25 +2998,422 @@ void chpl_comm_get(void* addr, int32_t node, void* raddr,
 }
 
 
-void chpl_comm_put_strd(void* dstaddr_arg, size_t* dststrides,
-                        c_nodeid_t dstnode,
-                        void* srcaddr_arg, size_t* srcstrides,
-                        size_t* count, int32_t stridelevels, size_t elemSize,
-                        int32_t commID, int ln, int32_t fn) {
-  put_strd_common(dstaddr_arg, dststrides,
-                  dstnode,
-                  srcaddr_arg, srcstrides,
-                  count, stridelevels, elemSize,
-                  1, NULL,
-                  commID, ln, fn);
-}
+////////////////////////////////////////
+//
+// Strided RMA
+//
+// A strided transfer is made up of contiguous chunks of count[0]
+// elements each.  When the chunks are small we pack them into a buffer
+// and send one AM, and the target node GETs and unpacks them (for a
+// PUT) or packs and PUTs them (for a GET).  Otherwise we move the
+// chunks directly, coalescing as many as the provider allows into each
+// fi_writemsg() or fi_readmsg() and keeping several of those in flight
+// at once.  CHPL_RT_COMM_OFI_STRD_PACK_MAX sets the largest chunk size
+// we pack.  Transfers to or from ourselves, and ones we can't handle in
+// either of these ways, use the common code in chpl-comm-strd-xfer.h.
+//
 
+#define STRD_MAX_IOV 16
+#define STRD_MAX_TXNS_OUT 64
+#define STRD_PACK_MAX_TOTAL ((size_t) 64 << 20)
+
+
+//
+// Advance the index vector 'idx' to the next chunk, and the byte
+// offsets of that chunk from two base addresses along with it.
+// 'cnt[i]' is the number of chunks along stride level i, and 'str1[i]'
+// and 'str2[i]' are the byte strides at that level.  Returns false if
+// there are no more chunks.
+//
+static inline
+chpl_bool strdNextChunk(int lvls, const size_t* cnt, size_t* idx,
+                        const size_t* str1, size_t* off1,
+                        const size_t* str2, size_t* off2) {
+  for (int i = 0; i < lvls; i++) {
+    if (++idx[i] < cnt[i]) {
+      *off1 += str1[i];
+      *off2 += str2[i];
+      return true;
+    }
+    *off1 -= str1[i] * (cnt[i] - 1);
+    *off2 -= str2[i] * (cnt[i] - 1);
+    idx[i] = 0;
+  }
+  return false;
+}
+
+
+//
+// The span of bytes covered by a strided region.
+//
+static inline
+size_t strdExtent(int lvls, const size_t* cnt, const size_t* str,
+                  size_t chunk) {
+  size_t ext = chunk;
+  for (int i = 0; i < lvls; i++) {
+    ext += str[i] * (cnt[i] - 1);
+  }
+  return ext;
+}
+
+
+//
+// The byte strides of a strided region once it has been packed.
+//
+static inline
+void strdPackedStrides(int lvls, const size_t* cnt, size_t chunk,
+                       size_t* str) {
+  for (int i = 0; i < lvls; i++) {
+    str[i] = (i == 0) ? chunk : str[i - 1] * cnt[i - 1];
+  }
+}
+
+
+//
+// Pack a strided region into a contiguous buffer, or unpack it back.
+//
+static
+void strdCopy(chpl_bool pack, char* packed, char* base,
+              int lvls, const size_t* cnt, const size_t* str, size_t chunk) {
+  size_t pStr[lvls];
+  strdPackedStrides(lvls, cnt, chunk, pStr);
+
+  size_t idx[lvls];
+  memset(idx, 0, sizeof(idx));
+  size_t off = 0;
+  size_t pOff = 0;
+  do {
+    if (pack) {
+      memcpy(packed + pOff, base + off, chunk);
+    } else {
+      memcpy(base + off, packed + pOff, chunk);
+    }
+  } while (strdNextChunk(lvls, cnt, idx, str, &off, pStr, &pOff));
+}
+
+
+//
+// Pack or unpack a strided region described by an AM strided RMA
+// descriptor (see chpl_comm_bundleData_strdRMA_t).  The descriptor is
+// the element size, then the strides (in elements), then the counts.
+// The packed data follows it.
+//
+static
+void strdCopyDesc(chpl_bool pack, char* buf, size_t descSize, void* addr) {
+  const size_t* desc = (const size_t*) buf;
+  const int lvls = descSize / sizeof(size_t) / 2 - 1;
+  const size_t elemSize = desc[0];
+  const size_t* strides = &desc[1];
+  const size_t* count = &desc[1 + lvls];
+
+  size_t cnt[lvls];
+  size_t str[lvls];
+  for (int i = 0; i < lvls; i++) {
+    cnt[i] = count[i + 1];
+    str[i] = strides[i] * elemSize;
+  }
+
+  strdCopy(pack, buf + descSize, (char*) addr,
+           lvls, cnt, str, count[0] * elemSize);
+}
+
+
+static
+void strdViaAm(chpl_bool isPut, c_nodeid_t node,
+               void* laddr, const size_t* lStr,
+               void* raddr, const size_t* rStrides,
+               const size_t* count, int lvls, size_t elemSize,
+               const size_t* cnt, size_t chunk, size_t size) {
+  const size_t descSize = (2 * lvls + 2) * sizeof(size_t);
+  char* buf = allocBounceBuf(descSize + size);
+  CHK_TRUE(mrGetLocalKey(buf, descSize + size) == 0);
+
+  size_t* desc = (size_t*) buf;
+  desc[0] = elemSize;
+  memcpy(&desc[1], rStrides, lvls * sizeof(size_t));
+  memcpy(&desc[1 + lvls], count, (lvls + 1) * sizeof(size_t));
+
+  DBG_PRINTF(DBG_RMA | (isPut ? DBG_RMAWRITE : DBG_RMAREAD),
+             "strided %s %d:%p, %zd chunks of %zd bytes, via AM",
+             isPut ? "PUT" : "GET", (int) node, raddr, size / chunk, chunk);
+
+  if (isPut) {
+    strdCopy(true /*pack*/, buf + descSize, laddr, lvls, cnt, lStr, chunk);
+    amRequestStrdRMA(node, am_opGetUnpack, raddr, buf, descSize, size);
+  } else {
+    amRequestStrdRMA(node, am_opPackPut, raddr, buf, descSize, size);
+    strdCopy(false /*pack*/, buf + descSize, laddr, lvls, cnt, lStr, chunk);
+  }
+
+  freeBounceBuf(buf);
+}
+
+
+static inline
+void strdWaitTxns(struct perTxCtxInfo_t* tcip, int* pNumTxnsOut,
+                  int maxTxnsOut) {
+  if (tcip->txCQ != NULL) {
+    while (*pNumTxnsOut > maxTxnsOut) {
+      checkTxCQ(tcip);
+    }
+  } else {
+    while (tcip->numTxnsBegun - getTxCntr(tcip) > maxTxnsOut) {
+      sched_yield();
+      ensure_progress();
+    }
+  }
+}
+
+
+static
+void strdViaRma(chpl_bool isPut, c_nodeid_t node,
+                void* laddr, const size_t* lStr,
+                uint64_t mrKey, uint64_t mrRaddr, const size_t* rStr,
+                int lvls, const size_t* cnt, size_t chunk, size_t size) {
+  //
+  // If the local side isn't registered, go through a bounce buffer
+  // with the chunks packed into it.
+  //
+  char* myAddr = (char*) laddr;
+  size_t myStr[lvls];
+  memcpy(myStr, lStr, sizeof(myStr));
+  void* mrDesc = NULL;
+  if (mrGetDesc(&mrDesc, laddr, strdExtent(lvls, cnt, lStr, chunk)) != 0) {
+    myAddr = allocBounceBuf(size);
+    DBG_PRINTF(DBG_RMA | (isPut ? DBG_RMAWRITE : DBG_RMAREAD),
+               "strided %s BB: %p", isPut ? "PUT src" : "GET tgt", myAddr);
+    CHK_TRUE(mrGetDesc(&mrDesc, myAddr, size) == 0);
+    strdPackedStrides(lvls, cnt, chunk, myStr);
+    if (isPut) {
+      strdCopy(true /*pack*/, myAddr, laddr, lvls, cnt, lStr, chunk);
+    }
+  }
+
+  size_t maxIov = STRD_MAX_IOV;
+  if (maxIov > ofi_info->tx_attr->iov_limit)
+    maxIov = ofi_info->tx_attr->iov_limit;
+  if (maxIov > ofi_info->tx_attr->rma_iov_limit)
+    maxIov = ofi_info->tx_attr->rma_iov_limit;
+  if (maxIov < 1)
+    maxIov = 1;
+  const size_t maxMsgSize = ofi_info->ep_attr->max_msg_size;
+
+  DBG_PRINTF(DBG_RMA | (isPut ? DBG_RMAWRITE : DBG_RMAREAD),
+             "strided %s %d:0x%" PRIx64 ", %zd chunks of %zd bytes, "
+             "<= %zd per txn",
+             isPut ? "PUT" : "GET", (int) node, mrRaddr, size / chunk, chunk,
+             maxIov);
+
+  struct perTxCtxInfo_t* tcip;
+  CHK_TRUE((tcip = tciAlloc()) != NULL);
+
+  struct iovec iov[STRD_MAX_IOV];
+  void* descs[STRD_MAX_IOV];
+  struct fi_rma_iov rmaIov[STRD_MAX_IOV];
+  int numTxnsOut = 0;
+
+  size_t idx[lvls];
+  memset(idx, 0, sizeof(idx));
+  size_t lOff = 0;
+  size_t rOff = 0;
+  chpl_bool more = true;
+
+  while (more) {
+    //
+    // Gather chunks into local and remote iovecs, merging adjacent ones,
+    // until we run out of chunks, iovec entries, or message size.
+    //
+    size_t numIov = 0;
+    size_t numRmaIov = 0;
+    size_t msgSize = 0;
+    do {
+      char* l = myAddr + lOff;
+      uint64_t r = mrRaddr + rOff;
+      if (numIov > 0
+          && (char*) iov[numIov - 1].iov_base + iov[numIov - 1].iov_len == l) {
+        iov[numIov - 1].iov_len += chunk;
+      } else {
+        iov[numIov] = (struct iovec) { .iov_base = l, .iov_len = chunk };
+        descs[numIov] = mrDesc;
+        numIov++;
+      }
+      if (numRmaIov > 0
+          && rmaIov[numRmaIov - 1].addr + rmaIov[numRmaIov - 1].len == r) {
+        rmaIov[numRmaIov - 1].len += chunk;
+      } else {
+        rmaIov[numRmaIov] = (struct fi_rma_iov)
+                            { .addr = r, .len = chunk, .key = mrKey };
+        numRmaIov++;
+      }
+      msgSize += chunk;
+      more = strdNextChunk(lvls, cnt, idx, myStr, &lOff, rStr, &rOff);
+    } while (more
+             && numIov < maxIov
+             && numRmaIov < maxIov
+             && msgSize + chunk <= maxMsgSize);
+
+    strdWaitTxns(tcip, &numTxnsOut, STRD_MAX_TXNS_OUT - 1);
+
+    void* ctx;
+    if (tcip->txCQ != NULL) {
+      ctx = txnTrkEncode(txnTrkCntr, &numTxnsOut);
+      numTxnsOut++;  // count txn now, saving control flow later
+    } else {
+      ctx = NULL;
+      tcip->numTxnsBegun++;
+    }
+
+    const struct fi_msg_rma msg = { .msg_iov = iov,
+                                    .desc = descs,
+                                    .iov_count = numIov,
+                                    .addr = rxRmaAddr(tcip, node),
+                                    .rma_iov = rmaIov,
+                                    .rma_iov_count = numRmaIov,
+                                    .context = ctx,
+                                    .data = 0, };
+    DBG_PRINTF(DBG_RMA | (isPut ? DBG_RMAWRITE : DBG_RMAREAD),
+               "tx %smsg: %zd iovs, %zd rma iovs, size %zd, ctx %p",
+               isPut ? "write" : "read", numIov, numRmaIov, msgSize, ctx);
+    if (isPut) {
+      OFI_RIDE_OUT_EAGAIN(fi_writemsg(tcip->txCtx, &msg,
+                                      ofi_info->tx_attr->op_flags),
+                          checkTxCQ(tcip));
+    } else {
+      OFI_RIDE_OUT_EAGAIN(fi_readmsg(tcip->txCtx, &msg,
+                                     ofi_info->tx_attr->op_flags),
+                          checkTxCQ(tcip));
+    }
+  }
+
+  strdWaitTxns(tcip, &numTxnsOut, 0);
+  tciFree(tcip);
+
+  if (myAddr != laddr) {
+    if (!isPut) {
+      strdCopy(false /*pack*/, myAddr, laddr, lvls, cnt, lStr, chunk);
+    }
+    freeBounceBuf(myAddr);
+  }
+}
+
+
+//
+// Do a strided transfer natively, if we can.  Returns false, having
+// done nothing, if we can't.
+//
+static
+chpl_bool ofi_strd(chpl_bool isPut, c_nodeid_t node,
+                   void* laddr, size_t* lStrides,
+                   void* raddr, size_t* rStrides,
+                   size_t* count, int32_t stridelevels, size_t elemSize,
+                   int32_t commID, int ln, int32_t fn) {
+  if (node == chpl_nodeID || stridelevels <= 0) {
+    return false;
+  }
+
+  const int lvls = stridelevels;
+  const size_t chunk = count[0] * elemSize;
+  size_t cnt[lvls];
+  size_t lStr[lvls];
+  size_t rStr[lvls];
+  size_t numChunks = 1;
+  for (int i = 0; i < lvls; i++) {
+    cnt[i] = count[i + 1];
+    lStr[i] = lStrides[i] * elemSize;
+    rStr[i] = rStrides[i] * elemSize;
+    numChunks *= cnt[i];
+  }
+  const size_t size = chunk * numChunks;
+
+  //
+  // Prefer packing for small chunks.  Otherwise use RMA if the remote
+  // side is registered, or packing if it isn't, unless the transfer is
+  // too big to pack.
+  //
+  uint64_t mrKey = 0;
+  uint64_t mrRaddr = 0;
+  const chpl_bool canRma =
+    (chunk <= ofi_info->ep_attr->max_msg_size
+     && mrGetKey(&mrKey, &mrRaddr, node, raddr,
+                 strdExtent(lvls, cnt, rStr, chunk)) == 0);
+  const chpl_bool canPack = (size <= STRD_PACK_MAX_TOTAL);
+  const chpl_bool doPack = canPack && (chunk <= strdPackMaxChunk || !canRma);
+  if (!doPack && !canRma) {
+    return false;
+  }
+
+  // Communications callback support
+  if (isPut
+      && chpl_comm_have_callbacks(chpl_comm_cb_event_kind_put_strd)) {
+    chpl_comm_cb_info_t cb_data =
+      {chpl_comm_cb_event_kind_put_strd, chpl_nodeID, node,
+       .iu.comm_strd={laddr, lStrides, raddr, rStrides, count,
+                      stridelevels, elemSize, commID, ln, fn}};
+    chpl_comm_do_callbacks (&cb_data);
+  } else if (!isPut
+             && chpl_comm_have_callbacks(chpl_comm_cb_event_kind_get_strd)) {
+    chpl_comm_cb_info_t cb_data =
+      {chpl_comm_cb_event_kind_get_strd, chpl_nodeID, node,
+       .iu.comm_strd={raddr, rStrides, laddr, lStrides, count,
+                      stridelevels, elemSize, commID, ln, fn}};
+    chpl_comm_do_callbacks (&cb_data);
+  }
+
+  if (isPut) {
+    chpl_comm_diags_verbose_rdmaStrd("put", node, ln, fn, commID);
+    chpl_comm_diags_incr(put);
+  } else {
+    chpl_comm_diags_verbose_rdmaStrd("get", node, ln, fn, commID);
+    chpl_comm_diags_incr(get);
+  }
+
+  if (size == 0) {
+    return true;
+  }
+
+  if (doPack) {
+    strdViaAm(isPut, node, laddr, lStr, raddr, rStrides,
+              count, lvls, elemSize, cnt, chunk, size);
+  } else {
+    strdViaRma(isPut, node, laddr, lStr, mrKey, mrRaddr, rStr,
+               lvls, cnt, chunk, size);
+  }
+
+  return true;
+}
+
+
+void chpl_comm_put_strd(void* dstaddr_arg, size_t* dststrides,
+                        c_nodeid_t dstnode,
+                        void* srcaddr_arg, size_t* srcstrides,
+                        size_t* count, int32_t stridelevels, size_t elemSize,
+                        int32_t commID, int ln, int32_t fn) {
+  if (ofi_strd(true /*isPut*/, dstnode,
+               srcaddr_arg, srcstrides, dstaddr_arg, dststrides,
+               count, stridelevels, elemSize, commID, ln, fn)) {
+    return;
+  }
+
+  put_strd_common(dstaddr_arg, dststrides,
+                  dstnode,
+                  srcaddr_arg, srcstrides,
+                  count, stridelevels, elemSize,
+                  1, NULL,
+                  commID, ln, fn);
+}
+
+
+void chpl_comm_get_strd(void* dstaddr_arg, size_t* dststrides,
+                        c_nodeid_t srcnode,
+                        void* srcaddr_arg, size_t* srcstrides, size_t* count,
+                        int32_t stridelevels, size_t elemSize,
+                        int32_t commID, int ln, int32_t fn) {
+  if (ofi_strd(false /*isPut*/, srcnode,
+               dstaddr_arg, dststrides, srcaddr_arg, srcstrides,
+               count, stridelevels, elemSize, commID, ln, fn)) {
+    return;
+  }
 
-void chpl_comm_get_strd(void* dstaddr_arg, size_t* dststrides,
-                        c_nodeid_t srcnode,
-                        void* srcaddr_arg, size_t* srcstrides, size_t* count,
-                        int32_t stridelevels, size_t elemSize,
-                        int32_t commID, int ln, int32_t fn) {
   get_strd_common(dstaddr_arg, dststrides,
                   srcnode,
                   srcaddr_arg, srcstrides,
@@ -2604,7 +3422,6 @@ void chpl_comm_get_strd(void* dstaddr_arg, size_t* dststrides,
                   commID, ln, fn);
 }
 
-#define MAX_UNORDERED_TRANS_SZ 1024
 void chpl_comm_getput_unordered(c_nodeid_t dstnode, void* dstaddr,
                                 c_nodeid_t srcnode, void* srcaddr,
                                 size_t size, int32_t commID,
@@ -2621,14 +3438,15 @@ void chpl_comm_getput_unordered(c_nodeid_t dstnode, void* dstaddr,
   }
 
   if (dstnode == chpl_nodeID) {
-    chpl_comm_get(dstaddr, srcnode, srcaddr, size, commID, ln, fn);
+    chpl_comm_get_unordered(dstaddr, srcnode, srcaddr, size, commID, ln, fn);
   } else if (srcnode == chpl_nodeID) {
-    chpl_comm_put(srcaddr, dstnode, dstaddr, size, commID, ln, fn);
+    chpl_comm_put_unordered(srcaddr, dstnode, dstaddr, size, commID, ln, fn);
   } else {
     if (size <= MAX_UNORDERED_TRANS_SZ) {
+      // The PUT copies from buf before it returns, so it can be unordered.
       char buf[MAX_UNORDERED_TRANS_SZ];
       chpl_comm_get(buf, srcnode, srcaddr, size, commID, ln, fn);
-      chpl_comm_put(buf, dstnode, dstaddr, size, commID, ln, fn);
+      chpl_comm_put_unordered(buf, dstnode, dstaddr, size, commID, ln, fn);
     } else {
       // Note, we do not expect this case to trigger, but if it does we may
       // want to do on-stmt to src node and then transfer
@@ -2640,17 +3458,219 @@ void chpl_comm_getput_unordered(c_nodeid_t dstnode, void* dstaddr,
   }
 }
 
+//
+// Unordered GETs and PUTs of up to MAX_UNORDERED_TRANS_SZ bytes are
+// initiated as non-blocking RMA, with the task's outstanding txn
+// counter as their context.  They are retired together, either when
+// the task has MAX_UNORDERED_RMA_LEN of them outstanding, or at a task
+// fence, or when the task ends.  The source of each PUT is copied into
+// a task-private buffer first, so that the caller can reuse it right
+// away.  Anything we can't do this way is just a regular GET or PUT.
+//
 void chpl_comm_get_unordered(void* addr, c_nodeid_t node, void* raddr,
                              size_t size, int32_t commID, int ln, int32_t fn) {
-  chpl_comm_get(addr, node, raddr, size, commID, ln, fn);
+  DBG_PRINTF(DBG_INTERFACE,
+             "chpl_comm_get_unordered(%p, %d, %p, %zd, %d)",
+             addr, (int) node, raddr, size, (int) commID);
+
+  CHK_TRUE(addr != NULL);
+  CHK_TRUE(raddr != NULL);
+
+  if (size == 0) {
+    return;
+  }
+
+  if (node == chpl_nodeID) {
+    memmove(addr, raddr, size);
+    return;
+  }
+
+  uint64_t mrKey;
+  uint64_t mrRaddr;
+  void* mrDesc = NULL;
+  unorderedRmaInfo_t* info;
+  if (size > MAX_UNORDERED_TRANS_SZ
+      || mrGetKey(&mrKey, &mrRaddr, node, raddr, size) != 0
+      || mrGetDesc(&mrDesc, addr, size) != 0
+      || (info = unorderedRmaAcquire()) == NULL) {
+    chpl_comm_get(addr, node, raddr, size, commID, ln, fn);
+    return;
+  }
+
+  // Communications callback support
+  if (chpl_comm_have_callbacks(chpl_comm_cb_event_kind_get)) {
+      chpl_comm_cb_info_t cb_data =
+        {chpl_comm_cb_event_kind_get, chpl_nodeID, node,
+         .iu.comm={addr, raddr, size, commID, ln, fn}};
+      chpl_comm_do_callbacks (&cb_data);
+  }
+
+  chpl_comm_diags_verbose_rdma("unordered get", node, size, ln, fn, commID);
+  chpl_comm_diags_incr(get);
+
+  chpl_comm_taskPrvData_t* prvData = get_comm_taskPrvdata();
+  struct perTxCtxInfo_t* tcip = info->tcip;
+  void* ctx = txnTrkEncode(txnTrkCntr, &prvData->numTxnsOut);
+  DBG_PRINTF(DBG_RMA | DBG_RMAREAD,
+             "tx read unordered: %p <= %d:%p, size %zd, key 0x%" PRIx64
+             ", ctx %p",
+             addr, (int) node, raddr, size, mrKey, ctx);
+  OFI_RIDE_OUT_EAGAIN(fi_read(tcip->txCtx, addr, size,
+                              mrDesc, rxRmaAddr(tcip, node),
+                              mrRaddr, mrKey, ctx),
+                      checkTxCQ(tcip));
+  prvData->numTxnsOut++;
+  unorderedRmaCount(info);
 }
 
+
 void chpl_comm_put_unordered(void* addr, c_nodeid_t node, void* raddr,
                              size_t size, int32_t commID, int ln, int32_t fn) {
-  chpl_comm_put(addr, node, raddr, size, commID, ln, fn);
+  DBG_PRINTF(DBG_INTERFACE,
+             "chpl_comm_put_unordered(%p, %d, %p, %zd, %d)",
+             addr, (int) node, raddr, size, (int) commID);
+
+  CHK_TRUE(addr != NULL);
+  CHK_TRUE(raddr != NULL);
+
+  if (size == 0) {
+    return;
+  }
+
+  if (node == chpl_nodeID) {
+    memmove(raddr, addr, size);
+    return;
+  }
+
+  uint64_t mrKey;
+  uint64_t mrRaddr;
+  void* mrDesc = NULL;
+  unorderedRmaInfo_t* info;
+  if (size > MAX_UNORDERED_TRANS_SZ
+      || mrGetKey(&mrKey, &mrRaddr, node, raddr, size) != 0
+      || (info = unorderedRmaAcquire()) == NULL) {
+    chpl_comm_put(addr, node, raddr, size, commID, ln, fn);
+    return;
+  }
+
+  void* myAddr = info->putSrc_v[info->numTxns];
+  if (mrGetDesc(&mrDesc, myAddr, size) != 0) {
+    chpl_comm_put(addr, node, raddr, size, commID, ln, fn);
+    return;
+  }
+
+  // Communications callback support
+  if (chpl_comm_have_callbacks(chpl_comm_cb_event_kind_put)) {
+      chpl_comm_cb_info_t cb_data =
+        {chpl_comm_cb_event_kind_put, chpl_nodeID, node,
+         .iu.comm={addr, raddr, size, commID, ln, fn}};
+      chpl_comm_do_callbacks (&cb_data);
+  }
+
+  chpl_comm_diags_verbose_rdma("unordered put", node, size, ln, fn, commID);
+  chpl_comm_diags_incr(put);
+
+  memcpy(myAddr, addr, size);
+
+  chpl_comm_taskPrvData_t* prvData = get_comm_taskPrvdata();
+  struct perTxCtxInfo_t* tcip = info->tcip;
+  void* ctx = txnTrkEncode(txnTrkCntr, &prvData->numTxnsOut);
+  DBG_PRINTF(DBG_RMA | DBG_RMAWRITE,
+             "tx write unordered: %d:%p <= %p, size %zd, key 0x%" PRIx64
+             ", ctx %p",
+             (int) node, raddr, myAddr, size, mrKey, ctx);
+  OFI_RIDE_OUT_EAGAIN(fi_write(tcip->txCtx, myAddr, size,
+                               mrDesc, rxRmaAddr(tcip, node),
+                               mrRaddr, mrKey, ctx),
+                      checkTxCQ(tcip));
+  prvData->numTxnsOut++;
+  unorderedRmaCount(info);
+}
+
+
+void chpl_comm_getput_unordered_task_fence(void) {
+  DBG_PRINTF(DBG_INTERFACE,
+             "chpl_comm_getput_unordered_task_fence()");
+
+  unorderedRmaRetire(false /*free*/);
+}
+
+
+//
+// internal unordered RMA utilities
+//
+
+static
+unorderedRmaInfo_t* unorderedRmaAcquire(void) {
+  //
+  // We can only leave transactions outstanding on a tx context that
+  // has a CQ and is bound to our thread, so that nobody else will see
+  // their completions.
+  //
+  chpl_task_prvData_t* task_prvData = chpl_task_getPrvData();
+  if (task_prvData == NULL) {
+    return NULL;
+  }
+  chpl_comm_taskPrvData_t* prvData = &task_prvData->comm_data;
+
+  struct perTxCtxInfo_t* tcip;
+  CHK_TRUE((tcip = tciAlloc()) != NULL);
+  tciFree(tcip);
+  if (!tcip->bound || tcip->txCQ == NULL) {
+    return NULL;
+  }
+
+  unorderedRmaInfo_t* info = prvData->unorderedRma;
+  if (info == NULL) {
+    info = allocBounceBuf(sizeof(*info));
+    info->tcip = tcip;
+    info->numTxns = 0;
+    prvData->unorderedRma = info;
+  } else if (info->tcip != tcip) {
+    //
+    // We've moved to another thread.  Until what we started on the old
+    // one has been retired, just do regular GETs and PUTs here.
+    //
+    if (info->numTxns > 0) {
+      return NULL;
+    }
+    info->tcip = tcip;
+  }
+
+  return info;
 }
 
-void chpl_comm_getput_unordered_task_fence(void) { }
+
+static inline
+void unorderedRmaCount(unorderedRmaInfo_t* info) {
+  if (++info->numTxns >= MAX_UNORDERED_RMA_LEN) {
+    unorderedRmaRetire(false /*free*/);
+  }
+}
+
+
+static
+void unorderedRmaRetire(chpl_bool freeInfo) {
+  chpl_task_prvData_t* task_prvData = chpl_task_getPrvData();
+  if (task_prvData == NULL) {
+    return;
+  }
+  chpl_comm_taskPrvData_t* prvData = &task_prvData->comm_data;
+  unorderedRmaInfo_t* info = prvData->unorderedRma;
+  if (info == NULL) {
+    return;
+  }
+
+  if (info->numTxns > 0) {
+    waitForCQAllTxns(info->tcip, prvData);
+    info->numTxns = 0;
+  }
+
+  if (freeInfo) {
+    freeBounceBuf(info);
+    prvData->unorderedRma = NULL;
+  }
+}
 
 
 ////////////////////////////////////////
@@ -2658,26 +3678,34 @@ void chpl_comm_getput_unordered_task_fence(void) { }
 // Internal communication support
 //
 
-static inline struct perTxCtxInfo_t* tciAllocCommon(chpl_bool);
-static struct perTxCtxInfo_t* findFreeTciTabEntry(chpl_bool);
+static inline struct perTxCtxInfo_t* tciAllocCommon(void);
+static struct perTxCtxInfo_t* findFreeTciTabEntry(void);
 
 static __thread struct perTxCtxInfo_t* _ttcip;
 
 
 static inline
 struct perTxCtxInfo_t* tciAlloc(void) {
-  return tciAllocCommon(false /*bindToAmHandler*/);
+  return tciAllocCommon();
 }
 
 
+//
+// AM handler i always has tciTab[numWorkerTxCtxs + i], because its
+// completions wake that handler through its wait set.
+//
 static inline
-struct perTxCtxInfo_t* tciAllocForAmHandler(void) {
-  return tciAllocCommon(true /*bindToAmHandler*/);
+struct perTxCtxInfo_t* tciAllocForAmHandler(int amh) {
+  _ttcip = &tciTab[tciTabLen - numAmHandlers + amh];
+  CHK_TRUE(!atomic_exchange_bool(&_ttcip->allocated, true));
+  _ttcip->bound = true;
+  DBG_PRINTF(DBG_TCIPS, "alloc bound tciTab[%td]", _ttcip - tciTab);
+  return _ttcip;
 }
 
 
 static inline
-struct perTxCtxInfo_t* tciAllocCommon(chpl_bool bindToAmHandler) {
+struct perTxCtxInfo_t* tciAllocCommon(void) {
   if (_ttcip != NULL) {
     //
     // If the last tx context we used is bound to our thread or can be
@@ -2696,12 +3724,10 @@ struct perTxCtxInfo_t* tciAllocCommon(chpl_bool bindToAmHandler) {
 
   //
   // Find a tx context that isn't busy and use that one.  If this is
-  // for either the AM handler or a tasking layer fixed worker thread,
-  // bind it permanently.
+  // for a tasking layer fixed worker thread, bind it permanently.
   //
-  _ttcip = findFreeTciTabEntry(bindToAmHandler);
-  if (bindToAmHandler
-      || (tciTabFixedAssignments && chpl_task_isFixedThread())) {
+  _ttcip = findFreeTciTabEntry();
+  if (tciTabFixedAssignments && chpl_task_isFixedThread()) {
     _ttcip->bound = true;
   }
   DBG_PRINTF(DBG_TCIPS, "alloc%s tciTab[%td]",
@@ -2711,26 +3737,15 @@ struct perTxCtxInfo_t* tciAllocCommon(chpl_bool bindToAmHandler) {
 
 
 static
-struct perTxCtxInfo_t* findFreeTciTabEntry(chpl_bool bindToAmHandler) {
+struct perTxCtxInfo_t* findFreeTciTabEntry(void) {
   //
   // Find a tx context that isn't busy.  Note that tx contexts for
-  // AM handlers and other threads come out of different blocks of
-  // the table.
+  // AM handlers come out of a different block of the table, which
+  // tciAllocForAmHandler() takes them from directly.
   //
   const int numWorkerTxCtxs = tciTabLen - numAmHandlers;
   struct perTxCtxInfo_t* tcip;
 
-  if (bindToAmHandler) {
-    //
-    // AM handlers use tciTab[numWorkerTxCtxs .. tciTabLen - 1].  For
-    // now we only support a single AM handler, so this is simple.  If
-    // we ever have more, the CHK_FALSE will force us to revisit this.
-    //
-    tcip = &tciTab[numWorkerTxCtxs];
-    CHK_FALSE(atomic_exchange_bool(&tcip->allocated, true));
-    return tcip;
-  }
-
   //
   // Workers use tciTab[0 .. numWorkerTxCtxs - 1].  Search forever for
   // an entry we can use.  Give up (and kill the program) only if we
@@ -3303,6 +4318,8 @@ void local_yield(void) {
 
 static inline void doAMO(c_nodeid_t, void*, const void*, const void*, void*,
                          int, enum fi_datatype, size_t);
+static void doUnorderedAMO(c_nodeid_t, void*, const void*,
+                           enum fi_op, enum fi_datatype, size_t);
 
 
 //
@@ -3422,8 +4439,10 @@ DEFN_CHPL_COMM_ATOMIC_CMPXCHG(real64, FI_DOUBLE, double)
                "chpl_comm_atomic_%s_unordered_%s(<%s>, %d, %p, %d, %s)",\
                #fnOp, #fnType, DBG_VAL(operand, ofiType), (int) node,   \
                object, ln, chpl_lookupFilename(fn));                    \
-    chpl_comm_atomic_##fnOp##_##fnType(operand, node, object,           \
-                                       memory_order_seq_cst, ln, fn);   \
+    chpl_comm_diags_verbose_amo("amo unordered_" #fnOp, node, ln, fn);  \
+    chpl_comm_diags_incr(amo);                                          \
+    doUnorderedAMO(node, object, operand,                               \
+                   ofiOp, ofiType, sizeof(Type));                       \
   }                                                                     \
                                                                         \
   void chpl_comm_atomic_fetch_##fnOp##_##fnType                         \
@@ -3486,8 +4505,11 @@ DEFN_IFACE_AMO_SIMPLE_OP(add, FI_SUM, real64, FI_DOUBLE, double)
                "%d, %s)",                                               \
                #fnType, DBG_VAL(operand, ofiType), (int) node, object,  \
                ln, chpl_lookupFilename(fn));                            \
-    chpl_comm_atomic_sub_##fnType(operand, node, object,                \
-                                  memory_order_seq_cst, ln, fn);        \
+    Type myOpnd = negate(*(Type*) operand);                             \
+    chpl_comm_diags_verbose_amo("amo unordered_sub", node, ln, fn);     \
+    chpl_comm_diags_incr(amo);                                          \
+    doUnorderedAMO(node, object, &myOpnd,                               \
+                   FI_SUM, ofiType, sizeof(Type));                      \
   }                                                                     \
                                                                         \
   void chpl_comm_atomic_fetch_sub_##fnType                              \
@@ -3517,7 +4539,156 @@ DEFN_IFACE_AMO_SUB(real32, FI_FLOAT, float, NEGATE_U_OR_R)
 DEFN_IFACE_AMO_SUB(real64, FI_DOUBLE, double, NEGATE_U_OR_R)
 
 void chpl_comm_atomic_unordered_task_fence(void) {
-  return;
+  DBG_PRINTF(DBG_INTERFACE,
+             "chpl_comm_atomic_unordered_task_fence()");
+
+  amoBatchFlush(false /*free*/);
+  unorderedRmaRetire(false /*free*/);
+}
+
+
+//
+// Unordered non-fetching AMOs.  If the network can do the AMO we start
+// it as a non-blocking transaction along with any unordered GETs and
+// PUTs, and it is retired with those.  Otherwise we buffer it with the
+// others to be done on the CPU of the same node, and send those in one
+// batch AM when there are enough of them, at a fence, or at task end.
+//
+static
+void doUnorderedAMO(c_nodeid_t node, void* object, const void* operand,
+                    enum fi_op ofiOp, enum fi_datatype ofiType,
+                    size_t size) {
+  if (chpl_numNodes <= 1) {
+    doCpuAMO(object, operand, NULL, NULL, ofiOp, ofiType, size);
+    return;
+  }
+
+  uint64_t mrKey;
+  uint64_t mrRaddr;
+  if (isAtomicValid(ofiType)
+      && mrGetKey(&mrKey, &mrRaddr, node, object, size) == 0) {
+    unorderedRmaInfo_t* info;
+    void* myOpnd;
+    void* mrDesc = NULL;
+    if ((info = unorderedRmaAcquire()) == NULL
+        || mrGetDesc(&mrDesc, (myOpnd = info->putSrc_v[info->numTxns]),
+                     size) != 0) {
+      doAMO(node, object, operand, NULL, NULL, ofiOp, ofiType, size);
+      return;
+    }
+
+    memcpy(myOpnd, operand, size);
+
+    chpl_comm_taskPrvData_t* prvData = get_comm_taskPrvdata();
+    struct perTxCtxInfo_t* tcip = info->tcip;
+    void* ctx = txnTrkEncode(txnTrkCntr, &prvData->numTxnsOut);
+    DBG_PRINTF(DBG_AMO,
+               "tx AMO unordered: obj %d:%" PRIx64 ", opnd <%s>, "
+               "op %s, typ %s, sz %zd, ctx %p",
+               (int) node, mrRaddr, DBG_VAL(myOpnd, ofiType),
+               amo_opName(ofiOp), amo_typeName(ofiType), size, ctx);
+    OFI_RIDE_OUT_EAGAIN(fi_atomic(tcip->txCtx,
+                                  myOpnd, 1, mrDesc,
+                                  rxRmaAddr(tcip, node), mrRaddr, mrKey,
+                                  ofiType, ofiOp, ctx),
+                        checkTxCQ(tcip));
+    prvData->numTxnsOut++;
+    unorderedRmaCount(info);
+  } else if (node == chpl_nodeID) {
+    doCpuAMO(object, operand, NULL, NULL, ofiOp, ofiType, size);
+  } else {
+    amoBatchAdd(node, object, operand, ofiOp, ofiType, size);
+  }
+}
+
+
+static
+void amoBatchAdd(c_nodeid_t node, void* object, const void* operand,
+                 enum fi_op ofiOp, enum fi_datatype ofiType, size_t size) {
+  chpl_task_prvData_t* task_prvData = chpl_task_getPrvData();
+  if (task_prvData == NULL) {
+    amRequestAMO(node, object, operand, NULL, NULL, ofiOp, ofiType, size);
+    return;
+  }
+  chpl_comm_taskPrvData_t* prvData = &task_prvData->comm_data;
+
+  amoBatchInfo_t* info = prvData->amoBatches;
+  if (info == NULL) {
+    CHPL_CALLOC(info, 1);
+    CHPL_CALLOC(info->node_v, chpl_numNodes);
+    CHPL_CALLOC(info->batch_v, chpl_numNodes);
+    prvData->amoBatches = info;
+  }
+
+  chpl_comm_on_bundle_t* batch = info->batch_v[node];
+  if (batch == NULL) {
+    batch = allocBounceBuf(AM_MAX_MSG_SIZE);
+    batch->comm.amoBatch = (struct chpl_comm_bundleData_AMOBatch_t)
+                             { .b = (struct chpl_comm_bundleData_base_t)
+                                    { .op = am_opAMOBatch,
+                                      .node = chpl_nodeID },
+                               .numAMOs = 0,
+                               .pAmDone = NULL };
+    info->batch_v[node] = batch;
+  }
+
+  struct chpl_comm_bundleData_AMOBatch_t* ab = &batch->comm.amoBatch;
+  if (ab->numAMOs == 0) {
+    info->node_v[info->numNodes++] = node;
+  }
+
+  struct chpl_comm_amoNF_t* amo = &amoBatchAMOs(ab)[ab->numAMOs++];
+  amo->ofiOp = ofiOp;
+  amo->ofiType = ofiType;
+  amo->size = size;
+  amo->obj = object;
+  memcpy(&amo->operand, operand, size);
+
+  if (ab->numAMOs == MAX_AMO_BATCH_LEN) {
+    //
+    // Send the full batch and drop the node from node_v[], so that it
+    // is listed again (once) when its next AMO is buffered.
+    //
+    amRequestAMOBatch(node, batch);
+    for (int i = 0; i < info->numNodes; i++) {
+      if (info->node_v[i] == node) {
+        info->node_v[i] = info->node_v[--info->numNodes];
+        break;
+      }
+    }
+  }
+}
+
+
+static
+void amoBatchFlush(chpl_bool freeInfo) {
+  chpl_task_prvData_t* task_prvData = chpl_task_getPrvData();
+  if (task_prvData == NULL) {
+    return;
+  }
+  chpl_comm_taskPrvData_t* prvData = &task_prvData->comm_data;
+  amoBatchInfo_t* info = prvData->amoBatches;
+  if (info == NULL) {
+    return;
+  }
+
+  for (int i = 0; i < info->numNodes; i++) {
+    c_nodeid_t node = info->node_v[i];
+    amRequestAMOBatch(node, info->batch_v[node]);
+  }
+  info->numNodes = 0;
+
+  if (freeInfo) {
+    for (int node = 0; node < chpl_numNodes; node++) {
+      if (info->batch_v[node] != NULL) {
+        freeBounceBuf(info->batch_v[node]);
+      }
+    }
+    CHPL_FREE(info->batch_v);
+    CHPL_FREE(info->node_v);
+    CHPL_FREE(info);
+    prvData->amoBatches = NULL;
+  }
 }
 
 
@@ -4247,7 +5418,11 @@ const char* am_opName(amOp_t op) {
   case am_opGet: return "opGet";
   case am_opPut: return "opPut";
   case am_opAMO: return "opAMO";
+  case am_opAMOBatch: return "opAMOBatch";
   case am_opShutdown: return "opShutdown";
+  case am_opPrivBcast: return "opPrivBcast";
+  case am_opGetUnpack: return "opGetUnpack";
+  case am_opPackPut: return "opPackPut";
   default: return "op???";
   }
 }
@@ -3820,22 +3820,44 @@ void regMemBroadcast(int mr_i, int mr_cnt, chpl_bool send_mreg_cnt)
 }
 
 
-wide_ptr_t* chpl_comm_broadcast_global_vars_helper() {
-  //
-  // Gather the global variables' wide pointers on node 0 into a
-  // buffer, and broadcast the address of that buffer to the other
-  // nodes.
-  //
-  wide_ptr_t* buf;
-  if (chpl_nodeID == 0) {
-    buf = (wide_ptr_t*) chpl_mem_allocMany(chpl_numGlobalsOnHeap, sizeof(*buf),
-                                           CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
-    for (int i = 0; i < chpl_numGlobalsOnHeap; i++) {
-      buf[i] = *chpl_globals_registry[i];
-    }
+void chpl_comm_broadcast_global_vars_helper(wide_ptr_t* buf) {
+  //
+  // Broadcast the address of node 0's buffer to the other nodes, and
+  // have them GET its contents.  Node 0 won't free its buffer until
+  // after the barrier that follows this.
+  //
+  wide_ptr_t* buf_on_0 = buf;
+  PMI_Bcast(&buf_on_0, sizeof(buf_on_0));
+  if (chpl_nodeID != 0) {
+    chpl_comm_get(buf, 0, buf_on_0, chpl_numGlobalsOnHeap * sizeof(*buf),
+                  CHPL_COMM_UNKNOWN_ID, 0, -1);
   }
-  PMI_Bcast(&buf, sizeof(buf));
-  return buf;
+}
+
+
+void chpl_comm_exchange_addrs_helper(void* addr, void** addrMap)
+{
+  //
+  // PMI_Allgather() yields unordered results, so gather (node, addr)
+  // pairs and scatter the addresses into the map ourselves.
+  //
+  typedef struct {
+    c_nodeid_t nodeID;
+    void* addr;
+  } gdata_t;
+
+  gdata_t my_gdata = { chpl_nodeID, addr };
+  gdata_t* gdata;
+
+  gdata = (gdata_t*) chpl_mem_allocMany(chpl_numNodes, sizeof(gdata[0]),
+                                        CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
+  if (PMI_Allgather(&my_gdata, gdata, sizeof(gdata[0])) != PMI_SUCCESS)
+    CHPL_INTERNAL_ERROR("PMI_Allgather(addrMap) failed");
+
+  for (int i = 0; i < chpl_numNodes; i++)
+    addrMap[gdata[i].nodeID] = gdata[i].addr;
+
+  chpl_mem_free(gdata, 0, 0);
 }
 
 
@@ -38,6 +38,7 @@
 #include "qio.h"
 #include "qbuffer.h"
 #include "qio_plugin_api.h"
+#include "qio_async.h"
 
 #include "error.h"
 
@@ -57,6 +58,7 @@
 #include <sys/stat.h>
 
 #include <assert.h>
+#include <pthread.h>
 
 // Default to using close-on-exec for systems that support it.
 #ifdef O_CLOEXEC
@@ -95,6 +97,10 @@ ssize_t qio_mmap_chunk_iobufs = 128; // mmap 128 iobufs at a time (8M)
 // Future - possibly set this based on ulimit?
 ssize_t qio_initial_mmap_max = 8*1024*1024;
 
+// Buffered QIO_METHOD_ASYNC channels read at least this much at a time
+// so that several requests can be in flight together.
+ssize_t qio_async_readahead = 1024*1024;
+
 #ifdef _chplrt_H_
 qioerr qio_lock(qio_lock_t* x) {
   // recursive mutex based on glibc pthreads implementation
@@ -401,6 +407,50 @@ error:
   return err;
 }
 
+// Like qio_preadv and qio_pwritev, but for QIO_METHOD_ASYNC: the transfer
+// is split into several requests that are in flight at once, and the
+// calling task yields until they have all finished.
+static
+qioerr _qio_async_prwv(qio_file_t* file, int writing, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int64_t seek_to_offset, ssize_t* num_moved)
+{
+  ssize_t nmoved = 0;
+  int64_t num_bytes = qbuffer_iter_num_bytes(start, end);
+  ssize_t num_parts = qbuffer_iter_num_parts(start, end);
+  struct iovec* iov = NULL;
+  size_t iovcnt;
+  MAYBE_STACK_SPACE(struct iovec, iov_onstack);
+  qioerr err;
+
+  if( num_bytes < 0 || num_parts < 0 || num_parts > INT_MAX ) {
+    QIO_RETURN_CONSTANT_ERROR(EINVAL, "range outside of buffer");
+  }
+
+  if( file->fd == -1 ) {
+    QIO_RETURN_CONSTANT_ERROR(EINVAL, "invalid file descriptor");
+  }
+
+  MAYBE_STACK_ALLOC(struct iovec, num_parts, iov, iov_onstack);
+  if( ! iov ) {
+    err = QIO_ENOMEM;
+    goto error;
+  }
+
+  err = qbuffer_to_iov(buf, start, end, num_parts, iov, NULL, &iovcnt);
+  if( err ) goto error;
+
+  if( writing )
+    err = qio_int_to_err(qio_async_pwritev(file->fd, iov, iovcnt, seek_to_offset, &nmoved));
+  else
+    err = qio_int_to_err(qio_async_preadv(file->fd, iov, iovcnt, seek_to_offset, &nmoved));
+
+error:
+  MAYBE_STACK_FREE(iov, iov_onstack);
+
+  *num_moved = nmoved;
+
+  return err;
+}
+
 qioerr qio_recv(fd_t sockfd, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int flags,
               sys_sockaddr_t* src_addr_out, /* can be NULL */
               void* ancillary_out, socklen_t* ancillary_len_inout, /* can be NULL */
@@ -561,6 +611,17 @@ qio_hint_t choose_io_method(qio_file_t* file, qio_hint_t hints, qio_hint_t defau
     } else {
       // method already chosen in hints.
     }
+
+    // Asynchronous I/O is positioned I/O on a file descriptor, so keep
+    // the file's own method for memory files and use read/write for
+    // files that can't seek.
+    if( method == QIO_METHOD_ASYNC ) {
+      if( file->fd == -1 && (default_hints & QIO_METHODMASK) ) {
+        method = default_hints & QIO_METHODMASK;
+      } else if( ! (fdflags & QIO_FDFLAG_SEEKABLE) ) {
+        method = QIO_METHOD_READWRITE;
+      }
+    }
   }
 
   // Always use fread/fwrite with FILE*
@@ -1006,11 +1067,141 @@ qioerr qio_file_close(qio_file_t* f)
 }
 
 
+// Regions of files mapped with qio_file_mmap_array.  The mapping
+// holds a reference to its file, so that qio_file_sync can write out
+// the mappings of a file before syncing it.
+typedef struct qio_mapping_s {
+  void* base;      // start of the mapping, page-aligned
+  size_t map_len;  // length of the mapping
+  void* data;      // the region asked for, within the mapping
+  int writable;
+  qio_file_t* file;
+  struct qio_mapping_s* next;
+} qio_mapping_t;
+
+static pthread_mutex_t qio_mappings_lock = PTHREAD_MUTEX_INITIALIZER;
+static qio_mapping_t* qio_mappings = NULL;
+
+qioerr qio_file_mmap_array(qio_file_t* f, int64_t start, int64_t len,
+                           int writable, qio_hint_t hints,
+                           void** data_out, void** freer_out)
+{
+  int64_t page = sys_page_size();
+  int64_t map_start = start - start % page;
+  int64_t map_len = len + (start - map_start);
+  int64_t file_len = 0;
+  qio_mapping_t* m;
+  void* base;
+  int prot = PROT_READ | PROT_WRITE;
+  int flags;
+  int populate = 0;
+  qioerr err;
+
+  *data_out = NULL;
+  *freer_out = NULL;
+
+  if( f->fp || f->fd < 0 ) {
+    QIO_RETURN_CONSTANT_ERROR(ENOSYS, "mmap requires a file descriptor");
+  }
+  if( start < 0 || len < 0 ) QIO_RETURN_CONSTANT_ERROR(EINVAL, "negative offset or length");
+  if( writable && ! (f->fdflags & QIO_FDFLAG_WRITEABLE) ) {
+    QIO_RETURN_CONSTANT_ERROR(EBADF, "file is not open for writing");
+  }
+  // This check is (only) important for 32-bit systems.
+  if( map_len > SSIZE_MAX ) QIO_RETURN_CONSTANT_ERROR(EOVERFLOW, "overflow in mmap");
+
+  err = qio_file_length(f, &file_len);
+  if( err ) return err;
+  if( start + len > file_len ) {
+    // Reading past the end would fault, so only writers may extend the file.
+    if( ! writable ) QIO_RETURN_CONSTANT_ERROR(EEOF, "region extends past end of file");
+    err = qio_int_to_err(sys_ftruncate(f->fd, start + len));
+    if( err ) return err;
+  }
+
+  // mmap cannot map an empty region, but an empty array is fine.
+  if( len == 0 ) return 0;
+
+  // Read-only arrays are still Chapel arrays that can be assigned to, so
+  // rather than a PROT_READ mapping that crashes on a store, give them a
+  // private copy-on-write mapping: stores change only this process's
+  // copy of the page, never the file.
+  flags = writable ? MAP_SHARED : MAP_PRIVATE;
+#ifdef MAP_POPULATE
+  if( hints & QIO_HINT_CACHED ) populate = MAP_POPULATE;
+#endif
+
+  err = qio_int_to_err(sys_mmap(NULL, map_len, prot, flags|populate,
+                                f->fd, map_start, &base));
+  if( err ) return err;
+
+  err = qio_madvise_for_hints(base, map_len, hints);
+  if( err ) {
+    sys_munmap(base, map_len);
+    return err;
+  }
+
+  m = (qio_mapping_t*) qio_malloc(sizeof(qio_mapping_t));
+  if( ! m ) {
+    sys_munmap(base, map_len);
+    return QIO_ENOMEM;
+  }
+  m->base = base;
+  m->map_len = map_len;
+  m->data = (char*) base + (start - map_start);
+  m->writable = writable;
+  m->file = f;
+  qio_file_retain(f);
+
+  pthread_mutex_lock(&qio_mappings_lock);
+  m->next = qio_mappings;
+  qio_mappings = m;
+  pthread_mutex_unlock(&qio_mappings_lock);
+
+  *data_out = m->data;
+  *freer_out = (void*) qio_file_munmap_array;
+  return 0;
+}
+
+void qio_file_munmap_array(void* data)
+{
+  qio_mapping_t** pm;
+  qio_mapping_t* m = NULL;
+
+  pthread_mutex_lock(&qio_mappings_lock);
+  for( pm = &qio_mappings; *pm; pm = &(*pm)->next ) {
+    if( (*pm)->data == data ) {
+      m = *pm;
+      *pm = m->next;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&qio_mappings_lock);
+
+  if( ! m ) return;
+
+  if( sys_munmap(m->base, m->map_len) ) {
+    chpl_internal_error("sys_munmap() failed");
+  }
+  qio_file_release(m->file);
+  qio_free(m);
+}
+
 qioerr qio_file_sync(qio_file_t* f)
 {
   qioerr err = 0;
   qioerr newerr;
 
+  // Write out any arrays mapped from this file first.
+  pthread_mutex_lock(&qio_mappings_lock);
+  for( qio_mapping_t* m = qio_mappings; m; m = m->next ) {
+    if( m->file == f && m->writable ) {
+      newerr = qio_int_to_err(sys_msync(m->base, m->map_len, MS_SYNC));
+      if( ! err ) err = newerr;
+    }
+  }
+  pthread_mutex_unlock(&qio_mappings_lock);
+
   if( f->fp ) {
     newerr = qio_int_to_err(fflush(f->fp));
     if( ! err ) err = newerr;
@@ -2206,6 +2397,7 @@ qioerr _buffered_read_atleast(qio_channel_t* ch, int64_t amt)
   qbuffer_iter_t read_end;
   ssize_t num_read;
   int64_t left = amt;
+  int64_t want;
   int64_t max_amt;
   int return_eof = 0;
   qioerr err;
@@ -2230,6 +2422,15 @@ qioerr _buffered_read_atleast(qio_channel_t* ch, int64_t amt)
     return chpl_qio_read_atleast(ch->chan_info, amt);
   }
 
+  // Asynchronous channels read ahead so that the read can be split
+  // into several requests in flight.  Only the original amount is
+  // required, since the read-ahead may run into the end of the file.
+  want = amt;
+  if( method == QIO_METHOD_ASYNC && amt < qio_async_readahead ) {
+    amt = qio_async_readahead;
+    if( amt > max_amt ) amt = max_amt;
+  }
+
   //printf("Allocating bufferspace %lli\n", (long long int) amt);
   err = _buffered_allocate_bufferspace(ch, amt, max_amt);
   if( err ) return err;
@@ -2253,6 +2454,9 @@ qioerr _buffered_read_atleast(qio_channel_t* ch, int64_t amt)
       case QIO_METHOD_PREADPWRITE:
         err = qio_preadv(ch->file, &ch->buf, read_start, read_end, read_start.offset, &num_read);
         break;
+      case QIO_METHOD_ASYNC:
+        err = _qio_async_prwv(ch->file, 0, &ch->buf, read_start, read_end, read_start.offset, &num_read);
+        break;
       case QIO_METHOD_FREADFWRITE:
         err = qio_freadv(ch->file->fp, &ch->buf, read_start, read_end, &num_read);
         break;
@@ -2270,6 +2474,12 @@ qioerr _buffered_read_atleast(qio_channel_t* ch, int64_t amt)
     // Ignore interrupted system call, just keep reading.
     if( err && qio_err_to_int(err) == EINTR ) err = 0;
 
+    if( want < amt && amt - left >= want ) {
+      // Got what was asked for; stop at the end of the read-ahead.
+      if( err && qio_err_to_int(err) == EEOF ) err = 0;
+      break;
+    }
+
     if( err ) break;
   }
 
@@ -2673,6 +2883,9 @@ qioerr _qio_buffered_behind(qio_channel_t* ch, int flushall)
         case QIO_METHOD_PREADPWRITE:
           err = qio_pwritev(ch->file, &ch->buf, write_start, write_end, write_start.offset, &num_written);
           break;
+        case QIO_METHOD_ASYNC:
+          err = _qio_async_prwv(ch->file, 1, &ch->buf, write_start, write_end, write_start.offset, &num_written);
+          break;
         case QIO_METHOD_FREADFWRITE:
           err = qio_fwritev(ch->file->fp, &ch->buf, write_start, write_end, &num_written);
           break;
@@ -2912,6 +3125,14 @@ qioerr _qio_unbuffered_write(qio_channel_t* ch, const void* ptr, ssize_t len_in,
         case QIO_METHOD_PREADPWRITE:
           err = qio_int_to_err(sys_pwrite(ch->file->fd, ptr, len, _right_mark_start(ch), &num_written));
           break;
+        case QIO_METHOD_ASYNC:
+          {
+            struct iovec one;
+            one.iov_base = (void*) ptr;
+            one.iov_len = len;
+            err = qio_int_to_err(qio_async_pwritev(ch->file->fd, &one, 1, _right_mark_start(ch), &num_written));
+          }
+          break;
         case QIO_METHOD_FREADFWRITE:
           if( ch->file->fp ) {
             num_written_u = fwrite(ptr, 1, len, ch->file->fp);
@@ -3006,6 +3227,14 @@ qioerr _qio_unbuffered_read(qio_channel_t* ch, void* ptr, ssize_t len_in, ssize_
         case QIO_METHOD_PREADPWRITE:
           err = qio_int_to_err(sys_pread(ch->file->fd, ptr, len, _right_mark_start(ch), &num_read));
           break;
+        case QIO_METHOD_ASYNC:
+          {
+            struct iovec one;
+            one.iov_base = ptr;
+            one.iov_len = len;
+            err = qio_int_to_err(qio_async_preadv(ch->file->fd, &one, 1, _right_mark_start(ch), &num_read));
+          }
+          break;
         case QIO_METHOD_FREADFWRITE:
           if( ch->file->fp ) {
             num_read_u = fread(ptr, 1, len, ch->file->fp);
@@ -3169,6 +3398,112 @@ qioerr _qio_slow_read(qio_channel_t* ch, void* ptr, ssize_t len, ssize_t* amt_re
   return ret;
 }
 
+static
+void qio_swap_units(void* dst, const void* src, int64_t len, int swap_size)
+{
+  int64_t i;
+  // dst may be src.  memcpy keeps this safe for unaligned data, and
+  // compiles to a plain load or store.
+  switch( swap_size ) {
+    case 2:
+      for( i = 0; i < len; i += 2 ) {
+        uint16_t x;
+        memcpy(&x, (const char*) src + i, 2);
+        x = bswap_16(x);
+        memcpy((char*) dst + i, &x, 2);
+      }
+      break;
+    case 4:
+      for( i = 0; i < len; i += 4 ) {
+        uint32_t x;
+        memcpy(&x, (const char*) src + i, 4);
+        x = bswap_32(x);
+        memcpy((char*) dst + i, &x, 4);
+      }
+      break;
+    case 8:
+      for( i = 0; i < len; i += 8 ) {
+        uint64_t x;
+        memcpy(&x, (const char*) src + i, 8);
+        x = bswap_64(x);
+        memcpy((char*) dst + i, &x, 8);
+      }
+      break;
+    default:
+      if( dst != src ) memcpy(dst, src, len);
+      break;
+  }
+}
+
+qioerr qio_channel_write_elts(const int threadsafe, qio_channel_t* restrict ch, const void* restrict ptr, int64_t len, int swap_size)
+{
+  qioerr err;
+  int swap = (swap_size == 2 || swap_size == 4 || swap_size == 8);
+  void* tmp = NULL;
+  int64_t done, piece;
+
+  if( swap && len % swap_size != 0 ) QIO_RETURN_CONSTANT_ERROR(EINVAL, "length is not a multiple of the swap size");
+
+  if( threadsafe ) {
+    err = qio_lock(&ch->lock);
+    if( err ) return err;
+  }
+
+  err = 0;
+  if( swap ) {
+    tmp = qio_malloc(len < QIO_BULK_CHUNK ? len : QIO_BULK_CHUNK);
+    if( ! tmp && len > 0 ) err = QIO_ENOMEM;
+  }
+
+  for( done = 0; done < len && ! err; done += piece ) {
+    const void* src = (const char*) ptr + done;
+    piece = len - done;
+    if( piece > QIO_BULK_CHUNK ) piece = QIO_BULK_CHUNK;
+    if( swap ) {
+      qio_swap_units(tmp, src, piece, swap_size);
+      src = tmp;
+    }
+    err = qio_channel_write_amt(false, ch, src, piece);
+  }
+
+  if( tmp ) qio_free(tmp);
+
+  if( threadsafe ) {
+    qio_unlock(&ch->lock);
+  }
+
+  return err;
+}
+
+qioerr qio_channel_read_elts(const int threadsafe, qio_channel_t* restrict ch, void* restrict ptr, int64_t len, int swap_size)
+{
+  qioerr err;
+  int swap = (swap_size == 2 || swap_size == 4 || swap_size == 8);
+  int64_t done, piece;
+
+  if( swap && len % swap_size != 0 ) QIO_RETURN_CONSTANT_ERROR(EINVAL, "length is not a multiple of the swap size");
+
+  if( threadsafe ) {
+    err = qio_lock(&ch->lock);
+    if( err ) return err;
+  }
+
+  err = 0;
+  for( done = 0; done < len && ! err; done += piece ) {
+    void* dst = qio_ptr_add(ptr, done);
+    piece = len - done;
+    if( piece > QIO_BULK_CHUNK ) piece = QIO_BULK_CHUNK;
+    err = qio_channel_read_amt(false, ch, dst, piece);
+    if( ! err && swap ) qio_swap_units(dst, dst, piece, swap_size);
+  }
+
+  if( threadsafe ) {
+    qio_unlock(&ch->lock);
+  }
+
+  return err;
+}
+
 // Only returns locking errors (ie when threadsafe=true).
 qioerr qio_channel_offset(const int threadsafe, qio_channel_t* ch, int64_t* offset_out)
 {
@@ -0,0 +1,547 @@
+/*
+ * Copyright 2004-2020 Hewlett Packard Enterprise Development LP
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sys_basic.h"
+
+#ifndef CHPL_RT_UNIT_TEST
+#include "chplrt.h"
+#include "chpl-env.h"
+#include "chpl-tasks.h"
+#endif
+
+#include "chpl-atomics.h"
+#include "qio.h"
+#include "sys.h"
+
+#include "qio_async.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define QIO_HAVE_IO_URING 1
+#endif
+#endif
+#endif
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+// Each transfer is cut into pieces of this many bytes...
+ssize_t qio_async_segment_size = 256*1024;
+// ... and at most this many of them are outstanding at a time.
+int qio_async_max_inflight = 16;
+
+typedef enum {
+  QIO_ASYNC_READ,
+  QIO_ASYNC_WRITE,
+} qio_async_op_t;
+
+typedef struct qio_async_req_s {
+  qio_async_op_t op;
+  fd_t fd;
+  const struct iovec* iov;
+  int iovcnt;
+  off_t offset;
+  ssize_t len;           // bytes requested
+  ssize_t result;        // bytes transferred
+  err_t err;
+  atomic_bool done;      // set last, by whoever completes the request
+  struct qio_async_req_s* next; // for the thread pool's queue
+} qio_async_req_t;
+
+typedef enum {
+  QIO_ASYNC_MODE_SYNC,   // no helpers could be started; run inline
+  QIO_ASYNC_MODE_URING,
+  QIO_ASYNC_MODE_POOL,
+} qio_async_mode_t;
+
+static qio_async_mode_t qio_async_mode = QIO_ASYNC_MODE_SYNC;
+static pthread_once_t qio_async_once = PTHREAD_ONCE_INIT;
+
+static
+void qio_async_yield(void)
+{
+#ifndef CHPL_RT_UNIT_TEST
+  chpl_task_yield();
+#else
+  sched_yield();
+#endif
+}
+
+static
+void qio_async_complete(qio_async_req_t* req, ssize_t result, err_t err)
+{
+  req->result = result;
+  req->err = err;
+  // The waiting task may reuse req as soon as it sees this.
+  atomic_store_bool(&req->done, true);
+}
+
+// Run a request on the calling thread.
+static
+void qio_async_run(qio_async_req_t* req)
+{
+  ssize_t amt = 0;
+  err_t err;
+
+  if( req->op == QIO_ASYNC_READ ) {
+    err = sys_preadv(req->fd, req->iov, req->iovcnt, req->offset, &amt);
+  } else {
+    err = sys_pwritev(req->fd, req->iov, req->iovcnt, req->offset, &amt);
+  }
+  // EOF is decided for the whole transfer, not for each piece.
+  if( err == EEOF ) err = 0;
+
+  qio_async_complete(req, amt, err);
+}
+
+#ifdef QIO_HAVE_IO_URING
+
+typedef struct {
+  int fd;
+  unsigned entries;
+  unsigned inflight;     // protected by lock; kept <= entries
+  pthread_mutex_t lock;  // protects the submission queue
+  unsigned* sq_head;
+  unsigned* sq_tail;
+  unsigned* sq_mask;
+  unsigned* sq_array;
+  struct io_uring_sqe* sqes;
+  unsigned* cq_head;
+  unsigned* cq_tail;
+  unsigned* cq_mask;
+  struct io_uring_cqe* cqes;
+} qio_uring_t;
+
+static qio_uring_t qio_uring;
+
+static
+int qio_uring_enter(unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+  return (int) syscall(__NR_io_uring_enter, qio_uring.fd,
+                       to_submit, min_complete, flags, NULL, 0);
+}
+
+// Reaps completions and marks their requests done.
+static
+void* qio_uring_reaper(void* arg)
+{
+  qio_uring_t* u = &qio_uring;
+
+  while( 1 ) {
+    unsigned head, tail, n;
+
+    if( qio_uring_enter(0, 1, IORING_ENTER_GETEVENTS) < 0 &&
+        errno != EINTR ) {
+      sched_yield();
+    }
+
+    n = 0;
+    head = *u->cq_head;
+    tail = __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE);
+    while( head != tail ) {
+      struct io_uring_cqe* cqe = &u->cqes[head & *u->cq_mask];
+      qio_async_req_t* req = (qio_async_req_t*) (uintptr_t) cqe->user_data;
+      if( cqe->res < 0 ) qio_async_complete(req, 0, -cqe->res);
+      else qio_async_complete(req, cqe->res, 0);
+      head++;
+      n++;
+    }
+    __atomic_store_n(u->cq_head, head, __ATOMIC_RELEASE);
+
+    if( n > 0 ) {
+      pthread_mutex_lock(&u->lock);
+      u->inflight -= n;
+      pthread_mutex_unlock(&u->lock);
+    }
+  }
+
+  return NULL;
+}
+
+static
+int qio_uring_init(unsigned entries)
+{
+  qio_uring_t* u = &qio_uring;
+  struct io_uring_params p;
+  size_t sq_len, cq_len, sqes_len;
+  void* sq = MAP_FAILED;
+  void* cq = MAP_FAILED;
+  void* sqes = MAP_FAILED;
+  pthread_attr_t attr;
+  pthread_t reaper;
+  int fd;
+
+  memset(&p, 0, sizeof(p));
+  fd = (int) syscall(__NR_io_uring_setup, entries, &p);
+  if( fd < 0 ) return -1;
+
+  sq_len = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+  cq_len = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+  sqes_len = p.sq_entries * sizeof(struct io_uring_sqe);
+
+  sq = mmap(NULL, sq_len, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+            fd, IORING_OFF_SQ_RING);
+  cq = mmap(NULL, cq_len, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+            fd, IORING_OFF_CQ_RING);
+  sqes = mmap(NULL, sqes_len, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+              fd, IORING_OFF_SQES);
+  if( sq == MAP_FAILED || cq == MAP_FAILED || sqes == MAP_FAILED ) goto error;
+
+  u->fd = fd;
+  u->entries = p.sq_entries;
+  u->inflight = 0;
+  pthread_mutex_init(&u->lock, NULL);
+  u->sq_head = (unsigned*) ((char*) sq + p.sq_off.head);
+  u->sq_tail = (unsigned*) ((char*) sq + p.sq_off.tail);
+  u->sq_mask = (unsigned*) ((char*) sq + p.sq_off.ring_mask);
+  u->sq_array = (unsigned*) ((char*) sq + p.sq_off.array);
+  u->sqes = (struct io_uring_sqe*) sqes;
+  u->cq_head = (unsigned*) ((char*) cq + p.cq_off.head);
+  u->cq_tail = (unsigned*) ((char*) cq + p.cq_off.tail);
+  u->cq_mask = (unsigned*) ((char*) cq + p.cq_off.ring_mask);
+  u->cqes = (struct io_uring_cqe*) ((char*) cq + p.cq_off.cqes);
+
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  if( pthread_create(&reaper, &attr, qio_uring_reaper, NULL) != 0 ) {
+    pthread_attr_destroy(&attr);
+    pthread_mutex_destroy(&u->lock);
+    goto error;
+  }
+  pthread_attr_destroy(&attr);
+
+  return 0;
+
+error:
+  if( sq != MAP_FAILED ) munmap(sq, sq_len);
+  if( cq != MAP_FAILED ) munmap(cq, cq_len);
+  if( sqes != MAP_FAILED ) munmap(sqes, sqes_len);
+  close(fd);
+  return -1;
+}
+
+// Returns 0 if the request was handed to the kernel.
+static
+int qio_uring_submit(qio_async_req_t* req)
+{
+  qio_uring_t* u = &qio_uring;
+  struct io_uring_sqe* sqe;
+  unsigned tail, idx;
+  int rc;
+
+  // Never have more requests outstanding than the completion queue,
+  // which is at least as large as the submission queue, can hold.
+  while( 1 ) {
+    pthread_mutex_lock(&u->lock);
+    if( u->inflight < u->entries ) break;
+    pthread_mutex_unlock(&u->lock);
+    qio_async_yield();
+  }
+
+  tail = *u->sq_tail;
+  idx = tail & *u->sq_mask;
+  sqe = &u->sqes[idx];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = (req->op == QIO_ASYNC_READ) ? IORING_OP_READV
+                                            : IORING_OP_WRITEV;
+  sqe->fd = req->fd;
+  sqe->addr = (uintptr_t) req->iov;
+  sqe->len = req->iovcnt;
+  sqe->off = req->offset;
+  sqe->user_data = (uintptr_t) req;
+  u->sq_array[idx] = idx;
+  __atomic_store_n(u->sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+  do {
+    rc = qio_uring_enter(1, 0, 0);
+  } while( rc < 0 && errno == EINTR );
+
+  if( rc != 1 && __atomic_load_n(u->sq_head, __ATOMIC_ACQUIRE) == tail ) {
+    // The kernel did not take it; withdraw it so the caller can run
+    // the request some other way.
+    __atomic_store_n(u->sq_tail, tail, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&u->lock);
+    return -1;
+  }
+
+  u->inflight++;
+  pthread_mutex_unlock(&u->lock);
+  return 0;
+}
+
+#endif
+
+static pthread_mutex_t qio_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t qio_pool_cond = PTHREAD_COND_INITIALIZER;
+static qio_async_req_t* qio_pool_head = NULL;
+static qio_async_req_t* qio_pool_tail = NULL;
+
+static
+void* qio_pool_worker(void* arg)
+{
+  while( 1 ) {
+    qio_async_req_t* req;
+
+    pthread_mutex_lock(&qio_pool_lock);
+    while( qio_pool_head == NULL ) {
+      pthread_cond_wait(&qio_pool_cond, &qio_pool_lock);
+    }
+    req = qio_pool_head;
+    qio_pool_head = req->next;
+    if( qio_pool_head == NULL ) qio_pool_tail = NULL;
+    pthread_mutex_unlock(&qio_pool_lock);
+
+    qio_async_run(req);
+  }
+
+  return NULL;
+}
+
+// Returns the number of threads started.
+static
+int qio_pool_init(int nthreads)
+{
+  pthread_attr_t attr;
+  pthread_t thread;
+  int i;
+
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  for( i = 0; i < nthreads; i++ ) {
+    if( pthread_create(&thread, &attr, qio_pool_worker, NULL) != 0 ) break;
+  }
+  pthread_attr_destroy(&attr);
+
+  return i;
+}
+
+static
+void qio_pool_submit(qio_async_req_t* req)
+{
+  req->next = NULL;
+  pthread_mutex_lock(&qio_pool_lock);
+  if( qio_pool_tail ) qio_pool_tail->next = req;
+  else qio_pool_head = req;
+  qio_pool_tail = req;
+  pthread_cond_signal(&qio_pool_cond);
+  pthread_mutex_unlock(&qio_pool_lock);
+}
+
+static
+void qio_async_init(void)
+{
+  int use_uring = 1;
+  int nthreads = 4;
+
+#ifndef CHPL_RT_UNIT_TEST
+  use_uring = chpl_env_rt_get_bool("QIO_ASYNC_URING", true);
+  nthreads = (int) chpl_env_rt_get_int("QIO_ASYNC_THREADS", nthreads);
+#endif
+
+#ifdef QIO_HAVE_IO_URING
+  if( use_uring && qio_uring_init(2 * qio_async_max_inflight) == 0 ) {
+    qio_async_mode = QIO_ASYNC_MODE_URING;
+    return;
+  }
+#else
+  (void) use_uring;
+#endif
+
+  if( nthreads > 0 && qio_pool_init(nthreads) > 0 ) {
+    qio_async_mode = QIO_ASYNC_MODE_POOL;
+  }
+}
+
+static
+void qio_async_submit(qio_async_req_t* req)
+{
+  switch( qio_async_mode ) {
+    case QIO_ASYNC_MODE_URING:
+#ifdef QIO_HAVE_IO_URING
+      if( qio_uring_submit(req) == 0 ) return;
+#endif
+      qio_async_run(req);
+      break;
+    case QIO_ASYNC_MODE_POOL:
+      qio_pool_submit(req);
+      break;
+    case QIO_ASYNC_MODE_SYNC:
+      qio_async_run(req);
+      break;
+  }
+}
+
+static
+void qio_async_wait(qio_async_req_t* req)
+{
+  while( ! atomic_load_bool(&req->done) ) {
+    qio_async_yield();
+  }
+}
+
+typedef struct {
+  int first;    // index of the first iovec in the segment
+  int iovcnt;
+  ssize_t len;
+  off_t offset;
+} qio_async_seg_t;
+
+static
+err_t qio_async_transfer(qio_async_op_t op, fd_t fd, const struct iovec* iov, int iovcnt, off_t seek_to_offset, ssize_t* amt_out)
+{
+  int64_t total = sys_iov_total_bytes(iov, iovcnt);
+  ssize_t segsz = qio_async_segment_size > 0 ? qio_async_segment_size : 1;
+  int window = qio_async_max_inflight > 0 ? qio_async_max_inflight : 1;
+  int64_t max_segs;
+  qio_async_seg_t* segs = NULL;
+  struct iovec* segiov = NULL;
+  qio_async_req_t* reqs = NULL;
+  int nsegs = 0;
+  int niov = 0;
+  int i, j, k, w;
+  size_t skip;
+  int64_t placed;
+  ssize_t amt = 0;
+  err_t err = 0;
+  int stop = 0;
+
+  *amt_out = 0;
+  if( total <= 0 ) return 0;
+
+  pthread_once(&qio_async_once, qio_async_init);
+
+  // Cut the iovecs at segment boundaries; a segment also ends when it
+  // would need more than IOV_MAX iovecs.
+  max_segs = (total + segsz - 1) / segsz + (iovcnt + IOV_MAX - 1) / IOV_MAX;
+  if( max_segs > INT_MAX - iovcnt ) return EOVERFLOW;
+
+  segs = (qio_async_seg_t*) qio_calloc(max_segs, sizeof(qio_async_seg_t));
+  segiov = (struct iovec*) qio_calloc(iovcnt + max_segs, sizeof(struct iovec));
+  if( ! segs || ! segiov ) {
+    err = ENOMEM;
+    goto done;
+  }
+
+  i = 0;
+  skip = 0;
+  placed = 0;
+  while( placed < total && nsegs < max_segs ) {
+    qio_async_seg_t* seg = &segs[nsegs++];
+    ssize_t want = (total - placed < segsz) ? (ssize_t) (total - placed) : segsz;
+
+    seg->first = niov;
+    seg->offset = seek_to_offset + placed;
+    seg->len = 0;
+    while( want > 0 && niov - seg->first < IOV_MAX ) {
+      size_t avail = iov[i].iov_len - skip;
+      size_t take;
+      if( avail == 0 ) {
+        i++;
+        skip = 0;
+        continue;
+      }
+      take = avail < (size_t) want ? avail : (size_t) want;
+      segiov[niov].iov_base = (char*) iov[i].iov_base + skip;
+      segiov[niov].iov_len = take;
+      niov++;
+      skip += take;
+      want -= take;
+      seg->len += take;
+    }
+    seg->iovcnt = niov - seg->first;
+    placed += seg->len;
+  }
+
+  if( window > nsegs ) window = nsegs;
+  reqs = (qio_async_req_t*) qio_calloc(window, sizeof(qio_async_req_t));
+  if( ! reqs ) {
+    err = ENOMEM;
+    goto done;
+  }
+
+  for( w = 0; w < nsegs && ! stop; w += window ) {
+    k = (nsegs - w < window) ? nsegs - w : window;
+
+    for( j = 0; j < k; j++ ) {
+      qio_async_seg_t* seg = &segs[w + j];
+      reqs[j].op = op;
+      reqs[j].fd = fd;
+      reqs[j].iov = &segiov[seg->first];
+      reqs[j].iovcnt = seg->iovcnt;
+      reqs[j].offset = seg->offset;
+      reqs[j].len = seg->len;
+      reqs[j].result = 0;
+      reqs[j].err = 0;
+      atomic_init_bool(&reqs[j].done, false);
+      qio_async_submit(&reqs[j]);
+    }
+
+    // Everything submitted must finish before the buffers can be
+    // released, even if an early segment came up short.
+    for( j = 0; j < k; j++ ) {
+      qio_async_wait(&reqs[j]);
+    }
+
+    // Only count bytes up to the first short or failed segment.
+    for( j = 0; j < k; j++ ) {
+      if( ! stop ) {
+        if( reqs[j].err ) {
+          err = reqs[j].err;
+          stop = 1;
+        } else {
+          amt += reqs[j].result;
+          if( reqs[j].result < reqs[j].len ) stop = 1;
+        }
+      }
+      atomic_destroy_bool(&reqs[j].done);
+    }
+  }
+
+  if( ! err && op == QIO_ASYNC_READ && amt == 0 ) err = EEOF;
+
+done:
+  if( reqs ) qio_free(reqs);
+  if( segiov ) qio_free(segiov);
+  if( segs ) qio_free(segs);
+
+  *amt_out = amt;
+  return err;
+}
+
+err_t qio_async_preadv(fd_t fd, const struct iovec* iov, int iovcnt, off_t seek_to_offset, ssize_t* num_read_out)
+{
+  return qio_async_transfer(QIO_ASYNC_READ, fd, iov, iovcnt, seek_to_offset, num_read_out);
+}
+
+err_t qio_async_pwritev(fd_t fd, const struct iovec* iov, int iovcnt, off_t seek_to_offset, ssize_t* num_written_out)
+{
+  return qio_async_transfer(QIO_ASYNC_WRITE, fd, iov, iovcnt, seek_to_offset, num_written_out);
+}
@@ -0,0 +1,388 @@
+/*
+ * Copyright 2004-2020 Hewlett Packard Enterprise Development LP
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sys_basic.h"
+
+#ifndef CHPL_RT_UNIT_TEST
+#include "chplrt.h"
+#endif
+
+#include "qio.h"
+#include "qio_delimited.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+qio_delimited_batch_ptr_t qio_delimited_batch_create(void)
+{
+  return (qio_delimited_batch_ptr_t) qio_calloc(1, sizeof(qio_delimited_batch_t));
+}
+
+void qio_delimited_batch_destroy(qio_delimited_batch_ptr_t batch)
+{
+  if( ! batch ) return;
+  if( batch->data ) qio_free(batch->data);
+  if( batch->fields ) qio_free(batch->fields);
+  qio_free(batch);
+}
+
+static
+qioerr _delim_append(qio_delimited_batch_t* b, const char* src, int64_t len)
+{
+  int64_t need = b->data_len + len;
+
+  if( need > b->data_cap ) {
+    int64_t cap = b->data_cap ? b->data_cap : 4096;
+    char* p;
+    while( cap < need ) cap *= 2;
+    p = (char*) qio_realloc(b->data, cap);
+    if( ! p ) return QIO_ENOMEM;
+    b->data = p;
+    b->data_cap = cap;
+  }
+
+  memcpy(b->data + b->data_len, src, len);
+  b->data_len = need;
+  return 0;
+}
+
+static inline
+qioerr _delim_append_byte(qio_delimited_batch_t* b, char c)
+{
+  if( b->data_len < b->data_cap ) {
+    b->data[b->data_len++] = c;
+    return 0;
+  }
+  return _delim_append(b, &c, 1);
+}
+
+static
+qioerr _delim_add_field(qio_delimited_batch_t* b, int64_t start)
+{
+  int64_t len = b->data_len - start;
+  qioerr err;
+
+  err = _delim_append_byte(b, '\0');
+  if( err ) return err;
+
+  if( b->fields_len >= b->fields_cap ) {
+    int64_t cap = b->fields_cap ? 2*b->fields_cap : 256;
+    int64_t* p = (int64_t*) qio_realloc(b->fields, 2*cap*sizeof(int64_t));
+    if( ! p ) return QIO_ENOMEM;
+    b->fields = p;
+    b->fields_cap = cap;
+  }
+
+  b->fields[2*b->fields_len] = start;
+  b->fields[2*b->fields_len+1] = len;
+  b->fields_len++;
+  return 0;
+}
+
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+// Look at 8 bytes at a time within a 64-bit word.  The lowest set
+// high bit in _delim_zero_bytes(v) marks the first zero byte in v.
+#define QIO_DELIM_SWAR 1
+#define _DELIM_ONES 0x0101010101010101ULL
+#define _DELIM_HIGHS 0x8080808080808080ULL
+
+static inline
+uint64_t _delim_zero_bytes(uint64_t v)
+{
+  return (v - _DELIM_ONES) & ~v & _DELIM_HIGHS;
+}
+#endif
+
+// Returns the first byte in [p, end) that is a, b, or c; or end.
+static inline
+const char* _delim_find3(const char* p, const char* end,
+                         unsigned char a, unsigned char b, unsigned char c)
+{
+#ifdef QIO_DELIM_SWAR
+  const uint64_t wa = _DELIM_ONES * a;
+  const uint64_t wb = _DELIM_ONES * b;
+  const uint64_t wc = _DELIM_ONES * c;
+
+  while( end - p >= 8 ) {
+    uint64_t v, m;
+    memcpy(&v, p, 8);
+    m = _delim_zero_bytes(v ^ wa) | _delim_zero_bytes(v ^ wb) |
+        _delim_zero_bytes(v ^ wc);
+    if( m ) return p + (__builtin_ctzll(m) >> 3);
+    p += 8;
+  }
+#endif
+
+  while( p < end ) {
+    unsigned char x = *p;
+    if( x == a || x == b || x == c ) break;
+    p++;
+  }
+  return p;
+}
+
+// Returns the next byte from the channel, or -EEOF or another negative
+// error code.
+static inline
+int _delim_next(qio_channel_t* restrict ch)
+{
+  return qio_channel_read_byte(false, ch);
+}
+
+// Reads the rest of a quoted field, after the opening quote, and
+// returns the byte after the closing quote (or a negative error code).
+static
+int _delim_read_quoted(qio_channel_t* restrict ch, int32_t quote,
+                       qio_delimited_batch_t* b, qioerr* err_out)
+{
+  int c;
+
+  while( 1 ) {
+    const char* cur = (const char*) ch->cached_cur;
+    const char* end = (const char*) ch->cached_end;
+
+    // Copy everything up to the next quote straight from the buffer.
+    if( cur < end ) {
+      const char* q = (const char*) memchr(cur, quote, end - cur);
+      if( ! q ) q = end;
+      *err_out = _delim_append(b, cur, q - cur);
+      if( *err_out ) return -1;
+      ch->cached_cur = (void*) q;
+    }
+
+    c = _delim_next(ch);
+    if( c == -EEOF ) {
+      QIO_GET_CONSTANT_ERROR(*err_out, EFORMAT, "unterminated quoted field");
+      return -1;
+    }
+    if( c < 0 ) return c;
+    if( c == quote ) {
+      // "" stands for one quote; anything else ends the field
+      c = _delim_next(ch);
+      if( c != quote ) return c;
+    }
+    *err_out = _delim_append_byte(b, c);
+    if( *err_out ) return -1;
+  }
+}
+
+qioerr qio_channel_read_delimited(const int threadsafe, qio_channel_t* restrict ch, int32_t delimiter, int32_t quote, int64_t nfields, int64_t max_records, int64_t end_offset, qio_delimited_batch_ptr_t batch)
+{
+  qioerr err = 0;
+  int c;
+
+  if( delimiter < 0 || delimiter > 127 || delimiter == '\n' ||
+      delimiter == '\r' || delimiter == quote || quote > 127 ||
+      quote == '\n' || quote == '\r' || nfields < 1 ) {
+    QIO_RETURN_CONSTANT_ERROR(EINVAL, "bad delimited record format");
+  }
+
+  if( threadsafe ) {
+    err = qio_lock(&ch->lock);
+    if( err ) {
+      return err;
+    }
+  }
+
+  batch->data_len = 0;
+  batch->fields_len = 0;
+  batch->nrecords = 0;
+
+  while( batch->nrecords < max_records ) {
+    int64_t nf = 0;
+
+    // Skip blank lines; the first other byte starts the record.
+    do {
+      c = _delim_next(ch);
+    } while( c == '\n' || c == '\r' );
+
+    if( c == -EEOF ) break;
+    if( c < 0 ) {
+      err = qio_int_to_err(-c);
+      break;
+    }
+
+    if( end_offset >= 0 && qio_channel_offset_unlocked(ch) - 1 >= end_offset )
+      break;
+
+    while( 1 ) {
+      int64_t start = batch->data_len;
+
+      if( quote >= 0 && c == quote ) {
+        c = _delim_read_quoted(ch, quote, batch, &err);
+        if( err ) goto error;
+        if( c != delimiter && c != '\n' && c != '\r' && c != -EEOF ) {
+          if( c < 0 ) err = qio_int_to_err(-c);
+          else QIO_GET_CONSTANT_ERROR(err, EFORMAT,
+                                      "unexpected text after a quoted field");
+          goto error;
+        }
+      } else {
+        while( c >= 0 && c != delimiter && c != '\n' && c != '\r' ) {
+          const char* cur;
+          const char* end;
+          const char* q;
+
+          err = _delim_append_byte(batch, c);
+          if( err ) goto error;
+
+          // Copy the rest of the field straight from the buffer.
+          cur = (const char*) ch->cached_cur;
+          end = (const char*) ch->cached_end;
+          if( cur < end ) {
+            q = _delim_find3(cur, end, delimiter, '\n', '\r');
+            err = _delim_append(batch, cur, q - cur);
+            if( err ) goto error;
+            ch->cached_cur = (void*) q;
+          }
+
+          c = _delim_next(ch);
+        }
+        if( c < 0 && c != -EEOF ) {
+          err = qio_int_to_err(-c);
+          goto error;
+        }
+      }
+
+      err = _delim_add_field(batch, start);
+      if( err ) goto error;
+      nf++;
+
+      if( c != delimiter ) break;
+      c = _delim_next(ch);
+    }
+
+    // A \r\n leaves the \n to be skipped as a blank line.
+    if( nf != nfields ) {
+      QIO_GET_CONSTANT_ERROR(err, EFORMAT,
+                             "wrong number of fields in delimited record");
+      goto error;
+    }
+
+    batch->nrecords++;
+    if( c == -EEOF ) break;
+  }
+
+  if( ! err && batch->nrecords == 0 ) err = QIO_EEOF;
+
+error:
+  // Drop the fields of a partially read record.
+  batch->fields_len = batch->nrecords * nfields;
+
+  _qio_channel_set_error_unlocked(ch, err);
+  if( threadsafe ) {
+    qio_unlock(&ch->lock);
+  }
+
+  return err;
+}
+
+static
+const char* _delim_skip_space(const char* p)
+{
+  while( isspace((unsigned char) *p) ) p++;
+  return p;
+}
+
+qioerr qio_delimited_field_to_int(qio_delimited_batch_ptr_t batch, int64_t i, void* restrict out, size_t len, int issigned)
+{
+  const char* s = qio_delimited_field_ptr(batch, i);
+  const char* fend = s + qio_delimited_field_len(batch, i);
+  char* e;
+  long long int sv = 0;
+  unsigned long long int uv = 0;
+  int range = 0;
+
+  s = _delim_skip_space(s);
+  errno = 0;
+  if( issigned ) {
+    sv = strtoll(s, &e, 10);
+  } else {
+    if( *s == '-' ) e = (char*) s;
+    else uv = strtoull(s, &e, 10);
+  }
+  if( e == s || _delim_skip_space(e) != fend ) {
+    QIO_RETURN_CONSTANT_ERROR(EFORMAT, "malformed integer field");
+  }
+  if( errno == ERANGE ) range = 1;
+
+  switch( issigned ? -(ssize_t) len : (ssize_t) len ) {
+    case -1:
+      if( sv > INT8_MAX || sv < INT8_MIN ) range = 1;
+      *(int8_t*) out = sv;
+      break;
+    case -2:
+      if( sv > INT16_MAX || sv < INT16_MIN ) range = 1;
+      *(int16_t*) out = sv;
+      break;
+    case -4:
+      if( sv > INT32_MAX || sv < INT32_MIN ) range = 1;
+      *(int32_t*) out = sv;
+      break;
+    case -8:
+      *(int64_t*) out = sv;
+      break;
+    case 1:
+      if( uv > UINT8_MAX ) range = 1;
+      *(uint8_t*) out = uv;
+      break;
+    case 2:
+      if( uv > UINT16_MAX ) range = 1;
+      *(uint16_t*) out = uv;
+      break;
+    case 4:
+      if( uv > UINT32_MAX ) range = 1;
+      *(uint32_t*) out = uv;
+      break;
+    case 8:
+      *(uint64_t*) out = uv;
+      break;
+    default:
+      QIO_RETURN_CONSTANT_ERROR(EINVAL, "bad integer type");
+  }
+
+  if( range ) {
+    QIO_RETURN_CONSTANT_ERROR(ERANGE, "out of bounds integer field");
+  }
+
+  return 0;
+}
+
+qioerr qio_delimited_field_to_float(qio_delimited_batch_ptr_t batch, int64_t i, void* restrict out, size_t len)
+{
+  const char* s = qio_delimited_field_ptr(batch, i);
+  const char* fend = s + qio_delimited_field_len(batch, i);
+  char* e;
+
+  s = _delim_skip_space(s);
+  // Overflow and underflow give infinity and zero or a subnormal,
+  // as they do when reading a number from a channel.
+  if( len == 4 ) *(float*) out = strtof(s, &e);
+  else if( len == 8 ) *(double*) out = strtod(s, &e);
+  else QIO_RETURN_CONSTANT_ERROR(EINVAL, "bad floating point type");
+
+  if( e == s || _delim_skip_space(e) != fend ) {
+    QIO_RETURN_CONSTANT_ERROR(EFORMAT, "malformed floating point field");
+  }
+
+  return 0;
+}
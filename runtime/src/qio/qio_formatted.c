@@ -2658,6 +2658,236 @@ error:
 }
 
 
+// Fast paths for reading numbers in the default decimal style.
+//
+// These look at the channel's cached buffer directly and handle only
+// the common, unambiguous forms:
+//   [whitespace] [+|-] digits [. digits] [e [+|-] digits]
+// followed by a character that can't continue the number.  Anything
+// else -- a number that runs to the end of the cached buffer, a base
+// prefix, inf or nan, an exponent without digits, non-ASCII whitespace
+// -- is left to _peek_number_unlocked and strtoull/strtod, so both paths
+// give the same results.
+
+typedef struct {
+  const char* start;    // first character of the number, after whitespace
+  const char* end;      // one past the last character of the number
+  int negative;
+  uint64_t mantissa;    // the first 19 significant digits
+  int many_digits;      // there were more than 19 significant digits
+  int64_t exp10;        // value is mantissa * 10^exp10 (if !many_digits)
+} qio_fast_number_t;
+
+#define QIO_FAST_MAX_DIGITS 19
+
+static inline
+int _fast_is_digit(char c)
+{
+  return '0' <= c && c <= '9';
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+// Check and convert 8 ASCII digits at a time within a 64-bit word.
+static inline
+int _fast_is_eight_digits(uint64_t v)
+{
+  return ((v & 0xF0F0F0F0F0F0F0F0ULL) |
+          (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+         0x3333333333333333ULL;
+}
+
+static inline
+uint64_t _fast_eight_digits_value(uint64_t v)
+{
+  const uint64_t mask = 0x000000FF000000FFULL;
+  const uint64_t mul1 = 0x000F424000000064ULL; // 100 + (1000000 << 32)
+  const uint64_t mul2 = 0x0000271000000001ULL; // 1 + (10000 << 32)
+  v -= 0x3030303030303030ULL;
+  v = (v * 10) + (v >> 8);
+  v = (((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32;
+  return v;
+}
+#define QIO_FAST_SWAR 1
+#endif
+
+// Accumulates a run of digits into n.  Returns the number of digits
+// consumed.  exp10 is decremented once per digit if is_fraction.
+static inline
+int64_t _fast_scan_digits(const char** pp, const char* end, qio_fast_number_t* n, int is_fraction)
+{
+  const char* p = *pp;
+  int64_t count = 0;
+  int nd = 0;
+
+  // Leading zeros aren't significant.
+  while( p < end && *p == '0' && n->mantissa == 0 ) {
+    p++;
+    count++;
+    if( is_fraction ) n->exp10--;
+  }
+
+  if( n->mantissa != 0 ) {
+    // count the significant digits we already have
+    uint64_t m = n->mantissa;
+    while( m != 0 ) { nd++; m /= 10; }
+  }
+
+#ifdef QIO_FAST_SWAR
+  while( end - p >= 8 && nd + 8 <= QIO_FAST_MAX_DIGITS && ! n->many_digits ) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    if( ! _fast_is_eight_digits(v) ) break;
+    n->mantissa = n->mantissa * 100000000ULL + _fast_eight_digits_value(v);
+    if( n->mantissa != 0 ) nd += 8;
+    if( is_fraction ) n->exp10 -= 8;
+    p += 8;
+    count += 8;
+  }
+#endif
+
+  while( p < end && _fast_is_digit(*p) ) {
+    if( nd < QIO_FAST_MAX_DIGITS && ! n->many_digits ) {
+      n->mantissa = n->mantissa * 10 + (*p - '0');
+      if( n->mantissa != 0 ) nd++;
+      if( is_fraction ) n->exp10--;
+    } else {
+      // Keep track of the magnitude, but the value needs strtod.
+      n->many_digits = 1;
+      if( ! is_fraction ) n->exp10++;
+    }
+    p++;
+    count++;
+  }
+
+  *pp = p;
+  return count;
+}
+
+// Returns 1 and fills in *n if [p, end) starts with a number in the
+// simple form described above; returns 0 otherwise.
+static
+int _fast_scan_number(const char* p, const char* end, int allow_neg, int allow_real, qio_fast_number_t* n)
+{
+  int64_t count;
+
+  n->negative = 0;
+  n->mantissa = 0;
+  n->many_digits = 0;
+  n->exp10 = 0;
+
+  while( p < end && (*p == ' ' || ('\t' <= *p && *p <= '\r')) ) p++;
+  if( p >= end ) return 0;
+
+  n->start = p;
+
+  if( *p == '-' ) {
+    if( ! allow_neg ) return 0;
+    n->negative = 1;
+    p++;
+  } else if( *p == '+' ) {
+    p++;
+  }
+
+  if( p >= end || ! _fast_is_digit(*p) ) return 0;
+  // 0x 0b 0o base prefixes, among others.
+  if( *p == '0' && p + 1 < end && isalpha((unsigned char) p[1]) ) return 0;
+
+  _fast_scan_digits(&p, end, n, 0);
+  // We can't tell if the number continues past the buffer.
+  if( p >= end ) return 0;
+
+  if( allow_real ) {
+    if( *p == '.' ) {
+      p++;
+      _fast_scan_digits(&p, end, n, 1);
+      if( p >= end ) return 0;
+    }
+    if( *p == 'e' || *p == 'E' ) {
+      int64_t e = 0;
+      int eneg = 0;
+      p++;
+      if( p < end && (*p == '+' || *p == '-') ) {
+        eneg = (*p == '-');
+        p++;
+      }
+      count = 0;
+      while( p < end && _fast_is_digit(*p) ) {
+        e = e * 10 + (*p - '0');
+        p++;
+        count++;
+        if( count > 6 ) return 0; // way out of range; let strtod report it
+      }
+      if( count == 0 || p >= end ) return 0;
+      n->exp10 += eneg ? -e : e;
+    }
+    // The general path would read any of these as more of the number.
+    if( _fast_is_digit(*p) || *p == '.' || *p == 'e' || *p == 'E' ) return 0;
+  }
+
+  n->end = p;
+  return 1;
+}
+
+// Converts a scanned number to a double, exactly as strtod would.
+// Returns 0 if it can't be done without strtod's help.
+static
+int _fast_number_to_double(const qio_fast_number_t* n, double* out)
+{
+  static const double pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+  double d;
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+  if( n->many_digits ) return 0;
+
+  if( n->mantissa == 0 ) {
+    d = 0.0;
+  } else {
+    // Clinger's fast path: the mantissa and the power of ten are both
+    // exact doubles, so a single multiply or divide rounds correctly.
+    if( n->mantissa > (1ULL << 53) ) return 0;
+    if( n->exp10 < -22 || n->exp10 > 22 ) return 0;
+    d = (double) n->mantissa;
+    if( n->exp10 < 0 ) d /= pow10[-n->exp10];
+    else d *= pow10[n->exp10];
+  }
+
+  *out = n->negative ? -d : d;
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+static
+int _fast_number_strtod(const qio_fast_number_t* n, double* out)
+{
+  char buf[128];
+  char* end_conv;
+  size_t len = n->end - n->start;
+  double d;
+
+  if( len + 1 > sizeof(buf) ) return 0;
+  memcpy(buf, n->start, len);
+  buf[len] = '\0';
+
+  errno = 0;
+  d = strtod(buf, &end_conv);
+  if( end_conv != buf + len || errno == ERANGE ) return 0;
+
+  *out = d;
+  return 1;
+}
+
+static inline
+int _fast_number_ok(void)
+{
+  // ASCII digits and whitespace mean the same thing as bytes
+  return qio_glocale_utf8 > 0;
+}
+
 qioerr qio_channel_scan_int(const int threadsafe, qio_channel_t* restrict ch, void* restrict out, size_t len, int issigned)
 {
   unsigned long long int num = 0;
@@ -2696,6 +2926,21 @@ qioerr qio_channel_scan_int(const int threadsafe, qio_channel_t* restrict ch, vo
   st.positive_char = tolower(style->positive_char);
   st.negative_char = tolower(style->negative_char);
 
+  if( _fast_number_ok() &&
+      (style->base == 0 || style->base == 10) &&
+      ! st.allow_point &&
+      st.positive_char == '+' && st.negative_char == '-' ) {
+    qio_fast_number_t n;
+    if( _fast_scan_number(ch->cached_cur, ch->cached_end, issigned, 0, &n) &&
+        ! n.many_digits ) {
+      num = n.mantissa;
+      sign = n.negative ? -1 : 1;
+      ch->cached_cur = (void*) n.end;
+      err = 0;
+      goto error;
+    }
+  }
+
   err = _peek_number_unlocked(ch, &st, &amount);
   if( qio_err_to_int(err) == EEOF && st.end > 0 ) err = 0; // we tolerate EOF if there's data.
   if( err ) goto error;
@@ -2858,6 +3103,21 @@ qioerr qio_channel_scan_float_or_imag(const int threadsafe, qio_channel_t* restr
   st.allow_i_after = needs_i;
   st.i_char = style->i_char;
 
+  if( _fast_number_ok() &&
+      (style->base == 0 || style->base == 10) &&
+      ! needs_i &&
+      st.positive_char == '+' && st.negative_char == '-' &&
+      st.point_char == '.' && st.exponent_char == 'e' ) {
+    qio_fast_number_t n;
+    if( _fast_scan_number(ch->cached_cur, ch->cached_end, 1, 1, &n) &&
+        ( _fast_number_to_double(&n, &num) ||
+          _fast_number_strtod(&n, &num) ) ) {
+      ch->cached_cur = (void*) n.end;
+      err = 0;
+      goto error;
+    }
+  }
+
   err = _peek_number_unlocked(ch, &st, &amount);
   if( qio_err_to_int(err) == EEOF && st.end > 0 ) err = 0; // we tolerate EOF if there's data.
   if( err ) goto error;
@@ -3514,6 +3774,131 @@ int _ftoa(char* restrict dst, size_t size, double num, int base, bool needs_i, c
   return width;
 }
 
+static const char _fast_digit_pairs[201] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+// Writes num in decimal, two digits at a time, to dst, which must have
+// room for 20 bytes.  Returns the number of bytes written.
+static inline
+int _fast_utoa(char* dst, uint64_t num)
+{
+  char tmp[20];
+  int at = sizeof(tmp);
+  int len;
+
+  while( num >= 100 ) {
+    int i = (num % 100) * 2;
+    num /= 100;
+    tmp[--at] = _fast_digit_pairs[i + 1];
+    tmp[--at] = _fast_digit_pairs[i];
+  }
+  if( num >= 10 ) {
+    int i = num * 2;
+    tmp[--at] = _fast_digit_pairs[i + 1];
+    tmp[--at] = _fast_digit_pairs[i];
+  } else {
+    tmp[--at] = '0' + num;
+  }
+
+  len = sizeof(tmp) - at;
+  memcpy(dst, tmp + at, len);
+  return len;
+}
+
+// Is _ltoa in this style just an optional - sign and decimal digits?
+static inline
+int _fast_ltoa_ok(const qio_style_t* style, int base)
+{
+  return base == 10 && ! style->showplus && ! style->showpoint &&
+         style->precision <= 0 && style->min_width_columns == 0;
+}
+
+// The default %g style prints 6 significant digits.  When num is the
+// closest double to a decimal with at most 6 significant digits in the
+// range where %g uses fixed notation, that decimal is exactly what
+// _ftoa would print, and we can write it without snprintf.  Returns the
+// number of bytes written to dst (which needs room for 32 bytes) or 0
+// if num isn't such a value or the style isn't the default.
+static
+int _fast_ftoa(char* dst, double num, int base, bool needs_i, const qio_style_t* restrict style)
+{
+  static const double pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10
+  };
+  char digits[20];
+  double a;
+  int64_t n = 0;
+  int k;
+  int ndigits;
+  int i = 0;
+  int j;
+
+  if( base != 10 || style->realfmt != 0 || style->precision >= 0 ||
+      style->showplus || style->showpoint || style->min_width_columns != 0 )
+    return 0;
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+  a = fabs(num);
+  if( a == 0.0 ) {
+    k = 0;
+  } else {
+    // Outside of this range, %g switches to exponential notation
+    // (and 1e5 <= a < 1e6 gets special handling in _ftoa_core).
+    if( !(a >= 1e-4 && a < 1e5) ) return 0;
+
+    // Find the fewest decimal places k such that a is the double
+    // closest to n / 10^k.  n / 10^k is then correctly rounded,
+    // since n and 10^k are exact.
+    for( k = 0; k <= 10; k++ ) {
+      double scaled = a * pow10[k];
+      if( scaled >= 999999.5 ) return 0; // more than 6 digits
+      n = (int64_t) (scaled + 0.5);
+      if( (double) n / pow10[k] == a ) break;
+    }
+    if( k > 10 ) return 0;
+  }
+#else
+  return 0;
+#endif
+
+  if( signbit(num) ) dst[i++] = style->negative_char;
+
+  ndigits = _fast_utoa(digits, n);
+  if( k == 0 ) {
+    memcpy(dst + i, digits, ndigits);
+    i += ndigits;
+    if( style->showpointzero ) {
+      dst[i++] = '.';
+      dst[i++] = '0';
+    }
+  } else if( k < ndigits ) {
+    memcpy(dst + i, digits, ndigits - k);
+    i += ndigits - k;
+    dst[i++] = '.';
+    memcpy(dst + i, digits + ndigits - k, k);
+    i += k;
+  } else {
+    dst[i++] = '0';
+    dst[i++] = '.';
+    for( j = ndigits; j < k; j++ ) dst[i++] = '0';
+    memcpy(dst + i, digits, ndigits);
+    i += ndigits;
+  }
+
+  if( needs_i ) dst[i++] = style->i_char;
+
+  return i;
+}
+
 // TODO -- support max_width
 qioerr qio_channel_print_int(const int threadsafe, qio_channel_t* restrict ch, const void* restrict ptr, size_t len, int issigned)
 {
@@ -3586,6 +3971,17 @@ qioerr qio_channel_print_int(const int threadsafe, qio_channel_t* restrict ch, c
     }
   }
 
+  if( _fast_ltoa_ok(style, base) &&
+      qio_space_in_ptr_diff(21, ch->cached_end, ch->cached_cur) ) {
+    char* dst = (char*) ch->cached_cur;
+    got = 0;
+    if( isneg ) dst[got++] = style->negative_char;
+    got += _fast_utoa(dst + got, num);
+    ch->cached_cur = qio_ptr_add(ch->cached_cur, got);
+    err = _qio_channel_post_cached_write(ch);
+    goto error;
+  }
+
   // Try printing it directly into the buffer.
   if( qio_space_in_ptr_diff(max, ch->cached_end,ch->cached_cur) ) {
     // Print it all directly into the buffer.
@@ -3689,6 +4085,15 @@ qioerr qio_channel_print_float_or_imag(const int threadsafe, qio_channel_t* rest
   }
   if( err ) goto error;
 
+  if( qio_space_in_ptr_diff(32, ch->cached_end, ch->cached_cur) ) {
+    got = _fast_ftoa(ch->cached_cur, num, base, needs_i, style);
+    if( got > 0 ) {
+      ch->cached_cur = qio_ptr_add(ch->cached_cur, got);
+      err = _qio_channel_post_cached_write(ch);
+      goto error;
+    }
+  }
+
   // Try printing it directly into the buffer.
   got = _ftoa(ch->cached_cur, qio_ptr_diff(ch->cached_end, ch->cached_cur),
               num, base, needs_i, style, &extra);
@@ -46,7 +46,12 @@
 
 
 //
-// task pool: linked list of tasks
+// Task descriptors.  A task waiting to run sits in exactly one queue:
+// either the work-stealing deque belonging to the thread that created
+// it, or (if that thread doesn't have a deque) the shared task pool.
+// It may also be on a task list, from which the task that owns the
+// list can run it directly.  Whoever gets to it first claims it; the
+// other reference is simply dropped.
 //
 typedef struct task_pool_struct* task_pool_p;
 
@@ -58,8 +63,10 @@ typedef struct task_pool_struct {
   task_pool_p*     p_list_head;  // task list we're on, if any
   task_pool_p      list_next;    // double-link pointers for list
   task_pool_p      list_prev;
-  task_pool_p      next;         // double-link pointers for pool
-  task_pool_p      prev;
+  task_pool_p      next;         // link pointer for shared pool
+
+  chpl_bool        claimed;      // has somebody started running this?
+  volatile int     refs;         // queue slot + executor references
 
   chpl_task_prvDataImpl_t chpl_data;
 
@@ -67,6 +74,29 @@ typedef struct task_pool_struct {
 } task_pool_t;
 
 
+//
+// Work-stealing deques, after Chase and Lev, "Dynamic Circular
+// Work-Stealing Deque" (SPAA '05).  The owning thread pushes and pops
+// at the bottom, so it runs the tasks it creates in LIFO order, while
+// other threads steal from the top.  When a deque fills up we replace
+// its array with one twice as large.  The old array is not freed,
+// because a thief may still be looking at it.
+//
+typedef struct {
+  int64_t          size;         // always a power of 2
+  task_pool_p      buf[];
+} task_deque_array_t;
+
+typedef struct {
+  volatile int64_t top;
+  char             pad[64 - sizeof(int64_t)];
+  volatile int64_t bottom;
+  task_deque_array_t* volatile array;
+} task_deque_t;
+
+#define TASK_DEQUE_INITIAL_SIZE 256
+
+
 typedef struct lockReport {
   int32_t            filename;
   int                lineno;
@@ -80,6 +110,8 @@ typedef struct lockReport {
 typedef struct {
   task_pool_p   ptask;
   lockReport_t* lockRprt;
+  task_deque_t* deque;          // our deque, if we run tasks from the pool
+  uint64_t      steal_seed;     // for choosing steal victims
 } thread_private_data_t;
 
 
@@ -88,18 +120,44 @@ static chpl_bool        initialized = false;
 static chpl_thread_mutex_t threading_lock;     // critical section lock
 static chpl_thread_mutex_t extra_task_lock;    // critical section lock
 static chpl_thread_mutex_t task_id_lock;       // critical section lock
-static chpl_thread_mutex_t task_list_lock;     // critical section lock
 static volatile task_pool_p
-                           task_pool_head;     // head of task pool
+                           task_pool_head;     // head of shared task pool
 static volatile task_pool_p
-                           task_pool_tail;     // tail of task pool
+                           task_pool_tail;     // tail of shared task pool
+
+//
+// Task lists are protected by a small set of locks, chosen by hashing
+// the address of the list head.
+//
+#define NUM_TASK_LIST_LOCKS 64
+static chpl_thread_mutex_t task_list_locks[NUM_TASK_LIST_LOCKS];
 
-static int                 queued_task_cnt;    // number of tasks in task pool
+//
+// All the work-stealing deques.  The array is replaced rather than
+// reallocated when it fills, so thieves can scan it without locking.
+//
+static chpl_thread_mutex_t deque_registry_lock;
+static task_deque_t** volatile
+                           deque_registry;
+static volatile int        deque_registry_cnt;
+static int                 deque_registry_size;
+
+//
+// Idle threads park here when they can't find any work.
+//
+#define IDLE_SPIN_ROUNDS 100
+static chpl_thread_mutex_t idle_lock;
+static chpl_thread_condvar_t
+                           idle_cond;
+static volatile int        parked_thread_cnt;  // number of parked threads
+
+static volatile int        queued_task_cnt;    // number of tasks waiting to
+                                               //   be claimed
 static int64_t             extra_task_cnt;     // number of tasks being run by
                                                //   threads occupied already
 static int                 blocked_thread_cnt; // number of threads that
                                                //   cannot make progress
-static int                 idle_thread_cnt;    // number of threads looking
+static volatile int        idle_thread_cnt;    // number of threads looking
                                                //   for work
 static uint64_t            progress_cnt;       // number of unblock operations,
                                                //   as a proxy for progress
@@ -117,7 +175,14 @@ static chpl_fn_p comm_task_fn;
 // Internal functions.
 //
 static void                    enqueue_task(task_pool_p, task_pool_p*);
-static void                    dequeue_task(task_pool_p);
+static chpl_bool               claim_task(task_pool_p);
+static void                    release_task(task_pool_p, int);
+static task_deque_t*           deque_new(void);
+static void                    deque_push(task_deque_t*, task_pool_p);
+static task_pool_p             deque_pop(task_deque_t*);
+static task_pool_p             deque_steal(task_deque_t*);
+static task_pool_p             find_task(thread_private_data_t*);
+static void                    wait_for_work(void);
 static void                    comm_task_wrapper(void*);
 static void                    taskCallBody(chpl_fn_int_t, chpl_fn_p,
                                             chpl_task_bundle_t*, size_t,
@@ -137,7 +202,7 @@ static void                    check_for_deadlock(void);
 static void                    thread_begin(void*);
 static void                    thread_end(void);
 static void                    maybe_add_thread(void);
-static task_pool_p             add_to_task_pool(chpl_fn_int_t, chpl_fn_p,
+static void                    add_to_task_pool(chpl_fn_int_t, chpl_fn_p,
                                                 chpl_task_bundle_t*, size_t,
                                                 chpl_bool, task_pool_p*,
                                                 chpl_bool, int, int32_t);
@@ -332,12 +397,19 @@ void chpl_task_init(void) {
   chpl_thread_mutexInit(&threading_lock);
   chpl_thread_mutexInit(&extra_task_lock);
   chpl_thread_mutexInit(&task_id_lock);
-  chpl_thread_mutexInit(&task_list_lock);
+  for (int i = 0; i < NUM_TASK_LIST_LOCKS; i++)
+    chpl_thread_mutexInit(&task_list_locks[i]);
+  chpl_thread_mutexInit(&deque_registry_lock);
+  chpl_thread_mutexInit(&idle_lock);
+  chpl_thread_condvar_init(&idle_cond);
   queued_task_cnt = 0;
   blocked_thread_cnt = 0;
   idle_thread_cnt = 0;
+  parked_thread_cnt = 0;
   extra_task_cnt = 0;
   task_pool_head = task_pool_tail = NULL;
+  deque_registry = NULL;
+  deque_registry_cnt = deque_registry_size = 0;
 
   chpl_thread_init(thread_begin, thread_end);
 
@@ -381,6 +453,10 @@ static void* do_callMain(void* arg) {
   // make sure this thread has thread-private data.
   setup_main_thread_private_data();
 
+  // Give the main task a deque, so that the tasks it creates can be
+  // stolen without going through the shared pool.
+  get_thread_private_data()->deque = deque_new();
+
   // make sure that the lock report is set up.
   if (blockreport)
     initializeLockReportForThread();
@@ -517,71 +593,254 @@ static void comm_task_wrapper(void* arg) {
 
 
 //
-// Enqueue and dequeue tasks from the pool.
+// Task lists are protected by one of a set of locks, chosen by the
+// address of the list head.
 //
 static inline
-void enqueue_task(task_pool_p ptask, task_pool_p* p_task_list_head) {
-  queued_task_cnt++;
+chpl_thread_mutex_p task_list_lock(task_pool_p* p_task_list_head) {
+  return &task_list_locks[((uintptr_t) p_task_list_head >> 3)
+                          % NUM_TASK_LIST_LOCKS];
+}
 
-  //
-  // Add to pool.
-  //
-  if (task_pool_tail)
-    task_pool_tail->next = ptask;
+
+//
+// Remove a task from its task list.  Assumes the list lock is held.
+//
+static inline
+void unlink_from_list(task_pool_p ptask) {
+  if (ptask == *(ptask->p_list_head))
+    *(ptask->p_list_head) = ptask->list_next;
   else
-    task_pool_head = ptask;
-  ptask->prev = task_pool_tail;
-  task_pool_tail = ptask;
+    ptask->list_prev->list_next = ptask->list_next;
+  if (ptask->list_next != NULL)
+    ptask->list_next->list_prev = ptask->list_prev;
+}
+
+
+//
+// Work-stealing deque operations.  Only the owning thread may push or
+// pop; any thread may steal.
+//
+static task_deque_t* deque_new(void) {
+  task_deque_t* d;
+
+  d = (task_deque_t*) chpl_mem_calloc(1, sizeof(task_deque_t),
+                                      CHPL_RT_MD_TASK_POOL_DESC, 0, 0);
+  d->array = (task_deque_array_t*)
+             chpl_mem_alloc(sizeof(task_deque_array_t)
+                            + TASK_DEQUE_INITIAL_SIZE * sizeof(task_pool_p),
+                            CHPL_RT_MD_TASK_POOL_DESC, 0, 0);
+  d->array->size = TASK_DEQUE_INITIAL_SIZE;
+
+  // begin critical section
+  chpl_thread_mutexLock(&deque_registry_lock);
+
+  if (deque_registry_cnt == deque_registry_size) {
+    int new_size = (deque_registry_size == 0) ? 16 : 2 * deque_registry_size;
+    task_deque_t** reg;
+
+    reg = (task_deque_t**) chpl_mem_alloc(new_size * sizeof(task_deque_t*),
+                                          CHPL_RT_MD_TASK_LAYER_UNSPEC, 0, 0);
+    if (deque_registry_cnt > 0)
+      memcpy(reg, deque_registry, deque_registry_cnt * sizeof(task_deque_t*));
+
+    // The old array is leaked, because thieves may still be scanning it.
+    __sync_synchronize();
+    deque_registry = reg;
+    deque_registry_size = new_size;
+  }
+
+  deque_registry[deque_registry_cnt] = d;
+  __sync_synchronize();
+  deque_registry_cnt++;
+
+  // end critical section
+  chpl_thread_mutexUnlock(&deque_registry_lock);
+
+  return d;
+}
+
+
+static void deque_push(task_deque_t* d, task_pool_p ptask) {
+  int64_t b = d->bottom;
+  int64_t t = d->top;
+  task_deque_array_t* a = d->array;
+
+  if (b - t >= a->size) {
+    task_deque_array_t* new_a;
+
+    new_a = (task_deque_array_t*)
+            chpl_mem_alloc(sizeof(task_deque_array_t)
+                           + 2 * a->size * sizeof(task_pool_p),
+                           CHPL_RT_MD_TASK_POOL_DESC, 0, 0);
+    new_a->size = 2 * a->size;
+    for (int64_t i = t; i < b; i++)
+      new_a->buf[i & (new_a->size - 1)] = a->buf[i & (a->size - 1)];
+    __sync_synchronize();
+    d->array = a = new_a;
+  }
+
+  a->buf[b & (a->size - 1)] = ptask;
+  __sync_synchronize();
+  d->bottom = b + 1;
+}
+
+
+static task_pool_p deque_pop(task_deque_t* d) {
+  int64_t b = d->bottom - 1;
+  task_deque_array_t* a = d->array;
+  task_pool_p ptask;
+  int64_t t;
+
+  d->bottom = b;
+  __sync_synchronize();
+  t = d->top;
+
+  if (t > b) {
+    // empty
+    d->bottom = b + 1;
+    return NULL;
+  }
+
+  ptask = a->buf[b & (a->size - 1)];
+  if (t == b) {
+    // This is the last task, so we may be racing a thief for it.
+    if (!__sync_bool_compare_and_swap(&d->top, t, t + 1))
+      ptask = NULL;
+    d->bottom = b + 1;
+  }
+
+  return ptask;
+}
+
+
+static task_pool_p deque_steal(task_deque_t* d) {
+  int64_t t, b;
+  task_deque_array_t* a;
+  task_pool_p ptask;
+
+  t = d->top;
+  __sync_synchronize();
+  b = d->bottom;
+  if (t >= b)
+    return NULL;
+
+  __sync_synchronize();
+  a = d->array;
+  ptask = a->buf[t & (a->size - 1)];
+
+  // If this fails somebody else got there first; let the caller move on.
+  if (!__sync_bool_compare_and_swap(&d->top, t, t + 1))
+    return NULL;
+
+  return ptask;
+}
+
+
+//
+// If threads are parked waiting for work and none are still actively
+// looking for it, wake one of them.  This is called after enqueueing
+// a task, and by a thread that has just claimed one (which may have
+// been the task the others were counting on it to find).
+//
+static inline
+void maybe_wake_thread(void) {
+  if (parked_thread_cnt > 0 && idle_thread_cnt <= parked_thread_cnt) {
+    chpl_thread_mutexLock(&idle_lock);
+    (void) pthread_cond_signal(&idle_cond);
+    chpl_thread_mutexUnlock(&idle_lock);
+  }
+}
+
+
+//
+// Enqueue a new task: onto its task list, if any, and then onto our
+// own deque if we have one or the shared pool if we don't.
+//
+static inline
+void enqueue_task(task_pool_p ptask, task_pool_p* p_task_list_head) {
+  thread_private_data_t* tp;
+
+  (void) __sync_fetch_and_add(&queued_task_cnt, 1);
 
   //
   // Add to list, if any.
   //
-  if (p_task_list_head == NULL) {
-    ptask->p_list_head = NULL;
-  }
-  else {
-    ptask->p_list_head = p_task_list_head;
+  ptask->p_list_head = p_task_list_head;
+  if (p_task_list_head != NULL) {
+    chpl_thread_mutex_p lock = task_list_lock(p_task_list_head);
+
+    chpl_thread_mutexLock(lock);
     ptask->list_next = *p_task_list_head;
     if (*p_task_list_head != NULL)
       (*p_task_list_head)->list_prev = ptask;
     ptask->list_prev = NULL;
     *p_task_list_head = ptask;
+    chpl_thread_mutexUnlock(lock);
   }
-}
-
-
-static inline
-void dequeue_task(task_pool_p ptask) {
-  assert(queued_task_cnt > 0);
-  queued_task_cnt--;
 
   //
-  // Remove from pool.
+  // Add to our deque or the shared pool.
   //
-  if (ptask == task_pool_head) {
-    if ((task_pool_head = task_pool_head->next) == NULL)
-      task_pool_tail = NULL;
-    else
-      task_pool_head->prev = NULL;
+  tp = (thread_private_data_t*) chpl_thread_getPrivateData();
+  if (tp != NULL && tp->deque != NULL) {
+    deque_push(tp->deque, ptask);
   }
   else {
-    if ((ptask->prev->next = ptask->next) == NULL)
-      task_pool_tail = ptask->prev;
+    // begin critical section
+    chpl_thread_mutexLock(&threading_lock);
+
+    if (task_pool_tail)
+      task_pool_tail->next = ptask;
     else
-      ptask->next->prev = ptask->prev;
+      task_pool_head = ptask;
+    task_pool_tail = ptask;
+
+    // end critical section
+    chpl_thread_mutexUnlock(&threading_lock);
   }
 
-  //
-  // Remove from list, if on one.
-  //
-  if (ptask->p_list_head != NULL) {
-    if (ptask == *(ptask->p_list_head))
-      *(ptask->p_list_head) = ptask->list_next;
-    else
-      ptask->list_prev->list_next = ptask->list_next;
-    if (ptask->list_next != NULL)
-      ptask->list_next->list_prev = ptask->list_prev;
+  maybe_wake_thread();
+}
+
+
+//
+// Claim a task we found in a deque or the shared pool, so that we can
+// run it.  This only fails if the task is also on a task list and the
+// owner of that list has already claimed it.
+//
+static inline
+chpl_bool claim_task(task_pool_p ptask) {
+  if (ptask->p_list_head == NULL) {
+    ptask->claimed = true;
+  }
+  else {
+    chpl_thread_mutex_p lock = task_list_lock(ptask->p_list_head);
+
+    chpl_thread_mutexLock(lock);
+    if (ptask->claimed) {
+      chpl_thread_mutexUnlock(lock);
+      return false;
+    }
+    ptask->claimed = true;
+    unlink_from_list(ptask);
+    chpl_thread_mutexUnlock(lock);
   }
+
+  (void) __sync_fetch_and_sub(&queued_task_cnt, 1);
+  return true;
+}
+
+
+//
+// Drop references to a task descriptor, freeing it when none remain.
+// There is one reference for the deque or pool slot that holds the
+// task and one for whoever runs it.
+//
+static inline
+void release_task(task_pool_p ptask, int n) {
+  if (__sync_sub_and_fetch(&ptask->refs, n) == 0)
+    chpl_mem_free(ptask, 0, 0);
 }
 
 
@@ -595,13 +854,10 @@ void chpl_task_addToTaskList(chpl_fn_int_t fid,
                              int32_t filename) {
   assert(subloc == c_sublocid_any);
 
-  // begin critical section
-  chpl_thread_mutexLock(&threading_lock);
-
   if (task_list_locale == chpl_nodeID) {
-    (void) add_to_task_pool(fid, chpl_ftable[fid], arg, arg_size,
-                            false, (task_pool_p*) p_task_list_void,
-                            is_begin_stmt, lineno, filename);
+    add_to_task_pool(fid, chpl_ftable[fid], arg, arg_size,
+                     false, (task_pool_p*) p_task_list_void,
+                     is_begin_stmt, lineno, filename);
 
   }
   else {
@@ -611,12 +867,9 @@ void chpl_task_addToTaskList(chpl_fn_int_t fid,
     // the context of a cobegin or coforall statement.
     //
     assert(is_begin_stmt);
-    (void) add_to_task_pool(fid, chpl_ftable[fid], arg, arg_size,
-                            false, NULL, true, 0, CHPL_FILE_IDX_UNKNOWN);
+    add_to_task_pool(fid, chpl_ftable[fid], arg, arg_size,
+                     false, NULL, true, 0, CHPL_FILE_IDX_UNKNOWN);
   }
-
-  // end critical section
-  chpl_thread_mutexUnlock(&threading_lock);
 }
 
 
@@ -631,18 +884,29 @@ void chpl_task_executeTasksInList(void** p_task_list_void) {
   curr_ptask = get_current_ptask();
 
   while (*p_task_list_head != NULL) {
+    chpl_thread_mutex_p lock = task_list_lock(p_task_list_head);
     chpl_fn_p task_to_run_fun = NULL;
 
+    //
+    // Tasks on the list haven't been claimed yet, since claiming one
+    // removes it from its list.  Whichever one we claim here will be
+    // skipped when it comes out of its deque or the shared pool.
+    //
+
     // begin critical section
-    chpl_thread_mutexLock(&threading_lock);
+    chpl_thread_mutexLock(lock);
 
     if ((child_ptask = *p_task_list_head) != NULL) {
       task_to_run_fun = child_ptask->bundle.requested_fn;
-      dequeue_task(child_ptask);
+      child_ptask->claimed = true;
+      unlink_from_list(child_ptask);
     }
 
     // end critical section
-    chpl_thread_mutexUnlock(&threading_lock);
+    chpl_thread_mutexUnlock(lock);
+
+    if (task_to_run_fun != NULL)
+      (void) __sync_fetch_and_sub(&queued_task_cnt, 1);
 
     if (task_to_run_fun == NULL)
       continue;
@@ -699,7 +963,7 @@ void chpl_task_executeTasksInList(void** p_task_list_void) {
     chpl_thread_mutexUnlock(&extra_task_lock);
 
     set_current_ptask(curr_ptask);
-    chpl_mem_free(child_ptask, 0, 0);
+    release_task(child_ptask, 1);
 
   }
 }
@@ -718,14 +982,8 @@ void taskCallBody(chpl_fn_int_t fid, chpl_fn_p fp,
                   chpl_task_bundle_t* arg, size_t arg_size,
                   c_sublocid_t subloc,
                   int lineno, int32_t filename) {
-  // begin critical section
-  chpl_thread_mutexLock(&threading_lock);
-
-  (void) add_to_task_pool(fid, fp, arg, arg_size, true,
-                          NULL, false, lineno, filename);
-
-  // end critical section
-  chpl_thread_mutexUnlock(&threading_lock);
+  add_to_task_pool(fid, fp, arg, arg_size, true,
+                   NULL, false, lineno, filename);
 }
 
 
@@ -830,7 +1088,9 @@ uint32_t chpl_task_getMaxPar(void) {
 }
 
 chpl_task_prvData_t* chpl_task_getPrvData(void) {
-  return & get_current_ptask()->chpl_data.prvdata;
+  // Threads that aren't running a task, such as comm threads, have none.
+  task_pool_p ptask = get_current_ptask();
+  return (ptask == NULL) ? NULL : &ptask->chpl_data.prvdata;
 }
 
 chpl_task_bundle_t* chpl_task_getPrvBundle(void) {
@@ -951,19 +1211,36 @@ static void report_locked_threads(void) {
 // This signal handler prints an overall task report, containing
 // pending tasks and those that are running.
 //
+static void report_pending_task(task_pool_p pendingTask) {
+  if (!pendingTask->claimed)
+    printf("- %s:%d\n", chpl_lookupFilename(pendingTask->bundle.filename),
+           pendingTask->bundle.lineno);
+}
+
 static void report_all_tasks(void) {
   task_pool_p pendingTask = task_pool_head;
+  int i;
 
   printf("Task report\n");
   printf("--------------------------------\n");
 
-  // print out pending tasks
+  //
+  // print out pending tasks, from the shared pool and then the deques.
+  // We don't lock anything here, so this is only a snapshot.
+  //
   printf("Pending tasks:\n");
   while (pendingTask != NULL) {
-    printf("- %s:%d\n", chpl_lookupFilename(pendingTask->bundle.filename),
-           pendingTask->bundle.lineno);
+    report_pending_task(pendingTask);
     pendingTask = pendingTask->next;
   }
+  for (i = 0; i < deque_registry_cnt; i++) {
+    task_deque_t* d = deque_registry[i];
+    task_deque_array_t* a = d->array;
+    int64_t t;
+
+    for (t = d->top; t < d->bottom; t++)
+      report_pending_task(a->buf[t & (a->size - 1)]);
+  }
   printf("\n");
 
   // print out running tasks
@@ -1109,9 +1386,147 @@ static void check_for_deadlock(void) {
 }
 
 
+//
+// Wait until there may be work for us.  New tasks often show up soon,
+// so we spin briefly first.  After that we park on a condition variable
+// until a task is enqueued.  If all the other threads seem to be
+// blocked we only wait for a second, and then check for deadlock.
+//
+// In revision 22137 we tried having idle threads wait on a condition
+// variable, but found that a thread could be stranded waiting for a
+// signal that never came.  Here spawners signal under the same lock
+// parked threads hold while rechecking the queued task count, and the
+// count is updated before the parked count is checked, so either the
+// parker sees the new task or the spawner sees the parker.
+//
+static void park_cleanup(void* ignore) {
+  (void) __sync_fetch_and_sub(&parked_thread_cnt, 1);
+  chpl_thread_mutexUnlock(&idle_lock);
+}
+
+static void wait_for_work(void) {
+  chpl_bool deadlock_possible;
+  chpl_bool timed_out = false;
+  int last_cancel_state;
+  int i;
+
+  for (i = 0; i < IDLE_SPIN_ROUNDS; i++) {
+    if (queued_task_cnt > 0)
+      return;
+    chpl_thread_yield();
+  }
+
+  deadlock_possible = set_block_loc(0, CHPL_FILE_IDX_IDLE_TASK);
+
+  // begin critical section
+  chpl_thread_mutexLock(&idle_lock);
+  (void) __sync_fetch_and_add(&parked_thread_cnt, 1);
+
+  if (queued_task_cnt == 0) {
+    //
+    // The threading layer only lets threads be canceled (at exit)
+    // while they are waiting for work, so we allow that here too.
+    //
+    pthread_cleanup_push(park_cleanup, NULL);
+    (void) pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, &last_cancel_state);
+
+    if (deadlock_possible) {
+      struct timeval now;
+      struct timespec ts;
+
+      gettimeofday(&now, NULL);
+      ts.tv_sec  = now.tv_sec + 1;
+      ts.tv_nsec = now.tv_usec * 1000UL;
+      timed_out = (pthread_cond_timedwait(&idle_cond,
+                                          (pthread_mutex_t*) &idle_lock, &ts)
+                   == ETIMEDOUT);
+    }
+    else {
+      (void) pthread_cond_wait(&idle_cond, (pthread_mutex_t*) &idle_lock);
+    }
+
+    (void) pthread_setcancelstate(last_cancel_state, NULL);
+    pthread_cleanup_pop(0);
+  }
+
+  (void) __sync_fetch_and_sub(&parked_thread_cnt, 1);
+
+  // end critical section
+  chpl_thread_mutexUnlock(&idle_lock);
+
+  if (timed_out && queued_task_cnt == 0)
+    check_for_deadlock();
+
+  unset_block_loc();
+}
+
+
+//
+// Find a task for this thread to run.  We look first in our own deque,
+// which gives us the most recently created (LIFO) task, then in the
+// shared pool, and then try to steal the oldest task from each of the
+// other deques in turn, starting with a randomly chosen one.  Returns
+// a claimed task, or NULL if we didn't find one.
+//
+static task_pool_p find_task(thread_private_data_t* tp) {
+  task_pool_p ptask;
+  task_deque_t** reg;
+  int n, start, i;
+
+  while ((ptask = deque_pop(tp->deque)) != NULL) {
+    if (claim_task(ptask))
+      return ptask;
+    release_task(ptask, 1);
+  }
+
+  while (task_pool_head != NULL) {
+    // begin critical section
+    chpl_thread_mutexLock(&threading_lock);
+
+    if ((ptask = task_pool_head) != NULL) {
+      if ((task_pool_head = ptask->next) == NULL)
+        task_pool_tail = NULL;
+    }
+
+    // end critical section
+    chpl_thread_mutexUnlock(&threading_lock);
+
+    if (ptask == NULL)
+      break;
+    if (claim_task(ptask))
+      return ptask;
+    release_task(ptask, 1);
+  }
+
+  n = deque_registry_cnt;
+  __sync_synchronize();
+  reg = deque_registry;
+
+  // xorshift64
+  tp->steal_seed ^= tp->steal_seed << 13;
+  tp->steal_seed ^= tp->steal_seed >> 7;
+  tp->steal_seed ^= tp->steal_seed << 17;
+  start = (int) (tp->steal_seed % n);
+
+  for (i = 0; i < n; i++) {
+    task_deque_t* d = reg[(start + i) % n];
+
+    if (d == tp->deque)
+      continue;
+    while ((ptask = deque_steal(d)) != NULL) {
+      if (claim_task(ptask))
+        return ptask;
+      release_task(ptask, 1);
+    }
+  }
+
+  return NULL;
+}
+
+
 //
 // When we create a thread it runs this wrapper function, which just
-// executes tasks out of the pool as they become available.
+// executes tasks as they become available.
 //
 static void
 thread_begin(void* ptask_void) {
@@ -1125,58 +1540,17 @@ thread_begin(void* ptask_void) {
 
   tp->ptask = NULL;
   tp->lockRprt = NULL;
+  tp->deque = deque_new();
+  tp->steal_seed = ((uint64_t) (intptr_t) tp) | 1;
   if (blockreport)
     initializeLockReportForThread();
 
   while (true) {
     //
-    // wait for a task to be present in the task pool
+    // wait for a task to become available
     //
-
-    // In revision 22137, we investigated whether it was beneficial to
-    // implement this while loop in a hybrid style, where depending on
-    // the number of tasks available, idle threads would either yield or
-    // wait on a condition variable to waken them.  Through analysis, we
-    // realized this could potential create a case where a thread would
-    // become stranded, waiting for a condition signal that would never
-    // come.  A potential solution to this was to keep a count of threads
-    // that were waiting on the signal, but since there was a performance
-    // impact from keeping it as a hybrid as opposed to merely yielding,
-    // it was decided that we would return to the simple yield case.
-    while (!task_pool_head) {
-      if (set_block_loc(0, CHPL_FILE_IDX_IDLE_TASK)) {
-        // all other tasks appear to be blocked
-        struct timeval deadline, now;
-        gettimeofday(&deadline, NULL);
-        deadline.tv_sec += 1;
-        do {
-          chpl_thread_yield();
-          if (!task_pool_head)
-            gettimeofday(&now, NULL);
-        } while (!task_pool_head
-                 && (now.tv_sec < deadline.tv_sec
-                     || (now.tv_sec == deadline.tv_sec
-                         && now.tv_usec < deadline.tv_usec)));
-        if (!task_pool_head) {
-          check_for_deadlock();
-        }
-      }
-      else {
-        do {
-          chpl_thread_yield();
-        } while (!task_pool_head);
-      }
-
-      unset_block_loc();
-    }
- 
-    //
-    // Just now the pool had at least one task in it.  Lock and see if
-    // there's something still there.
-    //
-    chpl_thread_mutexLock(&threading_lock);
-    if (!task_pool_head) {
-      chpl_thread_mutexUnlock(&threading_lock);
+    if ((ptask = find_task(tp)) == NULL) {
+      wait_for_work();
       continue;
     }
 
@@ -1187,19 +1561,15 @@ thread_begin(void* ptask_void) {
     if (blockreport)
       progress_cnt++;
 
+    (void) __sync_fetch_and_sub(&idle_thread_cnt, 1);
+    if (queued_task_cnt > 0)
+      maybe_wake_thread();
+
     //
-    // start new task; remove task from pool also add to task to task-table
-    // (structure in ChapelRuntime that keeps track of currently running tasks
-    // for task-reports on deadlock or Ctrl+C).
+    // start new task; add it to the task table (structure in
+    // ChapelRuntime that keeps track of currently running tasks for
+    // task-reports on deadlock or Ctrl+C).
     //
-    ptask = task_pool_head;
-    idle_thread_cnt--;
-
-    dequeue_task(ptask);
-
-    // end critical section
-    chpl_thread_mutexUnlock(&threading_lock);
-
     tp->ptask = ptask;
 
     if (do_taskReport) {
@@ -1231,18 +1601,12 @@ thread_begin(void* ptask_void) {
     }
 
     tp->ptask = NULL;
-    chpl_mem_free(ptask, 0, 0);
-
-    // begin critical section
-    chpl_thread_mutexLock(&threading_lock);
+    release_task(ptask, 2);
 
     //
     // finished task; increment idle count
     //
-    idle_thread_cnt++;
-
-    // end critical section
-    chpl_thread_mutexUnlock(&threading_lock);
+    (void) __sync_fetch_and_add(&idle_thread_cnt, 1);
   }
 }
 
@@ -1272,9 +1636,20 @@ static void thread_end(void)
 static void maybe_add_thread(void) {
   static chpl_bool warning_issued = false;
 
-  if (!warning_issued && chpl_thread_canCreate()) {
+  if (warning_issued || !chpl_thread_canCreate())
+    return;
+
+  // begin critical section
+  chpl_thread_mutexLock(&threading_lock);
+
+  //
+  // Recheck now that we hold the lock, in case some other spawner
+  // added a thread while we were waiting for it.
+  //
+  if (!warning_issued && chpl_thread_canCreate()
+      && queued_task_cnt > idle_thread_cnt) {
     if (chpl_thread_create(NULL) == 0) {
-      idle_thread_cnt++;
+      (void) __sync_fetch_and_add(&idle_thread_cnt, 1);
     }
     else {
       int32_t max_threads = chpl_thread_getMaxThreads();
@@ -1294,19 +1669,21 @@ static void maybe_add_thread(void) {
       warning_issued = true;
     }
   }
+
+  // end critical section
+  chpl_thread_mutexUnlock(&threading_lock);
 }
 
 
 // create a task from the given function pointer and arguments
-// and append it to the end of the task pool
-// assumes threading_lock has already been acquired!
+// and add it to our deque (or the shared pool, if we don't have one)
 static inline
-task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
-                             chpl_task_bundle_t* a, size_t a_size,
-                             chpl_bool is_executeOn,
-                             task_pool_p* p_task_list_head,
-                             chpl_bool is_begin_stmt,
-                             int lineno, int32_t filename) {
+void add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
+                      chpl_task_bundle_t* a, size_t a_size,
+                      chpl_bool is_executeOn,
+                      task_pool_p* p_task_list_head,
+                      chpl_bool is_begin_stmt,
+                      int lineno, int32_t filename) {
 
 
   size_t payload_size;
@@ -1328,7 +1705,8 @@ task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
   ptask->list_next              = NULL;
   ptask->list_prev              = NULL;
   ptask->next                   = NULL;
-  ptask->prev                   = NULL;
+  ptask->claimed                = false;
+  ptask->refs                   = 2;
   ptask->chpl_data              = pv;
   ptask->bundle.is_executeOn    = is_executeOn;
   ptask->bundle.lineno          = lineno;
@@ -1338,8 +1716,6 @@ task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
   ptask->bundle.requested_fn    = fp;
   ptask->bundle.id              = get_next_task_id();
 
-  enqueue_task(ptask, p_task_list_head);
-
   chpl_task_do_callbacks(chpl_task_cb_event_kind_create,
                          ptask->bundle.requested_fid,
                          ptask->bundle.filename,
@@ -1355,13 +1731,17 @@ task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
     chpl_thread_mutexUnlock(&taskTable_lock);
   }
 
+  //
+  // Once it's enqueued another thread may run (and free) the task at
+  // any time, so we can't refer to it after this.
+  //
+  enqueue_task(ptask, p_task_list_head);
+
   // If we now have more tasks than threads to run them on, try to start
   // another thread
   if (queued_task_cnt > idle_thread_cnt) {
     maybe_add_thread();
   }
-
-  return ptask;
 }
 
 
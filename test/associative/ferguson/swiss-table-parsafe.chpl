@@ -0,0 +1,87 @@
+// Exercises concurrent adds, removes and lookups on a parSafe
+// associative domain using the Swiss table engine, which locks only
+// the stripe for each index (see swiss-table-parsafe.compopts).
+
+config const n = 20000;
+config const numTasks = 8;
+
+var D: domain(int, parSafe=true);
+var A: [D] int;
+
+// overlapping adds: every index is added by two tasks
+coforall tid in 0..#numTasks with (ref D) do
+  for i in 1..n do
+    if i % numTasks == tid || (i+1) % numTasks == tid then
+      D += i;
+assert(D.size == n);
+
+forall i in D do
+  A[i] = i;
+assert(+ reduce A == n*(n+1)/2);
+
+// remove odd indices while other tasks look up the even ones
+coforall tid in 0..#numTasks with (ref D) {
+  if tid % 2 == 0 {
+    for i in 1..n by 2 do
+      if i % numTasks == tid || (i+2) % numTasks == tid then
+        D -= i;
+  } else {
+    for i in 2..n by 2 do
+      assert(D.contains(i) && A[i] == i);
+  }
+}
+for i in 1..n by 2 do
+  D -= i;
+assert(D.size == n/2);
+for i in 1..n do
+  assert(D.contains(i) == (i % 2 == 0));
+
+// churn: repeatedly add and remove disjoint ranges, leaving deleted
+// slots behind that must eventually be reclaimed
+coforall tid in 0..#numTasks with (ref D) {
+  for round in 1..10 {
+    for i in 1..n/numTasks do
+      D += -(tid*n + i);
+    for i in 1..n/numTasks do
+      D -= -(tid*n + i);
+  }
+}
+assert(D.size == n/2);
+for i in 2..n by 2 do
+  assert(A[i] == i);
+
+// grow, and then shrink, while other tasks look up the indices that
+// were there before.  Resizing moves entries to the new table a few at
+// a time, so these lookups see indices on both sides of the move.
+const half = numTasks/2;
+coforall tid in 0..#numTasks with (ref D) {
+  if tid % 2 == 0 {
+    for i in n+1..4*n do
+      if i % half == tid/2 then
+        D += i;
+  } else {
+    for i in 2..n by 2 do
+      assert(D.contains(i) && A[i] == i);
+  }
+}
+assert(D.size == n/2 + 3*n);
+for i in n+1..4*n do
+  assert(A[i] == 0);
+
+coforall tid in 0..#numTasks with (ref D) {
+  if tid % 2 == 0 {
+    for i in n+1..4*n do
+      if i % half == tid/2 then
+        D -= i;
+  } else {
+    for i in 2..n by 2 do
+      assert(D.contains(i) && A[i] == i);
+  }
+}
+assert(D.size == n/2);
+for i in 1..4*n do
+  assert(D.contains(i) == (i <= n && i % 2 == 0));
+for i in 2..n by 2 do
+  assert(A[i] == i);
+
+writeln("OK");
@@ -0,0 +1,84 @@
+// Exercises default associative domains and arrays using the
+// Swiss table engine (see swiss-table.compopts).
+
+config const n = 10000;
+
+proc checkInts(param parSafe: bool) {
+  var D: domain(int, parSafe=parSafe);
+  var A: [D] int;
+
+  for i in 1..n {
+    D += i;
+    A[i] = 2*i;
+  }
+  assert(D.size == n);
+
+  // remove the even indices, forcing shrinking resizes along the way
+  for i in 2..n by 2 do
+    D -= i;
+  assert(D.size == n/2);
+
+  for i in 1..n {
+    assert(D.contains(i) == (i % 2 == 1));
+    if i % 2 == 1 then
+      assert(A[i] == 2*i);
+  }
+
+  // re-add removed indices; they should be default-initialized
+  for i in 2..n by 2 do
+    D += i;
+  assert(D.size == n);
+  for i in 2..n by 2 do
+    assert(A[i] == 0);
+
+  var sum = 0;
+  for i in D do sum += i;
+  assert(sum == n*(n+1)/2);
+  assert(+ reduce D == n*(n+1)/2);
+  forall (i, a) in zip(D, A) do
+    assert(a == 0 || a == 2*i);
+
+  D.clear();
+  assert(D.size == 0);
+  for i in 1..n do
+    assert(!D.contains(i));
+}
+
+proc checkStrings() {
+  var D: domain(string);
+  var A: [D] int;
+
+  D.requestCapacity(n);
+  for i in 1..n {
+    const key = "key" + i:string;
+    D += key;
+    A[key] = i;
+  }
+  assert(D.size == n);
+  for i in 1..n by 3 do
+    D -= "key" + i:string;
+  for i in 1..n {
+    const key = "key" + i:string;
+    assert(D.contains(key) == ((i-1) % 3 != 0));
+    if D.contains(key) then
+      assert(A[key] == i);
+  }
+  assert(!D.contains("missing"));
+}
+
+proc checkParallelAdd() {
+  var D: domain(int, parSafe=true);
+  forall i in 1..n with (ref D) do
+    D += i;
+  assert(D.size == n);
+  var B: [D] int;
+  forall i in D do
+    B[i] = i;
+  assert(+ reduce B == n*(n+1)/2);
+}
+
+checkInts(false);
+checkInts(true);
+checkStrings();
+checkParallelAdd();
+writeln("OK");
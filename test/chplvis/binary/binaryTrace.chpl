@@ -0,0 +1,20 @@
+// Check that VisualDebug's binary trace format can be converted to
+// Chrome trace JSON (see the .prediff).
+
+use VisualDebug;
+
+var A: [0..#numLocales] int;
+
+startVdebug("binVis");
+
+tagVdebug("ons");
+coforall loc in Locales do on loc do
+  A[here.id] = here.id;
+
+tagVdebug("tasks");
+coforall i in 1..4 with (ref A) do
+  A[0] += 0;
+
+stopVdebug();
+
+writeln(A);
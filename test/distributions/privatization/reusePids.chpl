@@ -0,0 +1,18 @@
+// Check that the pids of privatized objects that have been freed get
+// reused, so that creating and destroying distributed arrays in a loop
+// doesn't keep growing the privatization table.
+
+use BlockDist;
+
+config const n = 1000;
+
+const D = {1..10} dmapped Block({1..10});
+
+var maxPid = -1;
+for i in 1..n {
+  var A: [D] int = i;
+  maxPid = max(maxPid, A._pid);
+  assert(+ reduce A == 10 * i);
+}
+
+writeln(maxPid < 10);
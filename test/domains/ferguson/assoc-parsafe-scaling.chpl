@@ -0,0 +1,61 @@
+// Measures how adding, finding and removing indices in a parSafe
+// associative domain scales with the number of tasks.  This test is
+// compiled once for each associative table engine (see
+// assoc-parsafe-scaling.compopts).
+config const n = 1000000;
+config const timing = true;
+config const perf = false;
+config const correctness = false;
+
+use Time;
+
+proc run(numTasks: int) {
+  var D: domain(int, parSafe=true);
+  var tAdd, tMember, tRemove: Timer;
+
+  tAdd.start();
+  coforall tid in 0..#numTasks with (ref D) do
+    for i in tid..n-1 by numTasks do
+      D += i * 7919;
+  tAdd.stop();
+
+  var found: atomic int;
+  tMember.start();
+  coforall tid in 0..#numTasks {
+    var myFound = 0;
+    for i in tid..2*n-1 by numTasks do
+      if D.contains(i * 7919) then
+        myFound += 1;
+    found.add(myFound);
+  }
+  tMember.stop();
+
+  tRemove.start();
+  coforall tid in 0..#numTasks with (ref D) do
+    for i in tid..n-1 by numTasks do
+      D -= i * 7919;
+  tRemove.stop();
+
+  if found.read() != n || D.size != 0 then
+    writeln("FAILURE for ", numTasks, " tasks: found=", found.read(),
+            " size=", D.size);
+
+  if timing {
+    const name = if numTasks == 1 then "serial" else "parallel";
+    if perf {
+      writef("%s add: %.3dr\n", name, tAdd.elapsed());
+      writef("%s member: %.3dr\n", name, tMember.elapsed());
+      writef("%s remove: %.3dr\n", name, tRemove.elapsed());
+    } else {
+      writef("%i tasks add/member/remove: %.3dr %.3dr %.3dr\n", numTasks,
+             tAdd.elapsed(), tMember.elapsed(), tRemove.elapsed());
+    }
+  }
+}
+
+run(1);
+run(max(2, here.maxTaskPar));
+
+if perf || correctness {
+  writeln("SUCCESS");
+}
@@ -0,0 +1,65 @@
+// Measures the throughput of adding, finding and removing indices
+// in default associative domains.  This test is compiled once for
+// each associative table engine (see assoc-table-ops.compopts).
+config const n = 1000000;
+config const timing = true;
+config const perf = false;
+config const correctness = false;
+
+use Time;
+
+proc run(type idxType, name: string) {
+  var D: domain(idxType);
+  var keys: [1..2*n] idxType;
+  for i in 1..2*n do
+    keys[i] = key(idxType, i);
+
+  var tAdd, tMember, tRemove: Timer;
+
+  tAdd.start();
+  for i in 1..n do
+    D += keys[i];
+  tAdd.stop();
+
+  // half of the lookups hit, half miss
+  var found = 0;
+  tMember.start();
+  for i in 1..2*n do
+    if D.contains(keys[i]) then
+      found += 1;
+  tMember.stop();
+
+  tRemove.start();
+  for i in 1..n do
+    D -= keys[i];
+  tRemove.stop();
+
+  if found != n || D.size != 0 then
+    writeln("FAILURE for ", name, ": found=", found, " size=", D.size);
+
+  if timing {
+    if perf {
+      writef("%s add: %.3dr\n", name, tAdd.elapsed());
+      writef("%s member: %.3dr\n", name, tMember.elapsed());
+      writef("%s remove: %.3dr\n", name, tRemove.elapsed());
+    } else {
+      writef("%s add/member/remove: %.3dr %.3dr %.3dr\n", name,
+             tAdd.elapsed(), tMember.elapsed(), tRemove.elapsed());
+    }
+  }
+}
+
+proc key(type idxType, i: int) where idxType == int {
+  return i * 7919;
+}
+
+proc key(type idxType, i: int) where idxType == string {
+  return "key-" + i:string;
+}
+
+run(int, "int");
+run(string, "string");
+
+if perf || correctness {
+  writeln("SUCCESS");
+}
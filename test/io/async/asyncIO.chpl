@@ -0,0 +1,75 @@
+// Reads and writes through IOHINT_ASYNC, both buffered and unbuffered,
+// with several readers working on the same file at once.
+use IO;
+
+config const n = 300_000;
+config const nReaders = 4;
+config const filename = "asyncIO.tmp";
+
+var A: [0..#n] int;
+for i in A.domain do A[i] = i * 7 + 1;
+
+// Binary array round trip; the array is large enough to go through
+// the bulk path and several asynchronous requests.
+{
+  var f = open(filename, iomode.cw, hints=IOHINT_ASYNC);
+  var w = f.writer(kind=iokind.big);
+  w.write(A);
+  w.close();
+  f.close();
+}
+{
+  var f = open(filename, iomode.r, hints=IOHINT_ASYNC);
+  writeln("size matches: ", f.length() == n * 8);
+  var B: [0..#n] int;
+  var r = f.reader(kind=iokind.big);
+  r.read(B);
+  r.close();
+  writeln("array round trip: ", && reduce (A == B));
+
+  // Many readers at once, each over its own region of the file.
+  var sums: [0..#nReaders] int;
+  const per = n / nReaders;
+  coforall t in 0..#nReaders {
+    const lo = t * per;
+    const hi = if t == nReaders - 1 then n else lo + per;
+    var rt = f.reader(kind=iokind.big, start=lo*8, end=hi*8);
+    var x: int;
+    var s = 0;
+    while rt.read(x) do s += x;
+    sums[t] = s;
+  }
+  writeln("parallel readers: ", + reduce sums == + reduce A);
+  f.close();
+}
+
+// Text written and read a line at a time.
+{
+  var f = open(filename, iomode.cwr, hints=IOHINT_ASYNC);
+  var w = f.writer();
+  for i in 1..20000 do w.writeln("line ", i);
+  w.close();
+
+  var r = f.reader();
+  var line: string;
+  var count = 0;
+  var ok = true;
+  while r.readline(line) {
+    count += 1;
+    ok &&= line == "line " + count:string + "\n";
+  }
+  writeln("lines: ", count, " ", ok);
+  r.close();
+  f.close();
+}
+
+// Memory files keep their own I/O method.
+{
+  var f = openmem();
+  var w = f.writer(hints=IOHINT_ASYNC);
+  w.write("in memory");
+  w.close();
+  var s: string;
+  f.reader().readline(s);
+  writeln(s);
+}
@@ -0,0 +1,85 @@
+// Binary array reads and writes go through a bulk path for contiguous
+// data and for slices whose rows are contiguous, in any byte order.
+// Check that they produce the same bytes as element-by-element I/O.
+use IO;
+
+proc kindName(param kind) param {
+  if kind == iokind.native then return "native";
+  else if kind == iokind.big then return "big";
+  else return "little";
+}
+
+// Write x with a bulk array write and return the bytes in the file.
+proc bulkBytes(param kind, const ref x) {
+  var f = openmem();
+  f.writer(kind=kind).write(x);
+  var got: [0..#f.length()] uint(8);
+  f.reader(kind=iokind.native).read(got);
+  return got;
+}
+
+// Write the elements of x one at a time and return the bytes in the file.
+proc eltBytes(param kind, const ref x) {
+  var f = openmem();
+  {
+    var w = f.writer(kind=kind);
+    for e in x do w.write(e);
+  }
+  var got: [0..#f.length()] uint(8);
+  f.reader(kind=iokind.native).read(got);
+  return got;
+}
+
+proc check(param kind, desc: string, ref x) {
+  const bulk = bulkBytes(kind, x);
+  const elts = eltBytes(kind, x);
+  var ok = bulk.size == elts.size && && reduce (bulk == elts);
+
+  // read the bytes back into x with a bulk array read
+  const saved = x;
+  x = 0:x.eltType;
+  var f = openmem();
+  f.writer(kind=iokind.native).write(bulk);
+  f.reader(kind=kind).read(x);
+  ok &&= && reduce (x == saved);
+
+  writeln(kindName(kind), " ", desc, ": ", if ok then "ok" else "MISMATCH");
+}
+
+proc testType(type t) {
+  var A: [1..10] t;
+  for i in 1..10 do A[i] = i:t;
+  var B: [1..4, 1..5] t;
+  for (i, j) in B.domain do B[i, j] = (10*i + j):t;
+
+  for param k in 0..2 {
+    param kind = if k == 0 then iokind.native
+                 else if k == 1 then iokind.big else iokind.little;
+    check(kind, t:string + " whole", A);
+    check(kind, t:string + " slice", A[3..7]);
+    check(kind, t:string + " strided", A[1..10 by 2]);
+    check(kind, t:string + " 2D whole", B);
+    check(kind, t:string + " 2D rows", B[2..3, 2..4]);
+    check(kind, t:string + " 2D strided rows", B[1..4 by 2, 1..5]);
+    check(kind, t:string + " 2D strided cols", B[1..4, 1..5 by 2]);
+  }
+}
+
+testType(int(32));
+testType(uint(16));
+testType(real);
+testType(complex);
+
+// Bools are one byte each in binary I/O, whatever their width.
+var D: [1..3] bool(32) = [true, false, true];
+for param k in 0..2 {
+  param kind = if k == 0 then iokind.native
+               else if k == 1 then iokind.big else iokind.little;
+  check(kind, "bool(32) whole", D);
+}
+writeln(bulkBytes(iokind.big, D));
+
+// Spot check the encoding itself.
+var C: [1..2] int(32) = [1:int(32), 0x01020304:int(32)];
+writeln(bulkBytes(iokind.big, C));
+writeln(bulkBytes(iokind.little, C));
@@ -0,0 +1,54 @@
+use IO;
+
+config const n = 200000;
+config const filename = "parallelLines.txt";
+
+proc lineNum(line: string) return line.strip()[6..]: int;
+
+{
+  var f = open(filename, iomode.cw);
+  var w = f.writer();
+  for i in 1..n do w.writeln("line ", i);
+  // no newline at the end of the last line
+  w.write("line ", n+1);
+  w.close();
+  f.close();
+}
+
+var f = open(filename, iomode.r);
+
+// serial
+var count, sum: int;
+for line in f.lines() {
+  count += 1;
+  sum += lineNum(line);
+}
+writeln("serial: ", count, " ", sum);
+
+// standalone
+var pcount, psum: int;
+forall line in f.lines() with (+ reduce pcount, + reduce psum) {
+  pcount += 1;
+  psum += lineNum(line);
+}
+writeln("standalone: ", pcount, " ", psum);
+
+// a region starting and ending in the middle of lines
+const start = 100003, end = f.length() - 50001;
+var rcount, rcountPar: int;
+var first: string;
+for line in f.lines(start=start, end=end) {
+  if rcount == 0 then first = line;
+  rcount += 1;
+}
+forall line in f.lines(start=start, end=end) with (+ reduce rcountPar) do
+  rcountPar += 1;
+writeln("region: ", rcount, " ", rcountPar, " ", first.strip());
+
+// parallel iteration never splits a line
+var bad: int;
+forall line in f.lines() with (+ reduce bad) do
+  if !line.startsWith("line ") then bad += 1;
+writeln("split lines: ", bad);
+
+f.close();
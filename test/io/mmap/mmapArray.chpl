@@ -0,0 +1,74 @@
+use IO;
+
+config const n = 100000;
+config const filename = "mmapArray.bin";
+
+{
+  var f = open(filename, iomode.cw);
+  var w = f.writer(kind=iokind.native);
+  for i in 1..n do w.write(i);
+  w.close();
+  f.close();
+}
+
+var f = open(filename, iomode.rw);
+
+// the whole file, read-only
+{
+  var A = f.mmapArray(int, hints=IOHINT_SEQUENTIAL);
+  writeln(A.domain, " ", + reduce A);
+}
+
+// a region in the middle
+{
+  var B = f.mmapArray(int, start=8*10, numElts=5);
+  writeln(B);
+}
+
+// writing to a read-only array changes only the array, even when the
+// file is only open for reading
+{
+  var fr = open(filename, iomode.r);
+  var B = fr.mmapArray(int, start=8*10, numElts=5);
+  B[1] = 0;
+  writeln(B, " ", f.mmapArray(int, start=8*10, numElts=5));
+}
+
+// writable: changes go to the file
+{
+  var C = f.mmapArray(int, writable=true);
+  forall c in C do c = -c;
+  f.fsync();
+}
+{
+  var r = f.reader(kind=iokind.native);
+  var x, sum: int;
+  while r.read(x) do sum += x;
+  writeln(sum);
+}
+
+// writable past the end extends the file
+{
+  var D = f.mmapArray(int, start=8*n, numElts=4, writable=true);
+  D = [7, 8, 9, 10];
+  f.fsync();
+  writeln(f.length() / 8, " ", f.mmapArray(int, start=8*n)[2]);
+}
+
+// errors
+try {
+  var E = f.mmapArray(int, start=3);
+} catch e: SystemError {
+  writeln("misaligned start: ", e.err == EINVAL);
+} catch {
+  writeln("unexpected error");
+}
+try {
+  var F = f.mmapArray(int, start=8*(n+2), numElts=10);
+} catch e: SystemError {
+  writeln("past the end: ", e.err == EEOF);
+} catch {
+  writeln("unexpected error");
+}
+
+f.close();
@@ -0,0 +1,69 @@
+// Reading and writing numbers in the default style has a fast path for
+// simple decimal text.  Check the cases at its edges, which must give
+// the same results as the general path.
+use IO;
+
+proc show(type t, text: string, n: int) {
+  var f = openmem();
+  f.writer().write(text);
+  var r = f.reader();
+  var x: t;
+  write(t:string, " ", "%'S".format(text), ":");
+  for 1..n {
+    r.read(x);
+    write(" ", x);
+  }
+  writeln();
+}
+
+// whitespace, terminators, and EOF right after a number
+show(int, "1 -2\t+3\n4", 4);
+show(int, "   17", 1);
+show(int, "12,34", 1);
+show(int, "0x1f 0b101 0", 3);
+show(int, "007 0 -0", 3);
+show(int(8), "127 -128", 2);
+show(uint(8), "255 +0", 2);
+show(int(16), "-32768 32767", 2);
+show(uint(32), "4294967295", 1);
+show(int, "9223372036854775807 -9223372036854775807", 2);
+show(uint, "18446744073709551615 1234567890123456789", 2);
+
+show(real, "1.5 -2.25 +3 4.", 4);
+show(real, "0.1 1e-4 99999.5 1e5 123456", 5);
+show(real, "1e22 1e23 2.2250738585072014e-308 4.9e-324", 4);
+show(real, "0.30000000000000004 9007199254740993", 2);
+show(real, "123456789012345678901234567890 0.000000000000000000000000000001", 2);
+show(real, "1.25E+2 1e-2\n7", 3);
+show(real, "inf -inf nan", 3);
+show(real, "-0 -0.0", 2);
+show(real(32), "0.1 3.4e38", 2);
+
+// printing
+writeln(0.0, " ", -0.0, " ", 1.0, " ", -1.5, " ", 0.1, " ", 1.0/3);
+writeln(1e-4, " ", 9.99999e-5, " ", 99999.9, " ", 99999.95, " ", 1e5);
+writeln(123456.0, " ", 0.000123456, " ", 1e-10, " ", 2.0**60);
+writeln(0.1:real(32), " ", 1.0/3:real(32), " ", 5.0i, " ", 1.0 + 2.5i);
+writeln(min(int), " ", max(int), " ", max(uint), " ", min(int(8)), " ", 0);
+
+// round trips
+var ok = true;
+for i in 0..20000 {
+  const x = (i * 7919) % 100003;
+  const r = (-1)**x * x / 1000.0;
+  const ri = (-1)**i * i * 46116860184273;
+  const rr = r / 3.0;
+  var f = openmem();
+  {
+    var w = f.writer();
+    w.writeln(r, " ", ri);
+    w.writef("%.17r\n", rr);
+  }
+  var r2, rr2: real, ri2: int;
+  f.reader().read(r2, ri2, rr2);
+  if r2 != r || ri2 != ri || rr2 != rr {
+    writeln("round trip mismatch: ", r, " ", ri, " ", rr);
+    ok = false;
+  }
+}
+writeln("round trips ", if ok then "ok" else "FAILED");
@@ -0,0 +1,50 @@
+use IO, Time;
+
+// test reading and writing a large text file of numbers
+
+config const n = 100000;
+config const timing = false;
+config const filename = "numericText.txt";
+
+var I: [1..n] int;
+var R: [1..n] real;
+for i in 1..n {
+  const x = (i * 7919) % 1000003;
+  I[i] = x - 500000;
+  // at most 6 significant digits, so the default style writes it exactly
+  R[i] = (x - 500000) / 100.0;
+}
+
+var tw: Timer;
+{
+  var f = open(filename, iomode.cw);
+  var w = f.writer(locking=false);
+  tw.start();
+  for i in 1..n do w.writeln(I[i], " ", R[i]);
+  w.close();
+  tw.stop();
+}
+
+var tr: Timer;
+var ok = true;
+{
+  var f = open(filename, iomode.r);
+  var r = f.reader(locking=false);
+  var x: int, y: real;
+  tr.start();
+  for i in 1..n {
+    r.read(x, y);
+    if x != I[i] || y != R[i] then ok = false;
+  }
+  tr.stop();
+}
+
+if ok then writeln("Success");
+else writeln("Mismatch reading back numbers");
+
+if timing {
+  writeln("n=", n);
+  writeln("time in seconds:");
+  writeln("write ", tw.elapsed());
+  writeln("read  ", tr.elapsed());
+}
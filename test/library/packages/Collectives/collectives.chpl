@@ -0,0 +1,64 @@
+use Collectives;
+
+config const n = 20000;   // big enough to take several pieces
+
+const sumIds = + reduce [loc in Locales] loc.id;
+const maxId = numLocales - 1;
+
+coforall loc in Locales do on loc {
+  const id = here.id;
+
+  // scalars, every op and element type
+  assert(allReduce(id) == sumIds);
+  assert(allReduce(id, reduceOp.min) == 0);
+  assert(allReduce(id, reduceOp.max) == maxId);
+  assert(allReduce(id+1, reduceOp.product) ==
+         * reduce [i in 1..numLocales] i);
+  assert(allReduce(1 << id, reduceOp.bitOr) == (1 << numLocales) - 1);
+  assert(allReduce(1 << id, reduceOp.bitXor) == (1 << numLocales) - 1);
+  assert(allReduce(~0, reduceOp.bitAnd) == ~0);
+  assert(allReduce(id: int(32)) == sumIds: int(32));
+  assert(allReduce(id: uint(32), reduceOp.max) == maxId: uint(32));
+  assert(allReduce(id: uint) == sumIds: uint);
+  assert(allReduce(id: real(32) + 0.5, reduceOp.min) == 0.5);
+  assert(allReduce(id + 0.5) == sumIds + 0.5 * numLocales);
+
+  // arrays, in several pieces
+  var A: [1..n] int = [i in 1..n] i * (id + 1);
+  allReduce(A);
+  assert(&& reduce [i in 1..n] A[i] == i * (numLocales * (numLocales+1)) / 2);
+
+  var R: [1..n] real = [i in 1..n] (i * numLocales + id): real;
+  allReduce(R, reduceOp.max);
+  assert(&& reduce [i in 1..n] R[i] == (i * numLocales + maxId): real);
+
+  // broadcasts from every root
+  for root in Locales {
+    var x = if here == root then 42 + root.id else -1;
+    broadcast(x, root);
+    assert(x == 42 + root.id);
+
+    var B: [0..#n] real;
+    if here == root then B = [i in 0..#n] i + root.id;
+    broadcast(B, root);
+    assert(&& reduce [i in 0..#n] B[i] == i + root.id);
+  }
+
+  // gathers
+  const ids = allGather(id);
+  assert(&& reduce [i in LocaleSpace] ids[i] == i);
+  const halves = allGather(id + 0.5);
+  assert(&& reduce [i in LocaleSpace] halves[i] == i + 0.5);
+
+  // barriers, with operations of every kind interleaved
+  for i in 1..100 {
+    barrier();
+    assert(allReduce(i + id) == i * numLocales + sumIds);
+    var y = if id == i % numLocales then i else 0;
+    broadcast(y, Locales[i % numLocales]);
+    assert(y == i);
+    assert(allGather(i * id)[maxId] == i * maxId);
+  }
+}
+
+writeln("ok");
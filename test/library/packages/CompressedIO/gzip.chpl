@@ -0,0 +1,101 @@
+// Write and read gzip files through CompressedIO channels.
+use CompressedIO, Spawn;
+
+// Check the file with the gzip tool itself.
+proc gzipAccepts(path: string): bool throws {
+  var p = spawn(["gzip", "-t", path]);
+  p.wait();
+  return p.exit_status == 0;
+}
+
+config const n = 100000;
+const filename = "gzip-test.txt.gz";
+
+// Formatted data over many blocks, compressed in parallel
+{
+  var w = openCompressedWriter(filename);
+  for i in 1..n do
+    w.writeln(i, " ", i * 0.5);
+  w.close();
+}
+{
+  var r = openCompressedReader(filename);
+  var ok = true;
+  var i: int, x: real;
+  var count = 0;
+  while r.read(i, x) {
+    count += 1;
+    if i != count || x != count * 0.5 then ok = false;
+  }
+  writeln("read ", count, " lines ", if ok then "correctly" else "WRONG");
+  writeln("gzip -t: ", gzipAccepts(filename));
+}
+
+// Starting at an offset in the decompressed data
+{
+  var r = openCompressedReader(filename, start=2 * 6);
+  var line: string;
+  r.readline(line);
+  write(line);
+}
+
+// Binary data
+{
+  var f = openCompressed(filename, iomode.cw);
+  var w = f.writer(kind=iokind.little);
+  for i in 1..n do
+    w.write(i:int(32));
+  w.close();
+  f.close();
+}
+{
+  var r = openCompressedReader(filename, kind=iokind.little);
+  var A: [1..n] int(32);
+  r.read(A);
+  const ok = && reduce (A == 1..n);
+  writeln("binary ", if ok then "correct" else "WRONG");
+  var x: int(32);
+  writeln("at end: ", !r.read(x));
+}
+
+// An empty file is still valid
+{
+  var w = openCompressedWriter(filename);
+  w.close();
+  var r = openCompressedReader(filename);
+  var s: string;
+  writeln("empty: ", !r.readline(s));
+  writeln("empty gzip -t: ", gzipAccepts(filename));
+}
+
+// Truncated data is an error
+{
+  var w = openCompressedWriter(filename);
+  for i in 1..1000 do
+    w.writeln(i);
+  w.close();
+  var f = open(filename, iomode.r);
+  var b: bytes;
+  f.reader().readbytes(b, f.length() - 10);
+  var copy = open("trunc-" + filename, iomode.cw).writer();
+  copy.write(b);
+  copy.close();
+  try {
+    var r = openCompressedReader("trunc-" + filename);
+    var s: string;
+    while r.readline(s) { }
+    writeln("no error");
+  } catch e: SystemError {
+    writeln("truncated: ", e.err == EFORMAT);
+  } catch {
+    writeln("unexpected error");
+  }
+}
+
+try {
+  openCompressed("test.txt");
+} catch e: IllegalArgumentError {
+  writeln(e.message());
+} catch {
+  writeln("unexpected error");
+}
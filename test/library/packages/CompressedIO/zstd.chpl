@@ -0,0 +1,76 @@
+// Write and read zstd files through CompressedIO channels.
+use CompressedIO, Spawn;
+
+// Check the file with the zstd tool itself.
+proc zstdAccepts(path: string): bool throws {
+  var p = spawn(["zstd", "-q", "-t", path]);
+  p.wait();
+  return p.exit_status == 0;
+}
+
+config const n = 100000;
+const filename = "zstd-test.txt.zst";
+
+// Formatted data over many blocks, compressed in parallel
+{
+  var w = openCompressedWriter(filename, level=5);
+  for i in 1..n do
+    w.writeln(i, " ", i * 0.5);
+  w.close();
+}
+{
+  var r = openCompressedReader(filename);
+  var ok = true;
+  var i: int, x: real;
+  var count = 0;
+  while r.read(i, x) {
+    count += 1;
+    if i != count || x != count * 0.5 then ok = false;
+  }
+  writeln("read ", count, " lines ", if ok then "correctly" else "WRONG");
+  writeln("zstd -t: ", zstdAccepts(filename));
+}
+
+// Binary data, with the format given explicitly
+{
+  const binname = "zstd-test.bin";
+  var w = openCompressedWriter(binname, kind=iokind.big,
+                               format=compressor.zstd);
+  for i in 1..n do
+    w.write(i);
+  w.close();
+
+  var r = openCompressedReader(binname, kind=iokind.big,
+                               format=compressor.zstd);
+  var A: [1..n] int;
+  r.read(A);
+  const ok = && reduce (A == 1..n);
+  writeln("binary ", if ok then "correct" else "WRONG");
+}
+
+// An empty file is still valid
+{
+  var w = openCompressedWriter(filename);
+  w.close();
+  var r = openCompressedReader(filename);
+  var s: string;
+  writeln("empty: ", !r.readline(s));
+  writeln("empty zstd -t: ", zstdAccepts(filename));
+}
+
+// Data that is not compressed is an error
+{
+  var w = open(filename, iomode.cw).writer();
+  w.writeln("not compressed");
+  w.close();
+  try {
+    var r = openCompressedReader(filename);
+    var s: string;
+    r.readline(s);
+    writeln("no error");
+  } catch e: SystemError {
+    writeln("not zstd: ", e.err == EFORMAT);
+  } catch {
+    writeln("unexpected error");
+  }
+}
@@ -0,0 +1,82 @@
+// Read records of delimited text with DelimitedReader and readDelimited.
+use IO, RecordParser;
+
+record Row {
+  var name: string;
+  var id: int;
+  var score: real;
+  var ok: bool;
+}
+
+proc show(text: string, delimiter = ",", quote = "\"", header = false) {
+  var f = openmem();
+  {
+    var w = f.writer();
+    w.write(text);
+    w.close();
+  }
+  var D = new owned DelimitedReader(Row, f.reader(), delimiter, quote,
+                                    header, batchSize=2);
+  var A: [1..2] Row;
+  try {
+    while true {
+      const n = D.readBatch(A);
+      if n == 0 then break;
+      for i in 1..n do writeln(A[i]);
+    }
+  } catch e: SystemError {
+    writeln("error: ", e.message());
+  } catch e {
+    writeln("error: ", e.message());
+  }
+  writeln("--");
+}
+
+show("a,1,2.5,true\nb,2,-1e3,false\nc,3,7,true\n");
+// quoting
+show('"x, y",3,0.5,true\n"say ""hi""",4,1,false\n"multi\nline",5,2,true\n');
+// \r\n, blank lines, empty fields, no newline at the end
+show("c,6,,\r\n\r\n\n,,7.25,true\n  d , 7 , 8 ,false");
+// a header, another delimiter, and quotes as text
+show('name\tid\tscore\tok\ne"f\t8\t9\ttrue\n', delimiter="\t", quote="", header=true);
+// errors
+show("g,1,2\n");
+show("h,x,1,true\n");
+show("i,300000000000000000000,1,true\n");
+show('"j"k,1,1,true\n');
+show('"unterminated,1,1,true\n');
+
+// readDelimited over several chunks gives the same records as a
+// serial reader
+config const n = 100000;
+const filename = "delimited.csv";
+{
+  var w = open(filename, iomode.cw).writer();
+  w.writeln("name,id,score,ok");
+  for i in 1..n {
+    const name = if i % 7 == 0 then '"row, ' + i:string + '"'
+                 else "row" + i:string;
+    w.writeln(name, ",", i, ",", i / 4.0, ",", i % 3 == 0);
+  }
+  w.close();
+}
+
+var f = open(filename, iomode.r);
+var P = readDelimited(Row, f, header=true);
+var S: [1..n] Row;
+{
+  var D = new owned DelimitedReader(Row, f.reader(), header=true);
+  var i = 0;
+  for r in D.stream() {
+    i += 1;
+    S[i] = r;
+  }
+  writeln("serial read ", i, " records");
+}
+writeln("parallel read ", P.size, " records");
+var same = P.size == n;
+if same then
+  for (p, s, i) in zip(P, S, 1..n) do
+    if p != s || p.id != i then same = false;
+writeln(if same then "same records" else "DIFFERENT records");
+writeln(P[6], " ", P[7]);
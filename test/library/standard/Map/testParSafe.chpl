@@ -0,0 +1,44 @@
+use Map;
+
+config const n = 10000;
+
+var m = new map(int, int, parSafe=true);
+
+forall i in 1..n with (ref m) do
+  m.add(i, i*i);
+assert(m.size == n);
+
+forall i in 1..n with (ref m) do
+  assert(m.contains(i) && m.set(i, -i));
+
+forall i in 1..n by 2 with (ref m) do
+  assert(m.remove(i));
+assert(m.size == n/2);
+
+var keySum, valSum: atomic int;
+forall k in m do
+  keySum.add(k);
+forall v in m.values() do
+  valSum.add(v);
+writeln(keySum.read(), " ", valSum.read());
+
+var count: atomic int;
+forall (k, v) in m.items() do
+  if k == -v then count.add(1);
+writeln(count.read());
+
+var keys: [1..n] int = [i in 1..n] n + i;
+var vals: [1..n] int = [i in 1..n] i;
+m.addAll(keys, vals);
+assert(m.size == n/2 + n);
+assert(m[n+7] == 7);
+
+var m2 = new map(int, int);
+m2.requestCapacity(n);
+m2.addAll(keys, vals);
+assert(m2.size == n);
+var total = + reduce m2.values();
+writeln(total);
+
+m.clear();
+assert(m.isEmpty());
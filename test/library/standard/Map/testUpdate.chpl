@@ -11,4 +11,4 @@ forall i in 19..40 with (ref m2) do
 
 m1.update(m2);
 
-writeln(m1.vals.sorted());
+writeln(m1.valuesToArray().sorted());
@@ -0,0 +1,32 @@
+use Set;
+
+config const n = 10000;
+
+proc doTest(param parSafe: bool) {
+  var s = new set(int, parSafe);
+  var xs: [1..n] int = [i in 1..n] i % (n/2);
+
+  s.addAll(xs);
+  assert(s.size == n/2);
+
+  if parSafe {
+    forall i in 1..n with (ref s) do
+      s.add(n + i);
+  } else {
+    for i in 1..n do
+      s.add(n + i);
+  }
+  assert(s.size == n/2 + n);
+
+  var sum: atomic int;
+  forall x in s do
+    sum.add(x);
+  writeln(sum.read());
+
+  for i in 0..#n/2 do
+    assert(s.remove(i));
+  assert(s.size == n);
+}
+
+doTest(false);
+doTest(true);
@@ -0,0 +1,41 @@
+use Time;
+
+// Allocates and frees objects from all of the tasks at once.  The
+// .perfexecopts run this with and without --memTrack, to show what
+// tracking costs when many tasks are allocating.  As in allocation.chpl,
+// the first trial is a warmup and isn't counted.  Set numTasks above the
+// number of cores to get contention on machines with only a few.
+config const printTiming : bool = true;
+config const numTrials : int = 3;
+config const allocationsPerTask : int = 1024 * 1024;
+config const numTasks : int = here.maxTaskPar;
+
+proc doParallelAllocation() {
+  var timer = new Timer();
+
+  var times : [1..numTrials] real;
+  for trial in 0..numTrials {
+    timer.start();
+    coforall 1..numTasks {
+      var arr : [1..allocationsPerTask] unmanaged object?;
+      for i in 1..allocationsPerTask {
+        arr[i] = new unmanaged object();
+      }
+      for i in 1..allocationsPerTask {
+        delete arr[i];
+      }
+    }
+    timer.stop();
+    if trial != 0 then times[trial] = timer.elapsed(TimeUnits.seconds);
+    timer.clear();
+  }
+
+  return times;
+}
+
+proc main() {
+  const times = doParallelAllocation();
+  if printTiming {
+    writeln("Parallel-Time:", (+ reduce times) / numTrials);
+  }
+}
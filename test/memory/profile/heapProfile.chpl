@@ -0,0 +1,12 @@
+use Memory;
+
+class C { var x: 10*int; }
+
+config const n = 100;
+
+var keep: [1..n] owned C?;
+for i in 1..n do keep[i] = new owned C();
+for i in 1..2*n { var c = new owned C(); }
+
+printMemProfile();
+printMemProfile(cumulative=true);
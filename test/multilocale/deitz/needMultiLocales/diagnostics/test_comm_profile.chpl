@@ -0,0 +1,17 @@
+use CommDiagnostics;
+
+config const n = 100;
+var A: [1..n] int;
+
+startCommProfile();
+on Locales(1) {
+  for i in 1..n do A(i) = i;
+  var s = 0;
+  for i in 1..n by 2 do s += A(i);
+  writeln(s);
+}
+stopCommProfile();
+printCommProfile();
+
+resetCommProfile();
+printCommProfile();
@@ -0,0 +1,36 @@
+use Time;
+
+//
+// Measure how task spawning scales when many tasks are creating tasks
+// at once, rather than a single parent.  Each of numSpawners tasks
+// repeatedly spawns and waits for a pair of empty tasks, so the rate
+// is limited by contention in the tasking layer's queues.
+//
+
+config const numTrials = 100;
+config const printTimings = false;
+
+proc main() {
+  for numSpawners in [1, 2, 4, 8] {
+    var t: Timer;
+    var counter: atomic int;
+
+    t.start();
+    coforall 1..numSpawners with (ref counter) {
+      for 1..numTrials {
+        sync {
+          begin counter.add(1);
+          begin counter.add(1);
+        }
+      }
+    }
+    t.stop();
+
+    if counter.read() != 2 * numTrials * numSpawners then
+      halt("expected ", 2 * numTrials * numSpawners, " tasks, but ran ",
+           counter.read());
+
+    if printTimings then
+      writeln("Elapsed time (", numSpawners, " spawners): ", t.elapsed());
+  }
+}
@@ -0,0 +1,24 @@
+config const n = 4;
+
+var total: atomic int;
+
+coforall i in 1..n do
+  total.add(i);
+
+sync {
+  for i in 1..3 do
+    begin total.add(1);
+}
+
+cobegin {
+  total.add(10);
+  total.add(20);
+}
+
+forall i in 1..1000 with (ref total) do
+  total.add(1);
+
+coforall loc in Locales do on loc do
+  total.add(100);
+
+writeln(total.read());
@@ -0,0 +1 @@
+executeOns.chpl
\ No newline at end of file
@@ -0,0 +1,39 @@
+//
+// Time on-statements from every other locale to locale 0.  Each of
+// those locales runs numTasksPerNode tasks, and each task does numOns
+// blocking on-statements that increment a counter on locale 0, so
+// locale 0's active message handling is the bottleneck.  This is run
+// with one AM handler thread per locale and, in the -4amh variant,
+// four, to see how on-statement throughput scales with the number of
+// handlers in the comm layers that support more than one.
+//
+use Time;
+
+config const numOns = 1000;
+config const numTasksPerNode = here.maxTaskPar;
+config const printTimings = false;
+
+proc main() {
+  var count: atomic int;
+  var t: Timer;
+
+  t.start();
+  coforall loc in Locales[1..] do on loc {
+    coforall 1..numTasksPerNode {
+      for 1..numOns do
+        on Locales[0] do count.add(1);
+    }
+  }
+  t.stop();
+
+  const expected = (numLocales - 1) * numTasksPerNode * numOns;
+  if count.read() != expected then
+    writeln("ERROR: ", count.read(), " on-statements, expected ", expected);
+
+  if printTimings {
+    writeln("On-statements: ", expected, " to locale 0 from ",
+            numLocales - 1, " locales");
+    writeln("Elapsed time: ", t.elapsed());
+    writeln("Performance (kOps/sec) = ", expected / t.elapsed() / 1e3);
+  }
+}
@@ -0,0 +1,30 @@
+//
+// Time runtime private broadcasts.  Starting and stopping comm
+// diagnostics each broadcast a runtime-private flag from locale 0 to
+// all the others, which is the same operation the program does at
+// startup for module-level constants and the global variables table.
+// Run this at several locale counts to see how broadcast cost scales;
+// setting CHPL_RT_COMM_BCAST_FANOUT to numLocales-1 or more gives the
+// flat (one send per locale from the root) broadcast for comparison.
+//
+use Time;
+use CommDiagnostics;
+
+config const numTrials = 100;
+config const printTimings = false;
+
+proc main() {
+  var t: Timer;
+
+  t.start();
+  for 1..numTrials {
+    startCommDiagnostics();
+    stopCommDiagnostics();
+  }
+  t.stop();
+
+  if printTimings {
+    writeln("Broadcasts: ", 2 * numTrials, " on ", numLocales, " locales");
+    writeln("Elapsed time: ", t.elapsed());
+  }
+}
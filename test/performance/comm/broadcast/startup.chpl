@@ -0,0 +1,36 @@
+//
+// Startup time for a program with module-level variables and constants.
+// Before user code runs, locale 0 broadcasts the global variables'
+// wide pointers, the values of module-level constants (privately), and
+// serialized module-level constants like strings to all the other
+// locales.  Run this at several locale counts to see how startup cost
+// scales; setting CHPL_RT_COMM_BCAST_FANOUT to numLocales-1 or more
+// gives the flat broadcast for comparison.
+//
+proc f(param p: int) {
+  var x: p*int;
+  for param i in 1..p do
+    x(i) = i;
+  return x;
+}
+
+const small = f(4);
+const large = f(1024);
+const name = "module-level string constant";
+const other = name + " " + name;
+
+var count: int;
+var flags: [0..#numLocales] bool;
+
+coforall loc in Locales with (+ reduce count) do on loc {
+  var sum = 0;
+  for param i in 1..4 do sum += small(i);
+  for param i in 1..1024 do sum += large(i);
+  if sum == 10 + 1024*1025/2 && other.size == 2*name.size + 1 then
+    count += 1;
+  flags[here.id] = true;
+}
+
+const allSet = && reduce flags;
+if count == numLocales && allSet then
+  writeln("ok");
@@ -0,0 +1,53 @@
+//
+// Time summing one value per locale.  In GlobalReduce mode locale 0
+// does a '+ reduce' over a Block-distributed array with one element on
+// each locale.  In AllReduce mode every locale calls
+// Collectives.allReduce(), which combines the values up a spanning
+// tree and sends the total back down.  Run this at several locale
+// counts to see how each scales.
+//
+use Time;
+use BlockDist;
+use Collectives;
+
+config const numTrials = 100;
+config const printTimings = false;
+
+enum ReduceMode {
+  GlobalReduce,
+  AllReduce
+};
+use ReduceMode;
+
+config param reduceMode = AllReduce;
+
+proc main() {
+  var t: Timer;
+
+  t.start();
+  select reduceMode {
+    when GlobalReduce do globalReduce();
+    when AllReduce do allReduceSPMD();
+  }
+  t.stop();
+
+  if printTimings {
+    writeln("Reductions: ", numTrials, " on ", numLocales, " locales");
+    writeln("Elapsed time: ", t.elapsed());
+  }
+}
+
+proc globalReduce() {
+  const D = LocaleSpace dmapped Block(LocaleSpace);
+  var A: [D] int = D;
+  const expected = + reduce A;
+  for 1..numTrials do
+    assert((+ reduce A) == expected);
+}
+
+proc allReduceSPMD() {
+  const expected = + reduce LocaleSpace;
+  coforall loc in Locales do on loc do
+    for 1..numTrials do
+      assert(allReduce(here.id) == expected);
+}
@@ -0,0 +1,92 @@
+//
+// Time strided GETs and PUTs between two locales.  Each one copies a
+// numChunks x chunkElems block of a numChunks x rowElems array to or
+// from the same block of an array on the other locale, so it consists
+// of numChunks contiguous chunks of chunkElems elements each.  This is
+// what a halo exchange or a strided slice assignment turns into.
+//
+use Time;
+
+enum op_t {
+  opGet,
+  opPut
+};
+
+use op_t;
+
+config const op = opGet;
+
+type elemType = int;
+
+config const chunkElems = 1;
+config const rowElems = 2 * chunkElems;
+config const numChunks = 10000;
+
+config const runSecs = 5.0;
+config const minOpsPerTimerCheck = 10;
+
+config const printTimings = false;
+
+proc main() {
+  if rowElems < chunkElems then
+    halt("rowElems must be at least chunkElems");
+
+  const D = {1..numChunks, 1..rowElems};
+  const Blk = {1..numChunks, 1..chunkElems};
+  var A: [D] elemType;
+  [(i, j) in D] A(i, j) = (i - 1) * rowElems + j;
+
+  on Locales[numLocales - 1] {
+    var nopsAtCheck = minOpsPerTimerCheck;
+    var nops: int;
+    var t: Timer;
+
+    var B: [D] elemType;
+    [(i, j) in D] B(i, j) = -((i - 1) * rowElems + j);
+
+    t.start();
+
+    while true {
+      if nops == nopsAtCheck {
+        if t.elapsed() >= runSecs then break;
+        nopsAtCheck = (nops * (0.75 * runSecs / t.elapsed())):int;
+        if nopsAtCheck - nops < minOpsPerTimerCheck then
+          nopsAtCheck = nops + minOpsPerTimerCheck;
+      }
+
+      // do op
+      if op == opGet {
+        B[Blk] = A[Blk];
+      } else if op == opPut {
+        A[Blk] = B[Blk];
+      }
+
+      nops += 1;
+    }
+
+    t.stop();
+
+    // check that the block, and only the block, was copied
+    if op == opGet then check(B, 1); else check(A, -1);
+
+    if printTimings {
+      const xferBytes = numChunks * chunkElems * numBytes(elemType);
+      writeln("Time: ", t.elapsed());
+      writeln("nops: ", nops);
+      writeln("MB/s: ", ((nops*xferBytes):real / 2**20:real) / t.elapsed());
+    }
+  }
+}
+
+//
+// Check that the block of X holds sign*A's original values and the rest
+// holds -sign*A's.
+//
+proc check(X: [] elemType, sign: int) {
+  for (i, j) in X.domain {
+    const v = (i - 1) * rowElems + j;
+    const expected = if j <= chunkElems then sign * v else -sign * v;
+    if X(i, j) != expected then
+      halt("mismatch at ", (i, j), ": ", X(i, j), " != ", expected);
+  }
+}
@@ -0,0 +1,39 @@
+// Reductions of Block and Cyclic arrays with built-in ops combine the
+// locales' results up a tree.  Check them against the same reductions
+// of local copies.
+use BlockDist, CyclicDist;
+
+config const n = 1000;
+
+proc check(A) {
+  var L: [{(...A.domain.dims())}] A.eltType = A;
+  writeln(A.eltType:string, ": ",
+          (+ reduce A) == (+ reduce L), " ",
+          (min reduce A) == (min reduce L), " ",
+          (max reduce A) == (max reduce L), " ",
+          (* reduce A) == (* reduce L));
+}
+
+const BD = {1..n} dmapped Block({1..n});
+const CD = {1..n} dmapped Cyclic(startIdx=1);
+const BD2 = {1..n/10, 1..10} dmapped Block({1..n/10, 1..10});
+
+var A: [BD] int = [i in BD] i % 17 - 8;
+var B: [CD] real = [i in CD] (i % 13):real / 8;  // exact in any order
+var C: [BD] uint(8) = [i in BD] (i % 251):uint(8);
+var D: [CD] bool = [i in CD] i % 3 == 0;
+var E: [BD2] int = [(i, j) in BD2] i - j;
+
+check(A);
+check(B);
+check(C);
+check(E);
+writeln((& reduce C), " ", (| reduce C), " ", (^ reduce C));
+writeln((+ reduce D), " ", (&& reduce D), " ", (|| reduce D));
+
+// slices and promoted expressions
+writeln((+ reduce A[2..n-1]), " ", + reduce (A + 1));
+
+// an empty array
+var Z: [{1..0} dmapped Block({1..n})] int;
+writeln(+ reduce Z, " ", max reduce Z);
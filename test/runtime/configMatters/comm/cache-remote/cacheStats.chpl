@@ -0,0 +1,34 @@
+use CommDiagnostics;
+
+config const n = 300000;
+
+on Locales[1] {
+  var A:[1..n] int;
+  for i in 1..n do A[i] = i;
+
+  on Locales[0] {
+    resetCacheStats();
+    startCacheStats();
+    var sum = 0;
+    for i in 1..n do sum += A[i];
+    for i in 1..n do A[i] = -A[i];
+    var s$: sync bool;
+    s$ = true; // release fence
+    s$;        // acquire fence
+    stopCacheStats();
+    assert(sum == n*(n+1)/2);
+
+    const cs = getCacheStats();
+    writeln("hits: ", cs[0].get_hits > 0);
+    writeln("misses: ", cs[0].get_misses > 0);
+    writeln("mostly hits: ", cs[0].get_hits > 10*cs[0].get_misses);
+    writeln("readaheads: ", cs[0].readaheads > 0);
+    writeln("dirty writebacks: ", cs[0].dirty_writebacks > 0);
+    writeln("ain evictions: ", cs[0].ain_evictions > 0);
+    writeln("fences: ", cs[0].release_fences > 0 && cs[0].acquire_fences > 0);
+    writeln("other locales: ", cs[1].get_hits + cs[2].get_hits == 0);
+
+    resetCacheStatsHere();
+    writeln(getCacheStatsHere());
+  }
+}
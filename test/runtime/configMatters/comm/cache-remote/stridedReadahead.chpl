@@ -0,0 +1,39 @@
+// Read remote arrays with a range of forward and backward strides, so that
+// the adaptive readahead policy (see the .execenv) detects streams, prefetches
+// ahead of them, and then gets interrupted by a change of stride.
+use CommDiagnostics;
+
+config const n = 40000;
+
+on Locales[1] {
+  var A:[0..#n] int;
+  for i in 0..#n do A[i] = i;
+
+  on Locales[0] {
+    for stride in [1, 3, 8, 64, 129, 1000] {
+      var fwd, bwd = 0;
+      resetCacheStatsHere();
+      startCacheStatsHere();
+      for i in 0..#n by stride {
+        assert(A[i] == i);
+        fwd += A[i];
+      }
+      for i in 0..#n by -stride {
+        assert(A[i] == i);
+        bwd += A[i];
+      }
+      stopCacheStatsHere();
+      assert(fwd == + reduce (0..#n by stride));
+      assert(bwd == + reduce (0..#n by -stride));
+
+      // Strides longer than a cache page must be prefetched too.  We only
+      // check strides within a system page, because with guard pages in
+      // use the cache doesn't prefetch past the page holding a request.
+      if stride * numBytes(int) < 4096 {
+        const cs = getCacheStatsHere();
+        if cs.readaheads == 0 || cs.readahead_useful == 0 then
+          writeln("stride ", stride, ": no useful readahead");
+      }
+    }
+  }
+}
@@ -0,0 +1,50 @@
+use BlockDist;
+use Random;
+use Time;
+use UnorderedAtomics;
+
+// Test many-to-many throughput of ordered and unordered atomics.  Every task
+// on every locale adds into random elements of a distributed histogram, so
+// most of the updates go to remote locales.
+
+config const updatesPerLocale = 10000,
+             numUpdates = updatesPerLocale * numLocales;
+config const binsPerLocale = 1024,
+             numBins = binsPerLocale * numLocales;
+config const printStats = false;
+config const oversubscription = 1,
+             tasksPerLocale = here.maxTaskPar * oversubscription;
+
+const BinSpace = {0..#numBins} dmapped Block({0..#numBins});
+const UpdateSpace = {0..#numUpdates} dmapped Block({0..#numUpdates},
+                                                   dataParTasksPerLocale=tasksPerLocale);
+
+var Rindex: [UpdateSpace] int;
+fillRandom(Rindex, seed=314159265);
+Rindex = mod(Rindex, numBins);
+
+proc test(param useUnordered, numUpdates, printStats) {
+  var Hist: [BinSpace] atomic int;
+
+  var t: Timer; t.start();
+  forall r in Rindex[0..#numUpdates] do
+    if useUnordered then Hist[r].unorderedAdd(1);
+                    else Hist[r].add(1);
+  t.stop();
+
+  if printStats {
+    const ordering = if useUnordered then "Unordered " else "Ordered ";
+    const time = "time(sec): " + t.elapsed():string;
+    const rate = "rate(mOps/sec): " + ((numUpdates / t.elapsed()) / 1e6):string;
+    writeln(ordering, time);
+    writeln(ordering, rate);
+  }
+
+  assert(+ reduce Hist.read() == numUpdates);
+}
+
+// warmup
+test(useUnordered=false, numUpdates=numUpdates/100, printStats=false);
+
+test(useUnordered=false, numUpdates=numUpdates/10, printStats=printStats);
+test(useUnordered=true,  numUpdates=numUpdates,    printStats=printStats);
@@ -0,0 +1,44 @@
+// Check the values left by unordered atomics once the tasks that did
+// them have fenced.  Each task fills its buffer for every other locale
+// many times over before its one fence, first for a single counter per
+// locale and then for counters scattered across all the locales.
+
+use BlockDist;
+use UnorderedAtomics;
+
+config const perTask = 50000,
+             tasksPerLocale = 4;
+
+const D = {0..#numLocales} dmapped Block({0..#numLocales});
+var Counts: [D] atomic int;
+
+coforall loc in Locales do on loc {
+  coforall tid in 0..#tasksPerLocale {
+    for i in 0..#perTask do
+      Counts[(here.id + 1 + i) % numLocales].unorderedAdd(1);
+    unorderedAtomicTaskFence();
+  }
+}
+
+const expected = perTask * tasksPerLocale;
+forall c in Counts do assert(c.read() == expected);
+writeln("ONE COUNTER PER LOCALE OK");
+
+const n = 1000 * numLocales;
+const D2 = {0..#n} dmapped Block({0..#n});
+var Scattered: [D2] atomic int;
+
+coforall loc in Locales do on loc {
+  coforall tid in 0..#tasksPerLocale {
+    for i in 0..#perTask do
+      Scattered[(i * 7919 + tid) % n].unorderedAdd(1);
+    unorderedAtomicTaskFence();
+  }
+}
+
+var E: [0..#n] int;
+for i in 0..#perTask do
+  for tid in 0..#tasksPerLocale do
+    E[(i * 7919 + tid) % n] += numLocales;
+forall i in D2 do assert(Scattered[i].read() == E[i]);
+writeln("SCATTERED COUNTERS OK");
@@ -0,0 +1,58 @@
+// Check the values left by unordered GETs and PUTs once the tasks that
+// did them have fenced.  Each task does many more of them than the comm
+// layers buffer before flushing, to scattered indices so that each
+// buffer holds a mix of destination locales.  The element sizes used
+// include the largest the comm layers buffer and one just over it.
+
+use BlockDist;
+use Random;
+use UnorderedCopy;
+
+config type eltType = int;
+config const perTask = 500,
+             tasksPerLocale = 4;
+
+const n = perTask * tasksPerLocale * numLocales;
+const D = {0..#n} dmapped Block({0..#n});
+
+// P is a permutation of D.  Task work is indexed by g, and goes to or
+// from index P[g].
+var P: [D] int;
+permutation(P, seed=314159);
+
+var A, B, C: [D] eltType;
+
+inline proc val(g: int): eltType {
+  var x: eltType;
+  x += g;
+  return x;
+}
+
+// Run body(g) for each g, with each task covering a strided piece of
+// its locale's indices and fencing when it is done.
+proc doUnordered(body) {
+  coforall loc in Locales do on loc {
+    const myInds = D.localSubdomain();
+    coforall tid in 0..#tasksPerLocale {
+      for g in myInds.low+tid..myInds.high by tasksPerLocale do
+        body(g);
+      unorderedCopyTaskFence();
+    }
+  }
+}
+
+record putter { proc this(g: int) { unorderedCopy(A[P[g]], val(g)); } }
+record getter { proc this(g: int) { unorderedCopy(B[g], A[P[g]]); } }
+record getputter { proc this(g: int) { unorderedCopy(C[P[g]], A[P[g]]); } }
+
+doUnordered(new putter());
+forall g in D do assert(A[P[g]] == val(g));
+writeln("PUT OK");
+
+doUnordered(new getter());
+forall g in D do assert(B[g] == val(g));
+writeln("GET OK");
+
+doUnordered(new getputter());
+forall g in D do assert(C[P[g]] == val(g));
+writeln("GETPUT OK");
@@ -0,0 +1,11 @@
+#include <private/internal-components.h>
+static const struct hwloc_component * hwloc_static_components[] = {
+  &hwloc_noos_component,
+  &hwloc_xml_component,
+  &hwloc_synthetic_component,
+  &hwloc_custom_component,
+  &hwloc_xml_nolibxml_component,
+  &hwloc_linux_component,
+  &hwloc_x86_component,
+  NULL
+};
@@ -0,0 +1,22 @@
+#!/bin/sh
+#-*-sh-*-
+
+#
+# Copyright © 2012-2018 Inria.  All rights reserved.
+# See COPYING in top-level directory.
+#
+
+HWLOC_top_builddir="/root/repo/third-party/hwloc/build/linux64-x86_64-native-gnu-none-flat"
+xmlbuffer=xmlbuffer
+
+HWLOC_PLUGINS_PATH=${HWLOC_top_builddir}/src
+export HWLOC_PLUGINS_PATH
+
+if test "`basename $1`" = "$xmlbuffer"; then
+    "$@" 1 1
+    "$@" 0 1
+    "$@" 1 0
+    "$@" 0 0
+else
+    "$@"
+fi
@@ -0,0 +1,9 @@
+#!/bin/sh
+
+prefix=/root/repo/runtime/../third-party/jemalloc/install/linux64-x86_64-unknown-gnu-none
+exec_prefix=/root/repo/runtime/../third-party/jemalloc/install/linux64-x86_64-unknown-gnu-none
+libdir=${exec_prefix}/lib
+
+LD_PRELOAD=${libdir}/libjemalloc.so.2
+export LD_PRELOAD
+exec "$@"